@@ -0,0 +1,656 @@
+/*
+ * Copyright (C) 2026, PADL Software Pty Ltd
+ *
+ * This file is part of AVDECCSwift.
+ *
+ * AVDECCSwift is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * AVDECCSwift is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with AVDECCSwift.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+// Executor microbenchmarks. Drives each executor flavour exactly the way
+// la_avdecc does — `ExecutorManager::pushJob` / `flush` by name — so the
+// numbers include the manager's lookup and the std::function hand-off,
+// not just our queue. Needs no network interface, no entity and no
+// privileges; run it on a quiet box and compare the JSON between builds:
+//
+//     swift run -c release avdecc-executor-benchmark > before.json
+//
+// Executors under test:
+//   stock    la_avdecc's ExecutorWithDispatchQueue (thread + condvar), the
+//            baseline ExecutorOwner replaced
+//   dispatch ExecutorOwner, ExecutorMode::Dispatch
+//   batched  ExecutorOwner, ExecutorMode::Batched
+//   thread   ExecutorOwner, ExecutorMode::Thread
+//
+// `batched` also accepts a `:pool` suffix, which roots the executor on a
+// shared ExecutorPool of `--pool-width` queues.
+//
+// Scenarios:
+//   push_single       one producer pushes `--jobs` no-op jobs, then flushes
+//   push_multi        `--producers` threads share the same job count
+//   flush_under_load  flush latency while producers keep the queue busy
+//   terminate_pending terminate(flushJobs=true) with `--jobs` queued behind
+//                     a job that is still running
+//   job_to_job        a job pushes its successor; push-to-start latency
+//   fanout            `--interfaces` executors (one per protocol
+//                     interface), each fed by `--entities` paced event
+//                     sources; reports the process's peak thread count
+//                     and context switches per second. Compare e.g.
+//                     `--executors batched,batched:pool`.
+//
+// Every scenario runs `--iterations` times on a fresh executor; results
+// are the per-iteration figures plus latency percentiles, one JSON
+// document on stdout. Progress and errors go to stderr.
+#include <CxxAVDECC.h>
+
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <cinttypes>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <functional>
+#include <future>
+#include <memory>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include <sys/resource.h>
+#if defined(__APPLE__)
+#  include <mach/mach.h>
+#else
+#  include <dirent.h>
+#endif
+
+namespace {
+
+using AVDECCSwift::steadyNanos;
+using la::avdecc::ExecutorManager;
+
+struct Config {
+  uint64_t jobs = 200000;
+  uint32_t producers = 4;
+  uint32_t iterations = 5;
+  uint32_t flushes = 200;
+  uint64_t chainLength = 20000;
+  uint32_t poolWidth = 0;
+  uint32_t interfaces = 8;
+  uint32_t entities = 4;
+  uint32_t bursts = 500;
+  uint32_t burstJobs = 16;
+  std::vector<std::string> executors{"stock", "dispatch", "batched", "thread"};
+  std::vector<std::string> scenarios{"push_single", "push_multi",
+                                     "flush_under_load", "terminate_pending",
+                                     "job_to_job"};
+};
+
+/// One registered executor, whatever its flavour. `terminate` flushes
+/// and stops it; the destructor drops the registration.
+class Subject final {
+  using WrapperPointer = ExecutorManager::ExecutorWrapper::UniquePointer;
+
+public:
+  static std::unique_ptr<Subject> create(std::string const& spec,
+                                         Config const& config) {
+    static std::atomic<uint32_t> serial{0};
+    auto subject = std::unique_ptr<Subject>(new Subject());
+    subject->name_ = "avdecc.bench." + spec + "." +
+                     std::to_string(serial.fetch_add(1));
+
+    auto flavour = spec;
+    auto const pooled = flavour.size() > 5 &&
+                        flavour.compare(flavour.size() - 5, 5, ":pool") == 0;
+    if (pooled) flavour.resize(flavour.size() - 5);
+
+    if (flavour == "stock") {
+      auto exec = la::avdecc::ExecutorWithDispatchQueue::create(
+          subject->name_, la::avdecc::utils::ThreadPriority::Highest);
+      subject->stock_ = exec.get();
+      subject->wrapper_ = std::make_unique<WrapperPointer>(
+          ExecutorManager::getInstance().registerExecutor(subject->name_,
+                                                          std::move(exec)));
+      return subject;
+    }
+
+    AVDECCSwift::ExecutorOptions options;
+    if (pooled) {
+      options.targetPool = "avdecc.bench.pool";
+      options.targetPoolWidth = config.poolWidth;
+    }
+    if (flavour == "dispatch") {
+      options.mode = static_cast<uint8_t>(AVDECCSwift::ExecutorMode::Dispatch);
+    } else if (flavour == "batched") {
+      options.mode = static_cast<uint8_t>(AVDECCSwift::ExecutorMode::Batched);
+    } else if (flavour == "thread") {
+      options.mode = static_cast<uint8_t>(AVDECCSwift::ExecutorMode::Thread);
+    } else {
+      std::fprintf(stderr, "unknown executor '%s'\n", flavour.c_str());
+      return nullptr;
+    }
+    AVDECCSwift::CapturedException err;
+    subject->owner_ =
+        AVDECCSwift::ExecutorOwner::create(subject->name_, options, err);
+    if (!subject->owner_) {
+      std::fprintf(stderr, "cannot create '%s' executor: %s\n",
+                   flavour.c_str(), err.message.c_str());
+      return nullptr;
+    }
+    return subject;
+  }
+
+  ~Subject() {
+    terminate();
+    if (owner_) AVDECCSwift_ExecutorOwner_release(owner_);
+  }
+
+  std::string const& name() const noexcept { return name_; }
+
+  void push(la::avdecc::Executor::Job&& job) const noexcept {
+    ExecutorManager::getInstance().pushJob(name_, std::move(job));
+  }
+
+  void flush() const noexcept { ExecutorManager::getInstance().flush(name_); }
+
+  void terminate() noexcept {
+    if (owner_) owner_->close();
+    if (stock_) {
+      stock_->terminate(/*flushJobs*/ true);
+      stock_ = nullptr;
+    }
+    wrapper_.reset();
+  }
+
+  AVDECCSwift::ExecutorStatistics statistics() const noexcept {
+    return owner_ ? owner_->statistics() : AVDECCSwift::ExecutorStatistics{};
+  }
+
+private:
+  Subject() = default;
+
+  std::string name_;
+  AVDECCSwift::ExecutorOwner* owner_ = nullptr;
+  la::avdecc::Executor* stock_ = nullptr;
+  // Boxed so an empty Subject needs no knowledge of the wrapper's deleter.
+  std::unique_ptr<WrapperPointer> wrapper_;
+};
+
+/// Latency samples for one scenario, all iterations pooled.
+class Samples final {
+public:
+  void reserve(size_t n) { values_.reserve(values_.size() + n); }
+  void add(uint64_t nanos) { values_.push_back(nanos); }
+  bool empty() const noexcept { return values_.empty(); }
+
+  void finish() { std::sort(values_.begin(), values_.end()); }
+
+  uint64_t percentile(double p) const noexcept {
+    if (values_.empty()) return 0;
+    auto const index = static_cast<size_t>(p * (values_.size() - 1) + 0.5);
+    return values_[std::min(index, values_.size() - 1)];
+  }
+
+  double mean() const noexcept {
+    if (values_.empty()) return 0;
+    long double total = 0;
+    for (auto v : values_) total += v;
+    return static_cast<double>(total / values_.size());
+  }
+
+private:
+  std::vector<uint64_t> values_;
+};
+
+struct Iteration {
+  uint64_t jobs = 0;
+  uint64_t jobsRun = 0;
+  /// Time spent pushing, and push-to-drained, in nanoseconds.
+  uint64_t pushNanos = 0;
+  uint64_t totalNanos = 0;
+  uint64_t heapAllocations = 0;
+  /// fanout only: peak threads beyond the benchmark's own (-1 if not
+  /// measured), and voluntary + involuntary context switches of the whole
+  /// process over `totalNanos`.
+  int64_t workerThreads = -1;
+  uint64_t contextSwitches = 0;
+};
+
+struct Result {
+  std::string executor;
+  std::string scenario;
+  uint32_t producers = 1;
+  std::vector<Iteration> iterations;
+  Samples latency;
+  bool ok = true;
+};
+
+/// Push `count` no-op jobs from `producers` threads, released together.
+/// Returns the wall time of the push phase.
+uint64_t pushFrom(Subject const& subject, uint64_t count, uint32_t producers,
+                  std::atomic<uint64_t>& ran) {
+  std::atomic<bool> go{false};
+  std::vector<std::thread> threads;
+  for (uint32_t p = 0; p < producers; ++p) {
+    auto const share = count / producers + (p < count % producers ? 1 : 0);
+    threads.emplace_back([&subject, &go, &ran, share] {
+      while (!go.load(std::memory_order_acquire)) std::this_thread::yield();
+      for (uint64_t i = 0; i < share; ++i) {
+        subject.push([&ran] { ran.fetch_add(1, std::memory_order_relaxed); });
+      }
+    });
+  }
+  auto const start = steadyNanos();
+  go.store(true, std::memory_order_release);
+  for (auto& t : threads) t.join();
+  return steadyNanos() - start;
+}
+
+bool runPush(Config const& config, Result& result) {
+  for (uint32_t it = 0; it < config.iterations; ++it) {
+    auto subject = Subject::create(result.executor, config);
+    if (!subject) return false;
+    std::atomic<uint64_t> ran{0};
+    Iteration row;
+    row.jobs = config.jobs;
+    auto const start = steadyNanos();
+    row.pushNanos = pushFrom(*subject, config.jobs, result.producers, ran);
+    subject->flush();
+    row.totalNanos = steadyNanos() - start;
+    row.jobsRun = ran.load();
+    row.heapAllocations = subject->statistics().jobNodeHeapAllocations;
+    result.iterations.push_back(row);
+  }
+  return true;
+}
+
+bool runFlushUnderLoad(Config const& config, Result& result) {
+  for (uint32_t it = 0; it < config.iterations; ++it) {
+    auto subject = Subject::create(result.executor, config);
+    if (!subject) return false;
+    std::atomic<uint64_t> ran{0};
+    std::atomic<uint64_t> pushed{0};
+    std::atomic<bool> stop{false};
+    std::vector<std::thread> threads;
+    for (uint32_t p = 0; p < result.producers; ++p) {
+      threads.emplace_back([&] {
+        while (!stop.load(std::memory_order_relaxed)) {
+          subject->push([&ran] { ran.fetch_add(1, std::memory_order_relaxed); });
+          pushed.fetch_add(1, std::memory_order_relaxed);
+        }
+      });
+    }
+    result.latency.reserve(config.flushes);
+    auto const start = steadyNanos();
+    for (uint32_t f = 0; f < config.flushes; ++f) {
+      auto const before = steadyNanos();
+      subject->flush();
+      result.latency.add(steadyNanos() - before);
+    }
+    stop.store(true, std::memory_order_relaxed);
+    for (auto& t : threads) t.join();
+    subject->flush();
+    Iteration row;
+    row.jobs = pushed.load();
+    row.jobsRun = ran.load();
+    row.totalNanos = steadyNanos() - start;
+    row.heapAllocations = subject->statistics().jobNodeHeapAllocations;
+    result.iterations.push_back(row);
+  }
+  return true;
+}
+
+bool runTerminatePending(Config const& config, Result& result) {
+  for (uint32_t it = 0; it < config.iterations; ++it) {
+    auto subject = Subject::create(result.executor, config);
+    if (!subject) return false;
+    // Park the executor on a gate job so every push below is still
+    // pending when terminate() is called.
+    std::promise<void> gate;
+    auto opened = gate.get_future().share();
+    std::promise<void> parked;
+    auto isParked = parked.get_future();
+    subject->push([opened, &parked] {
+      parked.set_value();
+      opened.wait();
+    });
+    isParked.wait();
+    std::atomic<uint64_t> ran{0};
+    Iteration row;
+    row.jobs = config.jobs;
+    row.pushNanos = pushFrom(*subject, config.jobs, 1, ran);
+    auto const start = steadyNanos();
+    gate.set_value();
+    subject->terminate();
+    row.totalNanos = steadyNanos() - start;
+    row.jobsRun = ran.load();
+    result.latency.add(row.totalNanos);
+    result.iterations.push_back(row);
+  }
+  return true;
+}
+
+/// Each job stamps the time, pushes its successor and records how long
+/// the previous push took to reach it.
+struct Chain {
+  Subject const* subject = nullptr;
+  uint64_t remaining = 0;
+  uint64_t pushedAt = 0;
+  std::vector<uint64_t> samples;
+  std::promise<void> done;
+
+  void step() {
+    auto const now = steadyNanos();
+    if (pushedAt != 0) samples.push_back(now - pushedAt);
+    if (remaining == 0) {
+      done.set_value();
+      return;
+    }
+    --remaining;
+    pushedAt = steadyNanos();
+    subject->push([this] { step(); });
+  }
+};
+
+bool runJobToJob(Config const& config, Result& result) {
+  for (uint32_t it = 0; it < config.iterations; ++it) {
+    auto subject = Subject::create(result.executor, config);
+    if (!subject) return false;
+    Chain chain;
+    chain.subject = subject.get();
+    chain.remaining = config.chainLength;
+    chain.samples.reserve(config.chainLength);
+    auto finished = chain.done.get_future();
+    auto const start = steadyNanos();
+    subject->push([&chain] { chain.step(); });
+    finished.wait();
+    Iteration row;
+    row.jobs = config.chainLength;
+    row.jobsRun = chain.samples.size();
+    row.totalNanos = steadyNanos() - start;
+    row.heapAllocations = subject->statistics().jobNodeHeapAllocations;
+    result.latency.reserve(chain.samples.size());
+    for (auto s : chain.samples) result.latency.add(s);
+    result.iterations.push_back(row);
+  }
+  return true;
+}
+
+void atomicMax(std::atomic<int64_t>& target, int64_t value) noexcept {
+  auto current = target.load(std::memory_order_relaxed);
+  while (value > current &&
+         !target.compare_exchange_weak(current, value, std::memory_order_relaxed)) {
+  }
+}
+
+/// Threads currently in this process, or -1 if unknown.
+int64_t threadCount() noexcept {
+#if defined(__APPLE__)
+  thread_act_array_t threads = nullptr;
+  mach_msg_type_number_t count = 0;
+  if (task_threads(mach_task_self(), &threads, &count) != KERN_SUCCESS) return -1;
+  for (mach_msg_type_number_t i = 0; i < count; ++i) {
+    mach_port_deallocate(mach_task_self(), threads[i]);
+  }
+  vm_deallocate(mach_task_self(), reinterpret_cast<vm_address_t>(threads),
+                count * sizeof(thread_act_t));
+  return count;
+#else
+  auto* dir = opendir("/proc/self/task");
+  if (!dir) return -1;
+  int64_t count = 0;
+  while (auto const* entry = readdir(dir)) {
+    if (entry->d_name[0] != '.') ++count;
+  }
+  closedir(dir);
+  return count;
+#endif
+}
+
+uint64_t contextSwitches() noexcept {
+  rusage usage{};
+  getrusage(RUSAGE_SELF, &usage);
+  return static_cast<uint64_t>(usage.ru_nvcsw) + static_cast<uint64_t>(usage.ru_nivcsw);
+}
+
+/// One executor per interface, each fed by `entities` sources that push
+/// `burstJobs` jobs and then sleep for a millisecond — roughly the shape
+/// of ADP / unsolicited-notification traffic. A sampler thread tracks the
+/// peak thread count while it runs.
+bool runFanout(Config const& config, Result& result) {
+  for (uint32_t it = 0; it < config.iterations; ++it) {
+    auto const baseline = threadCount();
+    std::vector<std::unique_ptr<Subject>> subjects;
+    for (uint32_t i = 0; i < config.interfaces; ++i) {
+      auto subject = Subject::create(result.executor, config);
+      if (!subject) return false;
+      subjects.push_back(std::move(subject));
+    }
+
+    std::atomic<uint64_t> ran{0};
+    std::atomic<bool> sampling{true};
+    std::atomic<int64_t> peak{threadCount()};
+    std::thread sampler([&] {
+      while (sampling.load(std::memory_order_relaxed)) {
+        atomicMax(peak, threadCount());
+        std::this_thread::sleep_for(std::chrono::milliseconds(1));
+      }
+    });
+
+    auto const switchesBefore = contextSwitches();
+    auto const start = steadyNanos();
+    std::vector<std::thread> sources;
+    for (auto const& subject : subjects) {
+      for (uint32_t e = 0; e < config.entities; ++e) {
+        sources.emplace_back([&config, &ran, target = subject.get()] {
+          for (uint32_t b = 0; b < config.bursts; ++b) {
+            for (uint32_t j = 0; j < config.burstJobs; ++j) {
+              target->push([&ran] { ran.fetch_add(1, std::memory_order_relaxed); });
+            }
+            std::this_thread::sleep_for(std::chrono::milliseconds(1));
+          }
+        });
+      }
+    }
+    for (auto& t : sources) t.join();
+    for (auto const& subject : subjects) subject->flush();
+
+    Iteration row;
+    row.totalNanos = steadyNanos() - start;
+    row.contextSwitches = contextSwitches() - switchesBefore;
+    sampling.store(false, std::memory_order_relaxed);
+    sampler.join();
+    row.jobs = uint64_t{config.interfaces} * config.entities * config.bursts *
+               config.burstJobs;
+    row.jobsRun = ran.load();
+    if (baseline >= 0 && peak.load() >= 0) {
+      // Discount the sources, the sampler and whatever ran before.
+      row.workerThreads = std::max<int64_t>(
+          0, peak.load() - baseline - static_cast<int64_t>(sources.size()) - 1);
+    }
+    result.iterations.push_back(row);
+  }
+  return true;
+}
+
+void printResult(Result& result, bool last) {
+  result.latency.finish();
+  std::printf("    {\n      \"executor\": \"%s\",\n      \"scenario\": \"%s\",\n"
+              "      \"producers\": %" PRIu32 ",\n      \"ok\": %s,\n"
+              "      \"iterations\": [",
+              result.executor.c_str(), result.scenario.c_str(),
+              result.producers, result.ok ? "true" : "false");
+  for (size_t i = 0; i < result.iterations.size(); ++i) {
+    auto const& row = result.iterations[i];
+    auto const rate = row.totalNanos
+        ? static_cast<double>(row.jobsRun) * 1e9 / static_cast<double>(row.totalNanos)
+        : 0.0;
+    auto const pushRate = row.pushNanos
+        ? static_cast<double>(row.jobs) * 1e9 / static_cast<double>(row.pushNanos)
+        : 0.0;
+    std::printf("%s\n        {\"jobs\": %" PRIu64 ", \"jobsRun\": %" PRIu64
+                ", \"pushNanos\": %" PRIu64 ", \"totalNanos\": %" PRIu64
+                ", \"pushesPerSecond\": %.1f, \"jobsPerSecond\": %.1f"
+                ", \"jobNodeHeapAllocations\": %" PRIu64,
+                i ? "," : "", row.jobs, row.jobsRun, row.pushNanos,
+                row.totalNanos, pushRate, rate, row.heapAllocations);
+    if (row.workerThreads >= 0) {
+      auto const switchRate = row.totalNanos
+          ? static_cast<double>(row.contextSwitches) * 1e9 /
+                static_cast<double>(row.totalNanos)
+          : 0.0;
+      std::printf(", \"workerThreads\": %" PRId64 ", \"contextSwitches\": %" PRIu64
+                  ", \"contextSwitchesPerSecond\": %.1f",
+                  row.workerThreads, row.contextSwitches, switchRate);
+    }
+    std::printf("}");
+  }
+  std::printf("\n      ]");
+  if (!result.latency.empty()) {
+    std::printf(",\n      \"latencyNanos\": {\"mean\": %.1f, \"p50\": %" PRIu64
+                ", \"p90\": %" PRIu64 ", \"p99\": %" PRIu64 ", \"p999\": %" PRIu64
+                ", \"max\": %" PRIu64 "}",
+                result.latency.mean(), result.latency.percentile(0.5),
+                result.latency.percentile(0.9), result.latency.percentile(0.99),
+                result.latency.percentile(0.999), result.latency.percentile(1.0));
+  }
+  std::printf("\n    }%s\n", last ? "" : ",");
+}
+
+std::vector<std::string> splitList(char const* arg) {
+  std::vector<std::string> out;
+  std::string current;
+  for (auto const* p = arg; *p; ++p) {
+    if (*p == ',') {
+      if (!current.empty()) out.push_back(current);
+      current.clear();
+    } else {
+      current += *p;
+    }
+  }
+  if (!current.empty()) out.push_back(current);
+  return out;
+}
+
+void usage(char const* argv0) {
+  std::fprintf(stderr,
+               "Usage: %s [--jobs N] [--producers N] [--iterations N]\n"
+               "          [--flushes N] [--chain N] [--pool-width N]\n"
+               "          [--interfaces N] [--entities N] [--bursts N]"
+               " [--burst-jobs N]\n"
+               "          [--executors stock,dispatch,batched,thread,"
+               "batched:pool]\n"
+               "          [--scenarios push_single,push_multi,flush_under_load,"
+               "terminate_pending,job_to_job,fanout]\n",
+               argv0);
+}
+
+bool parseArguments(int argc, char** argv, Config& config) {
+  for (int i = 1; i < argc; ++i) {
+    auto const* arg = argv[i];
+    if (i + 1 >= argc) return false;
+    auto const* value = argv[++i];
+    auto const number = std::strtoull(value, nullptr, 10);
+    if (!std::strcmp(arg, "--jobs")) {
+      config.jobs = number;
+    } else if (!std::strcmp(arg, "--producers")) {
+      config.producers = static_cast<uint32_t>(std::max<unsigned long long>(number, 1));
+    } else if (!std::strcmp(arg, "--iterations")) {
+      config.iterations = static_cast<uint32_t>(number);
+    } else if (!std::strcmp(arg, "--flushes")) {
+      config.flushes = static_cast<uint32_t>(number);
+    } else if (!std::strcmp(arg, "--chain")) {
+      config.chainLength = number;
+    } else if (!std::strcmp(arg, "--pool-width")) {
+      config.poolWidth = static_cast<uint32_t>(number);
+    } else if (!std::strcmp(arg, "--interfaces")) {
+      config.interfaces = static_cast<uint32_t>(std::max<unsigned long long>(number, 1));
+    } else if (!std::strcmp(arg, "--entities")) {
+      config.entities = static_cast<uint32_t>(std::max<unsigned long long>(number, 1));
+    } else if (!std::strcmp(arg, "--bursts")) {
+      config.bursts = static_cast<uint32_t>(number);
+    } else if (!std::strcmp(arg, "--burst-jobs")) {
+      config.burstJobs = static_cast<uint32_t>(number);
+    } else if (!std::strcmp(arg, "--executors")) {
+      config.executors = splitList(value);
+    } else if (!std::strcmp(arg, "--scenarios")) {
+      config.scenarios = splitList(value);
+    } else {
+      return false;
+    }
+  }
+  return true;
+}
+
+} // namespace
+
+int main(int argc, char** argv) {
+  Config config;
+  if (!parseArguments(argc, argv, config)) {
+    usage(argv[0]);
+    return 1;
+  }
+
+  std::vector<Result> results;
+  for (auto const& executor : config.executors) {
+    for (auto const& scenario : config.scenarios) {
+      Result result;
+      result.executor = executor;
+      result.scenario = scenario;
+      result.producers = scenario == "push_single" ? 1u : config.producers;
+      std::fprintf(stderr, "%s / %s\n", executor.c_str(), scenario.c_str());
+      if (scenario == "push_single" || scenario == "push_multi") {
+        result.ok = runPush(config, result);
+      } else if (scenario == "flush_under_load") {
+        result.ok = runFlushUnderLoad(config, result);
+      } else if (scenario == "terminate_pending") {
+        result.producers = 1;
+        result.ok = runTerminatePending(config, result);
+      } else if (scenario == "job_to_job") {
+        result.producers = 1;
+        result.ok = runJobToJob(config, result);
+      } else if (scenario == "fanout") {
+        result.producers = config.interfaces * config.entities;
+        result.ok = runFanout(config, result);
+      } else {
+        std::fprintf(stderr, "unknown scenario '%s'\n", scenario.c_str());
+        usage(argv[0]);
+        return 1;
+      }
+      results.push_back(std::move(result));
+    }
+  }
+
+  std::printf("{\n  \"benchmark\": \"executor\",\n  \"avdeccVersion\": \"%s\",\n"
+              "  \"statisticsEnabled\": %s,\n  \"hardwareConcurrency\": %u,\n"
+              "  \"config\": {\"jobs\": %" PRIu64 ", \"producers\": %" PRIu32
+              ", \"iterations\": %" PRIu32 ", \"flushes\": %" PRIu32
+              ", \"chain\": %" PRIu64 ", \"poolWidth\": %" PRIu32
+              ", \"interfaces\": %" PRIu32 ", \"entities\": %" PRIu32
+              ", \"bursts\": %" PRIu32 ", \"burstJobs\": %" PRIu32
+              "},\n  \"results\": [\n",
+              la::avdecc::getVersion().c_str(),
+              AVDECCSWIFT_EXECUTOR_STATISTICS ? "true" : "false",
+              std::thread::hardware_concurrency(), config.jobs, config.producers,
+              config.iterations, config.flushes, config.chainLength,
+              config.poolWidth, config.interfaces, config.entities, config.bursts,
+              config.burstJobs);
+  for (size_t i = 0; i < results.size(); ++i) {
+    printResult(results[i], i + 1 == results.size());
+  }
+  std::printf("  ]\n}\n");
+
+  auto const failed = std::any_of(results.begin(), results.end(),
+                                  [](Result const& r) { return !r.ok; });
+  return failed ? 2 : 0;
+}
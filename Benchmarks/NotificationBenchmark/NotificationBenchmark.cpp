@@ -0,0 +1,299 @@
+/*
+ * Copyright (C) 2026, PADL Software Pty Ltd
+ *
+ * This file is part of AVDECCSwift.
+ *
+ * AVDECCSwift is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * AVDECCSwift is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with AVDECCSwift.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+// Notification-dispatch microbenchmark: how many observer notifications
+// per second get from la_avdecc's virtual call to the bound block when
+// several la_avdecc threads fire at once. Needs no network interface:
+// notifications are fired straight at the adapter through
+// `ProtocolInterface::Observer&`, as la_avdecc does.
+//
+//     swift run -c release avdecc-notification-benchmark > notify.json
+//
+// Dispatchers under test:
+//   locked  the previous scheme, rebuilt here: one mutex for all slots,
+//           Block_copy of the slot under it, call, Block_release
+//   table   BlockProtocolInterfaceObserver (SlotTable snapshot, block
+//           called in place)
+//
+// Each dispatcher runs with every count in `--threads` (default 1,4,16)
+// firing `--notifications` onRemoteEntityOffline calls in total, shared
+// between them. With `--rebind-micros N` a further thread rebinds the
+// slot every N microseconds, which the table dispatcher must absorb
+// without its readers waiting. Every run is repeated `--iterations` times;
+// one JSON document on stdout, progress and errors on stderr.
+#include <CxxAVDECC.h>
+
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <cinttypes>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <vector>
+
+namespace {
+
+using AVDECCSwift::steadyNanos;
+using la::avdecc::protocol::ProtocolInterface;
+
+struct Config {
+  uint64_t notifications = 4'000'000;
+  uint32_t iterations = 5;
+  uint32_t rebindMicros = 0;
+  std::vector<uint32_t> threads{1, 4, 16};
+  std::vector<std::string> dispatchers{"locked", "table"};
+};
+
+using OfflineBlock = void (^)(ProtocolInterface*, uint64_t);
+
+/// The pre-SlotTable read path, kept here as the baseline: same slot
+/// type, same markJobSite call, but a shared mutex and a Block_copy /
+/// Block_release pair on every notification.
+class LockedObserver final : public ProtocolInterface::Observer {
+public:
+  void set(OfflineBlock blk) noexcept {
+    std::lock_guard<std::mutex> lock(slotsMutex_);
+    onRemoteEntityOffline_ = blk;
+  }
+
+private:
+  void onRemoteEntityOffline(ProtocolInterface* pi,
+                             la::avdecc::UniqueIdentifier const id) noexcept override {
+    AVDECCSwift::markJobSite(__func__);
+    decltype(onRemoteEntityOffline_) blk;
+    {
+      std::lock_guard<std::mutex> lock(slotsMutex_);
+      blk = onRemoteEntityOffline_;
+    }
+    if (blk) blk(pi, id.getValue());
+  }
+
+  std::mutex slotsMutex_;
+  AVDECCSwift::Block<void, ProtocolInterface*, uint64_t> onRemoteEntityOffline_;
+};
+
+class TableObserver final {
+public:
+  void set(OfflineBlock blk) noexcept {
+    observer_.setSlot(&AVDECCSwift::BlockProtocolInterfaceObserver::Slots::onRemoteEntityOffline_,
+                      blk);
+  }
+  ProtocolInterface::Observer& observer() noexcept { return observer_; }
+
+private:
+  AVDECCSwift::BlockProtocolInterfaceObserver observer_;
+};
+
+struct Iteration {
+  uint64_t notifications = 0;
+  uint64_t delivered = 0;
+  uint64_t rebinds = 0;
+  uint64_t totalNanos = 0;
+};
+
+struct Result {
+  std::string dispatcher;
+  uint32_t threads = 1;
+  std::vector<Iteration> iterations;
+  bool ok = true;
+};
+
+/// Fire `count` notifications from `threads` threads, released together,
+/// while `set` is called every `rebindMicros` from one more thread.
+template <typename Set>
+Iteration fire(ProtocolInterface::Observer& observer, Set&& set, uint64_t count,
+               uint32_t threads, uint32_t rebindMicros) {
+  // Shared by every firing thread, like a Swift closure capturing one
+  // object.
+  std::atomic<uint64_t> delivered{0};
+  auto* const counter = &delivered;
+  OfflineBlock const blk = ^(ProtocolInterface*, uint64_t) {
+    counter->fetch_add(1, std::memory_order_relaxed);
+  };
+  set(blk);
+
+  std::atomic<bool> go{false};
+  std::atomic<bool> firing{true};
+  Iteration row;
+  row.notifications = count;
+
+  std::thread rebinder;
+  if (rebindMicros) {
+    rebinder = std::thread([&] {
+      while (firing.load(std::memory_order_relaxed)) {
+        set(blk);
+        ++row.rebinds;
+        std::this_thread::sleep_for(std::chrono::microseconds(rebindMicros));
+      }
+    });
+  }
+
+  std::vector<std::thread> firers;
+  for (uint32_t t = 0; t < threads; ++t) {
+    auto const share = count / threads + (t < count % threads ? 1 : 0);
+    firers.emplace_back([&observer, &go, share, t] {
+      la::avdecc::UniqueIdentifier const id{0x001b92fffe000000ull + t};
+      while (!go.load(std::memory_order_acquire)) std::this_thread::yield();
+      for (uint64_t i = 0; i < share; ++i) observer.onRemoteEntityOffline(nullptr, id);
+    });
+  }
+  auto const start = steadyNanos();
+  go.store(true, std::memory_order_release);
+  for (auto& t : firers) t.join();
+  row.totalNanos = steadyNanos() - start;
+  firing.store(false, std::memory_order_relaxed);
+  if (rebinder.joinable()) rebinder.join();
+
+  set(nullptr);
+  row.delivered = delivered.load();
+  return row;
+}
+
+/// `result.dispatcher` is "locked" or "table".
+bool run(Config const& config, Result& result) {
+  for (uint32_t it = 0; it < config.iterations; ++it) {
+    Iteration row;
+    if (result.dispatcher == "locked") {
+      LockedObserver observer;
+      row = fire(observer, [&observer](OfflineBlock blk) { observer.set(blk); },
+                 config.notifications, result.threads, config.rebindMicros);
+    } else {
+      TableObserver table;
+      row = fire(table.observer(), [&table](OfflineBlock blk) { table.set(blk); },
+                 config.notifications, result.threads, config.rebindMicros);
+    }
+    if (row.delivered != row.notifications) result.ok = false;
+    result.iterations.push_back(row);
+  }
+  return result.ok;
+}
+
+void printResult(Result const& result, bool last) {
+  std::printf("    {\n      \"dispatcher\": \"%s\",\n      \"threads\": %" PRIu32
+              ",\n      \"ok\": %s,\n      \"iterations\": [",
+              result.dispatcher.c_str(), result.threads, result.ok ? "true" : "false");
+  for (size_t i = 0; i < result.iterations.size(); ++i) {
+    auto const& row = result.iterations[i];
+    auto const rate = row.totalNanos
+        ? static_cast<double>(row.delivered) * 1e9 / static_cast<double>(row.totalNanos)
+        : 0.0;
+    std::printf("%s\n        {\"notifications\": %" PRIu64 ", \"delivered\": %" PRIu64
+                ", \"rebinds\": %" PRIu64 ", \"totalNanos\": %" PRIu64
+                ", \"notificationsPerSecond\": %.1f}",
+                i ? "," : "", row.notifications, row.delivered, row.rebinds,
+                row.totalNanos, rate);
+  }
+  std::printf("\n      ]\n    }%s\n", last ? "" : ",");
+}
+
+template <typename T, typename Convert>
+std::vector<T> splitList(char const* arg, Convert convert) {
+  std::vector<T> out;
+  std::string current;
+  for (auto const* p = arg;; ++p) {
+    if (*p == ',' || !*p) {
+      if (!current.empty()) out.push_back(convert(current));
+      current.clear();
+      if (!*p) break;
+    } else {
+      current += *p;
+    }
+  }
+  return out;
+}
+
+void usage(char const* argv0) {
+  std::fprintf(stderr,
+               "Usage: %s [--notifications N] [--iterations N]"
+               " [--rebind-micros N]\n"
+               "          [--threads 1,4,16] [--dispatchers locked,table]\n",
+               argv0);
+}
+
+bool parseArguments(int argc, char** argv, Config& config) {
+  for (int i = 1; i < argc; ++i) {
+    auto const* arg = argv[i];
+    if (i + 1 >= argc) return false;
+    auto const* value = argv[++i];
+    auto const number = std::strtoull(value, nullptr, 10);
+    if (!std::strcmp(arg, "--notifications")) {
+      config.notifications = number;
+    } else if (!std::strcmp(arg, "--iterations")) {
+      config.iterations = static_cast<uint32_t>(number);
+    } else if (!std::strcmp(arg, "--rebind-micros")) {
+      config.rebindMicros = static_cast<uint32_t>(number);
+    } else if (!std::strcmp(arg, "--threads")) {
+      config.threads = splitList<uint32_t>(value, [](std::string const& s) {
+        auto const n = std::strtoull(s.c_str(), nullptr, 10);
+        return static_cast<uint32_t>(std::max<unsigned long long>(n, 1));
+      });
+    } else if (!std::strcmp(arg, "--dispatchers")) {
+      config.dispatchers = splitList<std::string>(value, [](std::string const& s) { return s; });
+    } else {
+      return false;
+    }
+  }
+  return true;
+}
+
+} // namespace
+
+int main(int argc, char** argv) {
+  Config config;
+  if (!parseArguments(argc, argv, config)) {
+    usage(argv[0]);
+    return 1;
+  }
+
+  std::vector<Result> results;
+  for (auto const& dispatcher : config.dispatchers) {
+    for (auto const threads : config.threads) {
+      Result result;
+      result.dispatcher = dispatcher;
+      result.threads = threads;
+      if (dispatcher != "locked" && dispatcher != "table") {
+        std::fprintf(stderr, "unknown dispatcher '%s'\n", dispatcher.c_str());
+        usage(argv[0]);
+        return 1;
+      }
+      std::fprintf(stderr, "%s / %" PRIu32 " threads\n", dispatcher.c_str(), threads);
+      run(config, result);
+      results.push_back(std::move(result));
+    }
+  }
+
+  std::printf("{\n  \"benchmark\": \"notification\",\n  \"avdeccVersion\": \"%s\",\n"
+              "  \"hardwareConcurrency\": %u,\n"
+              "  \"config\": {\"notifications\": %" PRIu64 ", \"iterations\": %" PRIu32
+              ", \"rebindMicros\": %" PRIu32 "},\n  \"results\": [\n",
+              la::avdecc::getVersion().c_str(), std::thread::hardware_concurrency(),
+              config.notifications, config.iterations, config.rebindMicros);
+  for (size_t i = 0; i < results.size(); ++i) {
+    printResult(results[i], i + 1 == results.size());
+  }
+  std::printf("  ]\n}\n");
+
+  auto const failed = std::any_of(results.begin(), results.end(),
+                                  [](Result const& r) { return !r.ok; });
+  return failed ? 2 : 0;
+}
@@ -0,0 +1,192 @@
+/*
+ * Copyright (C) 2026, PADL Software Pty Ltd
+ *
+ * This file is part of AVDECCSwift.
+ *
+ * AVDECCSwift is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * AVDECCSwift is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with AVDECCSwift.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+// Cold-start benchmark: how long a short-lived tool takes from process
+// launch to the first ADP it receives. The parent re-executes this binary
+// `--runs` times per mode and times each child from spawn to exit:
+//
+//   noop  exits straight from main — dynamic loading, static initialisers
+//         and the Swift runtime; the floor for any tool linking AVDECCSwift
+//   adp   opens two virtual ProtocolInterfaces on a private bus, advertises
+//         a LocalEntity on one and exits when the other reports it online
+//
+// `adp` children also report, from main, when the executor was brought up
+// and when the ADP arrived. Needs no network interface or privileges:
+//
+//     swift run -c release avdecc-startup-benchmark --runs 50 > startup.json
+import AVDECCSwift
+import Dispatch
+import Foundation
+
+private final class FirstAdp: ProtocolInterfaceObserver, @unchecked Sendable {
+  let seen = DispatchSemaphore(value: 0)
+
+  func onRemoteEntityOnline(_: ProtocolInterface, entity _: Entity) {
+    seen.signal()
+  }
+}
+
+private func nanoseconds(_ duration: Duration) -> Int64 {
+  let (seconds, attoseconds) = duration.components
+  return seconds * 1_000_000_000 + attoseconds / 1_000_000_000
+}
+
+/// Child side of `adp`. Prints `<bringUpNanos> <firstAdpNanos>`, both
+/// measured from main.
+private func runAdpChild() -> Int32 {
+  let clock = ContinuousClock()
+  let start = clock.now
+  do {
+    let bus = "avdecc-startup-\(ProcessInfo.processInfo.processIdentifier)"
+    let listener = try ProtocolInterface(type: .virtual, interfaceID: bus)
+    let bringUp = clock.now - start
+    let talker = try ProtocolInterface(type: .virtual, interfaceID: bus)
+    let observer = FirstAdp()
+    listener.observer = observer
+
+    let entity = try LocalEntity(
+      protocolInterface: talker, entityID: UniqueIdentifier(0x001B_92FF_FE00_0001)
+    )
+    entity.enableEntityAdvertising()
+    guard observer.seen.wait(timeout: .now() + .seconds(5)) == .success else {
+      FileHandle.standardError.write("no ADP within 5 s\n".data(using: .utf8)!)
+      return 3
+    }
+    let firstAdp = clock.now - start
+    print(nanoseconds(bringUp), nanoseconds(firstAdp))
+
+    entity.close()
+    talker.close()
+    listener.close()
+    return 0
+  } catch {
+    FileHandle.standardError.write("\(error)\n".data(using: .utf8)!)
+    return 2
+  }
+}
+
+private struct Samples {
+  var values: [Int64] = []
+
+  func json() -> String {
+    guard !values.isEmpty else { return "null" }
+    let sorted = values.sorted()
+    func percentile(_ p: Double) -> Int64 {
+      sorted[min(Int(p * Double(sorted.count - 1) + 0.5), sorted.count - 1)]
+    }
+    let mean = Double(sorted.reduce(0, +)) / Double(sorted.count)
+    return "{\"mean\": \(String(format: "%.1f", mean)), \"p50\": \(percentile(0.5))"
+      + ", \"p90\": \(percentile(0.9)), \"p99\": \(percentile(0.99))"
+      + ", \"max\": \(sorted.last!)}"
+  }
+}
+
+private struct ModeResult {
+  var launchToExit = Samples()
+  var bringUp = Samples()
+  var firstAdp = Samples()
+  var failures = 0
+}
+
+private func runParent(runs: Int, modes: [String]) -> Int32 {
+  let executable = URL(fileURLWithPath: CommandLine.arguments[0])
+  let clock = ContinuousClock()
+  var results: [(String, ModeResult)] = []
+
+  for mode in modes {
+    FileHandle.standardError.write("\(mode)\n".data(using: .utf8)!)
+    var result = ModeResult()
+    for _ in 0..<runs {
+      let process = Process()
+      process.executableURL = executable
+      process.arguments = ["--child", mode]
+      let output = Pipe()
+      process.standardOutput = output
+      let start = clock.now
+      do {
+        try process.run()
+      } catch {
+        result.failures += 1
+        continue
+      }
+      process.waitUntilExit()
+      let elapsed = clock.now - start
+      guard process.terminationStatus == 0 else {
+        result.failures += 1
+        continue
+      }
+      result.launchToExit.values.append(nanoseconds(elapsed))
+      let text = String(
+        decoding: output.fileHandleForReading.readDataToEndOfFile(), as: UTF8.self
+      )
+      let fields = text.split(whereSeparator: \.isWhitespace).compactMap { Int64($0) }
+      if fields.count == 2 {
+        result.bringUp.values.append(fields[0])
+        result.firstAdp.values.append(fields[1])
+      }
+    }
+    results.append((mode, result))
+  }
+
+  print("{\n  \"benchmark\": \"startup\",\n  \"runs\": \(runs),\n  \"results\": [")
+  for (index, (mode, result)) in results.enumerated() {
+    print("""
+        {
+          "mode": "\(mode)",
+          "failures": \(result.failures),
+          "launchToExitNanos": \(result.launchToExit.json()),
+          "mainToBringUpNanos": \(result.bringUp.json()),
+          "mainToFirstAdpNanos": \(result.firstAdp.json())
+        }\(index + 1 == results.count ? "" : ",")
+    """)
+  }
+  print("  ]\n}")
+  return results.contains { $0.1.failures > 0 } ? 2 : 0
+}
+
+private func usage() -> Never {
+  FileHandle.standardError.write(
+    "Usage: \(CommandLine.arguments[0]) [--runs N] [--modes noop,adp]\n"
+      .data(using: .utf8)!
+  )
+  exit(1)
+}
+
+var arguments = CommandLine.arguments.dropFirst()
+var runs = 20
+var modes = ["noop", "adp"]
+while let flag = arguments.popFirst() {
+  guard let value = arguments.popFirst() else { usage() }
+  switch flag {
+  case "--child":
+    switch value {
+    case "noop": exit(0)
+    case "adp": exit(runAdpChild())
+    default: usage()
+    }
+  case "--runs":
+    guard let n = Int(value), n > 0 else { usage() }
+    runs = n
+  case "--modes":
+    modes = value.split(separator: ",").map(String.init)
+  default:
+    usage()
+  }
+}
+exit(runParent(runs: runs, modes: modes))
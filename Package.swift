@@ -68,6 +68,22 @@ let package = Package(
       name: "avdecc-discovery",
       targets: ["Discovery"]
     ),
+    .executable(
+      name: "avdecc-executor-benchmark",
+      targets: ["ExecutorBenchmark"]
+    ),
+    .executable(
+      name: "avdecc-notification-benchmark",
+      targets: ["NotificationBenchmark"]
+    ),
+    .executable(
+      name: "avdecc-startup-benchmark",
+      targets: ["StartupBenchmark"]
+    ),
+    .executable(
+      name: "avdecc-flightrecorder-decode",
+      targets: ["FlightRecorderDecode"]
+    ),
   ],
   dependencies: [
     // Dependencies declare other packages that this package depends on.
@@ -152,10 +168,68 @@ let package = Package(
         .unsafeFlags(["-Xcc", "-I\(AvdeccIncludePath)", "-Xcc", "-fblocks"]),
       ]
     ),
+    // Plain C++ executable: it drives ExecutorOwner and la_avdecc's stock
+    // executor through ExecutorManager directly, which Swift cannot reach.
+    .executableTarget(
+      name: "ExecutorBenchmark",
+      dependencies: [
+        "CxxAVDECC",
+      ],
+      path: "Benchmarks/ExecutorBenchmark",
+      cxxSettings: [
+        .unsafeFlags(["-I\(AvdeccIncludePath)", "-fblocks"]),
+      ],
+      linkerSettings: [
+        // A C++-only target doesn't pick up libdispatch via the Swift
+        // runtime the way the Swift targets do.
+        .linkedLibrary("dispatch", .when(platforms: [.linux])),
+      ]
+    ),
+    // C++ like ExecutorBenchmark: fires observer virtuals directly.
+    .executableTarget(
+      name: "NotificationBenchmark",
+      dependencies: [
+        "CxxAVDECC",
+      ],
+      path: "Benchmarks/NotificationBenchmark",
+      cxxSettings: [
+        .unsafeFlags(["-I\(AvdeccIncludePath)", "-fblocks"]),
+      ],
+      linkerSettings: [
+        .linkedLibrary("dispatch", .when(platforms: [.linux])),
+      ]
+    ),
+    .executableTarget(
+      name: "StartupBenchmark",
+      dependencies: [
+        "AVDECCSwift",
+      ],
+      path: "Benchmarks/StartupBenchmark",
+      cxxSettings: [
+        .unsafeFlags(["-I\(AvdeccIncludePath)"]),
+      ],
+      swiftSettings: [
+        .interoperabilityMode(.Cxx),
+        .unsafeFlags(["-Xcc", "-I\(AvdeccIncludePath)", "-Xcc", "-fblocks"]),
+      ]
+    ),
+    // Reads the files written by Logger.startFlightRecorder; only needs
+    // the format header, but takes it from CxxAVDECC like the benchmark.
+    .executableTarget(
+      name: "FlightRecorderDecode",
+      dependencies: [
+        "CxxAVDECC",
+      ],
+      path: "Tools/FlightRecorderDecode",
+      cxxSettings: [
+        .unsafeFlags(["-I\(AvdeccIncludePath)", "-fblocks"]),
+      ]
+    ),
     .testTarget(
       name: "AVDECCSwiftTests",
       dependencies: [
         .target(name: "AVDECCSwift"),
+        .product(name: "Logging", package: "swift-log"),
       ],
       cxxSettings: [
         .unsafeFlags(["-I\(AvdeccIncludePath)"]),
@@ -0,0 +1,339 @@
+/*
+ * Copyright (C) 2026, PADL Software Pty Ltd
+ *
+ * This file is part of AVDECCSwift.
+ *
+ * AVDECCSwift is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * AVDECCSwift is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with AVDECCSwift.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+internal import CxxAVDECC
+import Synchronization
+
+/// What an event stream does with an event that finds its buffer full.
+public enum CallbackEventOverflow: UInt8, Sendable {
+  /// Discard the oldest buffered event.
+  case dropOldest = 0
+  /// Discard the new event.
+  case dropNewest = 1
+  /// Replace the newest buffered event from the same handler, entity and
+  /// leading `.integer` and `.bool` arguments (e.g. the same stream's
+  /// counters); discard the oldest if there is none. Other leading
+  /// arguments, such as stream info or mappings, are not compared.
+  case coalesce = 2
+}
+
+/// One observer or delegate callback, copied out of la_avdecc's thread
+/// into an event stream. Unlike the wrappers handed to observers, it owns
+/// everything it holds.
+public struct CallbackEvent: Sendable {
+  /// An `Entity` argument, as it was when the event was raised.
+  public struct EntityInfo: Sendable, Equatable {
+    public let entityID: UniqueIdentifier
+    public let entityModelID: UniqueIdentifier
+    public let entityCapabilities: EntityCapabilities
+    public let talkerStreamSources: UInt16
+    public let talkerCapabilities: TalkerCapabilities
+    public let listenerStreamSinks: UInt16
+    public let listenerCapabilities: ListenerCapabilities
+    public let controllerCapabilities: ControllerCapabilities
+    public let associationID: UniqueIdentifier?
+  }
+
+  /// An `Aecpdu` or `AemAecpdu` argument's header fields.
+  public struct AecpInfo: Sendable, Equatable {
+    public let targetEntityID: UniqueIdentifier
+    public let controllerEntityID: UniqueIdentifier
+    public let sequenceID: UInt16
+    public let messageType: UInt8
+    public let status: UInt8
+    /// Set for AEM PDUs.
+    public let commandType: UInt16?
+  }
+
+  /// An `Acmpdu` argument's fields.
+  public struct AcmpInfo: Sendable, Equatable {
+    public let messageType: UInt8
+    public let status: UInt8
+    public let sequenceID: UInt16
+    public let controllerEntityID: UniqueIdentifier
+    public let talkerEntityID: UniqueIdentifier
+    public let talkerUniqueID: UInt16
+    public let listenerEntityID: UniqueIdentifier
+    public let listenerUniqueID: UInt16
+    public let connectionCount: UInt16
+    public let flags: UInt16
+    public let streamVlanID: UInt16
+  }
+
+  /// A callback argument, in the shape the handler's C++ block receives
+  /// it (the `ProtocolInterface` argument of observer callbacks is left
+  /// out).
+  public enum Argument: Sendable, Equatable {
+    /// Entity IDs, descriptor types and indices, formats, statuses, ...
+    case integer(UInt64)
+    case bool(Bool)
+    case string(String)
+    case counters([UInt32])
+    /// As many mappings as fit in an event; the full count follows as an
+    /// `.integer`.
+    case mappings([AudioMapping])
+    case entity(EntityInfo)
+    case aecp(AecpInfo)
+    case acmp(AcmpInfo)
+    /// Some other plain value, byte for byte (possibly truncated).
+    case bytes([UInt8])
+    case null
+    /// A value an event cannot hold (e.g. AVB info, gPTP path).
+    case omitted
+
+    public var integer: UInt64? {
+      if case let .integer(value) = self { return value }
+      return nil
+    }
+  }
+
+  /// The handler, e.g. `"onEntityOnline"`.
+  public let name: String
+  /// The entity the event concerns (the listener, for ACMP); zero for
+  /// transport errors.
+  public let entityID: UniqueIdentifier
+  /// Steady-clock nanoseconds when la_avdecc raised it.
+  public let timestampNanos: UInt64
+  public let arguments: [Argument]
+}
+
+/// Observer or delegate callbacks as an `AsyncSequence`, from
+/// `ProtocolInterface.events(bufferDepth:overflow:)` or
+/// `LocalEntity.events(bufferDepth:overflow:)`.
+///
+/// la_avdecc's thread copies each event into a preallocated C++ ring of
+/// `bufferDepth` events and returns; it never waits for, or allocates on
+/// behalf of, the consumer. When the consumer falls behind, the ring's
+/// `overflow` policy decides what is lost, counted in `dropped` and
+/// `coalesced`. Iteration takes events in chunks, suspending only when
+/// the ring is empty.
+///
+/// Single consumer: iterate once. The sequence ends when the interface
+/// or entity is closed, or the iterating task is cancelled; either
+/// detaches the ring, as does releasing the sequence.
+public final class CallbackEvents: AsyncSequence, @unchecked Sendable {
+  public typealias Element = CallbackEvent
+
+  let stream: AVDECCSwift.CallbackEventStreamOwner
+  private let waiter: Waiter
+  private let detach: Mutex<(() -> ())?>
+
+  /// `attach` and `detach` bind the ring to its owner. Throws
+  /// `ProtocolInterfaceError` if the ring cannot be allocated.
+  init(
+    bufferDepth: Int,
+    overflow: CallbackEventOverflow,
+    attach: (AVDECCSwift.CallbackEventStreamOwner) -> (),
+    detach: @escaping (AVDECCSwift.CallbackEventStreamOwner) -> ()
+  ) throws {
+    let waiter = Waiter()
+    var captured = AVDECCSwift.CapturedException()
+    let stream = AVDECCSwift.CallbackEventStreamOwner.create(
+      UInt32(clamping: max(bufferDepth, 1)), overflow.rawValue, { waiter.resume() }, &captured
+    )
+    guard let stream else { throw ProtocolInterfaceError(captured) }
+    self.stream = stream
+    self.waiter = waiter
+    self.detach = Mutex<(() -> ())?>({ detach(stream) })
+    attach(stream)
+  }
+
+  deinit {
+    finish()
+  }
+
+  /// Events buffered since the stream was opened, including any later
+  /// dropped.
+  public var recorded: UInt64 { stream.recorded() }
+  /// Events lost to the overflow policy.
+  public var dropped: UInt64 { stream.dropped() }
+  /// Events merged into a buffered one under `.coalesce`.
+  public var coalesced: UInt64 { stream.coalesced() }
+  public var bufferDepth: Int { stream.depth() }
+
+  /// Stop recording. Buffered events are still delivered.
+  public func finish() {
+    if let detach = detach.withLock({ d in defer { d = nil }; return d }) { detach() }
+  }
+
+  public func makeAsyncIterator() -> AsyncIterator {
+    AsyncIterator(self)
+  }
+
+  public struct AsyncIterator: AsyncIteratorProtocol {
+    private let events: CallbackEvents
+    private var chunk = [AVDECCSwift.CallbackEventRecord]()
+    private var index = 0
+    private var count = 0
+    private var names = [UnsafeRawPointer: String]()
+
+    fileprivate init(_ events: CallbackEvents) {
+      self.events = events
+      chunk = .init(repeating: .init(), count: CallbackEvents.chunkSize)
+    }
+
+    public mutating func next() async -> CallbackEvent? {
+      while true {
+        if index < count {
+          let record = chunk[index]
+          index += 1
+          return withUnsafePointer(to: record) { CallbackEvent($0, names: &names) }
+        }
+        // Closed is checked first: nothing is recorded after, so an empty
+        // drain then means the end.
+        let closed = events.stream.closed()
+        count = chunk.withUnsafeMutableBufferPointer { events.stream.drain($0.baseAddress, $0.count) }
+        index = 0
+        if count != 0 { continue }
+        if closed || Task.isCancelled {
+          events.finish()
+          return nil
+        }
+        await events.waiter.wait(arming: events.stream)
+      }
+    }
+  }
+
+  static let chunkSize = 64
+
+  /// The consumer's parked continuation; the ring's ready block resumes
+  /// it.
+  final class Waiter: Sendable {
+    private let continuation = Mutex<CheckedContinuation<(), Never>?>(nil)
+
+    func wait(arming stream: AVDECCSwift.CallbackEventStreamOwner) async {
+      await withTaskCancellationHandler {
+        await withCheckedContinuation { c in
+          continuation.withLock { $0 = c }
+          // Not armed: events arrived (or the ring closed) since the drain.
+          if Task.isCancelled || !stream.arm() { resume() }
+        }
+      } onCancel: {
+        resume()
+      }
+    }
+
+    func resume() {
+      continuation.withLock { c in defer { c = nil }; return c }?.resume()
+    }
+  }
+}
+
+private enum CallbackEventArgKind: UInt8 {
+  // Mirrors AVDECCSwift::CallbackEventArgKind.
+  case none = 0, integer, boolean, string, counters, mappings, entity, aecp, acmp, bytes, null,
+    omitted
+}
+
+extension CallbackEvent {
+  init(
+    _ record: UnsafePointer<AVDECCSwift.CallbackEventRecord>,
+    names: inout [UnsafeRawPointer: String]
+  ) {
+    let r = record.pointee
+    if let site = r.name {
+      let key = UnsafeRawPointer(site)
+      if let cached = names[key] {
+        name = cached
+      } else {
+        name = String(cString: site)
+        names[key] = name
+      }
+    } else {
+      name = ""
+    }
+    entityID = UniqueIdentifier(r.entityID)
+    timestampNanos = r.timestampNanos
+
+    let payload = UnsafeRawPointer(AVDECCSwift.callbackEventPayload(record)!)
+    let kinds = withUnsafeBytes(of: r.kinds) { Array($0) }
+    let words = withUnsafeBytes(of: r.args) { Array($0.bindMemory(to: UInt64.self)) }
+    var arguments = [Argument]()
+    arguments.reserveCapacity(Int(r.argCount))
+    for i in 0..<Int(r.argCount) {
+      let word = words[i]
+      let at = payload + Int(word & 0xFFFF_FFFF)
+      let count = Int(word >> 32)
+      switch CallbackEventArgKind(rawValue: kinds[i]) ?? .omitted {
+      case .none:
+        continue
+      case .integer:
+        arguments.append(.integer(word))
+      case .boolean:
+        arguments.append(.bool(word != 0))
+      case .string:
+        let bytes = UnsafeRawBufferPointer(start: at, count: count)
+        arguments.append(.string(String(decoding: bytes.prefix { $0 != 0 }, as: UTF8.self)))
+      case .counters:
+        let counters = UnsafeBufferPointer(start: at.assumingMemoryBound(to: UInt32.self), count: count)
+        arguments.append(.counters(Array(counters)))
+      case .mappings:
+        let maps = UnsafeBufferPointer(
+          start: at.assumingMemoryBound(to: la.avdecc.entity.model.AudioMapping.self), count: count
+        )
+        arguments.append(.mappings(maps.map(AudioMapping.init)))
+      case .entity:
+        let e = at.load(as: AVDECCSwift.CallbackEventEntity.self)
+        arguments.append(.entity(EntityInfo(
+          entityID: UniqueIdentifier(e.entityID),
+          entityModelID: UniqueIdentifier(e.entityModelID),
+          entityCapabilities: EntityCapabilities(rawValue: e.entityCapabilities),
+          talkerStreamSources: e.talkerStreamSources,
+          talkerCapabilities: TalkerCapabilities(rawValue: e.talkerCapabilities),
+          listenerStreamSinks: e.listenerStreamSinks,
+          listenerCapabilities: ListenerCapabilities(rawValue: e.listenerCapabilities),
+          controllerCapabilities: ControllerCapabilities(rawValue: e.controllerCapabilities),
+          associationID: e.hasAssociationID ? UniqueIdentifier(e.associationID) : nil
+        )))
+      case .aecp:
+        let p = at.load(as: AVDECCSwift.CallbackEventAecp.self)
+        arguments.append(.aecp(AecpInfo(
+          targetEntityID: UniqueIdentifier(p.targetEntityID),
+          controllerEntityID: UniqueIdentifier(p.controllerEntityID),
+          sequenceID: p.sequenceID,
+          messageType: p.messageType,
+          status: p.status,
+          commandType: p.commandType == 0xFFFF ? nil : p.commandType
+        )))
+      case .acmp:
+        let p = at.load(as: AVDECCSwift.CallbackEventAcmp.self)
+        arguments.append(.acmp(AcmpInfo(
+          messageType: p.messageType,
+          status: p.status,
+          sequenceID: p.sequenceID,
+          controllerEntityID: UniqueIdentifier(p.controllerEntityID),
+          talkerEntityID: UniqueIdentifier(p.talkerEntityID),
+          talkerUniqueID: p.talkerUniqueID,
+          listenerEntityID: UniqueIdentifier(p.listenerEntityID),
+          listenerUniqueID: p.listenerUniqueID,
+          connectionCount: p.connectionCount,
+          flags: p.flags,
+          streamVlanID: p.streamVlanID
+        )))
+      case .bytes:
+        arguments.append(.bytes(Array(UnsafeRawBufferPointer(start: at, count: count))))
+      case .null:
+        arguments.append(.null)
+      case .omitted:
+        arguments.append(.omitted)
+      }
+    }
+    self.arguments = arguments
+  }
+}
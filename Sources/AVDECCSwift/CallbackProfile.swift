@@ -0,0 +1,94 @@
+/*
+ * Copyright (C) 2026, PADL Software Pty Ltd
+ *
+ * This file is part of AVDECCSwift.
+ *
+ * AVDECCSwift is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * AVDECCSwift is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with AVDECCSwift.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+internal import CxxAVDECC
+
+/// Per-handler invocation counts and time spent in the Swift handler,
+/// recorded in C++ while `isCallbackProfilingEnabled` is set on a
+/// `ProtocolInterface` or `LocalEntity`. Keyed by the observer or
+/// delegate method, e.g. `"onEntityOnline"`; handlers never called are
+/// absent. Diff two snapshots with `since(_:)` to profile an interval.
+public struct CallbackProfile: Sendable, Equatable {
+  public struct Entry: Sendable, Equatable {
+    public let invocations: UInt64
+    public let totalTime: Duration
+    public let maxTime: Duration
+    /// log2 buckets, as `Executor.Statistics.runHistogram`.
+    public let histogram: [UInt64]
+
+    public var meanTime: Duration {
+      invocations == 0 ? .zero : totalTime / Int(clamping: invocations)
+    }
+
+    /// Activity since `earlier`. `maxTime` is not a delta and stays the
+    /// maximum since profiling began.
+    public func since(_ earlier: Entry) -> Entry {
+      Entry(
+        invocations: invocations &- earlier.invocations,
+        totalTime: totalTime - earlier.totalTime,
+        maxTime: maxTime,
+        histogram: zip(histogram, earlier.histogram).map { $0 &- $1 }
+      )
+    }
+  }
+
+  public let entries: [String: Entry]
+
+  /// An empty profile, e.g. as the baseline for `since(_:)`.
+  public init() { entries = [:] }
+
+  fileprivate init(entries: [String: Entry]) { self.entries = entries }
+
+  public subscript(name: String) -> Entry? { entries[name] }
+
+  /// Handlers by total time spent, most expensive first.
+  public var byTotalTime: [(name: String, entry: Entry)] {
+    entries.map { ($0.key, $0.value) }.sorted { $0.entry.totalTime > $1.entry.totalTime }
+  }
+
+  /// Activity since `earlier`, a previous snapshot of the same object;
+  /// handlers not called in between are dropped.
+  public func since(_ earlier: CallbackProfile) -> CallbackProfile {
+    var delta = [String: Entry]()
+    for (name, entry) in entries {
+      let d = earlier.entries[name].map { entry.since($0) } ?? entry
+      if d.invocations != 0 { delta[name] = d }
+    }
+    return CallbackProfile(entries: delta)
+  }
+
+  /// Snapshot through an owner's `copyCallbackProfile`.
+  init(_ copy: (UnsafeMutablePointer<AVDECCSwift.SlotProfileStatistics>?, Int) -> Int) {
+    var stats = [AVDECCSwift.SlotProfileStatistics](
+      repeating: .init(), count: Int(AVDECCSwift.SlotProfileCapacity)
+    )
+    let count = stats.withUnsafeMutableBufferPointer { copy($0.baseAddress, $0.count) }
+    var entries = [String: Entry](minimumCapacity: count)
+    for s in stats.prefix(count) {
+      guard let name = s.name else { continue }
+      entries[String(cString: name)] = Entry(
+        invocations: s.invocations,
+        totalTime: .nanoseconds(s.totalNanos),
+        maxTime: .nanoseconds(s.maxNanos),
+        histogram: _histogram(s.histogram)
+      )
+    }
+    self.entries = entries
+  }
+}
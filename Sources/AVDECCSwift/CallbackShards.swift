@@ -0,0 +1,68 @@
+/*
+ * Copyright (C) 2026, PADL Software Pty Ltd
+ *
+ * This file is part of AVDECCSwift.
+ *
+ * AVDECCSwift is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * AVDECCSwift is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with AVDECCSwift.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+internal import CxxAVDECC
+
+/// A set of serial worker queues that observer and delegate callbacks can
+/// be moved onto, off la_avdecc's executor. Backed by
+/// AVDECCSwift::CallbackShardsOwner.
+///
+/// Assign one to `ProtocolInterface.callbackShards` and/or
+/// `LocalEntity.callbackShards`. Each callback is then queued on the
+/// shard chosen by a hash of its entity ID, so:
+///
+/// - callbacks for one entity arrive in the order la_avdecc raised them;
+/// - callbacks for different entities may run concurrently;
+/// - a slow handler no longer delays protocol processing.
+///
+/// Sharing one instance between a `ProtocolInterface` and its
+/// `LocalEntity` keeps an entity's observer and delegate callbacks
+/// ordered with respect to each other. Command completion handlers are
+/// not affected and still run on the executor, so a completion may arrive
+/// before a notification for the same entity that la_avdecc raised
+/// first.
+public final class CallbackShards: @unchecked Sendable {
+  let owner: AVDECCSwift.CallbackShardsOwner
+
+  /// - Parameters:
+  ///   - count: number of worker queues. 0 (the default) uses one per
+  ///     hardware thread.
+  ///   - label: dispatch queue label prefix; queue `i` is `label.i`.
+  /// - Throws: `ProtocolInterfaceError` (`.internalError`) if the queues
+  ///   cannot be created, e.g. for a `count` too large to allocate.
+  public init(
+    count: Int = 0,
+    label: String = "avdecc.callbacks"
+  ) throws {
+    var captured = AVDECCSwift.CapturedException()
+    let owner = AVDECCSwift.CallbackShardsOwner.create(
+      std.string(label), UInt32(clamping: max(count, 0)), &captured
+    )
+    guard let owner else { throw ProtocolInterfaceError(captured) }
+    self.owner = owner
+  }
+
+  public var count: Int { Int(owner.count()) }
+
+  /// Wait until every callback queued so far has been delivered. Returns
+  /// immediately when called from inside a delivered callback.
+  public func flush() {
+    owner.flush()
+  }
+}
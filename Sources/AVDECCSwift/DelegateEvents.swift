@@ -0,0 +1,108 @@
+/*
+ * Copyright (C) 2026, PADL Software Pty Ltd
+ *
+ * This file is part of AVDECCSwift.
+ *
+ * AVDECCSwift is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * AVDECCSwift is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with AVDECCSwift.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+internal import CxxAVDECC
+
+/// How `LocalEntity` hands controller-delegate events to its delegate.
+public enum DelegateDelivery: Sendable, Equatable {
+  /// One delegate call per event, as la_avdecc raises it (on the
+  /// executor, or on `callbackShards` if set).
+  case immediate
+
+  /// Events are recorded in C++ and handed over in batches through
+  /// `LocalEntityDelegate.onDelegateEvents(_:events:)`, whose default
+  /// replays each one into the matching `on…` method. A batch is flushed
+  /// once the executor has run the jobs queued ahead of its first event
+  /// (`interval` nil), or `interval` after its first event, and early
+  /// once it holds `maxEvents`.
+  ///
+  /// Batches arrive one at a time, in order, off the executor when
+  /// `interval` is set. Takes precedence over `callbackShards`.
+  case batched(interval: Duration? = nil, maxEvents: Int = 4096)
+}
+
+/// One batch of recorded delegate events. Only valid inside the
+/// `onDelegateEvents` call it was passed to: neither it nor its events
+/// may be kept.
+public struct DelegateEvents: Sequence {
+  let entity: LocalEntity
+  let batch: UnsafeRawPointer
+
+  public var count: Int { Int(AVDECCSwift.delegateEventCount(batch)) }
+
+  public func makeIterator() -> Iterator {
+    Iterator(events: self, index: 0, count: count)
+  }
+
+  public struct Iterator: IteratorProtocol {
+    let events: DelegateEvents
+    var index: Int
+    let count: Int
+
+    public mutating func next() -> DelegateEvent? {
+      guard index < count else { return nil }
+      defer { index += 1 }
+      return DelegateEvent(events: events, index: index)
+    }
+  }
+}
+
+/// A recorded delegate event. Reading `entityID` is free; `name` and
+/// `deliver()` do the work a direct call would have.
+public struct DelegateEvent {
+  let events: DelegateEvents
+  let index: Int
+
+  private var record: UnsafePointer<AVDECCSwift.DelegateEventRecord> {
+    AVDECCSwift.delegateEventRecord(events.batch, index)
+  }
+
+  /// The entity the event concerns: the listener for sniffed ACMP, 0 for
+  /// `onTransportError`.
+  public var entityID: UniqueIdentifier { UniqueIdentifier(AVDECCSwift.delegateEventEntityID(record)) }
+
+  /// The `LocalEntityDelegate` method it is for, e.g. `"onEntityOnline"`.
+  public var name: String { String(cString: AVDECCSwift.delegateEventName(record)) }
+
+  /// Decode the event and call the delegate method it is for, as direct
+  /// delivery would have. Borrowed values passed on are valid for that
+  /// call only.
+  public func deliver() {
+    events.entity.owner.replayDelegateEvent(events.batch, index)
+  }
+}
+
+/// High-rate delegate events that can be coalesced to their latest value
+/// with `LocalEntity.setCoalescing(_:interval:)`.
+public enum CoalescedDelegateEvent: UInt8, CaseIterable, Sendable {
+  /// `onEntityCountersChanged`, per entity.
+  case entityCounters = 0
+  /// `onAvbInterfaceCountersChanged`, per entity and interface.
+  case avbInterfaceCounters = 1
+  /// `onClockDomainCountersChanged`, per entity and clock domain.
+  case clockDomainCounters = 2
+  /// `onStreamInputCountersChanged`, per entity and stream.
+  case streamInputCounters = 3
+  /// `onStreamOutputCountersChanged`, per entity and stream.
+  case streamOutputCounters = 4
+  /// `onAecpResponseTime`, per entity.
+  case aecpResponseTime = 5
+  /// `onOperationStatus`, per entity, descriptor and operation.
+  case operationStatus = 6
+}
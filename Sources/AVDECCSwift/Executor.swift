@@ -44,21 +44,266 @@ public struct ExecutorError: CapturedError {
 /// drives retain/release. The C++ wrapper exists because Swift 6.3's
 /// importer cannot see la_avdecc's executor types directly.
 public struct Executor {
-  public nonisolated(unsafe) static let shared = try! Executor()
+  /// The default executor, brought up on first use. Prefer
+  /// `bringUp(options:)`, which reports a registration failure as an
+  /// error instead of trapping.
+  public static var shared: Executor {
+    try! bringUp()
+  }
+
+  /// Create and register the process-wide executor called `name` if it is
+  /// not running yet, otherwise return the running one (whose `options`
+  /// are those it was brought up with, not the ones passed here).
+  ///
+  /// Nothing touches la_avdecc's ExecutorManager until this runs.
+  /// `ProtocolInterface` calls it for `DefaultExecutorName` when it is
+  /// first created, so a process that never opens an interface pays for
+  /// no executor. Call it yourself beforehand to choose the default
+  /// executor's options, or to pay the setup cost at a time of your
+  /// choosing.
+  @discardableResult
+  public static func bringUp(
+    name: String = DefaultExecutorName,
+    options: Options = Options()
+  ) throws -> Executor {
+    var captured = AVDECCSwift.CapturedException()
+    let owner = AVDECCSwift.ExecutorOwner.shared(
+      std.string(name), options.cxxOptions, &captured
+    )
+    guard let owner else { throw ExecutorError(captured) }
+    return Executor(name: name, options: Options(owner.options()), owner: owner)
+  }
 
   let library = Library.shared
   public let name: String
 
   let owner: AVDECCSwift.ExecutorOwner
 
-  public init(name: String = DefaultExecutorName) throws {
+  /// How jobs reach the executor's serial queue. Mirrors the C++
+  /// `AVDECCSwift::ExecutorMode` raw values.
+  public enum Mode: UInt8, Sendable {
+    /// One `dispatch_async` per la_avdecc job.
+    case dispatch = 0
+    /// Jobs are pushed onto a lock-free MPSC queue and drained in batches
+    /// by a single block, scheduled only when the queue becomes non-empty.
+    /// Cheaper under bursty load (ADP storms, bulk enumeration).
+    case batched = 1
+    /// One owned thread drains the same queue as `.batched`. Reports a real
+    /// executor thread id to la_avdecc, so wait-style calls made from a job
+    /// run inline, and accepts the affinity / priority options below.
+    case thread = 2
+  }
+
+  /// Priority lane for executor work. Mirrors `AVDECCSwift::ExecutorLane`.
+  /// The queued modes drain `.interactive` ahead of `.bulk` while keeping
+  /// FIFO order within each lane; `.dispatch` mode has one FIFO and only
+  /// splits statistics by lane.
+  public enum Lane: UInt8, Sendable, CaseIterable {
+    /// Default for all work, including everything la_avdecc queues itself.
+    case bulk = 0
+    /// Operator-initiated commands, ACMP connect/disconnect and similar.
+    case interactive = 1
+  }
+
+  /// Construction options. The defaults reproduce `init(name:)`.
+  public struct Options: Sendable, Equatable {
+    public var mode: Mode
+    /// `.batched` only: jobs run per drain pass before yielding the queue
+    /// to other submitted work. 0 drains until empty.
+    public var drainBatchLimit: UInt32
+    /// `.batched` / `.thread`: consecutive `.interactive` jobs that may run
+    /// while `.bulk` work waits before one `.bulk` job is let through.
+    /// 0 gives strict priority.
+    public var interactiveBurstLimit: UInt32
+    /// `.thread` only: CPUs the executor thread may run on (bit i = CPU i);
+    /// 0 inherits. Linux only.
+    public var cpuAffinityMask: UInt64
+    /// `.thread` only: non-zero selects SCHED_FIFO at this priority.
+    public var schedFifoPriority: Int32
+    /// `.thread` only: per-thread nice value. Linux only.
+    public var nice: Int32?
+    /// If set, a watchdog off the executor queue reports any single job
+    /// that runs longer than this — to the `Logger` at `.warn`, to the
+    /// handler from `setStallHandler(_:)`, and in `Statistics.stalls`.
+    /// Millisecond resolution.
+    public var stallThreshold: Duration?
+    /// `.batched` only: share the worker threads of the process-wide pool
+    /// of this name rather than giving this executor a thread of its own.
+    /// The first executor to name a pool sizes it with `targetPoolWidth`
+    /// (0: one queue per hardware thread); at most that many pooled
+    /// executors run at once. Each executor remains serial.
+    public var targetPool: String?
+    public var targetPoolWidth: UInt32
+
+    public init(
+      mode: Mode = .dispatch,
+      drainBatchLimit: UInt32 = 64,
+      interactiveBurstLimit: UInt32 = 16,
+      cpuAffinityMask: UInt64 = 0,
+      schedFifoPriority: Int32 = 0,
+      nice: Int32? = nil,
+      stallThreshold: Duration? = nil,
+      targetPool: String? = nil,
+      targetPoolWidth: UInt32 = 0
+    ) {
+      self.mode = mode
+      self.drainBatchLimit = drainBatchLimit
+      self.interactiveBurstLimit = interactiveBurstLimit
+      self.cpuAffinityMask = cpuAffinityMask
+      self.schedFifoPriority = schedFifoPriority
+      self.nice = nice
+      self.stallThreshold = stallThreshold
+      self.targetPool = targetPool
+      self.targetPoolWidth = targetPoolWidth
+    }
+  }
+
+  public let options: Options
+
+  public init(name: String = DefaultExecutorName, options: Options = Options()) throws {
     var captured = AVDECCSwift.CapturedException()
-    let owner = AVDECCSwift.ExecutorOwner.create(std.string(name), &captured)
+    let owner = AVDECCSwift.ExecutorOwner.create(std.string(name), options.cxxOptions, &captured)
     guard let owner else { throw ExecutorError(captured) }
+    self.init(name: name, options: options, owner: owner)
+  }
+
+  private init(name: String, options: Options, owner: AVDECCSwift.ExecutorOwner) {
     self.name = name
+    self.options = options
     self.owner = owner
   }
 
+  /// Point-in-time view of the executor's instrumentation. Wait time is
+  /// enqueue-to-start, run time is start-to-finish; histograms are log2
+  /// buckets where index `i > 0` counts samples in [2^(i-1), 2^i) ns.
+  public struct Statistics: Sendable, Equatable {
+    /// False if the C++ side was built with
+    /// `AVDECCSWIFT_EXECUTOR_STATISTICS=0`; everything else is then zero.
+    public let isEnabled: Bool
+    public let jobsEnqueued: UInt64
+    public let jobsCompleted: UInt64
+    /// Jobs discarded unrun because the executor was torn down without a
+    /// flush.
+    public let jobsDropped: UInt64
+    public let queueDepth: UInt64
+    public let queueDepthHighWater: UInt64
+    /// Time since the executor was created, as of this snapshot.
+    public let uptime: Duration
+    public let totalWaitTime: Duration
+    public let maxWaitTime: Duration
+    public let waitHistogram: [UInt64]
+    public let totalRunTime: Duration
+    public let maxRunTime: Duration
+    public let runHistogram: [UInt64]
+    /// Jobs reported by the stall watchdog. Whole-executor snapshots only.
+    public let stalls: UInt64
+    /// Job nodes handed out by the executor's pool, and how many of those
+    /// requests had to go to the global allocator. In a soak test the
+    /// latter should stop increasing once the pool reaches peak depth.
+    /// Whole-executor snapshots only.
+    public let jobNodeAcquisitions: UInt64
+    public let jobNodeHeapAllocations: UInt64
+    public let jobNodePoolCapacity: UInt64
+
+    init(_ s: AVDECCSwift.ExecutorStatistics) {
+      isEnabled = s.enabled
+      jobsEnqueued = s.jobsEnqueued
+      jobsCompleted = s.jobsCompleted
+      jobsDropped = s.jobsDropped
+      queueDepth = s.queueDepth
+      queueDepthHighWater = s.queueDepthHighWater
+      uptime = .nanoseconds(s.uptimeNanos)
+      totalWaitTime = .nanoseconds(s.totalWaitNanos)
+      maxWaitTime = .nanoseconds(s.maxWaitNanos)
+      waitHistogram = _histogram(s.waitHistogram)
+      totalRunTime = .nanoseconds(s.totalRunNanos)
+      maxRunTime = .nanoseconds(s.maxRunNanos)
+      runHistogram = _histogram(s.runHistogram)
+      stalls = s.stalls
+      jobNodeAcquisitions = s.jobNodeAcquisitions
+      jobNodeHeapAllocations = s.jobNodeHeapAllocations
+      jobNodePoolCapacity = s.jobNodePoolCapacity
+    }
+
+    /// Completion rate between `earlier` and this snapshot (or since
+    /// creation, if `earlier` is nil). Each poller keeps its own previous
+    /// snapshot, so concurrent pollers do not skew each other's rates.
+    public func jobsPerSecond(since earlier: Statistics? = nil) -> Double {
+      let interval = uptime - (earlier?.uptime ?? .zero)
+      guard interval > .zero else { return 0 }
+      let (seconds, attoseconds) = interval.components
+      let elapsed = Double(seconds) + Double(attoseconds) * 1e-18
+      let completed = jobsCompleted - min(jobsCompleted, earlier?.jobsCompleted ?? 0)
+      return Double(completed) / elapsed
+    }
+  }
+
+  /// Queue count of the pool this executor runs on (see
+  /// `Options.targetPool`); 0 if it has a thread of its own.
+  public var targetPoolWidth: Int {
+    Int(owner.targetPoolWidth())
+  }
+
+  /// Cheap snapshot of queue depth, latency histograms and throughput.
+  /// Safe to poll from any thread, including after `close()`.
+  public func statistics() -> Statistics {
+    Statistics(owner.statistics())
+  }
+
+  /// Per-lane view of the same counters, to check e.g. that `.interactive`
+  /// wait times stay flat under `.bulk` load.
+  public func statistics(lane: Lane) -> Statistics {
+    Statistics(owner.laneStatistics(lane.rawValue))
+  }
+
+  /// Install a handler for stall-watchdog reports (see
+  /// `Options.stallThreshold`), replacing any previous one; nil removes it.
+  /// Called on a background queue, never the executor, with how long the
+  /// job had been running and the delegate slot or command handler it was
+  /// last in, if known.
+  public func setStallHandler(
+    _ handler: (@Sendable (_ running: Duration, _ site: String?) -> Void)?
+  ) {
+    guard let handler else {
+      owner.setOnStall(nil)
+      return
+    }
+    owner.setOnStall { runningNanos, site in
+      handler(.nanoseconds(runningNanos), site.map { String(cString: $0) })
+    }
+  }
+
+  /// Run `body` with `lane` as the calling thread's executor lane: any
+  /// la_avdecc work queued synchronously from inside it (commands issued,
+  /// jobs pushed) lands on that lane. Follow-up work those jobs queue in
+  /// turn goes back to `.bulk`, in FIFO order with everything else.
+  /// `body` is synchronous on purpose — a thread-local tag does not
+  /// survive an `await`.
+  public static func withLane<T>(_ lane: Lane, _ body: () throws -> T) rethrows -> T {
+    let previous = AVDECCSwift.ExecutorOwner.setCurrentLane(lane.rawValue)
+    defer { _ = AVDECCSwift.ExecutorOwner.setCurrentLane(previous) }
+    return try body()
+  }
+
+  /// The lane work queued from the calling thread lands on: the innermost
+  /// `withLane`, `.interactive` for the rest of a job handling a received
+  /// ACMP PDU (see `ProtocolInterface.prioritizesAcmp`), otherwise `.bulk`.
+  public static var currentLane: Lane {
+    Lane(rawValue: AVDECCSwift.ExecutorOwner.currentLane()) ?? .bulk
+  }
+
+  /// Wait until every job queued so far has run. Returns at once when
+  /// called from one of this executor's own jobs. Safe from a job of
+  /// another executor, including one sharing its `targetPool` queue.
+  public func flush() {
+    owner.flush()
+  }
+
+  /// Run `job` on this executor's queue, on `lane`.
+  public func async(lane: Lane = .bulk, _ job: @escaping @Sendable () -> Void) {
+    owner.pushJob(lane.rawValue, job)
+  }
+
   /// Eager teardown of the la_avdecc executor + its ExecutorManager
   /// registration. Idempotent. The C++ ExecutorOwner stays alive (refcount
   /// > 0) until all Swift references release, but the underlying executor
@@ -69,3 +314,47 @@ public struct Executor {
 }
 
 public let DefaultExecutorName = "avdecc::protocol::PI"
+
+extension Executor.Options {
+  init(_ cxx: AVDECCSwift.ExecutorOptions) {
+    self.init(
+      mode: Executor.Mode(rawValue: cxx.mode) ?? .dispatch,
+      drainBatchLimit: cxx.drainBatchLimit,
+      interactiveBurstLimit: cxx.interactiveBurstLimit,
+      cpuAffinityMask: cxx.cpuAffinityMask,
+      schedFifoPriority: cxx.schedFifoPriority,
+      nice: cxx.setNice ? cxx.nice : nil,
+      stallThreshold: cxx.stallThresholdMs == 0
+        ? nil : .milliseconds(Int64(cxx.stallThresholdMs)),
+      targetPool: cxx.targetPool.empty() ? nil : String(cxx.targetPool),
+      targetPoolWidth: cxx.targetPoolWidth
+    )
+  }
+
+  var cxxOptions: AVDECCSwift.ExecutorOptions {
+    var cxx = AVDECCSwift.ExecutorOptions()
+    cxx.mode = mode.rawValue
+    cxx.drainBatchLimit = drainBatchLimit
+    cxx.interactiveBurstLimit = interactiveBurstLimit
+    cxx.cpuAffinityMask = cpuAffinityMask
+    cxx.schedFifoPriority = schedFifoPriority
+    cxx.setNice = nice != nil
+    cxx.nice = nice ?? 0
+    if let stallThreshold {
+      let (seconds, attoseconds) = stallThreshold.components
+      let milliseconds = seconds * 1000 + attoseconds / 1_000_000_000_000_000
+      cxx.stallThresholdMs = UInt32(clamping: max(milliseconds, 1))
+    }
+    if let targetPool {
+      cxx.targetPool = std.string(targetPool)
+      cxx.targetPoolWidth = targetPoolWidth
+    }
+    return cxx
+  }
+}
+
+/// C fixed-size arrays import as homogeneous tuples; flatten one to an
+/// Array without spelling out all of its elements.
+func _histogram<T>(_ tuple: T) -> [UInt64] {
+  withUnsafeBytes(of: tuple) { Array($0.bindMemory(to: UInt64.self)) }
+}
@@ -19,6 +19,9 @@
 
 internal import CxxAVDECC
 
+/// Interface-version check against the linked la_avdecc. Swift statics
+/// are lazy, so this runs once, when the first `Executor` is created or
+/// brought up, not at load time.
 final class Library {
   nonisolated(unsafe) static let shared = Library()
 
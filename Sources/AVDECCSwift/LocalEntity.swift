@@ -446,6 +446,9 @@ public protocol LocalEntityDelegate: AnyObject {
   func onMvuAecpUnsolicitedReceived(
     _: LocalEntity, id: UniqueIdentifier, sequenceID: UInt16
   )
+
+  // Batched delivery (`LocalEntity.delegateDelivery = .batched`).
+  func onDelegateEvents(_: LocalEntity, events: DelegateEvents)
 }
 
 public extension LocalEntityDelegate {
@@ -728,6 +731,14 @@ public extension LocalEntityDelegate {
   func onMvuAecpUnsolicitedReceived(
     _: LocalEntity, id _: UniqueIdentifier, sequenceID _: UInt16
   ) {}
+
+  // Replays every event into its `on…` method. Override to coalesce or
+  // skip events without decoding them; see `DelegateEvent`.
+  func onDelegateEvents(_: LocalEntity, events: DelegateEvents) {
+    for event in events {
+      event.deliver()
+    }
+  }
 }
 
 /// Wraps an la_avdecc AggregateEntity (controller flavour). Backed by
@@ -749,6 +760,93 @@ public final class LocalEntity: @unchecked Sendable {
     didSet { rebindDelegate() }
   }
 
+  /// Where delegate callbacks run. `nil` (the default) calls the delegate
+  /// on la_avdecc's executor; otherwise each callback is queued on the
+  /// shard for its entity ID. Command completions still run on the
+  /// executor and are not ordered against sharded callbacks. See
+  /// `CallbackShards`.
+  public var callbackShards: CallbackShards? {
+    didSet { owner.setCallbackShards(callbackShards?.owner) }
+  }
+
+  /// Filters `onEntityUpdate` as `ProtocolInterface.entityUpdateFilter`
+  /// filters `onRemoteEntityUpdated`.
+  public var entityUpdateFilter: EntityUpdateFields? {
+    didSet { owner.setEntityUpdateFilter(entityUpdateFilter?.rawValue ?? 0) }
+  }
+
+  /// Entity updates forwarded and suppressed by `entityUpdateFilter`.
+  public var entityUpdateStatistics: (forwarded: UInt64, suppressed: UInt64) {
+    (owner.entityUpdatesForwarded(), owner.entityUpdatesSuppressed())
+  }
+
+  /// Count and time every delegate callback by handler; read the result
+  /// with `callbackProfile()`. Off by default, when it costs one relaxed
+  /// load per callback. Batched events are timed as they are replayed,
+  /// coalesced ones as they are flushed. Turning it off keeps the counts
+  /// gathered so far.
+  public var isCallbackProfilingEnabled: Bool {
+    get { owner.callbackProfiling() }
+    set { _ = owner.setCallbackProfiling(newValue) }
+  }
+
+  /// Snapshot of the delegate handlers' invocation counts and latencies.
+  public func callbackProfile() -> CallbackProfile {
+    CallbackProfile { owner.copyCallbackProfile($0, $1) }
+  }
+
+  /// Every delegate event, whether or not `delegate` is set, as an
+  /// `AsyncSequence`; see `ProtocolInterface.events(bufferDepth:overflow:)`.
+  /// Streams see each event as la_avdecc raises it, ahead of
+  /// `delegateDelivery` batching and `setCoalescing(_:interval:)`.
+  public func events(
+    bufferDepth: Int = 256,
+    overflow: CallbackEventOverflow = .dropOldest
+  ) throws -> CallbackEvents {
+    try CallbackEvents(
+      bufferDepth: bufferDepth,
+      overflow: overflow,
+      attach: { owner.attachEventStream($0) },
+      detach: { [owner] in owner.detachEventStream($0) }
+    )
+  }
+
+  /// Whether delegate events arrive one call each or in batches. Events
+  /// recorded under a previous `.batched` setting are delivered before
+  /// this returns. See `DelegateDelivery`.
+  public var delegateDelivery: DelegateDelivery = .immediate {
+    didSet { rebindDelegateDelivery() }
+  }
+
+  /// Events recorded and batches delivered since `delegateDelivery` was
+  /// last set to `.batched`; both 0 while `.immediate`.
+  public var delegateBatchStatistics: (events: UInt64, batches: UInt64) {
+    (owner.delegateBatchEvents(), owner.delegateBatches())
+  }
+
+  /// Deliver only the latest value of `event` per entity (and
+  /// descriptor), each at most once per `interval`; nil delivers every
+  /// event again. The first change after a quiet `interval` is delivered
+  /// at once and the last change of a burst is never lost. Coalesced
+  /// events arrive where the entity's other callbacks do (its
+  /// `callbackShards` shard, else the executor; under `.batched`
+  /// delivery, in a later batch) and in order with them; values still
+  /// pending when the entity goes offline are dropped.
+  public func setCoalescing(_ event: CoalescedDelegateEvent, interval: Duration?) {
+    var intervalNanos: UInt64 = 0
+    if let interval {
+      let (seconds, attoseconds) = interval.components
+      intervalNanos = UInt64(clamping: max(seconds * 1_000_000_000 + attoseconds / 1_000_000_000, 1))
+    }
+    owner.setDelegateCoalescing(event.rawValue, intervalNanos)
+  }
+
+  /// Events taken by coalescing and values delivered for them; the
+  /// difference is how many were coalesced away.
+  public var coalescingStatistics: (events: UInt64, deliveries: UInt64) {
+    (owner.delegateCoalescedEvents(), owner.delegateCoalescedDeliveries())
+  }
+
   public init(protocolInterface: ProtocolInterface, entityID: UniqueIdentifier) throws {
     self.protocolInterface = protocolInterface
     let mac = protocolInterface.macAddressBytes
@@ -3532,6 +3630,26 @@ public final class LocalEntity: @unchecked Sendable {
 
     owner.attachDelegate()
   }
+
+  /// Called from `delegateDelivery.didSet`. The batch block captures
+  /// `self` weakly, like the slot blocks.
+  private func rebindDelegateDelivery() {
+    guard case let .batched(interval, maxEvents) = delegateDelivery else {
+      owner.disableDelegateBatching()
+      return
+    }
+    var intervalNanos: UInt64 = 0
+    if let interval {
+      let (seconds, attoseconds) = interval.components
+      intervalNanos = UInt64(clamping: max(seconds * 1_000_000_000 + attoseconds / 1_000_000_000, 0))
+    }
+    owner.setDelegateBatching(
+      intervalNanos, UInt32(clamping: max(maxEvents, 1))
+    ) { [weak self] batch in
+      guard let self, let d = delegate, let batch else { return }
+      d.onDelegateEvents(self, events: DelegateEvents(entity: self, batch: batch))
+    }
+  }
 }
 
 /// Copy a borrowed `uint32_t const* counters[32]` callback parameter into
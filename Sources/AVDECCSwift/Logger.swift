@@ -83,73 +83,312 @@ public enum LogLayer: UInt8, Sendable {
   }
 }
 
+/// Error thrown by `Logger.startFlightRecorder(path:capacity:level:)`:
+/// `.internalError` with the errno text in `message` if the file cannot
+/// be created or mapped, `.invalidParameters` if a recorder is already
+/// running. Same shape as the other AVDECCSwift errors; see
+/// `CapturedError`.
+public struct LoggerError: CapturedError {
+  public let code: ProtocolInterfaceErrorCode
+  public let message: String
+
+  init(_ captured: AVDECCSwift.CapturedException) {
+    code = ProtocolInterfaceErrorCode(rawValue: captured.protocolInterfaceErrorCode)
+      ?? .internalError
+    message = String(captured.message)
+  }
+
+  init(code: ProtocolInterfaceErrorCode, message: String) {
+    self.code = code
+    self.message = message
+  }
+}
+
 /// Forwards la_avdecc's log events to swift-log. Construct one and hold
 /// a reference for as long as you want logs forwarded; deinit (or an
 /// explicit `close()`) detaches the observer from la_avdecc's singleton.
 ///
 /// Thread-safety: la_avdecc fires log events from arbitrary internal
-/// threads (executor, state machine, watch dog). The forwarding closure
-/// runs on whichever thread emitted the event; swift-log's `Logger` is
-/// thread-safe, so no extra synchronisation is required on our side.
+/// threads (executor, state machine, watch dog). With `.direct` capture
+/// the forwarding closure runs on whichever thread emitted the event;
+/// with `.ring` it runs on the logger's own drainer thread, and the
+/// emitting thread only copies the message into a preallocated ring.
+/// swift-log's `Logger` is thread-safe either way.
 ///
-/// Filtering: the `level` setting is la_avdecc's *global* emit filter —
-/// messages below it are dropped before our observer is invoked, saving
-/// the `getMessage()` allocation. Per-instance filtering still happens
-/// in the forwarder via the captured `Logger.logLevel`. Setting `level`
-/// affects every other observer too, so prefer the most permissive
-/// across all consumers and let swift-log handle finer-grained filters.
+/// Filtering: `level` applies to every layer, and `setLevel(_:for:)`
+/// overrides it for one. Both are checked before la_avdecc formats the
+/// message, so tracing one subsystem costs nothing in the others.
+/// la_avdecc's *global* emit filter is set to the most permissive of
+/// them, which affects every other observer too. Per-instance filtering
+/// still happens in the forwarder via the captured `Logger.logLevel`.
 public final class Logger: Sendable {
+  /// Where forwarding runs.
+  public enum Capture: Sendable, Equatable {
+    /// Forward each item synchronously on the thread that emitted it.
+    case direct
+    /// Copy each item into a lock-free ring of `capacity` records
+    /// (rounded up to a power of two) and forward from a dedicated
+    /// thread in batches. Messages longer than 240 bytes are truncated;
+    /// items arriving while the ring is full are counted in
+    /// `droppedItems` instead of blocking the emitter. If the ring or
+    /// its thread cannot be created the Logger falls back to `.direct`.
+    case ring(capacity: Int = 4096)
+  }
+
   nonisolated(unsafe) let owner: AVDECCSwift.LoggerOwner
 
   /// The destination swift-log Logger. Reassign to redirect output;
   /// the new value takes effect on the next la_avdecc log event.
   public let logger: Logging.Logger
 
-  /// Most-permissive level la_avdecc will emit. Backed by the C++ Logger
-  /// singleton (no Swift-side storage), so reading and writing are both
-  /// thread-safe and the property is `Sendable`-compatible. Setting this
-  /// affects the global la_avdecc Logger, so it influences other observers
-  /// if any exist — prefer the most permissive across consumers.
+  /// `logger` with `avdecc.layer` preset, one per `LogLayer`, so the
+  /// forwarding path doesn't copy and mutate metadata per item.
+  private let layerLoggers: [Logging.Logger]
+
+  /// The capture in use: what was asked for, or `.direct` if `.ring`
+  /// could not be set up.
+  public let capture: Capture
+
+  /// Level forwarded for layers without their own `setLevel(_:for:)`.
+  /// Stored in the C++ owner (no Swift-side storage), so reading and
+  /// writing are both thread-safe and the property is
+  /// `Sendable`-compatible. Lowering it also lowers the global la_avdecc
+  /// level, so it influences other observers if any exist.
   public var level: LogLevel {
     get { LogLevel(rawValue: owner.getLevel()) ?? .info }
     set { owner.setLevel(newValue.rawValue) }
   }
 
+  /// Override `level` for one layer, e.g. `.trace` for
+  /// `.controllerStateMachine` while everything else stays at `.info`.
+  /// `nil` makes the layer follow `level` again.
+  public func setLevel(_ level: LogLevel?, for layer: LogLayer) {
+    owner.setLayerLevel(
+      layer.rawValue,
+      level?.rawValue ?? AVDECCSwift.LayerLevelInherit
+    )
+  }
+
+  /// The level in effect for `layer`: its override, or `level`.
+  public func level(for layer: LogLayer) -> LogLevel {
+    LogLevel(rawValue: owner.getLayerLevel(layer.rawValue)) ?? .info
+  }
+
+  /// Item counts by level and layer since the Logger was created,
+  /// including items that were filtered out or never forwarded. Diff two
+  /// snapshots with `since(_:)` to get a rate.
+  public struct Counts: Sendable, Equatable {
+    private static let columns = Int(AVDECCSwift.LogLayerCount) + 1
+    fileprivate var values: [UInt64]
+
+    fileprivate init(values: [UInt64]) { self.values = values }
+
+    /// Items at `level` on `layer`; nil `layer` means la_avdecc's user
+    /// layers beyond the built-in ones.
+    public subscript(level: LogLevel, layer: LogLayer?) -> UInt64 {
+      guard level.rawValue < AVDECCSwift.LogLevelCount else { return 0 }
+      let column = layer.map { Int($0.rawValue) } ?? Self.columns - 1
+      return values[Int(level.rawValue) * Self.columns + column]
+    }
+
+    /// Items at `level`, on any layer.
+    public subscript(level: LogLevel) -> UInt64 {
+      guard level.rawValue < AVDECCSwift.LogLevelCount else { return 0 }
+      let start = Int(level.rawValue) * Self.columns
+      return values[start..<start + Self.columns].reduce(0, +)
+    }
+
+    /// Items on `layer`, at any level.
+    public subscript(layer layer: LogLayer) -> UInt64 {
+      stride(from: Int(layer.rawValue), to: values.count, by: Self.columns)
+        .reduce(0) { $0 + values[$1] }
+    }
+
+    public var total: UInt64 { values.reduce(0, +) }
+
+    /// Counts accumulated since `earlier`, a previous snapshot of the
+    /// same Logger.
+    public func since(_ earlier: Counts) -> Counts {
+      Counts(values: zip(values, earlier.values).map { $0 &- $1 })
+    }
+  }
+
+  /// Snapshot of the per-level, per-layer item counts. Counting is one
+  /// relaxed atomic increment per item, done before any filtering, and
+  /// needs no forwarding at all.
+  public func counts() -> Counts {
+    var values = [UInt64](repeating: 0, count: AVDECCSwift.LogCountsSize)
+    values.withUnsafeMutableBufferPointer {
+      owner.copyLogCounts($0.baseAddress, $0.count)
+    }
+    return Counts(values: values)
+  }
+
+  /// Lowest level counted even when nothing forwards or records it: la_avdecc
+  /// is asked to emit down to here, and such items are dropped right
+  /// after counting, before their message is formatted. nil counts only
+  /// what is emitted for other reasons.
+  public var countingLevel: LogLevel? {
+    get {
+      let raw = owner.getCountingLevel()
+      return raw == AVDECCSwift.LayerLevelInherit ? nil : LogLevel(rawValue: raw)
+    }
+    set { owner.setCountingLevel(newValue?.rawValue ?? AVDECCSwift.LayerLevelInherit) }
+  }
+
+  /// Also record every item at `level` or above, in binary, to a
+  /// circular memory-mapped file of `capacity` bytes at `path`, without
+  /// going through swift-log or `level`/`setLevel(_:for:)`. The file
+  /// stays readable after a crash; decode it with
+  /// `avdecc-flightrecorder-decode` or `FlightRecording`. It is truncated
+  /// first, and recording continues until the Logger is closed.
+  public func startFlightRecorder(
+    path: String,
+    capacity: Int = 8 << 20,
+    level: LogLevel = .trace
+  ) throws {
+    var captured = AVDECCSwift.CapturedException()
+    guard owner.startFlightRecorder(
+      std.string(path), UInt64(clamping: capacity), level.rawValue, &captured
+    ) else {
+      throw LoggerError(captured)
+    }
+  }
+
+  /// Items written to the flight recorder so far.
+  public var flightRecorderRecords: UInt64 { owner.flightRecorderRecords() }
+
+  /// Burst suppression, applied in C++ before items reach Swift (and,
+  /// with `.ring` capture, before they take a ring slot).
+  public struct BurstSuppression: Sendable, Equatable {
+    /// Repeats of the same level, layer and message within this window
+    /// are counted rather than forwarded, then reported as one
+    /// "repeated N times" item. Millisecond resolution; nil disables.
+    public var duplicateWindow: Duration?
+    /// Per-layer token bucket: sustained items per second, and how many
+    /// may arrive at once. Items over the limit are counted and reported
+    /// when the layer next gets through. nil disables.
+    public var maxItemsPerSecond: UInt32?
+    public var burst: UInt32
+
+    public init(
+      duplicateWindow: Duration? = .seconds(1),
+      maxItemsPerSecond: UInt32? = nil,
+      burst: UInt32 = 50
+    ) {
+      self.duplicateWindow = duplicateWindow
+      self.maxItemsPerSecond = maxItemsPerSecond
+      self.burst = burst
+    }
+  }
+
+  /// Enable, reconfigure or (with nil) disable burst suppression.
+  public func setBurstSuppression(_ suppression: BurstSuppression?) {
+    var windowMs: UInt32 = 0
+    if let window = suppression?.duplicateWindow {
+      let (seconds, attoseconds) = window.components
+      let milliseconds = seconds * 1000 + attoseconds / 1_000_000_000_000_000
+      windowMs = UInt32(clamping: max(milliseconds, 1))
+    }
+    owner.setBurstSuppression(
+      windowMs,
+      suppression?.maxItemsPerSecond ?? 0,
+      suppression?.burst ?? 0
+    )
+  }
+
+  /// Duplicate summaries are emitted as later items arrive; call this
+  /// periodically to also report bursts that have since gone quiet.
+  public func flushSuppressionSummaries() {
+    owner.flushSuppressionSummaries()
+  }
+
+  /// Items withheld by burst suppression, as duplicates or over a
+  /// layer's rate.
+  public var suppressedDuplicates: UInt64 { owner.suppressedDuplicates() }
+  public var rateLimitedItems: UInt64 { owner.rateLimitedItems() }
+  /// "repeated N times" and "rate limit" summaries emitted in their place.
+  public var suppressionSummaries: UInt64 { owner.suppressionSummaries() }
+
+  /// `.ring` capture: items captured so far, and items lost to a full
+  /// ring. Both zero for `.direct`.
+  public var capturedItems: UInt64 { owner.ringCaptured() }
+  public var droppedItems: UInt64 { owner.ringDropped() }
+
   public init(
     forwardingTo logger: Logging.Logger,
-    level: LogLevel = .info
+    level: LogLevel = .info,
+    capture: Capture = .direct
   ) {
     self.logger = logger
+    layerLoggers = (0..<AVDECCSwift.LogLayerCount).map { raw in
+      var l = logger
+      l[metadataKey: "avdecc.layer"] = .string((LogLayer(rawValue: raw) ?? .generic).name)
+      return l
+    }
     owner = AVDECCSwift.LoggerOwner.create()
     owner.setLevel(level.rawValue)
+    if case let .ring(capacity) = capture,
+       !owner.startRingCapture(UInt32(clamping: max(capacity, 2)))
+    {
+      self.capture = .direct
+    } else {
+      self.capture = capture
+    }
 
-    // The block captures `self` weakly so that an unreleased
+    // The blocks capture `self` weakly so that an unreleased
     // Logger doesn't keep itself alive via the la_avdecc
     // observer registration. Deinit calls owner.close(), which
     // detaches before we're freed.
-    owner.setOnLogItem { [weak self] rawLevel, rawLayer, dataPtr, size in
-      guard let self else { return }
-      let level = LogLevel(rawValue: rawLevel) ?? .info
-      let layer = LogLayer(rawValue: rawLayer) ?? .generic
-      let message: String
-      if let dataPtr, size > 0 {
-        let buf = UnsafeBufferPointer(
-          start: UnsafePointer<UInt8>(OpaquePointer(dataPtr)), count: size
-        )
-        message = String(decoding: buf, as: UTF8.self)
-      } else {
-        message = ""
+    if case .ring = self.capture {
+      owner.setOnLogBatch { [weak self] records, count in
+        guard let self, let records else { return }
+        for i in 0..<count {
+          let record = records + i
+          self.forward(
+            rawLevel: record.pointee.level,
+            rawLayer: record.pointee.layer,
+            data: AVDECCSwift.logRecordText(record),
+            size: Int(record.pointee.size)
+          )
+        }
+      }
+    } else {
+      owner.setOnLogItem { [weak self] rawLevel, rawLayer, dataPtr, size in
+        self?.forward(rawLevel: rawLevel, rawLayer: rawLayer, data: dataPtr, size: size)
       }
-      var l = self.logger
-      l[metadataKey: "avdecc.layer"] = .string(layer.name)
-      l.log(level: level.swiftLogLevel, "\(message)")
     }
 
     owner.registerObserver()
   }
 
+  private func forward(
+    rawLevel: UInt8, rawLayer: UInt8, data: UnsafePointer<CChar>?, size: Int
+  ) {
+    let level = LogLevel(rawValue: rawLevel) ?? .info
+    let message: String
+    if let data, size > 0 {
+      let buf = UnsafeBufferPointer(
+        start: UnsafePointer<UInt8>(OpaquePointer(data)), count: size
+      )
+      message = String(decoding: buf, as: UTF8.self)
+    } else {
+      message = ""
+    }
+    let layer = Int(rawLayer) < layerLoggers.count ? Int(rawLayer) : 0
+    layerLoggers[layer].log(level: level.swiftLogLevel, "\(message)")
+  }
+
+  /// Log `message` through la_avdecc's logger, as if la_avdecc had
+  /// emitted it: every observer sees it, this process's Loggers included,
+  /// subject to the same level filtering, counting and suppression.
+  public static func emit(_ message: String, level: LogLevel, layer: LogLayer = .generic) {
+    AVDECCSwift.emitLogItem(level.rawValue, layer.rawValue, std.string(message))
+  }
+
   /// Eager teardown. Detaches from la_avdecc's Logger singleton and
-  /// drops the forwarding closure. Idempotent.
+  /// drops the forwarding closure. With `.ring` capture, items already
+  /// captured are forwarded first. Idempotent.
   public func close() {
     owner.close()
   }
@@ -158,3 +397,49 @@ public final class Logger: Sendable {
     owner.close()
   }
 }
+
+/// The records of a file written by `Logger.startFlightRecorder`, oldest
+/// first: what `avdecc-flightrecorder-decode` prints, read back in
+/// process. The file may still be in use; records overwritten while it is
+/// read are skipped.
+public struct FlightRecording: Sendable {
+  public struct Record: Sendable, Equatable {
+    /// Steady-clock nanoseconds when the item was logged.
+    public let timestampNanos: UInt64
+    public let level: LogLevel
+    /// nil for layers outside `LogLayer`.
+    public let layer: LogLayer?
+    public let message: String
+  }
+
+  public let records: [Record]
+  /// Bytes passed over while resynchronising after damaged or partly
+  /// overwritten records.
+  public let skippedBytes: UInt64
+
+  /// Decode `image`, the whole file. Throws `LoggerError` with
+  /// `.invalidParameters` if it is not a flight-recorder file of this
+  /// version.
+  public init(image: UnsafeRawBufferPointer) throws {
+    guard let base = image.baseAddress else {
+      throw LoggerError(code: .invalidParameters, message: "file too short")
+    }
+    var reader = AVDECCSwift.FlightRecorderReader()
+    var error = std.string()
+    guard reader.open(base.assumingMemoryBound(to: UInt8.self), image.count, &error) else {
+      throw LoggerError(code: .invalidParameters, message: String(error))
+    }
+    var records = [Record]()
+    var record = AVDECCSwift.FlightRecorderReader.Record()
+    while reader.next(&record) {
+      records.append(Record(
+        timestampNanos: record.timestampNanos,
+        level: LogLevel(rawValue: record.level) ?? .info,
+        layer: LogLayer(rawValue: record.layer),
+        message: String(record.message)
+      ))
+    }
+    self.records = records
+    skippedBytes = reader.skippedBytes()
+  }
+}
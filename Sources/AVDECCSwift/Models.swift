@@ -225,6 +225,37 @@ public struct ControllerCapabilities: OptionSet, Sendable, Hashable {
   public static let implemented = ControllerCapabilities(rawValue: 1 << 0)
 }
 
+/// ADP fields compared by the entity-update filter
+/// (`ProtocolInterface.entityUpdateFilter`, `LocalEntity.entityUpdateFilter`).
+/// Bit values mirror `AVDECCSwift::EntityUpdateField`.
+public struct EntityUpdateFields: OptionSet, Sendable, Hashable {
+  public let rawValue: UInt32
+  public init(rawValue: UInt32) { self.rawValue = rawValue }
+
+  public static let entityModelID = EntityUpdateFields(rawValue: 1 << 0)
+  public static let entityCapabilities = EntityUpdateFields(rawValue: 1 << 1)
+  /// Talker stream sources and capabilities.
+  public static let talker = EntityUpdateFields(rawValue: 1 << 2)
+  /// Listener stream sinks and capabilities.
+  public static let listener = EntityUpdateFields(rawValue: 1 << 3)
+  public static let controllerCapabilities = EntityUpdateFields(rawValue: 1 << 4)
+  public static let identifyControlIndex = EntityUpdateFields(rawValue: 1 << 5)
+  public static let associationID = EntityUpdateFields(rawValue: 1 << 6)
+  /// The set of AVB interfaces and their MAC addresses.
+  public static let interfaces = EntityUpdateFields(rawValue: 1 << 7)
+  /// Per-interface gPTP grandmaster ID and domain number.
+  public static let gptp = EntityUpdateFields(rawValue: 1 << 8)
+  public static let availableIndex = EntityUpdateFields(rawValue: 1 << 9)
+  public static let validTime = EntityUpdateFields(rawValue: 1 << 10)
+
+  /// Everything except `availableIndex` and `validTime`, which change
+  /// with every advertisement.
+  public static let significant: EntityUpdateFields = [
+    .entityModelID, .entityCapabilities, .talker, .listener, .controllerCapabilities,
+    .identifyControlIndex, .associationID, .interfaces, .gptp,
+  ]
+}
+
 /// AvbInfo flags (IEEE 1722.1-2021 §7.4.40.2).
 public struct AvbInfoFlags: OptionSet, Sendable, Hashable {
   public let rawValue: UInt8
@@ -1475,6 +1506,41 @@ public struct OperationResult: Sendable, Hashable, CustomStringConvertible {
 
 // MARK: - PDU wrappers
 
+/// Wrapper around an la_avdecc ADP PDU pointer, as seen by
+/// `ProtocolInterfaceObserver.onAdpduReceived`. Same borrowed-pointer
+/// lifetime contract as `Aecpdu`.
+public struct Adpdu: CustomStringConvertible {
+  let pointer: UnsafeRawPointer
+
+  init(_ pointer: UnsafeRawPointer) {
+    self.pointer = pointer
+  }
+
+  public var entityID: UniqueIdentifier {
+    UniqueIdentifier(AVDECCSwift.adpdu_getEntityID(pointer))
+  }
+
+  public var entityModelID: UniqueIdentifier {
+    UniqueIdentifier(AVDECCSwift.adpdu_getEntityModelID(pointer))
+  }
+
+  public var messageType: AdpMessageType {
+    AdpMessageType(rawValue: AVDECCSwift.adpdu_getMessageType(pointer)) ?? .entityAvailable
+  }
+
+  /// Raw ADP message-type byte (1722.1 §6.2.1.5).
+  public var messageTypeRaw: UInt8 { AVDECCSwift.adpdu_getMessageType(pointer) }
+
+  /// Advertisement lifetime in 2-second units, as on the wire.
+  public var validTime: UInt8 { AVDECCSwift.adpdu_getValidTime(pointer) }
+  public var availableIndex: UInt32 { AVDECCSwift.adpdu_getAvailableIndex(pointer) }
+
+  public var description: String {
+    "Adpdu(entity: \(entityID), msgType: \(messageType)" +
+      ", availableIndex: \(availableIndex), validTime: \(validTime))"
+  }
+}
+
 /// Wrapper around an la_avdecc AECP PDU pointer. Polymorphic in C++
 /// (`Aecpdu` is the base of `AemAecpdu`, `MvuAecpdu`, …), so we hold the
 /// pointer rather than copying. Lifetime is bounded by the observer
@@ -1511,6 +1577,11 @@ public struct Aecpdu: CustomStringConvertible {
   /// Raw AECP status byte. Typed wrapper TBD.
   public var status: UInt8 { AVDECCSwift.aecpdu_getStatus(pointer) }
 
+  /// The AEM view of this PDU, or nil for non-AEM message types.
+  public var aem: AemAecpdu? {
+    messageType <= AecpMessageType.aemResponse.rawValue ? AemAecpdu(pointer) : nil
+  }
+
   public var description: String {
     "Aecpdu(target: \(targetEntityID), controller: \(controllerEntityID)" +
       ", seq: \(sequenceID), msgType: \(messageType), status: \(status))"
@@ -1629,6 +1700,83 @@ public struct Acmpdu: CustomStringConvertible {
   }
 }
 
+/// A raw PDU tap on `ProtocolInterfaceObserver` (`onAdpduReceived`,
+/// `onAecpduReceived`, `onAcmpduReceived`). Raw values mirror
+/// `AVDECCSwift::PduTapKind`.
+public enum PduTap: UInt8, Sendable, CaseIterable {
+  case adp = 0
+  case aecp = 1
+  case acmp = 2
+}
+
+/// Which PDUs a raw tap passes to the observer, tested in C++ before
+/// anything crosses into Swift. Fields are ANDed; an empty field matches
+/// anything, and any listed value within a field matches.
+public struct PduFilter: Sendable, Equatable {
+  /// Matches the PDU's entity (ADP), target or controller (AECP), or
+  /// talker, listener or controller (ACMP).
+  public var entityIDs: Set<UniqueIdentifier>
+  /// Raw message-type bytes. No PDU carries a value of 32 or more, so
+  /// a set of only such values matches nothing.
+  public var messageTypes: Set<UInt8>
+  /// AEM command types. AECP only; non-AEM PDUs then never match.
+  public var commandTypes: Set<UInt16>
+  /// Raw status bytes. AECP and ACMP only; as for `messageTypes`, values
+  /// of 32 or more never match.
+  public var statuses: Set<UInt8>
+
+  public init(
+    entityIDs: Set<UniqueIdentifier> = [],
+    messageTypes: Set<UInt8> = [],
+    commandTypes: Set<UInt16> = [],
+    statuses: Set<UInt8> = []
+  ) {
+    self.entityIDs = entityIDs
+    self.messageTypes = messageTypes
+    self.commandTypes = commandTypes
+    self.statuses = statuses
+  }
+
+  /// Passes every PDU.
+  public static let all = PduFilter()
+
+  /// The matching values as AVDECCSwift::PduFilter's bitmask: every bit
+  /// for an empty set, none if no value can match.
+  static func mask(_ values: Set<UInt8>) -> UInt32 {
+    if values.isEmpty { return .max }
+    return values.reduce(0) { $1 < 32 ? $0 | (1 << UInt32($1)) : $0 }
+  }
+}
+
+/// Counters of a `ProtocolInterface.startPduCapture` capture.
+public struct PduCaptureStatistics: Sendable, Equatable {
+  /// False once stopped, or if the writer hit `writeError`.
+  public let isRunning: Bool
+  /// PDUs copied into the ring.
+  public let captured: UInt64
+  /// PDUs lost because the ring was full.
+  public let dropped: UInt64
+  /// PDUs written to a file.
+  public let written: UInt64
+  /// Bytes written across all files, pcapng framing included.
+  public let bytesWritten: UInt64
+  /// Files opened so far, the current one included.
+  public let files: Int
+  /// errno of the failed write or rotation that stopped writing; 0 if
+  /// none.
+  public let writeError: Int32
+
+  init(_ s: AVDECCSwift.PduCaptureStatistics) {
+    isRunning = s.running && s.writeError == 0
+    captured = s.captured
+    dropped = s.dropped
+    written = s.written
+    bytesWritten = s.bytesWritten
+    files = Int(s.files)
+    writeError = s.writeError
+  }
+}
+
 // MARK: - Raw PDU send-side builders
 
 /// AdpMessageType (IEEE 1722.1-2013 §6.2.1.5).
@@ -0,0 +1,144 @@
+/*
+ * Copyright (C) 2026, PADL Software Pty Ltd
+ *
+ * This file is part of AVDECCSwift.
+ *
+ * AVDECCSwift is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * AVDECCSwift is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with AVDECCSwift.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+internal import CxxAVDECC
+
+/// Replays a pcap or pcapng capture of AVDECC traffic into a `.virtual`
+/// `ProtocolInterface`, to reproduce an incident or load-test controller
+/// logic offline. Backed by AVDECCSwift::PduReplayOwner.
+///
+/// A background thread reads the file and sends each ADP, AEM AECP and
+/// ACMP PDU through a second virtual interface on the target's interface
+/// ID, so the target receives them as if from the network. Other frames
+/// are skipped and counted, as are frames a pcapng file marks outbound
+/// (what the capturing interface sent, e.g. with
+/// `ProtocolInterface.startPduCapture`) unless `includeOutbound` is set.
+/// Pacing follows the recorded timestamps divided by `speed`; a `speed`
+/// of 0 sends back to back.
+///
+/// `statistics` reports the achieved PDU rate and the processing lag:
+/// how long each PDU took from being sent to reaching the target's
+/// observer, which is how far the target's executor is behind the
+/// replay. Lag is matched by arrival order, so the replay should be the
+/// only traffic on that interface ID.
+public final class PduReplay: @unchecked Sendable {
+  let owner: AVDECCSwift.PduReplayOwner
+
+  /// Starts replaying `path` into `target` immediately. Throws
+  /// `.invalidParameters` if `target` is not an open virtual interface
+  /// or already has a replay, and `.internalError` with the errno text
+  /// if the file cannot be opened or is neither pcap nor pcapng.
+  public init(
+    path: String,
+    into target: ProtocolInterface,
+    speed: Double = 1,
+    includeOutbound: Bool = false
+  ) throws {
+    var captured = AVDECCSwift.CapturedException()
+    let owner = AVDECCSwift.PduReplayOwner.create(
+      target.owner, std.string(path), max(speed, 0), includeOutbound, &captured
+    )
+    guard let owner else { throw ProtocolInterfaceError(captured) }
+    self.owner = owner
+  }
+
+  /// Abandon the rest of the file and detach from the target.
+  /// Idempotent; deinit also stops.
+  public func stop() {
+    owner.stop()
+  }
+
+  deinit {
+    owner.stop()
+  }
+
+  /// Block until the whole file has been sent or `stop()` is called, or
+  /// for at most `timeout`. Returns whether the replay has finished.
+  @discardableResult
+  public func wait(timeout: Duration? = nil) -> Bool {
+    guard let timeout else { return owner.waitUntilFinished(.max) }
+    let (seconds, attoseconds) = timeout.components
+    return owner.waitUntilFinished(
+      UInt64(clamping: max(seconds * 1_000_000_000 + attoseconds / 1_000_000_000, 0))
+    )
+  }
+
+  public struct Statistics: Sendable, Equatable {
+    /// False once the file is exhausted, the replay is stopped, or a read
+    /// error ends it.
+    public let isRunning: Bool
+    /// Frames read from the file.
+    public let frames: UInt64
+    public let injected: UInt64
+    /// Frames that are not ADP, AEM AECP or ACMP, or were captured
+    /// outbound and not included.
+    public let skipped: UInt64
+    public let malformed: UInt64
+    public let sendFailures: UInt64
+    /// Wall time since the replay started, up to when it finished.
+    public let elapsed: Duration
+    /// Recorded time covered so far, from the first frame read.
+    public let recorded: Duration
+    /// PDUs injected per second of `elapsed`.
+    public let pdusPerSecond: Double
+    /// Latest any PDU was sent after its paced time: how far the replay
+    /// thread itself fell behind.
+    public let maxScheduleSlip: Duration
+    /// Injected PDUs the target's observer has received.
+    public let processed: UInt64
+    /// Send-to-receipt lag over `processed`.
+    public let averageProcessingLag: Duration
+    public let maxProcessingLag: Duration
+    public let lastProcessingLag: Duration
+    /// Receipts too far behind to match a send time, and receipts of
+    /// traffic the replay did not send.
+    public let unmeasured: UInt64
+    public let unmatched: UInt64
+    /// errno of the read that ended the replay early (`EINVAL` for a
+    /// corrupt or truncated file); 0 if none.
+    public let readError: Int32
+
+    init(_ s: AVDECCSwift.PduReplayStatistics) {
+      isRunning = s.running
+      frames = s.frames
+      injected = s.injected
+      skipped = s.skipped
+      malformed = s.malformed
+      sendFailures = s.sendFailures
+      elapsed = .nanoseconds(s.elapsedNanos)
+      recorded = .nanoseconds(s.recordedNanos)
+      pdusPerSecond = s.elapsedNanos > 0
+        ? Double(s.injected) * 1e9 / Double(s.elapsedNanos) : 0
+      maxScheduleSlip = .nanoseconds(s.maxScheduleSlipNanos)
+      processed = s.processed
+      let measured = s.processed - s.unmeasured
+      averageProcessingLag = .nanoseconds(measured > 0 ? s.totalLagNanos / measured : 0)
+      maxProcessingLag = .nanoseconds(s.maxLagNanos)
+      lastProcessingLag = .nanoseconds(s.lastLagNanos)
+      unmeasured = s.unmeasured
+      unmatched = s.unmatched
+      readError = s.readError
+    }
+  }
+
+  /// Safe to poll from any thread, including after the replay finishes.
+  public var statistics: Statistics {
+    Statistics(owner.statistics())
+  }
+}
@@ -124,6 +124,13 @@ public protocol ProtocolInterfaceObserver: AnyObject {
   func onAecpAemIdentifyNotification(_: ProtocolInterface, pdu: AemAecpdu)
   func onAcmpCommand(_: ProtocolInterface, pdu: Acmpdu)
   func onAcmpResponse(_: ProtocolInterface, pdu: Acmpdu)
+
+  /// Raw PDU taps: every received PDU of that kind, before la_avdecc
+  /// processes it. Silent until a filter is set with
+  /// `ProtocolInterface.setPduFilter(_:for:)`.
+  func onAdpduReceived(_: ProtocolInterface, pdu: Adpdu)
+  func onAecpduReceived(_: ProtocolInterface, pdu: Aecpdu)
+  func onAcmpduReceived(_: ProtocolInterface, pdu: Acmpdu)
 }
 
 public extension ProtocolInterfaceObserver {
@@ -140,6 +147,9 @@ public extension ProtocolInterfaceObserver {
   func onAecpAemIdentifyNotification(_: ProtocolInterface, pdu _: AemAecpdu) {}
   func onAcmpCommand(_: ProtocolInterface, pdu _: Acmpdu) {}
   func onAcmpResponse(_: ProtocolInterface, pdu _: Acmpdu) {}
+  func onAdpduReceived(_: ProtocolInterface, pdu _: Adpdu) {}
+  func onAecpduReceived(_: ProtocolInterface, pdu _: Aecpdu) {}
+  func onAcmpduReceived(_: ProtocolInterface, pdu _: Acmpdu) {}
 }
 
 /// Wraps an la_avdecc ProtocolInterface. Backed by AVDECCSwift::
@@ -149,18 +159,155 @@ public extension ProtocolInterfaceObserver {
 /// cannot see la::avdecc::protocol::ProtocolInterface or its UniquePointer
 /// (std::function-typed handlers, templated Subject<>, move-only return).
 public final class ProtocolInterface {
-  let executor = Executor.shared
+  /// The shared executor, when this interface runs on
+  /// `DefaultExecutorName`. Interfaces on a custom executor name use
+  /// whatever `Executor` the caller registered under it.
+  let executor: Executor?
   let owner: AVDECCSwift.ProtocolInterfaceOwner
 
   public weak var observer: ProtocolInterfaceObserver? {
     didSet { rebindObserver() }
   }
 
+  /// Where observer callbacks run. `nil` (the default) calls the observer
+  /// on la_avdecc's executor; otherwise each callback is queued on the
+  /// shard for its entity ID. See `CallbackShards`.
+  public var callbackShards: CallbackShards? {
+    didSet { owner.setCallbackShards(callbackShards?.owner) }
+  }
+
+  /// Queue the work la_avdecc spawns while handling each received ACMP PDU
+  /// (its ACMP state machines' follow-up jobs) on `Executor.Lane
+  /// .interactive`, so connection management is not stuck behind queued
+  /// enumeration. On by default. Other follow-up work stays on `.bulk`.
+  public var prioritizesAcmp: Bool {
+    get { owner.acmpInteractive() }
+    set { owner.setAcmpInteractive(newValue) }
+  }
+
+  /// Forward `onRemoteEntityUpdated` only when one of these fields
+  /// differs from the entity's last forwarded (or online) state; nil or
+  /// empty forwards every update, as la_avdecc raises them. Compared in
+  /// C++ against a fingerprint kept per entity ID, so suppressed updates
+  /// never reach Swift. Changing the filter forwards each entity's next
+  /// update.
+  public var entityUpdateFilter: EntityUpdateFields? {
+    didSet { owner.setEntityUpdateFilter(entityUpdateFilter?.rawValue ?? 0) }
+  }
+
+  /// Entity updates forwarded and suppressed by `entityUpdateFilter`.
+  public var entityUpdateStatistics: (forwarded: UInt64, suppressed: UInt64) {
+    (owner.entityUpdatesForwarded(), owner.entityUpdatesSuppressed())
+  }
+
+  /// Turn a raw PDU tap on with `filter`, or off with nil (the default).
+  /// The filter runs in C++ on la_avdecc's executor, so PDUs it rejects
+  /// never reach Swift; an off tap costs one relaxed load per PDU.
+  public func setPduFilter(_ filter: PduFilter?, for tap: PduTap) {
+    guard let filter else {
+      _ = owner.setPduTapFilter(tap.rawValue, false, nil, 0, 0, 0, nil, 0)
+      return
+    }
+    let entityIDs = filter.entityIDs.map(\.rawValue)
+    let commandTypes = Array(filter.commandTypes)
+    entityIDs.withUnsafeBufferPointer { ids in
+      commandTypes.withUnsafeBufferPointer { commands in
+        _ = owner.setPduTapFilter(
+          tap.rawValue, true, ids.baseAddress, ids.count,
+          PduFilter.mask(filter.messageTypes), PduFilter.mask(filter.statuses),
+          commands.baseAddress, commands.count
+        )
+      }
+    }
+  }
+
+  /// PDUs a raw tap passed to the observer and filtered out.
+  public func pduTapStatistics(_ tap: PduTap) -> (matched: UInt64, rejected: UInt64) {
+    (owner.pduTapMatched(tap.rawValue), owner.pduTapRejected(tap.rawValue))
+  }
+
+  /// Write every ADP, AECP and ACMP PDU received, and every one sent with
+  /// `sendAdpMessage` / `sendAecpMessage` / `sendAcmpMessage`, to a pcapng
+  /// file at `path` that Wireshark can merge with a tcpdump of the same
+  /// link: timestamps are wall-clock nanoseconds, and direction is in
+  /// each packet's flags. PDUs la_avdecc's own state machines send are not
+  /// visible to the observer and so are not recorded.
+  ///
+  /// PDUs are copied into a ring of `bufferDepth` frames and written by a
+  /// background thread, so la_avdecc's executor never waits on the file;
+  /// when the ring is full a PDU is dropped and counted in
+  /// `pduCaptureStatistics.dropped`. After `maxFileSize` bytes the file
+  /// rotates to `path` with ".1", ".2", … before the extension, keeping
+  /// the last `maxFiles` (nil keeps all).
+  public func startPduCapture(
+    path: String,
+    maxFileSize: Int? = 64 << 20,
+    maxFiles: Int? = nil,
+    bufferDepth: Int = 4096
+  ) throws {
+    var captured = AVDECCSwift.CapturedException()
+    guard owner.startPduCapture(
+      std.string(path),
+      UInt64(clamping: maxFileSize ?? 0),
+      UInt32(clamping: maxFiles ?? 0),
+      UInt32(clamping: bufferDepth),
+      &captured
+    ) else {
+      throw ProtocolInterfaceError(captured)
+    }
+  }
+
+  /// Write out what is queued and close the capture file. Idempotent;
+  /// `close()` also stops it.
+  public func stopPduCapture() {
+    owner.stopPduCapture()
+  }
+
+  /// Counters of the running or last PDU capture; all zero if none was
+  /// started.
+  public var pduCaptureStatistics: PduCaptureStatistics {
+    PduCaptureStatistics(owner.pduCaptureStatistics())
+  }
+
+  /// Count and time every observer callback by handler; read the result
+  /// with `callbackProfile()`. Off by default, when it costs one relaxed
+  /// load per callback. Turning it off keeps the counts gathered so far.
+  public var isCallbackProfilingEnabled: Bool {
+    get { owner.callbackProfiling() }
+    set { _ = owner.setCallbackProfiling(newValue) }
+  }
+
+  /// Snapshot of the observer handlers' invocation counts and latencies.
+  public func callbackProfile() -> CallbackProfile {
+    CallbackProfile { owner.copyCallbackProfile($0, $1) }
+  }
+
+  /// Every observer event, whether or not `observer` is set, as an
+  /// `AsyncSequence` fed from a ring of `bufferDepth` events allocated
+  /// now. la_avdecc's executor never waits for the consumer; when it
+  /// falls behind, `overflow` decides what is lost. Each call opens an
+  /// independent stream. Throws `ProtocolInterfaceError` if a ring of
+  /// `bufferDepth` events cannot be allocated. See `CallbackEvents`.
+  public func events(
+    bufferDepth: Int = 256,
+    overflow: CallbackEventOverflow = .dropOldest
+  ) throws -> CallbackEvents {
+    try CallbackEvents(
+      bufferDepth: bufferDepth,
+      overflow: overflow,
+      attach: { owner.attachEventStream($0) },
+      detach: { [owner] in owner.detachEventStream($0) }
+    )
+  }
+
   public init(
     type: ProtocolInterfaceType = .pCap,
     interfaceID: String,
     executorName: String = DefaultExecutorName
   ) throws {
+    // First interface on the default executor brings it up; nothing is
+    // registered with la_avdecc before this point.
+    executor = executorName == DefaultExecutorName ? try Executor.bringUp() : nil
     var captured = AVDECCSwift.CapturedException()
     let owner = AVDECCSwift.ProtocolInterfaceOwner.create(
       type.rawValue, std.string(interfaceID), std.string(executorName), &captured
@@ -341,6 +488,18 @@ public final class ProtocolInterface {
       guard let self, let observer, let p else { return }
       observer.onAcmpResponse(self, pdu: Acmpdu(p))
     }
+    owner.setOnAdpduReceived { [weak self, weak observer] _, p in
+      guard let self, let observer, let p else { return }
+      observer.onAdpduReceived(self, pdu: Adpdu(p))
+    }
+    owner.setOnAecpduReceived { [weak self, weak observer] _, p in
+      guard let self, let observer, let p else { return }
+      observer.onAecpduReceived(self, pdu: Aecpdu(p))
+    }
+    owner.setOnAcmpduReceived { [weak self, weak observer] _, p in
+      guard let self, let observer, let p else { return }
+      observer.onAcmpduReceived(self, pdu: Acmpdu(p))
+    }
 
     owner.registerObserver()
   }
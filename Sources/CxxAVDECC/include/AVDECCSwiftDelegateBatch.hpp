@@ -0,0 +1,447 @@
+/*
+ * Copyright (C) 2026, PADL Software Pty Ltd
+ *
+ * This file is part of AVDECCSwift.
+ *
+ * AVDECCSwift is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * AVDECCSwift is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with AVDECCSwift.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+// Batched delivery for BlockControllerDelegate. A configuration change on
+// a large entity makes la_avdecc raise thousands of delegate events a
+// second, each a separate call into Swift. In batched mode the delegate
+// records events instead:
+//
+//   * each override's projection runs as usual, but against a recorder
+//     rather than the Swift block, so the arguments it would have passed
+//     are packed into a fixed-size DelegateEventRecord: scalars as words,
+//     pointed-to plain data copied into a byte arena, and the few
+//     payloads that are not plain data (`Entity`, `AvbInfo`, `AsPath`)
+//     held as owned copies;
+//   * the batch is handed to Swift in one call, from a job queued behind
+//     the executor's pending work or after a fixed interval;
+//   * Swift replays a record only if it wants it. Replaying calls the
+//     slot's block with pointers into the batch, exactly as the direct
+//     path would have, so skipped events are never decoded.
+//
+// Recording never runs Swift and never waits for a batch being delivered.
+#pragma once
+
+#include <algorithm>
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <memory>
+#include <mutex>
+#include <new>
+#include <string>
+#include <tuple>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+#include <dispatch/dispatch.h>
+
+#include <la/avdecc/executor.hpp>
+
+#include "AVDECCSwiftBlock.hpp"
+
+namespace AVDECCSwift {
+
+/// Most arguments any delegate block takes.
+constexpr size_t DelegateEventMaxArgs = 7;
+/// Record word for a null pointer argument.
+constexpr uint64_t DelegateEventNullPayload = ~uint64_t{0};
+
+class DelegateEventBatch;
+
+/// One recorded delegate event. Plain data; a batch is a flat array.
+struct DelegateEventRecord {
+  /// Calls the slot at `slotOffset` in `slots` with the decoded
+  /// arguments. Set by the recorder; Swift goes through
+  /// LocalEntityOwner::replayDelegateEvent.
+  void (*replay)(void const* slots, DelegateEventRecord const& record,
+                 DelegateEventBatch const& batch) noexcept;
+  /// Name of the delegate method that raised the event (a literal).
+  char const* name;
+  /// The entity the event is about (listener for sniffed ACMP, 0 for
+  /// transport errors).
+  uint64_t entityID;
+  uint32_t slotOffset;
+  uint32_t argCount;
+  /// Scalars, arena offsets, or indices of held copies.
+  uint64_t args[DelegateEventMaxArgs];
+};
+
+/// Records plus the payloads they point into. Handed to Swift as an
+/// opaque pointer, valid for the duration of the batch callback.
+class DelegateEventBatch final {
+public:
+  size_t size() const noexcept { return records_.size(); }
+  DelegateEventRecord const& operator[](size_t index) const noexcept { return records_[index]; }
+
+  uint8_t const* arena() const noexcept { return arena_.data(); }
+  void const* held(uint64_t index) const noexcept { return held_[index].get(); }
+
+  /// Copy `count` values to the arena, aligned for T; returns the offset.
+  template <typename T>
+  uint64_t store(T const* values, size_t count) {
+    auto const offset = (arena_.size() + alignof(T) - 1) / alignof(T) * alignof(T);
+    arena_.resize(offset + count * sizeof(T));
+    if (count) std::memcpy(arena_.data() + offset, values, count * sizeof(T));
+    return offset;
+  }
+
+  /// Keep an owned copy of `value`; returns its index.
+  template <typename T>
+  uint64_t hold(T const& value) {
+    held_.push_back(std::make_shared<T const>(value));
+    return held_.size() - 1;
+  }
+
+private:
+  friend class DelegateEventBatcher;
+
+  struct Mark {
+    size_t records, arena, held;
+  };
+  Mark mark() const noexcept { return {records_.size(), arena_.size(), held_.size()}; }
+  void rollback(Mark const& mark) noexcept {
+    records_.resize(mark.records);
+    arena_.resize(mark.arena);
+    held_.resize(mark.held);
+  }
+  /// Capacity is kept, so a steady stream of batches stops allocating.
+  void clear() noexcept {
+    records_.clear();
+    arena_.clear();
+    held_.clear();
+  }
+  void swap(DelegateEventBatch& other) noexcept {
+    records_.swap(other.records_);
+    arena_.swap(other.arena_);
+    held_.swap(other.held_);
+  }
+
+  std::vector<DelegateEventRecord> records_;
+  std::vector<uint8_t> arena_;
+  std::vector<std::shared_ptr<void const>> held_;
+};
+
+/// Elements behind a pointer argument with no size_t count after it.
+/// The only bare uint32_t array the delegate passes is a descriptor's 32
+/// counters.
+template <typename T>
+constexpr size_t delegateEventDefaultCount = 1;
+template <>
+constexpr size_t delegateEventDefaultCount<uint32_t> = 32;
+
+/// How one block argument of type T is packed into a record word.
+template <typename T, typename = void>
+struct DelegateEventArg {
+  static constexpr bool encodable = false;
+};
+
+// Arithmetic and enum values: the word itself.
+template <typename T>
+struct DelegateEventArg<T, std::enable_if_t<std::is_arithmetic<T>::value ||
+                                            std::is_enum<T>::value>> {
+  static constexpr bool encodable = true;
+  static uint64_t encode(T value, size_t, DelegateEventBatch&) noexcept {
+    if constexpr (std::is_enum<T>::value) {
+      return static_cast<uint64_t>(static_cast<std::underlying_type_t<T>>(value));
+    } else {
+      return static_cast<uint64_t>(value);
+    }
+  }
+  static T decode(uint64_t word, DelegateEventBatch const&) noexcept {
+    return static_cast<T>(word);
+  }
+};
+
+// Pointers to plain data: copied into the arena, `count` elements.
+// Anything else copy-constructible: an owned copy (single values only).
+template <typename T>
+struct DelegateEventArg<T const*, std::enable_if_t<std::is_copy_constructible<T>::value>> {
+  static constexpr bool encodable = true;
+  static uint64_t encode(T const* value, size_t count, DelegateEventBatch& batch) {
+    if (!value) return DelegateEventNullPayload;
+    if constexpr (std::is_trivially_copyable<T>::value) {
+      return batch.store(value, count);
+    } else {
+      return batch.hold(*value);
+    }
+  }
+  static T const* decode(uint64_t word, DelegateEventBatch const& batch) noexcept {
+    if (word == DelegateEventNullPayload) return nullptr;
+    if constexpr (std::is_trivially_copyable<T>::value) {
+      return reinterpret_cast<T const*>(batch.arena() + word);
+    } else {
+      return static_cast<T const*>(batch.held(word));
+    }
+  }
+};
+
+template <typename... Ts>
+constexpr bool delegateEventEncodable =
+    sizeof...(Ts) <= DelegateEventMaxArgs &&
+    (DelegateEventArg<std::decay_t<Ts>>::encodable && ...);
+
+template <size_t I, typename Tuple, typename = void>
+struct DelegateEventCountFollows : std::false_type {};
+template <size_t I, typename Tuple>
+struct DelegateEventCountFollows<I, Tuple, std::enable_if_t<(I + 1 < std::tuple_size<Tuple>::value)>>
+    : std::is_same<std::decay_t<std::tuple_element_t<I + 1, Tuple>>, size_t> {};
+
+/// Elements behind argument `I` if it is a pointer: the following
+/// argument when that is a size_t count (mappings, control values), else
+/// the default. Must match the arguments' meaning, not just their types,
+/// so keep counts directly after their pointers when adding slots.
+template <size_t I, typename Tuple>
+size_t delegateEventCount(Tuple const& args) noexcept {
+  using Arg = std::decay_t<std::tuple_element_t<I, Tuple>>;
+  if constexpr (!std::is_pointer<Arg>::value) {
+    return 0;
+  } else if constexpr (DelegateEventCountFollows<I, Tuple>::value) {
+    return std::get<I + 1>(args);
+  } else {
+    return delegateEventDefaultCount<std::remove_cv_t<std::remove_pointer_t<Arg>>>;
+  }
+}
+
+template <typename BlockT, typename... Ts, size_t... I>
+void replayDelegateEvent(BlockT const& blk, DelegateEventRecord const& record,
+                         DelegateEventBatch const& batch, std::index_sequence<I...>) noexcept {
+  blk(DelegateEventArg<Ts>::decode(record.args[I], batch)...);
+}
+
+/// DelegateEventRecord::replay for a slot of type BlockT called with Ts.
+template <typename BlockT, typename... Ts>
+void replayDelegateEvent(void const* slots, DelegateEventRecord const& record,
+                         DelegateEventBatch const& batch) noexcept {
+  auto const& blk = *reinterpret_cast<BlockT const*>(static_cast<uint8_t const*>(slots) +
+                                                     record.slotOffset);
+  if (blk) {
+    replayDelegateEvent<BlockT, Ts...>(blk, record, batch, std::index_sequence_for<Ts...>{});
+  }
+}
+
+/// For Swift, which sees the batch as a raw pointer.
+inline size_t delegateEventCount(void const* batch) noexcept {
+  return static_cast<DelegateEventBatch const*>(batch)->size();
+}
+inline DelegateEventRecord const* delegateEventRecord(void const* batch, size_t index) noexcept {
+  return &(*static_cast<DelegateEventBatch const*>(batch))[index];
+}
+inline char const* delegateEventName(DelegateEventRecord const* record) noexcept {
+  return record->name;
+}
+inline uint64_t delegateEventEntityID(DelegateEventRecord const* record) noexcept {
+  return record->entityID;
+}
+
+/// Pending events of one BlockControllerDelegate plus the Swift block
+/// that takes them. Always held by std::shared_ptr: scheduled flushes pin
+/// it, so it may outlive the owner that stopped it.
+class DelegateEventBatcher final : public std::enable_shared_from_this<DelegateEventBatcher> {
+public:
+  /// Receives a `DelegateEventBatch const*`.
+  using BatchBlock = Block<void, void const*>;
+
+  /// `intervalNanos` 0 flushes from a job pushed to `executorName` when
+  /// the first event of a batch arrives, i.e. after the jobs already
+  /// queued there; otherwise from a timer that long after it. A batch
+  /// reaching `maxEvents` is flushed as soon as possible.
+  static std::shared_ptr<DelegateEventBatcher> create(std::string executorName,
+                                                      uint64_t intervalNanos,
+                                                      uint32_t maxEvents, BatchBlock handler) {
+    return std::shared_ptr<DelegateEventBatcher>(new DelegateEventBatcher(
+        std::move(executorName), intervalNanos, maxEvents, std::move(handler)));
+  }
+
+  ~DelegateEventBatcher() noexcept {
+    if (timerQueue_) dispatch_release(timerQueue_);
+  }
+
+  DelegateEventBatcher(DelegateEventBatcher const&) = delete;
+  DelegateEventBatcher& operator=(DelegateEventBatcher const&) = delete;
+
+  /// Any thread. Records the event, or returns false if it could not be
+  /// (drained, stopped, or out of memory); the caller then delivers it
+  /// directly.
+  template <typename BlockT, typename... Ts>
+  bool append(char const* name, uint64_t entityID, uint32_t slotOffset,
+              Ts const&... args) noexcept {
+    std::lock_guard<std::mutex> lg(pendingLock_);
+    if (!accepting_) return false;
+    auto const mark = pending_.mark();
+    try {
+      DelegateEventRecord record{};
+      record.replay = &replayDelegateEvent<BlockT, std::decay_t<Ts>...>;
+      record.name = name;
+      record.entityID = entityID;
+      record.slotOffset = slotOffset;
+      record.argCount = static_cast<uint32_t>(sizeof...(Ts));
+      encode(record, std::forward_as_tuple(args...), std::index_sequence_for<Ts...>{});
+      pending_.records_.push_back(record);
+    } catch (...) {
+      pending_.rollback(mark);
+      return false;
+    }
+    events_.fetch_add(1, std::memory_order_relaxed);
+    if (!flushScheduled_) {
+      flushScheduled_ = scheduleFlush(intervalNanos_);
+    } else if (pending_.size() == maxEvents_) {
+      scheduleFlush(0);
+    }
+    return true;
+  }
+
+  /// Hand the pending batch to Swift now, on the calling thread. Batches
+  /// are delivered one at a time, in order; calling this from inside the
+  /// handler delivers the newer events before it returns.
+  void flush() noexcept {
+    std::lock_guard<std::recursive_mutex> lg(flushLock_);
+    DelegateEventBatch batch;
+    {
+      std::lock_guard<std::mutex> pl(pendingLock_);
+      flushScheduled_ = false;
+      if (stopped_ || pending_.size() == 0) return;
+      batch.swap(pending_);
+      pending_.swap(spare_);
+    }
+    batches_.fetch_add(1, std::memory_order_relaxed);
+    handler_(&batch);
+    batch.clear();
+    std::lock_guard<std::mutex> pl(pendingLock_);
+    if (spare_.records_.capacity() < batch.records_.capacity()) spare_.swap(batch);
+  }
+
+  /// Refuse further events (their recorders deliver them directly) and
+  /// hand what is pending to Swift now, on the calling thread.
+  void drain() noexcept {
+    {
+      std::lock_guard<std::mutex> lg(pendingLock_);
+      accepting_ = false;
+    }
+    flush();
+  }
+
+  /// Drop pending events and deliver no more batches. Does not wait for
+  /// one being delivered.
+  void stop() noexcept {
+    std::lock_guard<std::mutex> lg(pendingLock_);
+    accepting_ = false;
+    stopped_ = true;
+    pending_.clear();
+  }
+
+  uint64_t events() const noexcept { return events_.load(std::memory_order_relaxed); }
+  uint64_t batches() const noexcept { return batches_.load(std::memory_order_relaxed); }
+
+private:
+  DelegateEventBatcher(std::string executorName, uint64_t intervalNanos, uint32_t maxEvents,
+                       BatchBlock handler)
+      : executorName_(std::move(executorName)),
+        intervalNanos_(intervalNanos),
+        maxEvents_(std::max(maxEvents, 1u)),
+        handler_(std::move(handler)) {
+    if (intervalNanos_) {
+      timerQueue_ = dispatch_queue_create("avdecc.delegate-batch", DISPATCH_QUEUE_SERIAL);
+    }
+  }
+
+  template <typename Tuple, size_t... I>
+  void encode(DelegateEventRecord& record, Tuple const& args, std::index_sequence<I...>) {
+    ((record.args[I] = DelegateEventArg<std::decay_t<std::tuple_element_t<I, Tuple>>>::encode(
+          std::get<I>(args), delegateEventCount<I>(args), pending_)),
+     ...);
+  }
+
+  // pendingLock_ held. In executor mode every flush is a job on the
+  // executor; in timer mode, on the serial timer queue. Either way
+  // batches never reach Swift concurrently or from a recording thread.
+  bool scheduleFlush(uint64_t delayNanos) noexcept {
+    std::weak_ptr<DelegateEventBatcher> weak = weak_from_this();
+    if (timerQueue_) {
+      auto* context = new (std::nothrow) std::weak_ptr<DelegateEventBatcher>(std::move(weak));
+      if (!context) return false;
+      dispatch_after_f(dispatch_time(DISPATCH_TIME_NOW, static_cast<int64_t>(delayNanos)),
+                       timerQueue_, context, [](void* context) {
+                         auto* weak = static_cast<std::weak_ptr<DelegateEventBatcher>*>(context);
+                         if (auto self = weak->lock()) self->flush();
+                         delete weak;
+                       });
+      return true;
+    }
+    try {
+      la::avdecc::ExecutorManager::getInstance().pushJob(executorName_, [weak = std::move(weak)] {
+        if (auto self = weak.lock()) self->flush();
+      });
+      return true;
+    } catch (...) {
+      return false;
+    }
+  }
+
+  std::string const executorName_;
+  uint64_t const intervalNanos_;
+  size_t const maxEvents_;
+  BatchBlock const handler_;
+  dispatch_queue_t timerQueue_ = nullptr;
+
+  std::recursive_mutex flushLock_;
+  std::mutex pendingLock_;
+  bool accepting_ = true;
+  bool stopped_ = false;
+  bool flushScheduled_ = false;
+  DelegateEventBatch pending_;
+  /// Buffers of the last delivered batch, reused for the next one.
+  DelegateEventBatch spare_;
+
+  std::atomic<uint64_t> events_{0};
+  std::atomic<uint64_t> batches_{0};
+};
+
+/// Stands in for a slot's block when an override's projection runs in
+/// batched mode: the projection's call records the event instead. The
+/// call converts to the block's own parameter types first, so the record
+/// replays exactly what the block would have received. An event that
+/// cannot be recorded is delivered directly.
+template <typename BlockT>
+class DelegateEventRecorder;
+
+template <typename... Params>
+class DelegateEventRecorder<Block<void, Params...>> final {
+  using BlockT = Block<void, Params...>;
+  static_assert(delegateEventEncodable<Params...>, "delegate block argument cannot be recorded");
+
+public:
+  DelegateEventRecorder(DelegateEventBatcher& batcher, BlockT const& blk, char const* name,
+                        uint64_t entityID, uint32_t slotOffset) noexcept
+      : batcher_(batcher), blk_(blk), name_(name), entityID_(entityID), slotOffset_(slotOffset) {}
+
+  void operator()(Params... args) const noexcept {
+    if (!batcher_.template append<BlockT>(name_, entityID_, slotOffset_, args...)) blk_(args...);
+  }
+
+private:
+  DelegateEventBatcher& batcher_;
+  BlockT const& blk_;
+  char const* name_;
+  uint64_t entityID_;
+  uint32_t slotOffset_;
+};
+
+} // namespace AVDECCSwift
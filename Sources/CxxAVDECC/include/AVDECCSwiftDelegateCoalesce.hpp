@@ -0,0 +1,490 @@
+/*
+ * Copyright (C) 2026, PADL Software Pty Ltd
+ *
+ * This file is part of AVDECCSwift.
+ *
+ * AVDECCSwift is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * AVDECCSwift is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with AVDECCSwift.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+// Latest-value coalescing for BlockControllerDelegate's high-rate slots
+// (counters, AECP response times, operation status). Consumers of those
+// want the current value, not every intermediate one, yet each event
+// used to cost a Swift call and a 32-counter array copy.
+//
+// With coalescing enabled for a slot, an event only overwrites the entry
+// for its key, (slot, entity, descriptor), in a fixed table. A timer on
+// the coalescer's serial queue picks each changed entry at most once per
+// the slot's interval: the first change after a quiet period goes out at
+// once, later ones wait for the interval to elapse and then carry
+// whatever value is latest. The last value of a burst is always
+// delivered.
+//
+// The timer only decides what is due. The values themselves are handed
+// to the entity's callback shard, or to la_avdecc's executor without
+// shards, so they reach Swift where that entity's other notifications
+// do and in order with them. A value still in transit when its entity
+// goes offline, or its slot is rebound, is dropped rather than delivered
+// after the fact.
+//
+// Entries keep their own copy of the block, so delivery never touches
+// the delegate. The table is large, so BlockControllerDelegate creates
+// the coalescer only when a slot is first coalesced.
+#pragma once
+
+#include <algorithm>
+#include <array>
+#include <atomic>
+#include <bitset>
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <limits>
+#include <memory>
+#include <mutex>
+#include <new>
+#include <string>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+#include <dispatch/dispatch.h>
+
+#include <la/avdecc/executor.hpp>
+
+#include "AVDECCSwiftDelegateBatch.hpp"
+#include "AVDECCSwiftDelivery.hpp"
+#include "AVDECCSwiftSlotProfile.hpp"
+#include "AVDECCSwiftStatistics.hpp"
+
+namespace AVDECCSwift {
+
+/// Keys the table holds; an event that finds no entry is delivered as if
+/// coalescing were off.
+constexpr size_t DelegateCoalesceCapacity = 512;
+/// Entries probed per key before giving up.
+constexpr size_t DelegateCoalesceProbe = 16;
+
+/// Whether a slot taking Params can be coalesced: an entity ID, then
+/// scalars and at most a counters array.
+template <typename... Params>
+struct DelegateCoalescible : std::false_type {};
+template <typename... Params>
+struct DelegateCoalescible<uint64_t, Params...>
+    : std::integral_constant<bool, sizeof...(Params) < DelegateEventMaxArgs &&
+                                       ((std::is_arithmetic<Params>::value ||
+                                         std::is_enum<Params>::value ||
+                                         std::is_same<Params, uint32_t const*>::value) &&
+                                        ...)> {};
+template <typename... Params>
+struct DelegateCoalescible<Block<void, Params...>> : DelegateCoalescible<Params...> {};
+
+class DelegateCoalescer final : public std::enable_shared_from_this<DelegateCoalescer> {
+public:
+  /// Slot indices (slot offset / pointer size) the coalescer can track.
+  static constexpr size_t MaxSlots = 128;
+
+  /// Values are delivered on `executorName` unless shards are set.
+  /// Direct deliveries are timed into `profiler`, if given.
+  static std::shared_ptr<DelegateCoalescer> create(
+      std::string executorName, std::shared_ptr<SlotProfiler> profiler = nullptr) {
+    return std::shared_ptr<DelegateCoalescer>(
+        new DelegateCoalescer(std::move(executorName), std::move(profiler)));
+  }
+
+  ~DelegateCoalescer() noexcept {
+    if (queue_) dispatch_release(queue_);
+  }
+
+  DelegateCoalescer(DelegateCoalescer const&) = delete;
+  DelegateCoalescer& operator=(DelegateCoalescer const&) = delete;
+
+  /// Coalesce the slot at `slotOffset`, keyed by the entity ID (its
+  /// first argument) and the `keyArgs` arguments after it, delivering
+  /// each key at most once per `intervalNanos`. 0 turns it off; pending
+  /// values for the slot are then delivered by the next flush.
+  void setInterval(uint32_t slotOffset, uint32_t keyArgs, uint64_t intervalNanos) noexcept {
+    auto const index = slotOffset / sizeof(void*);
+    if (index >= MaxSlots) return;
+    std::lock_guard<std::mutex> lg(lock_);
+    if (intervalNanos && !queue_) {
+      queue_ = dispatch_queue_create("avdecc.delegate-coalesce", DISPATCH_QUEUE_SERIAL);
+      if (!queue_) return;
+    }
+    keyArgs_[index].store(std::min<uint32_t>(keyArgs, DelegateEventMaxArgs - 1),
+                          std::memory_order_relaxed);
+    intervals_[index].store(intervalNanos, std::memory_order_relaxed);
+    if (!intervalNanos && nextFlushAt_ != Never) {
+      nextFlushAt_ = steadyNanos();
+      schedule(0);
+    }
+  }
+
+  /// Any thread; one relaxed load.
+  bool coalesces(uint32_t slotOffset) const noexcept {
+    auto const index = slotOffset / sizeof(void*);
+    return index < MaxSlots && intervals_[index].load(std::memory_order_relaxed) != 0;
+  }
+
+  /// Where flushed values go while batching is on; see
+  /// BlockControllerDelegate::setBatcher. Batched values are recorded
+  /// from the executor, like shard-less deliveries.
+  void setBatcher(std::shared_ptr<DelegateEventBatcher> batcher) noexcept {
+    std::lock_guard<std::mutex> lg(lock_);
+    batcher_ = std::move(batcher);
+  }
+
+  /// Deliver on the entity's shard rather than the executor (nullptr for
+  /// the executor); see BlockControllerDelegate::setShards.
+  void setShards(std::shared_ptr<CallbackShards> shards) noexcept {
+    std::lock_guard<std::mutex> lg(lock_);
+    shards_ = std::move(shards);
+  }
+
+  /// Drop pending values for one slot (offset) or, with no argument, all.
+  void forget(uint32_t slotOffset = std::numeric_limits<uint32_t>::max()) noexcept {
+    std::lock_guard<std::mutex> lg(lock_);
+    for (auto& entry : entries_) {
+      if (entry.used && (slotOffset == std::numeric_limits<uint32_t>::max() ||
+                         entry.slotOffset == slotOffset)) {
+        entry = Entry{};
+      }
+    }
+  }
+
+  /// Drop every value held or in transit for `entityID`, which has gone
+  /// offline.
+  void forgetEntity(uint64_t entityID) noexcept {
+    std::lock_guard<std::mutex> lg(lock_);
+    for (auto& entry : entries_) {
+      if (entry.used && entry.entityID == entityID) entry = Entry{};
+    }
+  }
+
+  /// Drop everything and deliver nothing more, including values already
+  /// handed to a shard or the executor.
+  void stop() noexcept {
+    std::lock_guard<std::mutex> lg(lock_);
+    stopped_ = true;
+    for (auto& entry : entries_) entry = Entry{};
+    batcher_.reset();
+    shards_.reset();
+  }
+
+  /// Any thread. Stores the event as the latest value for its key, or
+  /// returns false if it was not taken (stopped, slot not coalesced,
+  /// table full); the caller then delivers it itself.
+  template <typename BlockT, typename... Params>
+  bool offer(BlockT const& blk, char const* name, uint32_t slotOffset,
+             Params const&... args) noexcept {
+    static_assert(DelegateCoalescible<Params...>::value, "slot cannot be coalesced");
+    auto const index = slotOffset / sizeof(void*);
+    if (index >= MaxSlots) return false;
+    auto const interval = intervals_[index].load(std::memory_order_relaxed);
+    if (!interval) return false;
+
+    uint64_t words[sizeof...(Params)];
+    uint32_t const* counters = nullptr;
+    encode(words, counters, std::forward_as_tuple(args...), std::index_sequence_for<Params...>{});
+    auto const keyArgs = std::min<size_t>(keyArgs_[index].load(std::memory_order_relaxed),
+                                          sizeof...(Params) - 1);
+    uint64_t descriptor = 0;
+    for (size_t i = 1; i <= keyArgs; ++i) descriptor = (descriptor << 16) ^ words[i];
+
+    std::lock_guard<std::mutex> lg(lock_);
+    if (stopped_) return false;
+    auto* const entry = find(slotOffset, words[0], descriptor);
+    if (!entry) return false;
+    if (!entry->block ||
+        static_cast<BlockT const*>(entry->block.get())->get() != blk.get()) {
+      try {
+        entry->block = std::make_shared<BlockT const>(blk);
+      } catch (...) {
+        return false;
+      }
+    }
+    entry->emit = &emit<BlockT, Params...>;
+    entry->name = name;
+    entry->interval = interval;
+    std::copy(std::begin(words), std::end(words), entry->args);
+    if (counters) std::memcpy(entry->counters, counters, sizeof(entry->counters));
+    offered_.fetch_add(1, std::memory_order_relaxed);
+
+    if (!entry->dirty) {
+      entry->dirty = true;
+      auto const now = steadyNanos();
+      auto const at = std::max(entry->due, now);
+      if (at < nextFlushAt_) {
+        nextFlushAt_ = at;
+        schedule(at - now);
+      }
+    }
+    return true;
+  }
+
+  /// Call `fn()`, a direct delivery of the slot at `slotOffset`, through
+  /// the profiler.
+  template <typename Fn>
+  void deliverDirect(uint32_t slotOffset, char const* name, Fn&& fn) const noexcept {
+    if (profiler_) {
+      profiler_->time(slotOffset, name, fn);
+    } else {
+      fn();
+    }
+  }
+
+  /// Events taken, and values delivered; the difference was coalesced.
+  uint64_t offered() const noexcept { return offered_.load(std::memory_order_relaxed); }
+  uint64_t delivered() const noexcept { return delivered_.load(std::memory_order_relaxed); }
+
+private:
+  struct Entry {
+    bool used = false;
+    bool dirty = false;
+    /// Copies flushed but not yet delivered; such an entry is not evicted.
+    uint16_t inFlight = 0;
+    /// Position in entries_, and the claim it belongs to: a copy is
+    /// delivered only if its entry has not been dropped or reclaimed since.
+    uint32_t index = 0;
+    uint64_t generation = 0;
+    uint32_t slotOffset = 0;
+    uint64_t entityID = 0;
+    uint64_t descriptor = 0;
+    /// Earliest time the key may be delivered again.
+    uint64_t due = 0;
+    uint64_t interval = 0;
+    char const* name = nullptr;
+    void (*emit)(DelegateCoalescer const& self, Entry const& entry,
+                 DelegateEventBatcher* batcher) noexcept = nullptr;
+    /// A BlockT, copied when the slot's binding changes.
+    std::shared_ptr<void const> block;
+    uint64_t args[DelegateEventMaxArgs] = {};
+    /// The one pointer argument a coalesced slot may take.
+    uint32_t counters[32] = {};
+  };
+
+  static constexpr uint64_t Never = std::numeric_limits<uint64_t>::max();
+  static constexpr uint64_t NullCounters = ~uint64_t{0};
+
+  DelegateCoalescer(std::string executorName, std::shared_ptr<SlotProfiler> profiler)
+      : executorName_(std::move(executorName)), profiler_(std::move(profiler)) {
+    ready_.reserve(DelegateCoalesceCapacity);
+  }
+
+  template <typename T>
+  static uint64_t encodeArg(T const& value, uint32_t const*&) noexcept {
+    return static_cast<uint64_t>(value);
+  }
+  static uint64_t encodeArg(uint32_t const* value, uint32_t const*& counters) noexcept {
+    counters = value;
+    return value ? 0 : NullCounters;
+  }
+
+  template <typename T>
+  static T decodeArg(uint64_t word, Entry const& entry) noexcept {
+    if constexpr (std::is_pointer<T>::value) {
+      return word == NullCounters ? nullptr : entry.counters;
+    } else {
+      return static_cast<T>(word);
+    }
+  }
+
+  template <typename Tuple, size_t... I>
+  static void encode(uint64_t* words, uint32_t const*& counters, Tuple const& args,
+                     std::index_sequence<I...>) noexcept {
+    ((words[I] = encodeArg(std::get<I>(args), counters)), ...);
+  }
+
+  template <typename BlockT, typename... Params, size_t... I>
+  static void emitIndexed(DelegateCoalescer const& self, Entry const& entry,
+                          DelegateEventBatcher* batcher, std::index_sequence<I...>) noexcept {
+    auto const& blk = *static_cast<BlockT const*>(entry.block.get());
+    if (!blk) return;
+    if (batcher) {
+      DelegateEventRecorder<BlockT>{*batcher, blk, entry.name, entry.entityID, entry.slotOffset}(
+          decodeArg<Params>(entry.args[I], entry)...);
+    } else {
+      self.deliverDirect(entry.slotOffset, entry.name,
+                         [&] { blk(decodeArg<Params>(entry.args[I], entry)...); });
+    }
+  }
+
+  template <typename BlockT, typename... Params>
+  static void emit(DelegateCoalescer const& self, Entry const& entry,
+                   DelegateEventBatcher* batcher) noexcept {
+    emitIndexed<BlockT, Params...>(self, entry, batcher, std::index_sequence_for<Params...>{});
+  }
+
+  // lock_ held. The key's entry, a free one claimed for it, or a clean
+  // one evicted for it; nullptr if every probed entry holds another
+  // pending or in-transit value.
+  Entry* find(uint32_t slotOffset, uint64_t entityID, uint64_t descriptor) noexcept {
+    auto hash = entityID * 0x9e3779b97f4a7c15ull ^ descriptor * 0xc2b2ae3d27d4eb4full ^ slotOffset;
+    hash ^= hash >> 29;
+    Entry* vacant = nullptr;
+    for (size_t probe = 0; probe < DelegateCoalesceProbe; ++probe) {
+      auto& entry = entries_[(hash + probe) % DelegateCoalesceCapacity];
+      if (entry.used && entry.slotOffset == slotOffset && entry.entityID == entityID &&
+          entry.descriptor == descriptor) {
+        return &entry;
+      }
+      if (!vacant && (!entry.used || (!entry.dirty && !entry.inFlight))) vacant = &entry;
+    }
+    if (!vacant) return nullptr;
+    *vacant = Entry{};
+    vacant->used = true;
+    vacant->index = static_cast<uint32_t>(vacant - entries_.data());
+    vacant->generation = ++generation_;
+    vacant->slotOffset = slotOffset;
+    vacant->entityID = entityID;
+    vacant->descriptor = descriptor;
+    return vacant;
+  }
+
+  // lock_ held.
+  void schedule(uint64_t delayNanos) noexcept {
+    if (!queue_) return;
+    auto* context = new (std::nothrow) std::weak_ptr<DelegateCoalescer>(weak_from_this());
+    if (!context) return;
+    dispatch_after_f(dispatch_time(DISPATCH_TIME_NOW, static_cast<int64_t>(delayNanos)), queue_,
+                     context, [](void* context) {
+                       auto* weak = static_cast<std::weak_ptr<DelegateCoalescer>*>(context);
+                       if (auto self = weak->lock()) self->flush();
+                       delete weak;
+                     });
+  }
+
+  // On queue_ only, so ready_ needs no lock of its own.
+  void flush() noexcept {
+    std::shared_ptr<CallbackShards> shards;
+    {
+      std::lock_guard<std::mutex> lg(lock_);
+      if (stopped_) return;
+      auto const now = steadyNanos();
+      auto next = Never;
+      for (auto& entry : entries_) {
+        if (!entry.dirty) continue;
+        if (entry.due <= now || !coalesces(entry.slotOffset)) {
+          ready_.push_back(entry);
+          entry.dirty = false;
+          ++entry.inFlight;
+          entry.due = now + entry.interval;
+        } else {
+          next = std::min(next, entry.due);
+        }
+      }
+      nextFlushAt_ = next;
+      if (next != Never) schedule(next - now);
+      // The batcher is fed from the executor, whatever the shards.
+      if (!batcher_) shards = shards_;
+    }
+    if (!ready_.empty()) handOff(shards);
+    ready_.clear();
+  }
+
+  // On queue_. Pass ready_ to the entity's shard, else to the executor;
+  // whatever neither takes is delivered here.
+  void handOff(std::shared_ptr<CallbackShards> const& shards) noexcept {
+    std::weak_ptr<DelegateCoalescer> weak = weak_from_this();
+    size_t handed = 0;
+    try {
+      if (shards) {
+        for (; handed < ready_.size(); ++handed) {
+          shards->submit(ready_[handed].entityID, [weak, entry = ready_[handed]] {
+            if (auto self = weak.lock()) self->deliver(&entry, 1);
+          });
+        }
+      } else {
+        la::avdecc::ExecutorManager::getInstance().pushJob(
+            executorName_, [weak, batch = std::vector<Entry>(ready_.begin(), ready_.end())] {
+              if (auto self = weak.lock()) self->deliver(batch.data(), batch.size());
+            });
+        handed = ready_.size();
+      }
+    } catch (...) {
+    }
+    if (handed < ready_.size()) deliver(ready_.data() + handed, ready_.size() - handed);
+  }
+
+  // Where the values are due: emit the flushed copies whose entries are
+  // still the ones they were taken from.
+  void deliver(Entry const* copies, size_t count) noexcept {
+    std::bitset<DelegateCoalesceCapacity> live;
+    std::shared_ptr<DelegateEventBatcher> batcher;
+    {
+      std::lock_guard<std::mutex> lg(lock_);
+      if (stopped_) return;
+      for (size_t i = 0; i < count; ++i) {
+        auto& entry = entries_[copies[i].index];
+        if (entry.used && entry.generation == copies[i].generation) {
+          if (entry.inFlight) --entry.inFlight;
+          live.set(i);
+        }
+      }
+      batcher = batcher_;
+    }
+    for (size_t i = 0; i < count; ++i) {
+      if (live.test(i)) copies[i].emit(*this, copies[i], batcher.get());
+    }
+    delivered_.fetch_add(live.count(), std::memory_order_relaxed);
+  }
+
+  std::string const executorName_;
+  std::shared_ptr<SlotProfiler> const profiler_;
+  std::array<std::atomic<uint64_t>, MaxSlots> intervals_{};
+  std::array<std::atomic<uint32_t>, MaxSlots> keyArgs_{};
+
+  std::mutex lock_;
+  dispatch_queue_t queue_ = nullptr;
+  bool stopped_ = false;
+  /// Earliest flush already scheduled.
+  uint64_t nextFlushAt_ = Never;
+  std::shared_ptr<DelegateEventBatcher> batcher_;
+  std::shared_ptr<CallbackShards> shards_;
+  std::array<Entry, DelegateCoalesceCapacity> entries_;
+  uint64_t generation_ = 0;
+  /// Entries being delivered by flush(); capacity reserved up front.
+  std::vector<Entry> ready_;
+
+  std::atomic<uint64_t> offered_{0};
+  std::atomic<uint64_t> delivered_{0};
+};
+
+/// Stands in for a coalesced slot's block in an override's projection,
+/// like DelegateEventRecorder does for batching.
+template <typename BlockT>
+class DelegateCoalesceRecorder;
+
+template <typename... Params>
+class DelegateCoalesceRecorder<Block<void, Params...>> final {
+  using BlockT = Block<void, Params...>;
+
+public:
+  DelegateCoalesceRecorder(DelegateCoalescer& coalescer, BlockT const& blk, char const* name,
+                           uint32_t slotOffset) noexcept
+      : coalescer_(coalescer), blk_(blk), name_(name), slotOffset_(slotOffset) {}
+
+  void operator()(Params... args) const noexcept {
+    if (!coalescer_.template offer<BlockT>(blk_, name_, slotOffset_, args...)) {
+      coalescer_.deliverDirect(slotOffset_, name_, [&] { blk_(args...); });
+    }
+  }
+
+private:
+  DelegateCoalescer& coalescer_;
+  BlockT const& blk_;
+  char const* name_;
+  uint32_t slotOffset_;
+};
+
+} // namespace AVDECCSwift
@@ -0,0 +1,231 @@
+/*
+ * Copyright (C) 2026, PADL Software Pty Ltd
+ *
+ * This file is part of AVDECCSwift.
+ *
+ * AVDECCSwift is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * AVDECCSwift is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with AVDECCSwift.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+// Sharded callback delivery for the observer / delegate adapters. By
+// default every BlockProtocolInterfaceObserver / BlockControllerDelegate
+// callback runs its Swift block inline, on la_avdecc's executor, so one
+// slow handler holds up protocol processing for every entity. With a
+// CallbackShards attached, each callback is instead handed to one of N
+// serial dispatch queues picked by a hash of its entity ID:
+//
+//   * per-entity order is preserved (one entity always maps to one
+//     serial queue), while different entities run in parallel;
+//   * the executor returns as soon as the arguments are copied.
+//
+// Deferring means la_avdecc's by-reference arguments must be copied:
+// `deliverCallback` captures each one by value (PDUs, which are
+// polymorphic, through their `copy()`), and hands the Swift block a
+// pointer into that copy — valid for the duration of the call, exactly
+// as the inline path's borrowed pointer is. The one argument that is not
+// copied is the observer's `ProtocolInterface*`: a deferred call may run
+// after the interface is gone, so it gets nullptr instead.
+//
+// Only observer and delegate notifications go through the shards. Command
+// completion handlers are still called on la_avdecc's executor, so with
+// shards attached a completion can reach Swift before a notification for
+// the same entity that la_avdecc raised ahead of it.
+#pragma once
+
+#include <algorithm>
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+#include <memory>
+#include <string>
+#include <thread>
+#include <tuple>
+#include <utility>
+#include <vector>
+
+#include <dispatch/dispatch.h>
+
+#include <la/avdecc/internals/protocolAcmpdu.hpp>
+#include <la/avdecc/internals/protocolAdpdu.hpp>
+#include <la/avdecc/internals/protocolAecpdu.hpp>
+#include <la/avdecc/internals/protocolAemAecpdu.hpp>
+#include <la/avdecc/internals/protocolInterface.hpp>
+#include <la/avdecc/utils.hpp>
+
+#include "AVDECCSwiftJobQueue.hpp"
+
+namespace AVDECCSwift {
+
+/// N serial dispatch queues plus the node pool their jobs travel in.
+/// Always held by std::shared_ptr: every submitted job pins it through
+/// the node's `keepAlive`, so queues outlive the last delivery even if
+/// the owning Swift object is released first.
+class CallbackShards final : public std::enable_shared_from_this<CallbackShards> {
+public:
+  /// `count` 0 selects one queue per hardware thread. Queue labels are
+  /// `label.<i>`.
+  static std::shared_ptr<CallbackShards> create(std::string const& label,
+                                                uint32_t count) {
+    return std::shared_ptr<CallbackShards>(new CallbackShards(label, count));
+  }
+
+  ~CallbackShards() noexcept {
+    for (auto* queue : queues_) dispatch_release(queue);
+  }
+
+  CallbackShards(CallbackShards const&) = delete;
+  CallbackShards& operator=(CallbackShards const&) = delete;
+
+  uint32_t count() const noexcept { return static_cast<uint32_t>(queues_.size()); }
+
+  /// Stable shard for `key`. The splitmix64 finaliser spreads entity IDs,
+  /// whose low bits are often a vendor-assigned serial, evenly.
+  uint32_t shardFor(uint64_t key) const noexcept {
+    key ^= key >> 30;
+    key *= 0xbf58476d1ce4e5b9ull;
+    key ^= key >> 27;
+    key *= 0x94d049bb133111ebull;
+    key ^= key >> 31;
+    return static_cast<uint32_t>(key % queues_.size());
+  }
+
+  void submit(uint64_t key, std::function<void()>&& fn) noexcept {
+    auto* node = pool_.acquire();
+    node->job = std::move(fn);
+    node->keepAlive = shared_from_this();
+    dispatch_async_f(queues_[shardFor(key)], node, &runNode);
+  }
+
+  /// Wait until everything submitted so far has been delivered. A no-op
+  /// when called from a shard (the caller's own shard is then already
+  /// ordered, and waiting on it would deadlock).
+  void flush() noexcept {
+    if (dispatch_get_specific(this) == this) return;
+    for (auto* queue : queues_) dispatch_sync_f(queue, nullptr, [](void*) {});
+  }
+
+  /// Job-node pool statistics, as ExecutorStatistics reports them.
+  JobNodePool const& pool() const noexcept { return pool_; }
+
+private:
+  CallbackShards(std::string const& label, uint32_t count) {
+    if (count == 0) count = std::max(1u, std::thread::hardware_concurrency());
+    queues_.reserve(count);
+    for (uint32_t i = 0; i < count; ++i) {
+      auto const name = label + "." + std::to_string(i);
+#if __has_include(<sys/qos.h>)
+      auto attr = dispatch_queue_attr_make_with_qos_class(
+          DISPATCH_QUEUE_SERIAL, QOS_CLASS_USER_INITIATED, 0);
+#else
+      dispatch_queue_attr_t attr = DISPATCH_QUEUE_SERIAL;
+#endif
+      auto* queue = dispatch_queue_create(name.c_str(), attr);
+      dispatch_queue_set_specific(queue, this, this, nullptr);
+      queues_.push_back(queue);
+    }
+  }
+
+  static void runNode(void* context) noexcept {
+    auto* node = static_cast<JobNode*>(context);
+    auto keepAlive = std::move(node->keepAlive);
+    la::avdecc::utils::invokeProtectedHandler(node->job);
+    static_cast<CallbackShards*>(keepAlive.get())->pool_.release(node);
+  }
+
+  std::vector<dispatch_queue_t> queues_;
+  JobNodePool pool_;
+};
+
+/// How a callback argument is kept alive across a deferred delivery.
+/// The default copies the value; `get` yields what the projection sees.
+template <typename T>
+struct DeferredArg {
+  using Held = T;
+  static T const& hold(T const& value) noexcept { return value; }
+  static T const& get(Held const& held) noexcept { return held; }
+};
+
+// PDUs are polymorphic and only constructible through their factories,
+// so they are deep-copied through `copy()` rather than by value.
+// The interface may be destroyed before a deferred call runs, and nothing
+// here owns it; the Swift side identifies the interface itself.
+template <>
+struct DeferredArg<la::avdecc::protocol::ProtocolInterface*> {
+  using Held = std::nullptr_t;
+  static Held hold(la::avdecc::protocol::ProtocolInterface* const&) noexcept {
+    return nullptr;
+  }
+  static la::avdecc::protocol::ProtocolInterface* get(Held) noexcept { return nullptr; }
+};
+
+template <>
+struct DeferredArg<la::avdecc::protocol::Aecpdu> {
+  using Held = std::shared_ptr<la::avdecc::protocol::Aecpdu const>;
+  static Held hold(la::avdecc::protocol::Aecpdu const& pdu) { return pdu.copy(); }
+  static la::avdecc::protocol::Aecpdu const& get(Held const& held) noexcept {
+    return *held;
+  }
+};
+
+template <>
+struct DeferredArg<la::avdecc::protocol::AemAecpdu> {
+  using Held = std::shared_ptr<la::avdecc::protocol::Aecpdu const>;
+  static Held hold(la::avdecc::protocol::AemAecpdu const& pdu) { return pdu.copy(); }
+  static la::avdecc::protocol::AemAecpdu const& get(Held const& held) noexcept {
+    return static_cast<la::avdecc::protocol::AemAecpdu const&>(*held);
+  }
+};
+
+template <>
+struct DeferredArg<la::avdecc::protocol::Adpdu> {
+  using Held = std::shared_ptr<la::avdecc::protocol::Adpdu const>;
+  static Held hold(la::avdecc::protocol::Adpdu const& pdu) { return pdu.copy(); }
+  static la::avdecc::protocol::Adpdu const& get(Held const& held) noexcept {
+    return *held;
+  }
+};
+
+template <>
+struct DeferredArg<la::avdecc::protocol::Acmpdu> {
+  using Held = std::shared_ptr<la::avdecc::protocol::Acmpdu const>;
+  static Held hold(la::avdecc::protocol::Acmpdu const& pdu) { return pdu.copy(); }
+  static la::avdecc::protocol::Acmpdu const& get(Held const& held) noexcept {
+    return *held;
+  }
+};
+
+/// Run `proj(blk, args...)` inline when `shards` is null, otherwise on
+/// the shard for `key` with owned copies of `args`. `proj` must be
+/// captureless: it is copied into the deferred job, and anything it
+/// captured by reference would be gone by the time it runs.
+///
+/// If the copy cannot be made (allocation failure) the callback is
+/// delivered inline instead of dropped.
+template <typename BlockT, typename Project, typename... Args>
+void deliverCallback(std::shared_ptr<CallbackShards> const& shards, uint64_t key,
+                     BlockT const& blk, Project proj, Args const&... args) noexcept {
+  if (shards) {
+    try {
+      shards->submit(key, [blk, proj,
+                           held = std::make_tuple(DeferredArg<Args>::hold(args)...)] {
+        std::apply([&](auto const&... h) { proj(blk, DeferredArg<Args>::get(h)...); },
+                   held);
+      });
+      return;
+    } catch (...) {
+    }
+  }
+  proj(blk, args...);
+}
+
+} // namespace AVDECCSwift
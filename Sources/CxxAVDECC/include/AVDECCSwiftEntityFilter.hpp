@@ -0,0 +1,179 @@
+/*
+ * Copyright (C) 2026, PADL Software Pty Ltd
+ *
+ * This file is part of AVDECCSwift.
+ *
+ * AVDECCSwift is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * AVDECCSwift is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with AVDECCSwift.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+// Change-only filtering for entity updates. la_avdecc raises
+// onRemoteEntityUpdated / onEntityUpdate for every ADP advertisement that
+// differs from the last one, and most differ only in `availableIndex`,
+// which every entity bumps on each advertisement. Each such update made
+// Swift wrap the Entity and re-run its update logic for nothing.
+//
+// EntityUpdateFilter keeps, per entity ID, a 64-bit fingerprint of the
+// fields selected by a mask (taken when the entity comes online and on
+// each forwarded update) and forwards an update only if the fingerprint
+// changed. A mask of 0 turns it off: every update is forwarded and the
+// filter costs one relaxed load.
+#pragma once
+
+#include <atomic>
+#include <cstdint>
+#include <mutex>
+#include <unordered_map>
+
+#include <la/avdecc/internals/entity.hpp>
+
+namespace AVDECCSwift {
+
+/// Field groups compared by EntityUpdateFilter; mirrored by Swift's
+/// `EntityUpdateFields`.
+namespace EntityUpdateField {
+constexpr uint32_t EntityModelID = 1u << 0;
+constexpr uint32_t EntityCapabilities = 1u << 1;
+/// Talker stream sources and capabilities.
+constexpr uint32_t Talker = 1u << 2;
+/// Listener stream sinks and capabilities.
+constexpr uint32_t Listener = 1u << 3;
+constexpr uint32_t ControllerCapabilities = 1u << 4;
+constexpr uint32_t IdentifyControlIndex = 1u << 5;
+constexpr uint32_t AssociationID = 1u << 6;
+/// The set of AVB interfaces and their MAC addresses.
+constexpr uint32_t Interfaces = 1u << 7;
+/// Per-interface gPTP grandmaster ID and domain number.
+constexpr uint32_t Gptp = 1u << 8;
+constexpr uint32_t AvailableIndex = 1u << 9;
+constexpr uint32_t ValidTime = 1u << 10;
+} // namespace EntityUpdateField
+
+class EntityUpdateFilter final {
+public:
+  /// Compare the fields in `mask` (EntityUpdateField bits); 0 forwards
+  /// every update. Changing the mask forgets every fingerprint, so the
+  /// next update of each entity is forwarded.
+  void setMask(uint32_t mask) noexcept {
+    std::lock_guard<std::mutex> lg(lock_);
+    mask_.store(mask, std::memory_order_relaxed);
+    fingerprints_.clear();
+  }
+  uint32_t mask() const noexcept { return mask_.load(std::memory_order_relaxed); }
+
+  /// Entity came online: remember its fields.
+  void seed(la::avdecc::entity::Entity const& entity) noexcept {
+    auto const mask = mask_.load(std::memory_order_relaxed);
+    if (!mask) return;
+    auto const print = fingerprint(entity, mask);
+    std::lock_guard<std::mutex> lg(lock_);
+    if (mask != mask_.load(std::memory_order_relaxed)) return;
+    try {
+      fingerprints_[entity.getEntityID().getValue()] = print;
+    } catch (...) {
+    }
+  }
+
+  /// Entity went offline.
+  void forget(la::avdecc::UniqueIdentifier const entityID) noexcept {
+    if (!mask_.load(std::memory_order_relaxed)) return;
+    std::lock_guard<std::mutex> lg(lock_);
+    fingerprints_.erase(entityID.getValue());
+  }
+
+  /// Whether an update should be forwarded; counts it either way.
+  bool admit(la::avdecc::entity::Entity const& entity) noexcept {
+    auto const mask = mask_.load(std::memory_order_relaxed);
+    if (!mask) {
+      forwarded_.fetch_add(1, std::memory_order_relaxed);
+      return true;
+    }
+    auto const print = fingerprint(entity, mask);
+    bool changed = true;
+    {
+      std::lock_guard<std::mutex> lg(lock_);
+      try {
+        auto const inserted = fingerprints_.emplace(entity.getEntityID().getValue(), print);
+        if (!inserted.second) {
+          changed = inserted.first->second != print;
+          inserted.first->second = print;
+        }
+      } catch (...) {
+      }
+    }
+    (changed ? forwarded_ : suppressed_).fetch_add(1, std::memory_order_relaxed);
+    return changed;
+  }
+
+  uint64_t forwarded() const noexcept { return forwarded_.load(std::memory_order_relaxed); }
+  uint64_t suppressed() const noexcept { return suppressed_.load(std::memory_order_relaxed); }
+
+  /// Fingerprint of the fields of `entity` selected by `mask`.
+  static uint64_t fingerprint(la::avdecc::entity::Entity const& entity, uint32_t mask) noexcept {
+    namespace F = EntityUpdateField;
+    uint64_t h = 0x84222325cbf29ce4ull ^ mask;
+    auto const mix = [&h](uint64_t value) noexcept {
+      h ^= value + 0x9e3779b97f4a7c15ull + (h << 6) + (h >> 2);
+      h *= 0xff51afd7ed558ccdull;
+    };
+    if (mask & F::EntityModelID) mix(entity.getEntityModelID().getValue());
+    if (mask & F::EntityCapabilities) mix(entity.getEntityCapabilities().value());
+    if (mask & F::Talker) {
+      mix(entity.getTalkerStreamSources());
+      mix(entity.getTalkerCapabilities().value());
+    }
+    if (mask & F::Listener) {
+      mix(entity.getListenerStreamSinks());
+      mix(entity.getListenerCapabilities().value());
+    }
+    if (mask & F::ControllerCapabilities) mix(entity.getControllerCapabilities().value());
+    if (mask & F::IdentifyControlIndex) {
+      auto const index = entity.getIdentifyControlIndex();
+      mix(index ? uint64_t{*index} : ~uint64_t{0});
+    }
+    if (mask & F::AssociationID) {
+      auto const association = entity.getAssociationID();
+      mix(association ? association->getValue() : ~uint64_t{0});
+      mix(association.has_value());
+    }
+    if (mask & (F::Interfaces | F::Gptp | F::AvailableIndex | F::ValidTime)) {
+      // std::map: iterated in interface-index order, so equal sets hash
+      // equally.
+      for (auto const& [index, info] : entity.getInterfacesInformation()) {
+        mix(index);
+        if (mask & F::Interfaces) {
+          uint64_t mac = 0;
+          for (auto const byte : info.macAddress) mac = (mac << 8) | byte;
+          mix(mac);
+        }
+        if (mask & F::Gptp) {
+          mix(info.gptpGrandmasterID ? info.gptpGrandmasterID->getValue() : ~uint64_t{0});
+          mix(info.gptpDomainNumber ? uint64_t{*info.gptpDomainNumber} : ~uint64_t{0});
+        }
+        if (mask & F::AvailableIndex) mix(info.availableIndex);
+        if (mask & F::ValidTime) mix(info.validTime);
+      }
+    }
+    return h;
+  }
+
+private:
+  std::atomic<uint32_t> mask_{0};
+  std::mutex lock_;
+  /// Entity ID to the fingerprint of its last forwarded (or online) state.
+  std::unordered_map<uint64_t, uint64_t> fingerprints_;
+  std::atomic<uint64_t> forwarded_{0};
+  std::atomic<uint64_t> suppressed_{0};
+};
+
+} // namespace AVDECCSwift
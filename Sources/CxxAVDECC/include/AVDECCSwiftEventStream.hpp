@@ -0,0 +1,626 @@
+/*
+ * Copyright (C) 2026, PADL Software Pty Ltd
+ *
+ * This file is part of AVDECCSwift.
+ *
+ * AVDECCSwift is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * AVDECCSwift is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with AVDECCSwift.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+// Bounded event streams for the observer / delegate adapters. Swift code
+// that re-posts every callback into an actor pays a hop and an unbounded
+// task per event, and a slow actor grows memory without limit. A stream
+// instead gets each event as a fixed-size CallbackEventRecord copied into
+// its own preallocated ring, which a Swift AsyncSequence drains in
+// chunks:
+//
+//   * the recording thread takes the ring's lock for one record copy and
+//     never waits for the consumer, which holds it only to copy records
+//     out;
+//   * when the ring is full the overflow policy decides: drop the oldest
+//     record, drop the new one, or coalesce it into a queued record for
+//     the same key (slot, entity, and the scalar arguments before the
+//     last);
+//   * the consumer parks on a Swift continuation, woken by one block call
+//     per empty-to-non-empty transition.
+//
+// Records are produced by CallbackEventRecorder, which stands in for the
+// slot's block in an override's projection like the batch and coalesce
+// recorders do, so a stream sees exactly the arguments the block would
+// have. Scalars are stored as words; names, counters, audio mappings and
+// other plain data are copied into the record's payload, and entities and
+// PDUs as fixed summaries. Anything else (AvbInfo, AsPath) is marked
+// omitted.
+#pragma once
+
+#include <algorithm>
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <memory>
+#include <mutex>
+#include <new>
+#include <tuple>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+#include <la/avdecc/internals/entity.hpp>
+#include <la/avdecc/internals/entityModelTypes.hpp>
+#include <la/avdecc/internals/protocolAcmpdu.hpp>
+#include <la/avdecc/internals/protocolAdpdu.hpp>
+#include <la/avdecc/internals/protocolAecpdu.hpp>
+#include <la/avdecc/internals/protocolAemAecpdu.hpp>
+#include <la/avdecc/internals/protocolInterface.hpp>
+
+#include "AVDECCSwiftBlock.hpp"
+#include "AVDECCSwiftDelegateBatch.hpp"
+#include "AVDECCSwiftStatistics.hpp"
+
+namespace AVDECCSwift {
+
+/// Most arguments a recorded event keeps (as many as a delegate block
+/// takes).
+constexpr size_t CallbackEventMaxArgs = DelegateEventMaxArgs;
+/// Bytes of copied argument data per record: 32 counters, or a name plus
+/// change.
+constexpr size_t CallbackEventPayloadCapacity = 160;
+
+/// What a CallbackEventRecord argument word holds. Mirrored by Swift's
+/// `CallbackEvent.Argument`.
+enum class CallbackEventArgKind : uint8_t {
+  /// Not an argument Swift sees (the ProtocolInterface pointer).
+  None = 0,
+  Integer = 1,
+  Boolean = 2,
+  /// AvdeccFixedString bytes in the payload, NUL-padded; the count is in
+  /// bytes.
+  String = 3,
+  /// uint32_t elements in the payload.
+  Counters = 4,
+  /// AudioMapping elements in the payload.
+  Mappings = 5,
+  /// CallbackEventEntity in the payload.
+  Entity = 6,
+  /// CallbackEventAecp in the payload.
+  Aecp = 7,
+  /// CallbackEventAcmp in the payload.
+  Acmp = 8,
+  /// Raw bytes of some other plain-data argument; the count is in bytes.
+  Bytes = 9,
+  /// A null pointer.
+  Null = 10,
+  /// Could not be copied into a record.
+  Omitted = 11,
+};
+
+/// Owned summary of an `Entity` argument.
+struct CallbackEventEntity {
+  uint64_t entityID;
+  uint64_t entityModelID;
+  uint64_t associationID;
+  uint32_t entityCapabilities;
+  uint32_t controllerCapabilities;
+  uint16_t talkerStreamSources;
+  uint16_t talkerCapabilities;
+  uint16_t listenerStreamSinks;
+  uint16_t listenerCapabilities;
+  bool hasAssociationID;
+};
+
+/// Owned summary of an AECP (or AEM AECP) PDU argument.
+struct CallbackEventAecp {
+  uint64_t targetEntityID;
+  uint64_t controllerEntityID;
+  uint16_t sequenceID;
+  /// 0xFFFF unless the PDU is AEM.
+  uint16_t commandType;
+  uint8_t messageType;
+  uint8_t status;
+};
+
+/// Owned summary of an ACMP PDU argument.
+struct CallbackEventAcmp {
+  uint64_t controllerEntityID;
+  uint64_t talkerEntityID;
+  uint64_t listenerEntityID;
+  uint16_t talkerUniqueID;
+  uint16_t listenerUniqueID;
+  uint16_t sequenceID;
+  uint16_t connectionCount;
+  uint16_t flags;
+  uint16_t streamVlanID;
+  uint8_t messageType;
+  uint8_t status;
+};
+
+/// One recorded callback, as queued in a ring and handed to Swift. Plain
+/// data, so a chunk is a flat array.
+struct CallbackEventRecord {
+  /// `steadyNanos()` when recorded.
+  uint64_t timestampNanos;
+  /// The override that raised it, e.g. "onEntityOnline" (a literal).
+  char const* name;
+  /// The entity it concerns (listener for ACMP, 0 for transport errors).
+  uint64_t entityID;
+  uint32_t slotOffset;
+  uint16_t payloadSize;
+  uint8_t argCount;
+  CallbackEventArgKind kinds[CallbackEventMaxArgs];
+  /// Scalars; for payload kinds, the payload offset in the low 32 bits
+  /// and the element count in the high 32.
+  uint64_t args[CallbackEventMaxArgs];
+  alignas(8) uint8_t payload[CallbackEventPayloadCapacity];
+};
+
+/// For Swift: `record->payload` as a pointer (it imports as a tuple).
+inline uint8_t const* callbackEventPayload(CallbackEventRecord const* record) noexcept {
+  return record->payload;
+}
+
+/// How a stream handles an event that finds its ring full.
+enum class CallbackEventOverflow : uint8_t {
+  /// Discard the oldest queued event.
+  DropOldest = 0,
+  /// Discard the new event.
+  DropNewest = 1,
+  /// Overwrite the newest queued event with the same key, else discard
+  /// the oldest. See CallbackEventRing::sameKey.
+  Coalesce = 2,
+};
+
+/// How one block argument of type T is stored in a record.
+template <typename T, typename = void>
+struct CallbackEventArg {
+  static void encode(T const&, size_t, CallbackEventRecord& record, size_t index) noexcept {
+    record.kinds[index] = CallbackEventArgKind::Omitted;
+  }
+};
+
+// Reserve `size` payload bytes aligned for T; nullptr if they do not fit.
+template <typename T>
+T* callbackEventReserve(CallbackEventRecord& record, size_t count, size_t index) noexcept {
+  auto const offset = (size_t{record.payloadSize} + alignof(T) - 1) / alignof(T) * alignof(T);
+  if (offset + count * sizeof(T) > CallbackEventPayloadCapacity) return nullptr;
+  record.payloadSize = static_cast<uint16_t>(offset + count * sizeof(T));
+  record.args[index] = offset | (uint64_t{count} << 32);
+  return reinterpret_cast<T*>(record.payload + offset);
+}
+
+template <typename T>
+struct CallbackEventArg<T, std::enable_if_t<std::is_arithmetic<T>::value ||
+                                            std::is_enum<T>::value>> {
+  static void encode(T value, size_t, CallbackEventRecord& record, size_t index) noexcept {
+    if constexpr (std::is_same<T, bool>::value) {
+      record.kinds[index] = CallbackEventArgKind::Boolean;
+      record.args[index] = value;
+    } else if constexpr (std::is_enum<T>::value) {
+      record.kinds[index] = CallbackEventArgKind::Integer;
+      record.args[index] = static_cast<uint64_t>(static_cast<std::underlying_type_t<T>>(value));
+    } else {
+      record.kinds[index] = CallbackEventArgKind::Integer;
+      record.args[index] = static_cast<uint64_t>(value);
+    }
+  }
+};
+
+template <>
+struct CallbackEventArg<la::avdecc::protocol::ProtocolInterface*> {
+  static void encode(la::avdecc::protocol::ProtocolInterface*, size_t, CallbackEventRecord& record,
+                     size_t index) noexcept {
+    record.kinds[index] = CallbackEventArgKind::None;
+  }
+};
+
+// Plain data: as many of `count` elements as fit, tagged by type.
+template <typename T>
+struct CallbackEventArg<T const*, std::enable_if_t<std::is_trivially_copyable<T>::value>> {
+  static void encode(T const* value, size_t count, CallbackEventRecord& record,
+                     size_t index) noexcept {
+    if (!value) {
+      record.kinds[index] = CallbackEventArgKind::Null;
+      return;
+    }
+    if constexpr (std::is_same<T, uint32_t>::value) {
+      record.kinds[index] = CallbackEventArgKind::Counters;
+    } else if constexpr (std::is_same<T, la::avdecc::entity::model::AudioMapping>::value) {
+      record.kinds[index] = CallbackEventArgKind::Mappings;
+    } else {
+      record.kinds[index] =
+          std::is_same<T, la::avdecc::entity::model::AvdeccFixedString>::value
+              ? CallbackEventArgKind::String
+              : CallbackEventArgKind::Bytes;
+      count *= sizeof(T);
+    }
+    using Element = std::conditional_t<std::is_same<T, uint32_t>::value ||
+                                           std::is_same<T, la::avdecc::entity::model::AudioMapping>::value,
+                                       T, uint8_t>;
+    auto const room = (CallbackEventPayloadCapacity - record.payloadSize) / sizeof(Element);
+    auto const kept = std::min(count, room);
+    auto* const out = callbackEventReserve<Element>(record, kept, index);
+    if (!out) {
+      record.kinds[index] = CallbackEventArgKind::Omitted;
+      return;
+    }
+    if (kept) std::memcpy(out, value, kept * sizeof(Element));
+  }
+};
+
+template <>
+struct CallbackEventArg<la::avdecc::entity::Entity const*> {
+  static void encode(la::avdecc::entity::Entity const* entity, size_t, CallbackEventRecord& record,
+                     size_t index) noexcept {
+    if (!entity) {
+      record.kinds[index] = CallbackEventArgKind::Null;
+      return;
+    }
+    auto* const out = callbackEventReserve<CallbackEventEntity>(record, 1, index);
+    if (!out) {
+      record.kinds[index] = CallbackEventArgKind::Omitted;
+      return;
+    }
+    record.kinds[index] = CallbackEventArgKind::Entity;
+    auto const association = entity->getAssociationID();
+    *out = CallbackEventEntity{
+        entity->getEntityID().getValue(),
+        entity->getEntityModelID().getValue(),
+        association ? association->getValue() : 0,
+        entity->getEntityCapabilities().value(),
+        entity->getControllerCapabilities().value(),
+        entity->getTalkerStreamSources(),
+        entity->getTalkerCapabilities().value(),
+        entity->getListenerStreamSinks(),
+        entity->getListenerCapabilities().value(),
+        association.has_value(),
+    };
+  }
+};
+
+template <typename Pdu>
+struct CallbackEventAecpArg {
+  static void encode(Pdu const* pdu, size_t, CallbackEventRecord& record, size_t index) noexcept {
+    if (!pdu) {
+      record.kinds[index] = CallbackEventArgKind::Null;
+      return;
+    }
+    auto* const out = callbackEventReserve<CallbackEventAecp>(record, 1, index);
+    if (!out) {
+      record.kinds[index] = CallbackEventArgKind::Omitted;
+      return;
+    }
+    record.kinds[index] = CallbackEventArgKind::Aecp;
+    uint16_t commandType = 0xFFFF;
+    if constexpr (std::is_same<Pdu, la::avdecc::protocol::AemAecpdu>::value) {
+      commandType = pdu->getCommandType().getValue();
+    } else if (pdu->getMessageType().getValue() <= 1) {
+      // AEM_COMMAND / AEM_RESPONSE arrive as AemAecpdu behind the base.
+      commandType = static_cast<la::avdecc::protocol::AemAecpdu const*>(pdu)
+                        ->getCommandType()
+                        .getValue();
+    }
+    *out = CallbackEventAecp{
+        pdu->getTargetEntityID().getValue(),
+        pdu->getControllerEntityID().getValue(),
+        pdu->getSequenceID(),
+        commandType,
+        pdu->getMessageType().getValue(),
+        pdu->getStatus().getValue(),
+    };
+  }
+};
+
+template <>
+struct CallbackEventArg<la::avdecc::protocol::Aecpdu const*>
+    : CallbackEventAecpArg<la::avdecc::protocol::Aecpdu> {};
+template <>
+struct CallbackEventArg<la::avdecc::protocol::AemAecpdu const*>
+    : CallbackEventAecpArg<la::avdecc::protocol::AemAecpdu> {};
+
+// No summary for raw ADP taps; the entity ID is the record's key.
+template <>
+struct CallbackEventArg<la::avdecc::protocol::Adpdu const*> {
+  static void encode(la::avdecc::protocol::Adpdu const* pdu, size_t, CallbackEventRecord& record,
+                     size_t index) noexcept {
+    record.kinds[index] = pdu ? CallbackEventArgKind::Omitted : CallbackEventArgKind::Null;
+  }
+};
+
+template <>
+struct CallbackEventArg<la::avdecc::protocol::Acmpdu const*> {
+  static void encode(la::avdecc::protocol::Acmpdu const* pdu, size_t, CallbackEventRecord& record,
+                     size_t index) noexcept {
+    if (!pdu) {
+      record.kinds[index] = CallbackEventArgKind::Null;
+      return;
+    }
+    auto* const out = callbackEventReserve<CallbackEventAcmp>(record, 1, index);
+    if (!out) {
+      record.kinds[index] = CallbackEventArgKind::Omitted;
+      return;
+    }
+    record.kinds[index] = CallbackEventArgKind::Acmp;
+    *out = CallbackEventAcmp{
+        pdu->getControllerEntityID().getValue(),
+        pdu->getTalkerEntityID().getValue(),
+        pdu->getListenerEntityID().getValue(),
+        pdu->getTalkerUniqueID(),
+        pdu->getListenerUniqueID(),
+        pdu->getSequenceID(),
+        pdu->getConnectionCount(),
+        pdu->getFlags().value(),
+        pdu->getStreamVlanID(),
+        pdu->getMessageType().getValue(),
+        pdu->getStatus().getValue(),
+    };
+  }
+};
+
+/// One stream's preallocated ring. Always held by std::shared_ptr: the
+/// adapter's stream list and the Swift-side owner share it.
+class CallbackEventRing final {
+public:
+  /// Called, outside the ring's lock, when an event arrives for a
+  /// consumer that armed the ring, and when the ring is closed.
+  using ReadyBlock = Block<void>;
+
+  /// `depth` records (at least 1) are allocated up front.
+  static std::shared_ptr<CallbackEventRing> create(uint32_t depth, CallbackEventOverflow overflow,
+                                                   ReadyBlock ready) {
+    return std::shared_ptr<CallbackEventRing>(
+        new CallbackEventRing(std::max(depth, 1u), overflow, std::move(ready)));
+  }
+
+  CallbackEventRing(CallbackEventRing const&) = delete;
+  CallbackEventRing& operator=(CallbackEventRing const&) = delete;
+
+  size_t depth() const noexcept { return records_.size(); }
+
+  /// Any thread. Never waits for the consumer.
+  void push(CallbackEventRecord const& record) noexcept {
+    bool wake = false;
+    {
+      std::lock_guard<std::mutex> lg(lock_);
+      if (closed_) return;
+      if (count_ == records_.size()) {
+        switch (overflow_) {
+          case CallbackEventOverflow::DropNewest:
+            dropped_.fetch_add(1, std::memory_order_relaxed);
+            return;
+          case CallbackEventOverflow::Coalesce:
+            if (auto* queued = findSameKey(record)) {
+              *queued = record;
+              coalesced_.fetch_add(1, std::memory_order_relaxed);
+              return;
+            }
+            [[fallthrough]];
+          case CallbackEventOverflow::DropOldest:
+            head_ = (head_ + 1) % records_.size();
+            --count_;
+            dropped_.fetch_add(1, std::memory_order_relaxed);
+            break;
+        }
+      }
+      records_[(head_ + count_) % records_.size()] = record;
+      ++count_;
+      wake = armed_;
+      armed_ = false;
+    }
+    recorded_.fetch_add(1, std::memory_order_relaxed);
+    if (wake && ready_) ready_();
+  }
+
+  /// Consumer. Copies up to `max` records into `out`, oldest first, and
+  /// returns how many.
+  size_t drain(CallbackEventRecord* out, size_t max) noexcept {
+    std::lock_guard<std::mutex> lg(lock_);
+    auto const count = std::min(max, count_);
+    for (size_t i = 0; i < count; ++i) {
+      out[i] = records_[head_];
+      head_ = (head_ + 1) % records_.size();
+    }
+    count_ -= count;
+    return count;
+  }
+
+  /// Consumer, with nothing left to drain: ask for the ready block on the
+  /// next event. Returns false, without arming, if one has arrived since
+  /// or the ring is closed.
+  bool arm() noexcept {
+    std::lock_guard<std::mutex> lg(lock_);
+    if (count_ || closed_) return false;
+    armed_ = true;
+    return true;
+  }
+
+  /// Accept no more events; the consumer drains what is queued, then
+  /// finishes.
+  void close() noexcept {
+    bool wake;
+    {
+      std::lock_guard<std::mutex> lg(lock_);
+      if (closed_) return;
+      closed_ = true;
+      wake = armed_;
+      armed_ = false;
+    }
+    if (wake && ready_) ready_();
+  }
+
+  bool closed() const noexcept {
+    std::lock_guard<std::mutex> lg(lock_);
+    return closed_;
+  }
+
+  /// Events queued, events discarded, and events merged into a queued one.
+  uint64_t recorded() const noexcept { return recorded_.load(std::memory_order_relaxed); }
+  uint64_t dropped() const noexcept { return dropped_.load(std::memory_order_relaxed); }
+  uint64_t coalesced() const noexcept { return coalesced_.load(std::memory_order_relaxed); }
+
+private:
+  CallbackEventRing(uint32_t depth, CallbackEventOverflow overflow, ReadyBlock ready)
+      : records_(depth), overflow_(overflow), ready_(std::move(ready)) {}
+
+  // The key is the slot, the entity, and the integer and boolean
+  // arguments before the last (descriptor indices, operation IDs, ...).
+  // Leading payload arguments, such as a StreamInfo or a mappings list,
+  // only need the same kind: they are values, so a newer one replaces
+  // an older one for the same descriptor.
+  static bool sameKey(CallbackEventRecord const& a, CallbackEventRecord const& b) noexcept {
+    if (a.slotOffset != b.slotOffset || a.entityID != b.entityID || a.argCount != b.argCount) {
+      return false;
+    }
+    for (size_t i = 0; i + 1 < a.argCount; ++i) {
+      if (a.kinds[i] != b.kinds[i]) return false;
+      if (a.kinds[i] == CallbackEventArgKind::Integer ||
+          a.kinds[i] == CallbackEventArgKind::Boolean) {
+        if (a.args[i] != b.args[i]) return false;
+      }
+    }
+    return true;
+  }
+
+  // lock_ held. Newest first, so a burst keeps overwriting the same one.
+  CallbackEventRecord* findSameKey(CallbackEventRecord const& record) noexcept {
+    for (size_t i = count_; i-- > 0;) {
+      auto& queued = records_[(head_ + i) % records_.size()];
+      if (sameKey(queued, record)) return &queued;
+    }
+    return nullptr;
+  }
+
+  std::vector<CallbackEventRecord> records_;
+  CallbackEventOverflow const overflow_;
+  ReadyBlock const ready_;
+
+  mutable std::mutex lock_;
+  size_t head_ = 0;
+  size_t count_ = 0;
+  bool armed_ = false;
+  bool closed_ = false;
+
+  std::atomic<uint64_t> recorded_{0};
+  std::atomic<uint64_t> dropped_{0};
+  std::atomic<uint64_t> coalesced_{0};
+};
+
+/// The streams attached to one adapter. Copy-on-write: the list is
+/// replaced, never changed, so recorders read it without a lock.
+class CallbackEventStreams final {
+public:
+  /// Any thread; one relaxed load.
+  bool active() const noexcept { return active_.load(std::memory_order_relaxed); }
+
+  std::shared_ptr<std::vector<std::shared_ptr<CallbackEventRing>> const> rings() const noexcept {
+    return std::atomic_load_explicit(&rings_, std::memory_order_acquire);
+  }
+
+  void add(std::shared_ptr<CallbackEventRing> ring) {
+    std::lock_guard<std::mutex> lg(writeLock_);
+    auto next = copy();
+    next->push_back(std::move(ring));
+    publish(std::move(next));
+  }
+
+  void remove(CallbackEventRing const* ring) noexcept {
+    std::lock_guard<std::mutex> lg(writeLock_);
+    try {
+      auto next = copy();
+      next->erase(std::remove_if(next->begin(), next->end(),
+                                 [ring](auto const& r) { return r.get() == ring; }),
+                  next->end());
+      publish(std::move(next));
+    } catch (...) {
+    }
+  }
+
+  /// Detach and close every stream.
+  void closeAll() noexcept {
+    std::shared_ptr<std::vector<std::shared_ptr<CallbackEventRing>> const> previous;
+    {
+      std::lock_guard<std::mutex> lg(writeLock_);
+      previous = std::atomic_exchange_explicit(
+          &rings_, std::shared_ptr<std::vector<std::shared_ptr<CallbackEventRing>> const>{},
+          std::memory_order_acq_rel);
+      active_.store(false, std::memory_order_relaxed);
+    }
+    if (previous) {
+      for (auto const& ring : *previous) ring->close();
+    }
+  }
+
+private:
+  std::shared_ptr<std::vector<std::shared_ptr<CallbackEventRing>>> copy() const {
+    auto const current = rings();
+    return current ? std::make_shared<std::vector<std::shared_ptr<CallbackEventRing>>>(*current)
+                   : std::make_shared<std::vector<std::shared_ptr<CallbackEventRing>>>();
+  }
+
+  void publish(std::shared_ptr<std::vector<std::shared_ptr<CallbackEventRing>>> next) noexcept {
+    active_.store(!next->empty(), std::memory_order_relaxed);
+    std::atomic_store_explicit(
+        &rings_, std::shared_ptr<std::vector<std::shared_ptr<CallbackEventRing>> const>(std::move(next)),
+        std::memory_order_release);
+  }
+
+  std::atomic<bool> active_{false};
+  // Accessed only through std::atomic_load/store.
+  std::shared_ptr<std::vector<std::shared_ptr<CallbackEventRing>> const> rings_;
+  std::mutex writeLock_;
+};
+
+/// Stands in for a slot's block in an override's projection while
+/// streams are attached: the call is recorded once and copied into every
+/// stream's ring.
+template <typename BlockT>
+class CallbackEventRecorder;
+
+template <typename... Params>
+class CallbackEventRecorder<Block<void, Params...>> final {
+  static_assert(sizeof...(Params) <= CallbackEventMaxArgs, "too many arguments to record");
+
+public:
+  CallbackEventRecorder(CallbackEventStreams const& streams, char const* name, uint64_t entityID,
+                        uint32_t slotOffset) noexcept
+      : streams_(streams), name_(name), entityID_(entityID), slotOffset_(slotOffset) {}
+
+  void operator()(Params... args) const noexcept {
+    auto const rings = streams_.rings();
+    if (!rings || rings->empty()) return;
+    CallbackEventRecord record;
+    record.timestampNanos = steadyNanos();
+    record.name = name_;
+    record.entityID = entityID_;
+    record.slotOffset = slotOffset_;
+    record.payloadSize = 0;
+    record.argCount = static_cast<uint8_t>(sizeof...(Params));
+    encode(record, std::forward_as_tuple(args...), std::index_sequence_for<Params...>{});
+    for (auto const& ring : *rings) ring->push(record);
+  }
+
+private:
+  template <typename Tuple, size_t... I>
+  static void encode(CallbackEventRecord& record, Tuple const& args,
+                     std::index_sequence<I...>) noexcept {
+    (CallbackEventArg<std::decay_t<std::tuple_element_t<I, Tuple>>>::encode(
+         std::get<I>(args), delegateEventCount<I>(args), record, I),
+     ...);
+  }
+
+  CallbackEventStreams const& streams_;
+  char const* name_;
+  uint64_t entityID_;
+  uint32_t slotOffset_;
+};
+
+} // namespace AVDECCSwift
@@ -0,0 +1,129 @@
+/*
+ * Copyright (C) 2026, PADL Software Pty Ltd
+ *
+ * This file is part of AVDECCSwift.
+ *
+ * AVDECCSwift is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * AVDECCSwift is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with AVDECCSwift.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+// Named target-queue pools for dispatch-backed executors. Every
+// ExecutorOwner creates its own serial queue, and libdispatch by default
+// roots serial queues on the *overcommit* global queue: each one that has
+// work may get its own worker thread, so a process with one executor per
+// NIC (plus callback shards) multiplies threads with the number of
+// interfaces.
+//
+// A pool is `width` serial queues rooted on the non-overcommit global
+// queue, which libdispatch caps at roughly one thread per CPU. Executors
+// joining the pool are `dispatch_set_target_queue`d onto its queues round
+// robin, so:
+//
+//   * at most `width` executors run at once, on a bounded set of threads;
+//   * each executor keeps its own serial queue — queue-specific tags,
+//     flush / terminate barriers and FIFO order are unchanged;
+//   * executors sharing a pool queue are serialised against each other,
+//     which is the price of the bound; size `width` accordingly.
+//
+// That serialisation means a job of one executor cannot dispatch_sync onto
+// a sibling on the same pool queue: the sibling only runs once the job
+// returns. `isCurrent` lets ExecutorOwner detect the case, and its flush /
+// terminate then drain the sibling inline, which is why pooling is limited
+// to the Batched mode.
+#pragma once
+
+#include <algorithm>
+#include <atomic>
+#include <cstdint>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <unordered_map>
+#include <vector>
+
+#include <dispatch/dispatch.h>
+
+namespace AVDECCSwift {
+
+class ExecutorPool final {
+public:
+  /// The process-wide pool called `name`, created on first use with
+  /// `width` queues (0: one per hardware thread). Later callers share the
+  /// existing pool whatever `width` they pass. The pool lives as long as
+  /// one executor (or caller) still holds it.
+  static std::shared_ptr<ExecutorPool> named(std::string const& name,
+                                             uint32_t width) {
+    static std::mutex lock;
+    static std::unordered_map<std::string, std::weak_ptr<ExecutorPool>> pools;
+
+    std::lock_guard<std::mutex> lg(lock);
+    auto& slot = pools[name];
+    if (auto existing = slot.lock()) return existing;
+    auto pool = std::shared_ptr<ExecutorPool>(new ExecutorPool(name, width));
+    slot = pool;
+    return pool;
+  }
+
+  ~ExecutorPool() noexcept {
+    for (auto* queue : targets_) dispatch_release(queue);
+  }
+
+  ExecutorPool(ExecutorPool const&) = delete;
+  ExecutorPool& operator=(ExecutorPool const&) = delete;
+
+  std::string const& name() const noexcept { return name_; }
+  uint32_t width() const noexcept { return static_cast<uint32_t>(targets_.size()); }
+
+  /// Retarget a freshly created (not yet used) queue onto the next pool
+  /// queue, and return that pool queue.
+  dispatch_queue_t adopt(dispatch_queue_t queue) noexcept {
+    auto const index = next_.fetch_add(1, std::memory_order_relaxed) % targets_.size();
+    dispatch_set_target_queue(queue, targets_[index]);
+    return targets_[index];
+  }
+
+  /// Whether the caller is running on `target` (one of our queues),
+  /// directly or through a queue rooted on it.
+  bool isCurrent(dispatch_queue_t target) const noexcept {
+    return target && dispatch_get_specific(this) == target;
+  }
+
+private:
+  ExecutorPool(std::string const& name, uint32_t width) : name_(name) {
+    if (width == 0) width = std::max(1u, std::thread::hardware_concurrency());
+    // Same priority the executors' own queues ask for (USER_INITIATED on
+    // Darwin, the high-priority root queue on swift-corelibs-libdispatch).
+#if __has_include(<sys/qos.h>)
+    auto* root = dispatch_get_global_queue(QOS_CLASS_USER_INITIATED, 0);
+#else
+    auto* root = dispatch_get_global_queue(DISPATCH_QUEUE_PRIORITY_HIGH, 0);
+#endif
+    targets_.reserve(width);
+    for (uint32_t i = 0; i < width; ++i) {
+      auto const label = name + "." + std::to_string(i);
+      dispatch_queue_attr_t attr = DISPATCH_QUEUE_SERIAL;
+      auto* queue = dispatch_queue_create(label.c_str(), attr);
+      dispatch_set_target_queue(queue, root);
+      // Looked up through the hierarchy by isCurrent.
+      dispatch_queue_set_specific(queue, this, queue, nullptr);
+      targets_.push_back(queue);
+    }
+  }
+
+  std::string name_;
+  std::vector<dispatch_queue_t> targets_;
+  std::atomic<uint32_t> next_{0};
+};
+
+} // namespace AVDECCSwift
@@ -0,0 +1,284 @@
+/*
+ * Copyright (C) 2026, PADL Software Pty Ltd
+ *
+ * This file is part of AVDECCSwift.
+ *
+ * AVDECCSwift is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * AVDECCSwift is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with AVDECCSwift.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+// Flight recorder: la_avdecc log items appended as compact binary records
+// to a fixed-size circular file that is mmap'd MAP_SHARED. The pages
+// belong to the file, not the process, so whatever was written survives
+// a crash and can be decoded afterwards (avdecc-flightrecorder-decode).
+//
+// File layout (native endianness, decoded on the same architecture):
+//
+//   [0, DataOffset)            FlightRecorderHeader
+//   [DataOffset, +capacity)    circular data area
+//
+// A record is RecordHeader followed by the message, padded to 8 bytes.
+// Writers reserve space with one fetch_add on `head` (wait-free where the
+// CPU has an atomic add), copy the record in, wrapping at the end of the
+// data area, and publish it by storing its logical position into its
+// first word last. The reader starts at the oldest position still in the
+// buffer and accepts a record only if its first word equals the position
+// it was found at: records from earlier laps, torn writes and the middle
+// of a record all fail that check, and the reader then resynchronises 8
+// bytes further on.
+//
+// A writer lapped by the others while still copying can corrupt a newer
+// record; that costs records, never the file's readability.
+#pragma once
+
+#include <algorithm>
+#include <atomic>
+#include <cerrno>
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <new>
+#include <string>
+#include <system_error>
+
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+namespace AVDECCSwift {
+
+struct FlightRecorderHeader {
+  static constexpr char Magic[8] = {'A', 'V', 'D', 'F', 'L', 'R', 'E', 'C'};
+  static constexpr uint32_t CurrentVersion = 1;
+  /// Data area offset; one page, so the data area is page aligned.
+  static constexpr uint64_t DataOffset = 4096;
+
+  char magic[8];
+  uint32_t version;
+  uint32_t dataOffset;
+  /// Bytes in the data area; a multiple of 8.
+  uint64_t capacity;
+  /// A steady-clock reading and the wall-clock time taken with it, so
+  /// record timestamps can be shown as dates.
+  uint64_t openedSteadyNanos;
+  uint64_t openedRealtimeNanos;
+  uint64_t pid;
+  /// Logical bytes reserved since the file was opened; the next record
+  /// starts at `head % capacity`.
+  alignas(64) std::atomic<uint64_t> head;
+};
+
+static_assert(sizeof(FlightRecorderHeader) <= FlightRecorderHeader::DataOffset,
+              "header must fit before the data area");
+static_assert(std::atomic<uint64_t>::is_always_lock_free,
+              "head is shared through the file and must be lock free");
+
+struct FlightRecorderRecord {
+  /// Logical position of this record; written last, with release.
+  uint64_t position;
+  uint64_t timestampNanos;
+  /// Record bytes including this header and padding.
+  uint32_t size;
+  uint16_t messageSize;
+  uint8_t level;
+  uint8_t layer;
+};
+
+static_assert(sizeof(FlightRecorderRecord) == 24, "record header layout");
+
+class FlightRecorder final {
+public:
+  /// Longest message stored; longer ones are cut.
+  static constexpr size_t MaxMessageSize = 1024;
+
+  /// Create (or truncate) `path` with a `capacity`-byte data area,
+  /// rounded up to a page, and map it. Throws std::system_error.
+  FlightRecorder(std::string const& path, uint64_t capacity, uint64_t steadyNanos,
+                 uint64_t realtimeNanos) {
+    auto const page = static_cast<uint64_t>(sysconf(_SC_PAGESIZE));
+    capacity = std::max<uint64_t>(capacity, page);
+    capacity = (capacity + page - 1) / page * page;
+    length_ = FlightRecorderHeader::DataOffset + capacity;
+
+    auto const fd = ::open(path.c_str(), O_RDWR | O_CREAT | O_TRUNC | O_CLOEXEC, 0644);
+    if (fd < 0) throw std::system_error(errno, std::generic_category(), path);
+    if (::ftruncate(fd, static_cast<off_t>(length_)) != 0) {
+      auto const error = errno;
+      ::close(fd);
+      throw std::system_error(error, std::generic_category(), path);
+    }
+    auto* const base = ::mmap(nullptr, length_, PROT_READ | PROT_WRITE, MAP_SHARED, fd, 0);
+    auto const error = errno;
+    ::close(fd);
+    if (base == MAP_FAILED) throw std::system_error(error, std::generic_category(), path);
+
+    base_ = static_cast<uint8_t*>(base);
+    header_ = new (base_) FlightRecorderHeader{};
+    std::memcpy(header_->magic, FlightRecorderHeader::Magic, sizeof(header_->magic));
+    header_->version = FlightRecorderHeader::CurrentVersion;
+    header_->dataOffset = static_cast<uint32_t>(FlightRecorderHeader::DataOffset);
+    header_->capacity = capacity;
+    header_->openedSteadyNanos = steadyNanos;
+    header_->openedRealtimeNanos = realtimeNanos;
+    header_->pid = static_cast<uint64_t>(::getpid());
+    header_->head.store(0, std::memory_order_release);
+    data_ = base_ + FlightRecorderHeader::DataOffset;
+    capacity_ = capacity;
+  }
+
+  ~FlightRecorder() noexcept {
+    ::msync(base_, length_, MS_ASYNC);
+    ::munmap(base_, length_);
+  }
+
+  FlightRecorder(FlightRecorder const&) = delete;
+  FlightRecorder& operator=(FlightRecorder const&) = delete;
+
+  uint64_t capacity() const noexcept { return capacity_; }
+  uint64_t bytesWritten() const noexcept {
+    return header_->head.load(std::memory_order_relaxed);
+  }
+  uint64_t records() const noexcept { return records_.load(std::memory_order_relaxed); }
+
+  /// Any thread; never waits.
+  void append(uint8_t level, uint8_t layer, uint64_t timestampNanos, char const* data,
+              size_t size) noexcept {
+    auto const messageSize = std::min(size, MaxMessageSize);
+    auto const recordSize = (sizeof(FlightRecorderRecord) + messageSize + 7) & ~size_t{7};
+    auto const position = header_->head.fetch_add(recordSize, std::memory_order_relaxed);
+
+    FlightRecorderRecord record{};
+    record.position = ~position; // not yet published
+    record.timestampNanos = timestampNanos;
+    record.size = static_cast<uint32_t>(recordSize);
+    record.messageSize = static_cast<uint16_t>(messageSize);
+    record.level = level;
+    record.layer = layer;
+    write(position, &record, sizeof(record));
+    if (messageSize) write(position + sizeof(record), data, messageSize);
+
+    // Positions are 8-aligned and so is the data area, so the first word
+    // never straddles the wrap point.
+    reinterpret_cast<std::atomic<uint64_t>*>(data_ + position % capacity_)
+        ->store(position, std::memory_order_release);
+    records_.fetch_add(1, std::memory_order_relaxed);
+  }
+
+private:
+  void write(uint64_t position, void const* bytes, size_t size) noexcept {
+    auto const offset = position % capacity_;
+    auto const first = std::min<uint64_t>(size, capacity_ - offset);
+    std::memcpy(data_ + offset, bytes, first);
+    if (first < size) {
+      std::memcpy(data_, static_cast<uint8_t const*>(bytes) + first, size - first);
+    }
+  }
+
+  uint8_t* base_ = nullptr;
+  FlightRecorderHeader* header_ = nullptr;
+  uint8_t* data_ = nullptr;
+  uint64_t capacity_ = 0;
+  size_t length_ = 0;
+  std::atomic<uint64_t> records_{0};
+};
+
+/// Reads a flight-recorder image (a mapped or copied file) oldest record
+/// first. Used by the decoder tool; safe on a file still being written,
+/// in which case records being overwritten are skipped.
+class FlightRecorderReader final {
+public:
+  struct Record {
+    uint64_t timestampNanos;
+    uint8_t level;
+    uint8_t layer;
+    std::string message;
+  };
+
+  /// `image` / `size` cover the whole file. Returns false (with `error`
+  /// set) if it is not a flight-recorder file of this version.
+  bool open(uint8_t const* image, size_t size, std::string& error) {
+    if (size < FlightRecorderHeader::DataOffset) {
+      error = "file too short";
+      return false;
+    }
+    header_ = reinterpret_cast<FlightRecorderHeader const*>(image);
+    if (std::memcmp(header_->magic, FlightRecorderHeader::Magic, sizeof(header_->magic)) != 0) {
+      error = "not a flight-recorder file";
+      return false;
+    }
+    if (header_->version != FlightRecorderHeader::CurrentVersion) {
+      error = "unsupported version " + std::to_string(header_->version);
+      return false;
+    }
+    if (header_->capacity == 0 || header_->capacity % 8) {
+      error = "invalid capacity " + std::to_string(header_->capacity);
+      return false;
+    }
+    // Compared against what is left after the offset so neither sum can wrap.
+    if (header_->dataOffset > size || header_->capacity > size - header_->dataOffset) {
+      error = "truncated data area";
+      return false;
+    }
+    data_ = image + header_->dataOffset;
+    capacity_ = header_->capacity;
+    end_ = header_->head.load(std::memory_order_acquire);
+    position_ = end_ > capacity_ ? end_ - capacity_ : 0;
+    return true;
+  }
+
+  FlightRecorderHeader const& header() const noexcept { return *header_; }
+
+  /// Next intact record, or false at the end.
+  bool next(Record& out) {
+    while (position_ + sizeof(FlightRecorderRecord) <= end_) {
+      FlightRecorderRecord record;
+      read(position_, &record, sizeof(record));
+      if (record.position != position_ || record.size < sizeof(record) ||
+          record.size % 8 || record.size > capacity_ || position_ + record.size > end_ ||
+          sizeof(record) + record.messageSize > record.size) {
+        skipped_ += 8;
+        position_ += 8;
+        continue;
+      }
+      out.timestampNanos = record.timestampNanos;
+      out.level = record.level;
+      out.layer = record.layer;
+      out.message.resize(record.messageSize);
+      read(position_ + sizeof(record), &out.message[0], record.messageSize);
+      position_ += record.size;
+      return true;
+    }
+    return false;
+  }
+
+  /// Bytes passed over while resynchronising.
+  uint64_t skippedBytes() const noexcept { return skipped_; }
+
+private:
+  void read(uint64_t position, void* bytes, size_t size) const noexcept {
+    auto const offset = position % capacity_;
+    auto const first = std::min<uint64_t>(size, capacity_ - offset);
+    std::memcpy(bytes, data_ + offset, first);
+    if (first < size) std::memcpy(static_cast<uint8_t*>(bytes) + first, data_, size - first);
+  }
+
+  FlightRecorderHeader const* header_ = nullptr;
+  uint8_t const* data_ = nullptr;
+  uint64_t capacity_ = 0;
+  uint64_t position_ = 0;
+  uint64_t end_ = 0;
+  uint64_t skipped_ = 0;
+};
+
+} // namespace AVDECCSwift
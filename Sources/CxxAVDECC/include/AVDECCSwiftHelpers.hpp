@@ -33,17 +33,32 @@
 //     per signature shape, not per la_avdecc method).
 #pragma once
 
+#include <algorithm>
+#include <array>
 #include <atomic>
+#include <cerrno>
+#include <chrono>
+#include <condition_variable>
 #include <cstdint>
 #include <functional>
+#include <future>
 #include <memory>
 #include <mutex>
 #include <stdexcept>
 #include <string>
+#include <system_error>
 #include <thread>
+#include <unordered_map>
 #include <utility>
 
 #include <dispatch/dispatch.h>
+#include <pthread.h>
+#include <sched.h>
+#include <sys/resource.h>
+#if defined(__linux__)
+#  include <sys/syscall.h>
+#  include <unistd.h>
+#endif
 
 #include <la/avdecc/executor.hpp>
 #include <la/avdecc/logger.hpp>
@@ -51,6 +66,22 @@
 #include <la/avdecc/internals/protocolInterface.hpp>
 
 #include "AVDECCSwiftBlock.hpp"
+#include "AVDECCSwiftDelegateBatch.hpp"
+#include "AVDECCSwiftDelegateCoalesce.hpp"
+#include "AVDECCSwiftDelivery.hpp"
+#include "AVDECCSwiftEntityFilter.hpp"
+#include "AVDECCSwiftEventStream.hpp"
+#include "AVDECCSwiftExecutorPool.hpp"
+#include "AVDECCSwiftFlightRecorder.hpp"
+#include "AVDECCSwiftJobQueue.hpp"
+#include "AVDECCSwiftLogRing.hpp"
+#include "AVDECCSwiftLogThrottle.hpp"
+#include "AVDECCSwiftPduCapture.hpp"
+#include "AVDECCSwiftPduFilter.hpp"
+#include "AVDECCSwiftPduReplay.hpp"
+#include "AVDECCSwiftSlotProfile.hpp"
+#include "AVDECCSwiftSlotTable.hpp"
+#include "AVDECCSwiftStatistics.hpp"
 
 // Inlined excerpt from `<swift/bridging>` (Swift toolchain header). We can't
 // rely on Swift's include directory being on the C++ search path since
@@ -170,6 +201,148 @@ void AVDECCSwift_ExecutorOwner_release(AVDECCSwift::ExecutorOwner* p) noexcept;
 
 namespace AVDECCSwift {
 
+/// Executor flavours selectable through `ExecutorOptions::mode`. Crosses
+/// to Swift as a raw `uint8_t` (mirrored by `Executor.Mode`).
+enum class ExecutorMode : uint8_t {
+  /// One `dispatch_async` (and one block + shared_ptr allocation) per
+  /// la_avdecc job. The original proxy; still the default.
+  Dispatch = 0,
+  /// Jobs are pushed onto a lock-free MPSC queue owned by DispatchState.
+  /// A single drain block is scheduled only when the queue goes from
+  /// empty to non-empty, and runs queued jobs back-to-back. Amortises the
+  /// per-job dispatch cost during ADP storms / bulk enumeration.
+  Batched = 1,
+  /// One owned std::thread drains the same MPSC queue, sleeping on a
+  /// condvar only when it runs dry. Reports its real id from
+  /// `getExecutorThread()` (so la_avdecc's inline wait short-circuit
+  /// fires) and can be pinned / given a realtime priority.
+  Thread = 2,
+};
+
+/// Priority lanes for queued executor work. Each lane is its own FIFO;
+/// the drain prefers Interactive (see
+/// `ExecutorOptions::interactiveBurstLimit`). Untagged work — including
+/// everything la_avdecc pushes from its capture threads, and from jobs
+/// already running — is Bulk, so the relative order of la_avdecc's own
+/// jobs is unchanged. The one exception is work queued while a received
+/// ACMP PDU is being handled (see `promoteRunningJob`).
+enum class ExecutorLane : uint8_t {
+  Bulk = 0,
+  Interactive = 1,
+};
+
+constexpr size_t ExecutorLaneCount = 2;
+
+/// Lane that jobs pushed from this thread land on. Set around a call by
+/// `ExecutorOwner::setCurrentLane` (Swift `Executor.withLane`). The drain
+/// resets it to Bulk for each job it runs, whatever lane the job itself
+/// came from: a job's follow-up work keeps FIFO order with everything
+/// else la_avdecc queued, unless `promoteRunningJob` says otherwise.
+inline thread_local uint8_t currentExecutorLane =
+    static_cast<uint8_t>(ExecutorLane::Bulk);
+
+/// True while this thread is running one of our executors' jobs.
+inline thread_local bool runningExecutorJob = false;
+
+/// Queue the rest of the running job's follow-up work on `lane`. Called
+/// from the receive path once a PDU is known to warrant it (ACMP), which
+/// is as early as the lane can be chosen: la_avdecc queues the receive
+/// job itself before anything has parsed the frame. No-op outside a job.
+inline void promoteRunningJob(ExecutorLane lane) noexcept {
+  if (runningExecutorJob) currentExecutorLane = static_cast<uint8_t>(lane);
+}
+
+/// What the stall watchdog can see of the job an executor is running.
+/// Single writer (the executor); the watchdog timer only reads. The start
+/// stamp is stored last with release, so a reader that sees it also sees
+/// the matching `sequence`.
+struct RunningJobRecord {
+  /// `steadyNanos()` at job start; 0 while idle.
+  std::atomic<uint64_t> startedAt{0};
+  std::atomic<uint64_t> sequence{0};
+  /// Static string naming the delegate slot / command handler the job most
+  /// recently entered; nullptr if it never reached one of ours.
+  std::atomic<char const*> site{nullptr};
+};
+
+/// Record of the job running on this thread, if its executor has a stall
+/// watchdog; nullptr otherwise.
+inline thread_local RunningJobRecord* currentRunningJob = nullptr;
+
+/// Executor state whose jobs this thread is draining outside the
+/// executor's own queue (a flush from a pooled sibling); nullptr otherwise.
+inline thread_local void const* inlineDrainingExecutor = nullptr;
+
+/// Attribute the running job (if watched) to `site`, which must outlive
+/// the executor — in practice a `__builtin_FUNCTION()` / literal.
+inline void markJobSite(char const* site) noexcept {
+  if (auto* job = currentRunningJob) job->site.store(site, std::memory_order_relaxed);
+}
+
+/// Construction options for `ExecutorOwner::create`. A plain aggregate so
+/// Swift can fill it in field by field; the defaults reproduce the
+/// original single-`create(name)` behaviour.
+struct ExecutorOptions {
+  /// `ExecutorMode` raw value.
+  uint8_t mode = static_cast<uint8_t>(ExecutorMode::Dispatch);
+  /// Batched mode only: jobs one drain block runs before re-queueing
+  /// itself behind whatever else was submitted to the dispatch queue in
+  /// the meantime (flush/terminate barriers in particular). 0 = drain
+  /// until empty.
+  uint32_t drainBatchLimit = 64;
+  /// Batched/Thread modes: consecutive Interactive-lane jobs the drain may
+  /// run while Bulk work is waiting before letting one Bulk job through.
+  /// 0 = strict priority (Bulk runs only when Interactive is empty).
+  /// Dispatch mode has a single FIFO; lanes there only split statistics.
+  uint32_t interactiveBurstLimit = 16;
+  /// Thread mode only: CPUs (bit i = CPU i) the executor thread may run
+  /// on. 0 leaves the inherited affinity. Linux only; rejected elsewhere.
+  uint64_t cpuAffinityMask = 0;
+  /// Thread mode only: if non-zero, run the thread under SCHED_FIFO at
+  /// this priority. Usually needs CAP_SYS_NICE / an rtprio rlimit.
+  int32_t schedFifoPriority = 0;
+  /// Thread mode only: if `setNice`, apply `nice` to the executor thread
+  /// (Linux per-thread nice; rejected elsewhere).
+  bool setNice = false;
+  int32_t nice = 0;
+  /// If non-zero, run a stall watchdog: a timer off the executor that
+  /// reports (via la_avdecc's Logger and `ExecutorOwner::setOnStall`) any
+  /// single job running longer than this.
+  uint32_t stallThresholdMs = 0;
+  /// Batched mode only: if non-empty, root the executor's queue on the
+  /// process-wide ExecutorPool of this name (created with
+  /// `targetPoolWidth` queues, 0 = one per hardware thread) instead of
+  /// giving it its own worker thread. Rejected in the other modes: see
+  /// DispatchState::drainFromForeignThread for why it must be Batched.
+  std::string targetPool;
+  uint32_t targetPoolWidth = 0;
+};
+
+/// Logger item carrying a preformatted message: stall reports, and
+/// items emitted from Swift through `emitLogItem`. Routed to Swift
+/// through LoggerOwner like any other la_avdecc log line.
+class MessageLogItem final : public la::avdecc::logger::LogItem {
+public:
+  MessageLogItem(la::avdecc::logger::Layer layer, std::string message) noexcept
+      : LogItem(layer), message_(std::move(message)) {}
+
+  std::string getMessage() const noexcept override { return message_; }
+
+private:
+  std::string message_;
+};
+
+/// Log `message` through la_avdecc's Logger at `level` on `layer`, so it
+/// reaches every observer as if la_avdecc had emitted it. Subject to the
+/// global level, like la_avdecc's own log sites.
+inline void emitLogItem(uint8_t level, uint8_t layer, std::string message) noexcept {
+  auto& logger = la::avdecc::logger::Logger::getInstance();
+  auto const itemLevel = static_cast<la::avdecc::logger::Level>(level);
+  if (itemLevel < logger.getLevel()) return;
+  MessageLogItem item(static_cast<la::avdecc::logger::Layer>(layer), std::move(message));
+  logger.logItem(itemLevel, &item);
+}
+
 /// Owns a libdispatch-backed la_avdecc executor + ExecutorManager
 /// registration. Necessary because none of la_avdecc's executor classes
 /// (Executor, ExecutorManager, ExecutorProxy) reach Swift's C++ importer —
@@ -186,7 +359,12 @@ namespace AVDECCSwift {
 /// Contract notes for the four ExecutorProxy entry points:
 ///  - `pushJob`/`flush`/`terminate` map cleanly onto dispatch_async /
 ///    dispatch_sync. The serial queue gives us the FIFO drain order the
-///    Executor interface promises.
+///    Executor interface promises. In `ExecutorMode::Batched` the FIFO is
+///    the MPSC job queue instead, drained in order by one block at a time
+///    on the same serial queue, so the promise is unchanged.
+///  - `ExecutorMode::Thread` swaps the dispatch queue for one owned
+///    thread draining the MPSC queue; it is the exception to the next
+///    point, since it has a tid to report (see makeThreadProxy).
 ///  - `getExecutorThread()` returns the empty `std::thread::id{}`. The
 ///    Executor interface uses this only to short-circuit re-entrant
 ///    `ExecutorManager::waitJobResponse` and
@@ -215,6 +393,8 @@ namespace AVDECCSwift {
 class SWIFT_SHARED_REFERENCE(AVDECCSwift_ExecutorOwner_retain,
                              AVDECCSwift_ExecutorOwner_release)
     ExecutorOwner final : public IntrusiveReferenceCounted<ExecutorOwner> {
+  using Job = la::avdecc::Executor::Job;
+
 public:
   /// On failure, fills `outErr` with the captured exception (typed code
   /// if from the ProtocolInterface::Exception hierarchy, otherwise
@@ -225,8 +405,54 @@ public:
   SWIFT_RETURNS_RETAINED
   static ExecutorOwner* create(std::string const& name,
                                CapturedException& outErr) noexcept {
+    return create(name, ExecutorOptions{}, outErr);
+  }
+
+  /// As above, with an explicit executor flavour. Unknown `mode` values
+  /// are rejected as InvalidParameters rather than silently falling back.
+  /// In Thread mode a failure to apply the affinity / scheduling options
+  /// (typically EPERM for SCHED_FIFO) fails the create with the errno
+  /// text in `message`; no half-configured thread is left running.
+  SWIFT_RETURNS_RETAINED
+  static ExecutorOwner* create(std::string const& name,
+                               ExecutorOptions const& options,
+                               CapturedException& outErr) noexcept {
     return invokeCapturingException(outErr, [&]() -> ExecutorOwner* {
+      auto const mode = static_cast<ExecutorMode>(options.mode);
+      if (mode != ExecutorMode::Dispatch && mode != ExecutorMode::Batched &&
+          mode != ExecutorMode::Thread) {
+        throw la::avdecc::protocol::ProtocolInterface::Exception(
+            la::avdecc::protocol::ProtocolInterface::Error::InvalidParameters,
+            "Unknown ExecutorMode");
+      }
+
+      if (mode != ExecutorMode::Batched && !options.targetPool.empty()) {
+        throw la::avdecc::protocol::ProtocolInterface::Exception(
+            la::avdecc::protocol::ProtocolInterface::Error::InvalidParameters,
+            "targetPool requires ExecutorMode::Batched");
+      }
+
       auto state = std::make_shared<DispatchState>();
+      state->mode = mode;
+      state->drainBatchLimit = options.drainBatchLimit;
+      state->interactiveBurstLimit = options.interactiveBurstLimit;
+      state->name = name;
+      state->stallThresholdNanos = uint64_t{options.stallThresholdMs} * 1000000u;
+
+      if (mode == ExecutorMode::Thread) {
+        // The thread must exist before registerExecutor: ExecutorManager
+        // snapshots getExecutorThread() exactly once, at registration.
+        startThread(state, name, options);
+        try {
+          auto wrapper = la::avdecc::ExecutorManager::getInstance()
+              .registerExecutor(name, makeThreadProxy(state));
+          startWatchdog(state);
+          return new ExecutorOwner(name, options, std::move(wrapper), std::move(state));
+        } catch (...) {
+          state->terminate(/*flushJobs*/ false);
+          throw;
+        }
+      }
 
       // Darwin: USER_INITIATED matches the prior
       // ExecutorWithDispatchQueue::create(..., ThreadPriority::Highest)
@@ -243,6 +469,12 @@ public:
       dispatch_queue_attr_t attr = DISPATCH_QUEUE_SERIAL;
 #endif
       state->queue = dispatch_queue_create(name.c_str(), attr);
+      if (!options.targetPool.empty()) {
+        // Before anything is submitted: the queue is still idle, so the
+        // retarget takes effect for its first job.
+        state->targetPool = ExecutorPool::named(options.targetPool, options.targetPoolWidth);
+        state->poolTarget = state->targetPool->adopt(state->queue);
+      }
 
       // Tag the queue with a key whose value is the state pointer. Lambdas
       // use `dispatch_get_specific(key) == key` to detect "am I currently
@@ -251,69 +483,47 @@ public:
       dispatch_queue_set_specific(state->queue, state.get(), state.get(),
                                   nullptr);
 
-      using Job = la::avdecc::Executor::Job;
-
-      auto pushJobProxy = [state](Job&& job) noexcept {
-        // Serialize against flush/terminate via enqueueLock — mirrors
-        // ExecutorWithDispatchQueueImpl::pushJob. Without the lock, a
-        // pushJob racing with terminate(true) could land a block onto the
-        // queue after terminate's drain returned, leaving a stray block
-        // referencing la_avdecc captures whose lifetime is ending.
-        std::lock_guard<std::mutex> lg(state->enqueueLock);
-        if (state->terminated.load(std::memory_order_acquire)) return;
-        // Block captures are by-value-copy; std::function is copyable but
-        // boxing in a shared_ptr avoids re-copying the job target.
-        auto sharedJob = std::make_shared<Job>(std::move(job));
-        dispatch_async(state->queue, ^{
-          // In-block check covers terminate(flushJobs=false): the drain
-          // doesn't run, so already-queued blocks must bail at the head
-          // rather than execute against a torn-down la_avdecc.
-          if (state->terminated.load(std::memory_order_acquire)) return;
-          la::avdecc::utils::invokeProtectedHandler(*sharedJob);
-        });
-      };
-
-      auto flushProxy = [state]() noexcept {
-        // Serial-queue ordering already guarantees prior jobs are complete
-        // by the time *this* job runs, so a flush-from-job is a no-op (and
-        // dispatch_sync onto our own queue would deadlock).
-        if (dispatch_get_specific(state.get()) == state.get()) return;
-        // Hold the enqueueLock across the drain so concurrent pushJobs
-        // block until the queue is empty — matches the original
-        // ExecutorWithDispatchQueueImpl::flush semantics.
-        std::lock_guard<std::mutex> lg(state->enqueueLock);
-        dispatch_sync(state->queue, ^{});
-      };
-
-      auto terminateProxy = [state](bool flushJobs) noexcept {
-        std::lock_guard<std::mutex> lg(state->enqueueLock);
-        if (flushJobs &&
-            dispatch_get_specific(state.get()) != state.get()) {
-          dispatch_sync(state->queue, ^{});
-        }
-        // Set terminated last: pushJob (locked-out above) sees this on
-        // the next acquire and silently drops, and any blocks still in
-        // the queue (only possible with flushJobs=false) bail at the
-        // in-block check above.
-        state->terminated.store(true, std::memory_order_release);
-      };
-
-      // See class comment: returning {} disables the inline short-circuit
-      // in waitJobResponse / runJobOnExecutorAndWait. ExecutorManager
-      // snapshots this once at registration anyway, so a per-job cache
-      // would be ignored.
-      auto getThreadProxy = []() noexcept -> std::thread::id {
-        return std::thread::id{};
-      };
-
-      auto exec = la::avdecc::ExecutorProxy::create(
-          pushJobProxy, flushProxy, terminateProxy, getThreadProxy);
+      auto exec = mode == ExecutorMode::Batched ? makeBatchedProxy(state)
+                                                : makeDispatchProxy(state);
       auto wrapper = la::avdecc::ExecutorManager::getInstance()
           .registerExecutor(name, std::move(exec));
-      return new ExecutorOwner(name, std::move(wrapper), std::move(state));
+      // Only once registered: a failed create must leave no timer behind.
+      startWatchdog(state);
+      return new ExecutorOwner(name, options, std::move(wrapper), std::move(state));
     });
   }
 
+  /// The process-wide executor registered as `name`. The first call
+  /// creates and registers it with `options`; later calls return the same
+  /// owner whatever options they pass, until it is closed, after which the
+  /// next call brings up a fresh one. This is what lets the Swift layer
+  /// defer ExecutorManager registration to the first ProtocolInterface
+  /// instead of doing it in a static initialiser.
+  ///
+  /// The registry holds its reference for the life of the process and
+  /// never releases it at exit, so no executor teardown runs from
+  /// __cxa_finalize behind la_avdecc's own static destructors.
+  SWIFT_RETURNS_RETAINED
+  static ExecutorOwner* shared(std::string const& name,
+                               ExecutorOptions const& options,
+                               CapturedException& outErr) noexcept {
+    static std::mutex lock;
+    static auto* owners = new std::unordered_map<std::string, ExecutorOwner*>();
+
+    std::lock_guard<std::mutex> lg(lock);
+    auto& slot = (*owners)[name];
+    if (slot && !slot->isOpen()) {
+      AVDECCSwift_ExecutorOwner_release(slot);
+      slot = nullptr;
+    }
+    if (!slot) {
+      slot = create(name, options, outErr);
+      if (!slot) return nullptr;
+    }
+    AVDECCSwift_ExecutorOwner_retain(slot);
+    return slot;
+  }
+
   /// Idempotent early teardown. Drains and terminates the la_avdecc
   /// executor (so any blocks already on the queue finish before
   /// la_avdecc's higher-level objects can tear down their captures),
@@ -327,34 +537,484 @@ public:
   /// which it has by the time this function returns.
   void close() noexcept {
     if (state_ && !state_->terminated.load(std::memory_order_acquire)) {
-      std::lock_guard<std::mutex> lg(state_->enqueueLock);
-      if (dispatch_get_specific(state_.get()) != state_.get()) {
-        dispatch_sync(state_->queue, ^{});
-      }
-      state_->terminated.store(true, std::memory_order_release);
+      state_->terminate(/*flushJobs*/ true);
     }
     wrapper_.reset();
   }
 
   std::string const& name() const noexcept { return name_; }
 
+  /// The options this executor was created with.
+  ExecutorOptions const& options() const noexcept { return options_; }
+
+  /// False once `close()` has run.
+  bool isOpen() const noexcept { return static_cast<bool>(wrapper_); }
+
+  uint8_t mode() const noexcept {
+    return state_ ? static_cast<uint8_t>(state_->mode) : 0u;
+  }
+
+  /// Width of the ExecutorPool this executor's queue is rooted on; 0 if it
+  /// has a queue of its own.
+  uint32_t targetPoolWidth() const noexcept {
+    return state_ && state_->targetPool ? state_->targetPool->width() : 0u;
+  }
+
+  /// Snapshot of the executor's queue-depth / latency counters. Cheap
+  /// (relaxed loads only) and safe from any thread, including after
+  /// close(). Rates are left to the reader: two snapshots' `jobsCompleted`
+  /// and `uptimeNanos` give one over whatever interval it polls at.
+  ExecutorStatistics statistics() const noexcept {
+    ExecutorStatistics out;
+    if (!state_) return out;
+    state_->counters.copyTo(out);
+    out.stalls = state_->stalls.load(std::memory_order_relaxed);
+    out.jobNodeAcquisitions = state_->pool.acquisitions();
+    out.jobNodeHeapAllocations = state_->pool.heapAllocations();
+    out.jobNodePoolCapacity = state_->pool.capacity();
+    return out;
+  }
+
+  /// Invoked from the watchdog timer (never the executor) with the running
+  /// time and site of each job that crosses `stallThresholdMs`, once per
+  /// job. `site` may be null. Pass nil to clear.
+  void setOnStall(void (^cb)(uint64_t /*runningNanos*/, char const* /*site*/)) noexcept {
+    if (!state_) return;
+    std::lock_guard<std::mutex> lg(state_->stallHandlerLock);
+    state_->onStall = Block<void, uint64_t, char const*>(cb);
+  }
+
+  /// As `statistics()`, restricted to one ExecutorLane. Out-of-range lanes
+  /// return an all-zero snapshot.
+  ExecutorStatistics laneStatistics(uint8_t lane) const noexcept {
+    ExecutorStatistics out;
+    if (!state_ || lane >= ExecutorLaneCount) return out;
+    state_->laneCounters[lane].copyTo(out);
+    return out;
+  }
+
+  /// Lane a job pushed from the calling thread would land on.
+  static uint8_t currentLane() noexcept { return DispatchState::pushLane(); }
+
+  /// Set the calling thread's lane for subsequently pushed jobs and
+  /// return the previous one, for the caller to restore. Invalid lanes
+  /// are ignored.
+  static uint8_t setCurrentLane(uint8_t lane) noexcept {
+    auto const previous = currentExecutorLane;
+    if (lane < ExecutorLaneCount) currentExecutorLane = lane;
+    return previous;
+  }
+
+  /// Wait until every job queued so far has run, through ExecutorManager
+  /// like la_avdecc's own flushes. No-op once closed.
+  void flush() const noexcept {
+    if (!wrapper_) return;
+    la::avdecc::ExecutorManager::getInstance().flush(name_);
+  }
+
+  /// Run `job` on this executor, queued on `lane`. Routed through
+  /// ExecutorManager so it takes exactly the path la_avdecc's own jobs do.
+  void pushJob(uint8_t lane, void (^job)()) const noexcept {
+    if (!job || !wrapper_) return;
+    auto const previous = setCurrentLane(lane);
+    la::avdecc::ExecutorManager::getInstance().pushJob(
+        name_, [blk = Block<void>(job)]() { blk(); });
+    currentExecutorLane = previous;
+  }
+
 private:
   /// Shared state captured by every ExecutorProxy lambda and every block
   /// dispatched onto the queue. Held by std::shared_ptr so a block still
   /// in flight when ExecutorOwner is destroyed keeps the queue + flags
-  /// alive until it returns.
+  /// alive until it returns. In Thread mode `queue` stays null and the
+  /// executor thread holds the reference instead.
   struct DispatchState {
+    ExecutorMode mode = ExecutorMode::Dispatch;
     dispatch_queue_t queue = nullptr;
+    /// Pool `queue` is rooted on, if any. Held so the pool's queues
+    /// outlive every executor targeting them.
+    std::shared_ptr<ExecutorPool> targetPool;
+    /// The pool queue `queue` was retargeted onto.
+    dispatch_queue_t poolTarget = nullptr;
     std::atomic<bool> terminated{false};
+    ExecutorCounters counters;
+    ExecutorCounters laneCounters[ExecutorLaneCount];
     /// Serializes pushJob against flush/terminate. Counterpart of
     /// ExecutorWithDispatchQueueImpl::_enqueueLock — without it, a
     /// pushJob can land a block onto the queue after a concurrent
     /// terminate's drain has already returned. Non-recursive: our
     /// flush/terminate inline the drain rather than call each other,
-    /// so no thread re-enters.
+    /// so no thread re-enters. Batched mode only takes it in flush /
+    /// terminate (to serialise those against each other), Thread mode
+    /// only in terminate; their pushJob relies on `gate` instead.
     std::mutex enqueueLock;
 
+    // ---- Batched / Thread modes -----------------------------------------
+    uint32_t drainBatchLimit = 0;
+    uint32_t interactiveBurstLimit = 0;
+    /// Consumer-only: Interactive jobs run back-to-back while Bulk waited.
+    uint32_t interactiveStreak = 0;
+    ProducerGate gate;
+    /// Node storage for every mode. Declared ahead of `jobs` so it is
+    /// destroyed after them.
+    JobNodePool pool;
+    /// One FIFO per ExecutorLane.
+    MpscJobQueue jobs[ExecutorLaneCount];
+    /// Per-lane end markers for drainToBarrier(). Never pooled or run; only
+    /// one barrier drain is in flight at a time (enqueueLock).
+    JobNode barriers[ExecutorLaneCount];
+    /// Set by the producer that takes the queue from empty to non-empty
+    /// (and therefore owns scheduling the drain block); cleared by the
+    /// drain once it observes the queue empty.
+    std::atomic<bool> drainScheduled{false};
+    /// Pins this state while a drain is scheduled: set by whichever
+    /// producer wins `drainScheduled`, handed back by the drain when it
+    /// clears the flag. Stands in for the shared_ptr a capturing block
+    /// would hold, without the per-burst Block_copy.
+    std::shared_ptr<DispatchState> drainKeepAlive;
+
+    // ---- Thread mode ----------------------------------------------------
+    std::thread thread;
+    std::thread::id threadId;
+    /// Only touched when the thread goes to sleep / is woken: producers
+    /// check `threadSleeping` lock-free and take `wakeLock` only if the
+    /// thread actually parked.
+    std::mutex wakeLock;
+    std::condition_variable wakeCondition;
+    std::atomic<bool> threadSleeping{false};
+    std::atomic<bool> stopRequested{false};
+
+    // ---- Stall watchdog ---------------------------------------------------
+    std::string name;
+    uint64_t stallThresholdNanos = 0;
+    RunningJobRecord running;
+    dispatch_source_t watchdog = nullptr;
+    /// Watchdog handler only (timer events on one source are serialised).
+    uint64_t lastStallSequence = 0;
+    std::atomic<uint64_t> stalls{0};
+    std::mutex stallHandlerLock;
+    Block<void, uint64_t, char const*> onStall;
+
+    void checkStall() noexcept {
+      auto const startedAt = running.startedAt.load(std::memory_order_acquire);
+      if (startedAt == 0) return;
+      auto const sequence = running.sequence.load(std::memory_order_relaxed);
+      auto const now = steadyNanos();
+      if (now < startedAt + stallThresholdNanos || sequence == lastStallSequence) return;
+      lastStallSequence = sequence;
+      stalls.fetch_add(1, std::memory_order_relaxed);
+      auto const elapsed = now - startedAt;
+      auto const* site = running.site.load(std::memory_order_relaxed);
+      logStall(elapsed, site);
+      Block<void, uint64_t, char const*> handler;
+      {
+        std::lock_guard<std::mutex> lg(stallHandlerLock);
+        handler = onStall;
+      }
+      if (handler) handler(elapsed, site);
+    }
+
+    void logStall(uint64_t elapsed, char const* site) const noexcept {
+      auto& logger = la::avdecc::logger::Logger::getInstance();
+      if (la::avdecc::logger::Level::Warn < logger.getLevel()) return;
+      try {
+        auto message = "Executor '" + name + "' job running for " +
+                       std::to_string(elapsed / 1000000u) + " ms";
+        if (site) message += std::string(" in ") + site;
+        MessageLogItem item(la::avdecc::logger::Layer::Generic, std::move(message));
+        logger.logItem(la::avdecc::logger::Level::Warn, &item);
+      } catch (...) {
+      }
+    }
+
+    bool isCurrentQueue() const noexcept {
+      if (mode == ExecutorMode::Thread) {
+        return std::this_thread::get_id() == threadId;
+      }
+      return dispatch_get_specific(this) == this || inlineDrainingExecutor == this;
+    }
+
+    void wakeThread() noexcept {
+      // seq_cst load pairs with the sleeper's store-then-check of
+      // `jobs`; the RMW is only paid when the thread really parked.
+      if (threadSleeping.load(std::memory_order_seq_cst) &&
+          threadSleeping.exchange(false, std::memory_order_seq_cst)) {
+        std::lock_guard<std::mutex> lg(wakeLock);
+        wakeCondition.notify_one();
+      }
+    }
+
+    /// Executor thread body: drain everything queued, then park until a
+    /// producer wakes us. Stop is only honoured with the queue empty, so
+    /// terminate(flushJobs=true) gets its drain for free.
+    void threadLoop() noexcept {
+      for (;;) {
+        drainAll();
+        std::unique_lock<std::mutex> lk(wakeLock);
+        threadSleeping.store(true, std::memory_order_seq_cst);
+        if (hasQueuedJobs()) {
+          threadSleeping.store(false, std::memory_order_relaxed);
+          continue;
+        }
+        if (stopRequested.load(std::memory_order_seq_cst)) return;
+        wakeCondition.wait(lk, [this] {
+          return !threadSleeping.load(std::memory_order_seq_cst) ||
+                 stopRequested.load(std::memory_order_seq_cst);
+        });
+        threadSleeping.store(false, std::memory_order_relaxed);
+      }
+    }
+
+    /// Fires once the last flush barrier job holding it is destroyed —
+    /// after running, or when dropped unrun by terminate(flushJobs=false)
+    /// or the state's teardown — so a flush waiting on it always returns.
+    struct FlushSignal {
+      std::promise<void> reached;
+      ~FlushSignal() { reached.set_value(); }
+    };
+
+    /// Thread-mode flush from a foreign thread: queue a barrier job per
+    /// lane and wait for the executor to be done with all of them. Lanes
+    /// drain out of order relative to each other, so only "every barrier
+    /// is gone" means every job queued before the flush has run.
+    ///
+    /// Admission is through the gate rather than enqueueLock, and the wait
+    /// holds neither: a terminate() issued meanwhile — possibly by a job on
+    /// the executor thread — must not block behind the flush it is about
+    /// to cut short.
+    void flushThread() noexcept {
+      if (!gate.enter()) return;
+      auto signal = std::make_shared<FlushSignal>();
+      auto done = signal->reached.get_future();
+      for (uint8_t lane = 0; lane < ExecutorLaneCount; ++lane) {
+        enqueue([signal] {}, lane);
+      }
+      signal.reset();
+      wakeThread();
+      gate.leave();
+      done.wait();
+    }
+
+    void stopThread() noexcept {
+      {
+        std::lock_guard<std::mutex> lg(wakeLock);
+        stopRequested.store(true, std::memory_order_seq_cst);
+      }
+      wakeCondition.notify_one();
+      if (thread.joinable() && !isCurrentQueue()) thread.join();
+    }
+
+    static uint8_t pushLane() noexcept {
+      return currentExecutorLane < ExecutorLaneCount
+          ? currentExecutorLane
+          : static_cast<uint8_t>(ExecutorLane::Bulk);
+    }
+
+    /// Producer side of the queued modes; caller holds the gate.
+    void enqueue(Job&& job, uint8_t lane) noexcept {
+      // Count before publishing: the drain may pop (and decrement the
+      // depth) before push() even returns.
+      counters.jobEnqueued();
+      laneCounters[lane].jobEnqueued();
+      jobs[lane].push(makeNode(std::move(job), lane));
+    }
+
+    JobNode* makeNode(Job&& job, uint8_t lane) noexcept {
+      auto* node = pool.acquire();
+      node->job = std::move(job);
+      node->enqueuedAt = monotonicNanos();
+      node->lane = lane;
+      return node;
+    }
+
+    bool hasQueuedJobs() const noexcept {
+      for (auto const& lane : jobs) {
+        if (!lane.empty()) return true;
+      }
+      return false;
+    }
+
+    /// Next job in priority order, or nullptr. Interactive first, except
+    /// that after `interactiveBurstLimit` consecutive Interactive jobs one
+    /// waiting Bulk job is let through so Bulk cannot starve. `open` masks
+    /// the lanes that may be popped (bit = 1 << lane).
+    JobNode* popNext(unsigned open = (1u << ExecutorLaneCount) - 1) noexcept {
+      constexpr auto interactiveBit = 1u << static_cast<unsigned>(ExecutorLane::Interactive);
+      constexpr auto bulkBit = 1u << static_cast<unsigned>(ExecutorLane::Bulk);
+      auto& interactive = jobs[static_cast<size_t>(ExecutorLane::Interactive)];
+      auto& bulk = jobs[static_cast<size_t>(ExecutorLane::Bulk)];
+      if ((open & interactiveBit) &&
+          (interactiveBurstLimit == 0 || interactiveStreak < interactiveBurstLimit)) {
+        if (auto* node = interactive.pop()) {
+          ++interactiveStreak;
+          return node;
+        }
+      }
+      interactiveStreak = 0;
+      if (open & bulkBit) {
+        if (auto* node = bulk.pop()) return node;
+      }
+      return (open & interactiveBit) ? interactive.pop() : nullptr;
+    }
+
+    void runJob(Job& job, uint64_t enqueuedAt, uint8_t lane) noexcept {
+      auto const startedAt = monotonicNanos();
+      counters.jobStarted(enqueuedAt, startedAt);
+      laneCounters[lane].jobStarted(enqueuedAt, startedAt);
+      auto const outerLane = currentExecutorLane;
+      auto const outerRunning = runningExecutorJob;
+      auto* const outerJob = currentRunningJob;
+      currentExecutorLane = static_cast<uint8_t>(ExecutorLane::Bulk);
+      runningExecutorJob = true;
+      if (stallThresholdNanos) {
+        running.site.store(nullptr, std::memory_order_relaxed);
+        running.sequence.store(running.sequence.load(std::memory_order_relaxed) + 1,
+                               std::memory_order_relaxed);
+        running.startedAt.store(steadyNanos(), std::memory_order_release);
+        currentRunningJob = &running;
+      } else {
+        currentRunningJob = nullptr;
+      }
+      la::avdecc::utils::invokeProtectedHandler(job);
+      if (stallThresholdNanos) running.startedAt.store(0, std::memory_order_release);
+      currentRunningJob = outerJob;
+      runningExecutorJob = outerRunning;
+      currentExecutorLane = outerLane;
+      auto const finishedAt = monotonicNanos();
+      counters.jobFinished(startedAt, finishedAt);
+      laneCounters[lane].jobFinished(startedAt, finishedAt);
+    }
+
+    // In-queue terminated check covers terminate(flushJobs=false): the
+    // drain doesn't run, so already-queued jobs must bail at the head
+    // rather than execute against a torn-down la_avdecc. They are counted
+    // as dropped, not completed, and queueDepth still returns to zero.
+    void runNode(JobNode* node) noexcept {
+      if (terminated.load(std::memory_order_acquire)) {
+        dropNode(node);
+        return;
+      }
+      runJob(node->job, node->enqueuedAt, node->lane);
+      pool.release(node);
+    }
+
+    void dropNode(JobNode* node) noexcept {
+      counters.jobDropped();
+      laneCounters[node->lane].jobDropped();
+      pool.release(node);
+    }
+
+    /// Run every queued job, in priority order, on the current (executor)
+    /// queue. Yields while a producer is between its head exchange and its
+    /// link store — a window of a couple of instructions.
+    void drainAll() noexcept {
+      for (;;) {
+        while (auto* node = popNext()) runNode(node);
+        if (!hasQueuedJobs()) return;
+        std::this_thread::yield();
+      }
+    }
+
+    /// Run exactly the jobs queued before this call, in priority order, on
+    /// the current (executor) queue: push an end marker onto every lane and
+    /// stop popping a lane once its marker comes out. Work pushed meanwhile
+    /// stays queued for the regular drain, so producers that never pause
+    /// cannot keep a flush draining forever. Caller holds enqueueLock.
+    void drainToBarrier() noexcept {
+      unsigned open = 0;
+      for (uint8_t lane = 0; lane < ExecutorLaneCount; ++lane) {
+        barriers[lane].lane = lane;
+        jobs[lane].push(&barriers[lane]);
+        open |= 1u << lane;
+      }
+      while (open != 0) {
+        auto* node = popNext(open);
+        if (!node) {
+          // A producer ahead of a marker is between its exchange and its
+          // link store.
+          std::this_thread::yield();
+          continue;
+        }
+        if (node == &barriers[node->lane]) {
+          open &= ~(1u << node->lane);
+        } else {
+          runNode(node);
+        }
+      }
+    }
+
+    /// Batched flush / terminate from off the queue: barrier-drain on the
+    /// executor's queue, waiting for it. A caller that is itself a job of
+    /// another executor rooted on the same (serial) pool queue cannot wait
+    /// for this queue — it is what occupies the pool queue — but for the
+    /// same reason this executor cannot be running, so the drain runs
+    /// right here instead, with exclusive use of the consumer side. That
+    /// is only possible because Batched jobs sit in our own queues; a
+    /// Dispatch-mode job is a block only libdispatch can run.
+    void drainFromForeignThread() noexcept {
+      if (targetPool && targetPool->isCurrent(poolTarget)) {
+        auto const* const outer = inlineDrainingExecutor;
+        inlineDrainingExecutor = this;
+        drainToBarrier();
+        inlineDrainingExecutor = outer;
+        return;
+      }
+      dispatch_sync(queue, ^{ drainToBarrier(); });
+    }
+
+    void terminate(bool flushJobs) noexcept {
+      std::lock_guard<std::mutex> lg(enqueueLock);
+      if (watchdog) dispatch_source_cancel(watchdog);
+      // Batched/Thread: stop admitting pushes and wait out in-flight
+      // ones, so the drain below is guaranteed to be the last word.
+      if (mode != ExecutorMode::Dispatch) gate.close();
+      if (mode == ExecutorMode::Thread) {
+        // Without a flush (or when called from a job, where joining
+        // ourselves is impossible) mark terminated first so whatever is
+        // still queued bails in runJob as the thread winds down.
+        if (!flushJobs || isCurrentQueue()) {
+          terminated.store(true, std::memory_order_release);
+        }
+        stopThread();
+        terminated.store(true, std::memory_order_release);
+        return;
+      }
+      if (flushJobs && !isCurrentQueue()) {
+        if (mode == ExecutorMode::Batched) {
+          drainFromForeignThread();
+        } else {
+          dispatch_sync(queue, ^{});
+        }
+      }
+      // Set terminated last: pushJob (locked-out above) sees this on
+      // the next acquire and silently drops, and any blocks still in
+      // the queue (only possible with flushJobs=false) bail at the
+      // in-block check.
+      terminated.store(true, std::memory_order_release);
+    }
+
     ~DispatchState() noexcept {
+      // The executor thread owns a reference, so if it is still joinable
+      // here we are either on it (last reference dropped by the thread
+      // itself) or it has already left threadLoop.
+      if (thread.joinable()) {
+        if (std::this_thread::get_id() == thread.get_id()) {
+          thread.detach();
+        } else {
+          thread.join();
+        }
+      }
+      if (watchdog) {
+        // Normally cancelled by terminate() already; this covers a state
+        // that never got that far.
+        dispatch_source_cancel(watchdog);
+        dispatch_release(watchdog);
+      }
+      // Only non-empty after terminate(flushJobs=false); the nodes'
+      // storage belongs to `pool`.
+      for (auto& lane : jobs) {
+        lane.clear([this](JobNode* node) noexcept { dropNode(node); });
+      }
       if (queue) {
         // User-side refcount drop. libdispatch keeps the queue alive
         // internally until any still-pending blocks complete.
@@ -363,17 +1023,280 @@ private:
     }
   };
 
+  static la::avdecc::Executor::UniquePointer
+  makeDispatchProxy(std::shared_ptr<DispatchState> const& state) {
+    auto pushJobProxy = [state](Job&& job) noexcept {
+      // Serialize against flush/terminate via enqueueLock — mirrors
+      // ExecutorWithDispatchQueueImpl::pushJob. Without the lock, a
+      // pushJob racing with terminate(true) could land a block onto the
+      // queue after terminate's drain returned, leaving a stray block
+      // referencing la_avdecc captures whose lifetime is ending.
+      std::lock_guard<std::mutex> lg(state->enqueueLock);
+      if (state->terminated.load(std::memory_order_acquire)) return;
+      // A pooled node handed to dispatch_async_f replaces the old
+      // make_shared<Job> + capturing block (two allocations per job).
+      // The node's keepAlive does what the block's shared_ptr capture
+      // did — keep the state alive until the job has run — for the
+      // price of a refcount increment.
+      auto const lane = DispatchState::pushLane();
+      state->counters.jobEnqueued();
+      state->laneCounters[lane].jobEnqueued();
+      auto* node = state->makeNode(std::move(job), lane);
+      node->keepAlive = state;
+      dispatch_async_f(state->queue, node, &runDispatchedNode);
+    };
+
+    auto flushProxy = [state]() noexcept {
+      // Serial-queue ordering already guarantees prior jobs are complete
+      // by the time *this* job runs, so a flush-from-job is a no-op (and
+      // dispatch_sync onto our own queue would deadlock).
+      if (state->isCurrentQueue()) return;
+      // Hold the enqueueLock across the drain so concurrent pushJobs
+      // block until the queue is empty — matches the original
+      // ExecutorWithDispatchQueueImpl::flush semantics.
+      std::lock_guard<std::mutex> lg(state->enqueueLock);
+      dispatch_sync(state->queue, ^{});
+    };
+
+    auto terminateProxy = [state](bool flushJobs) noexcept {
+      state->terminate(flushJobs);
+    };
+
+    return la::avdecc::ExecutorProxy::create(
+        pushJobProxy, flushProxy, terminateProxy, getThreadProxy);
+  }
+
+  static la::avdecc::Executor::UniquePointer
+  makeBatchedProxy(std::shared_ptr<DispatchState> const& state) {
+    auto pushJobProxy = [state](Job&& job) noexcept {
+      // No enqueueLock: the gate gives terminate() the same "nothing
+      // lands after the final drain" guarantee without serialising
+      // producers. A push that loses the race is dropped, exactly as a
+      // push after terminate() always has been.
+      if (!state->gate.enter()) return;
+      state->enqueue(std::move(job), DispatchState::pushLane());
+      if (!state->drainScheduled.exchange(true, std::memory_order_seq_cst)) {
+        state->drainKeepAlive = state;
+        scheduleDrain(*state);
+      }
+      state->gate.leave();
+    };
+
+    auto flushProxy = [state]() noexcept {
+      // Same on-queue short-circuit as the dispatch proxy: everything
+      // queued before the running job has already run.
+      if (state->isCurrentQueue()) return;
+      // Lock only serialises against terminate(); producers keep pushing
+      // (lock-free), and what they land after the barrier is left to the
+      // regular drain.
+      std::lock_guard<std::mutex> lg(state->enqueueLock);
+      state->drainFromForeignThread();
+    };
+
+    auto terminateProxy = [state](bool flushJobs) noexcept {
+      state->terminate(flushJobs);
+    };
+
+    return la::avdecc::ExecutorProxy::create(
+        pushJobProxy, flushProxy, terminateProxy, getThreadProxy);
+  }
+
+  /// Thread mode. Producers are the same gate + MPSC push as Batched;
+  /// the wakeup is a lock-free test of `threadSleeping`, so a push to a
+  /// busy executor never touches the condvar.
+  ///
+  /// Unlike the dispatch modes, `getExecutorThread()` reports the real
+  /// thread id. la_avdecc's `waitJobResponse` / `runJobOnExecutorAndWait`
+  /// therefore run inline when called from a job, instead of queueing
+  /// behind it — which also lifts the self-deadlock caveat in the class
+  /// comment for this mode.
+  static la::avdecc::Executor::UniquePointer
+  makeThreadProxy(std::shared_ptr<DispatchState> const& state) {
+    auto pushJobProxy = [state](Job&& job) noexcept {
+      if (!state->gate.enter()) return;
+      state->enqueue(std::move(job), DispatchState::pushLane());
+      state->wakeThread();
+      state->gate.leave();
+    };
+
+    auto flushProxy = [state]() noexcept {
+      if (state->isCurrentQueue()) return;
+      state->flushThread();
+    };
+
+    auto terminateProxy = [state](bool flushJobs) noexcept {
+      state->terminate(flushJobs);
+    };
+
+    auto threadIdProxy = [state]() noexcept { return state->threadId; };
+
+    return la::avdecc::ExecutorProxy::create(
+        pushJobProxy, flushProxy, terminateProxy, threadIdProxy);
+  }
+
+  /// Arm the stall watchdog, if configured. The timer runs on a global
+  /// queue — never the executor's — samples the running-job record every
+  /// half threshold, and holds only a weak reference so it cannot keep a
+  /// torn-down executor alive. Nothing here touches the push path.
+  static void startWatchdog(std::shared_ptr<DispatchState> const& state) noexcept {
+    if (state->stallThresholdNanos == 0) return;
+    auto const interval = std::max<uint64_t>(state->stallThresholdNanos / 2, 1000000u);
+    state->watchdog = dispatch_source_create(
+        DISPATCH_SOURCE_TYPE_TIMER, 0, 0,
+        dispatch_get_global_queue(DISPATCH_QUEUE_PRIORITY_DEFAULT, 0));
+    if (!state->watchdog) return;
+    dispatch_source_set_timer(state->watchdog,
+                              dispatch_time(DISPATCH_TIME_NOW, static_cast<int64_t>(interval)),
+                              interval, interval / 10);
+    std::weak_ptr<DispatchState> weakState = state;
+    dispatch_source_set_event_handler(state->watchdog, ^{
+      if (auto strongState = weakState.lock()) strongState->checkStall();
+    });
+    dispatch_resume(state->watchdog);
+  }
+
+  /// Start the Thread-mode executor thread and wait until it has applied
+  /// `options`; rethrows (after joining) if it could not.
+  static void startThread(std::shared_ptr<DispatchState> const& state,
+                          std::string const& name,
+                          ExecutorOptions const& options) {
+    // The promise moves into the thread: set_value may still be touching
+    // it after get() has returned on this side.
+    std::promise<void> configured;
+    auto ready = configured.get_future();
+    state->thread = std::thread([state, name, options,
+                                 configured = std::move(configured)]() mutable noexcept {
+      try {
+        configureCurrentThread(name, options);
+      } catch (...) {
+        configured.set_exception(std::current_exception());
+        return;
+      }
+      configured.set_value();
+      state->threadLoop();
+    });
+    state->threadId = state->thread.get_id();
+    try {
+      ready.get();
+    } catch (...) {
+      state->thread.join();
+      throw;
+    }
+  }
+
+  /// Name the calling thread and apply the Thread-mode scheduling
+  /// options to it. Runs on the executor thread itself because per-thread
+  /// nice on Linux is addressed by tid, which only the thread knows.
+  static void configureCurrentThread(std::string const& name,
+                                     ExecutorOptions const& options) {
+    using la::avdecc::protocol::ProtocolInterface;
+#if defined(__linux__)
+    // Linux caps thread names at 15 characters plus NUL.
+    pthread_setname_np(pthread_self(), name.substr(0, 15).c_str());
+    if (options.cpuAffinityMask != 0) {
+      cpu_set_t cpus;
+      CPU_ZERO(&cpus);
+      for (int cpu = 0; cpu < 64; ++cpu) {
+        if (options.cpuAffinityMask & (uint64_t{1} << cpu)) CPU_SET(cpu, &cpus);
+      }
+      if (auto err = pthread_setaffinity_np(pthread_self(), sizeof(cpus), &cpus)) {
+        throw std::system_error(err, std::generic_category(),
+                                "pthread_setaffinity_np");
+      }
+    }
+    if (options.setNice) {
+      if (setpriority(PRIO_PROCESS, static_cast<id_t>(syscall(SYS_gettid)),
+                      options.nice) != 0) {
+        throw std::system_error(errno, std::generic_category(), "setpriority");
+      }
+    }
+#else
+    pthread_setname_np(name.c_str());
+    if (options.cpuAffinityMask != 0 || options.setNice) {
+      throw ProtocolInterface::Exception(
+          ProtocolInterface::Error::InvalidParameters,
+          "CPU affinity and per-thread nice are only supported on Linux");
+    }
+#endif
+    if (options.schedFifoPriority != 0) {
+      sched_param param{};
+      param.sched_priority = options.schedFifoPriority;
+      if (auto err = pthread_setschedparam(pthread_self(), SCHED_FIFO, &param)) {
+        throw std::system_error(err, std::generic_category(),
+                                "pthread_setschedparam(SCHED_FIFO)");
+      }
+    }
+  }
+
+  static void runDispatchedNode(void* context) noexcept {
+    auto* node = static_cast<JobNode*>(context);
+    // Move the reference out first: releasing the node must not be what
+    // destroys the pool it is being released into.
+    auto keepAlive = std::move(node->keepAlive);
+    static_cast<DispatchState*>(keepAlive.get())->runNode(node);
+  }
+
+  /// One drain per empty→non-empty transition, via dispatch_async_f so
+  /// scheduling it allocates nothing; the caller owns `drainKeepAlive`.
+  static void scheduleDrain(DispatchState& s) noexcept {
+    dispatch_async_f(s.queue, &s, &drainBatch);
+  }
+
+  static void drainBatch(void* context) noexcept {
+    auto& s = *static_cast<DispatchState*>(context);
+    for (;;) {
+      uint32_t ran = 0;
+      while (s.drainBatchLimit == 0 || ran < s.drainBatchLimit) {
+        auto* node = s.popNext();
+        if (!node) break;
+        s.runNode(node);
+        ++ran;
+      }
+      if (ran != 0 && ran == s.drainBatchLimit) {
+        // Batch limit hit: stay "scheduled" and re-queue behind whatever
+        // was submitted meanwhile so flush/terminate barriers and other
+        // blocks on the queue are not starved by a producer storm.
+        scheduleDrain(s);
+        return;
+      }
+      // Hand scheduling back to producers, then re-check: a push that
+      // saw `drainScheduled == true` just before the store relies on us
+      // noticing its node here. The keep-alive goes with the flag; if it
+      // was the last reference, the state dies as this returns.
+      auto keepAlive = std::move(s.drainKeepAlive);
+      s.drainScheduled.store(false, std::memory_order_seq_cst);
+      if (!s.hasQueuedJobs()) return;
+      if (s.drainScheduled.exchange(true, std::memory_order_seq_cst)) return;
+      s.drainKeepAlive = std::move(keepAlive);
+      if (ran == 0) {
+        // Non-empty but nothing poppable: a producer is mid-push. Re-queue
+        // rather than spin on the serial queue.
+        scheduleDrain(s);
+        return;
+      }
+    }
+  }
+
+  // See class comment: returning {} disables the inline short-circuit
+  // in waitJobResponse / runJobOnExecutorAndWait. ExecutorManager
+  // snapshots this once at registration anyway, so a per-job cache
+  // would be ignored.
+  static std::thread::id getThreadProxy() noexcept { return std::thread::id{}; }
+
   friend class IntrusiveReferenceCounted<ExecutorOwner>;
   ExecutorOwner(
       std::string name,
+      ExecutorOptions options,
       la::avdecc::ExecutorManager::ExecutorWrapper::UniquePointer wrapper,
       std::shared_ptr<DispatchState> state) noexcept
       : name_(std::move(name))
+      , options_(std::move(options))
       , wrapper_(std::move(wrapper))
       , state_(std::move(state)) {}
   ~ExecutorOwner() noexcept { close(); }
 
   std::string name_;
+  ExecutorOptions options_;
   la::avdecc::ExecutorManager::ExecutorWrapper::UniquePointer wrapper_;
   std::shared_ptr<DispatchState> state_;
 };
@@ -391,6 +1314,17 @@ void AVDECCSwift_LoggerOwner_release(AVDECCSwift::LoggerOwner* p) noexcept;
 
 namespace AVDECCSwift {
 
+/// la_avdecc's built-in log layers, Generic through JsonSerializer.
+constexpr uint8_t LogLayerCount = 9;
+/// `LoggerOwner::setLayerLevel` value that makes a layer follow the base
+/// level again.
+constexpr uint8_t LayerLevelInherit = 0xff;
+/// la_avdecc's item levels, Trace through Compat.
+constexpr uint8_t LogLevelCount = 6;
+/// `LoggerOwner::copyLogCounts` entries: one per (level, layer), layers
+/// beyond the built-in ones sharing the last column.
+constexpr size_t LogCountsSize = size_t{LogLevelCount} * (LogLayerCount + 1);
+
 /// Bridge between la_avdecc's `Logger::Observer` (singleton, pointer-
 /// registered) and a Swift block. Each instance registers itself with
 /// the global la_avdecc Logger on construction and unregisters on
@@ -402,22 +1336,58 @@ namespace AVDECCSwift {
 /// Message passes as (data, size) UTF-8 — Swift constructs a String
 /// without going through Foundation, which keeps the log path off the
 /// CFString TSD setup that we audited out earlier.
+///
+/// Ring mode (`startRingCapture`): the emitting thread only copies the
+/// item into a LogRing and returns — no lock, no block, no Swift. A
+/// drainer thread owned by this class hands records to the
+/// `setOnLogBatch` block up to LogBatchCapacity at a time.
 class SWIFT_SHARED_REFERENCE(AVDECCSwift_LoggerOwner_retain,
                              AVDECCSwift_LoggerOwner_release)
     LoggerOwner final
     : public IntrusiveReferenceCounted<LoggerOwner> {
 public:
+  /// Records per `setOnLogBatch` invocation, at most.
+  static constexpr size_t LogBatchCapacity = 64;
+
   SWIFT_RETURNS_RETAINED
   static LoggerOwner* create() noexcept { return new LoggerOwner(); }
 
   /// Idempotent. Detaches the observer from la_avdecc's Logger singleton.
   /// Block slot is cleared so any in-flight notifications complete with
-  /// no-op forwarding.
+  /// no-op forwarding. In ring mode, records already captured are
+  /// delivered before this returns (unless called from the batch block
+  /// itself). The flight recorder is closed, and la_avdecc's global level
+  /// goes back to the base level: per-layer overrides, the recorder and
+  /// the counting level stop lowering it.
   void close() noexcept {
     if (registered_) {
       la::avdecc::logger::Logger::getInstance().unregisterObserver(&observer_);
       registered_ = false;
     }
+    if (!closed_) {
+      std::lock_guard<std::mutex> lg(levelsLock_);
+      closed_ = true;
+      // No emitting thread can reach the recorder once unregistered.
+      observer_.setRecorder(nullptr, LayerLevelInherit);
+      recorder_.reset();
+      recorderLevel_ = LayerLevelInherit;
+      countingLevel_ = LayerLevelInherit;
+      la::avdecc::logger::Logger::getInstance().setLevel(
+          static_cast<la::avdecc::logger::Level>(baseLevel_));
+    }
+    observer_.flushSummaries(true);
+    if (ring_) {
+      // No producer can reach the ring once unregistered.
+      observer_.setRing(nullptr);
+      if (drainer_.joinable() && drainer_.get_id() == std::this_thread::get_id()) {
+        // Called from the batch block: records still queued are dropped.
+        ring_->abandon();
+        drainer_.detach();
+      } else {
+        ring_->stop();
+        if (drainer_.joinable()) drainer_.join();
+      }
+    }
     observer_.clearSlot();
   }
 
@@ -435,18 +1405,152 @@ public:
     observer_.setSlot(cb);
   }
 
-  /// la_avdecc's global emit-level filter. Messages below this level
-  /// are dropped before our observer is even invoked, saving the
-  /// std::string allocation for getMessage(). Swift typically sets
-  /// this to the most permissive level any consumer wants and then
-  /// per-consumer-filters in the block.
+  /// Ring mode's delivery block, called on the drainer thread.
+  void setOnLogBatch(void (^cb)(LogRecord const* /*records*/, size_t /*count*/)) noexcept {
+    observer_.setBatchSlot(cb);
+  }
+
+  /// Switch to ring mode with `capacity` records (rounded up to a power
+  /// of two). One-way: the ring stays until `close()`. Call before
+  /// `registerObserver()` so no item takes the direct path. Returns false,
+  /// leaving the owner in direct mode, if the ring, its drain batch or
+  /// the drainer thread cannot be created.
+  bool startRingCapture(uint32_t capacity) noexcept {
+    if (ring_) return true;
+    try {
+      auto ring = std::make_shared<LogRing>(capacity);
+      std::unique_ptr<LogRecord[]> batch(new LogRecord[LogBatchCapacity]);
+      drainer_ = std::thread([this, ring, batch = std::move(batch)]() mutable {
+        drainLoop(*ring, std::move(batch));
+      });
+      ring_ = std::move(ring);
+    } catch (...) {
+      return false;
+    }
+    observer_.setRing(ring_.get());
+    return true;
+  }
+
+  /// Also append every item at `level` or above to a memory-mapped
+  /// circular file of `capacity` bytes at `path` (see
+  /// AVDECCSwiftFlightRecorder.hpp), independently of what is forwarded
+  /// and before burst suppression. One-way, like ring mode; the file is
+  /// truncated first. Returns false with `outErr` filled if it cannot be
+  /// created or mapped, or if a recorder is already running.
+  bool startFlightRecorder(std::string const& path, uint64_t capacity, uint8_t level,
+                           CapturedException& outErr) noexcept {
+    return invokeCapturingException(outErr, [&]() -> bool {
+      std::lock_guard<std::mutex> lg(levelsLock_);
+      if (recorder_) {
+        throw la::avdecc::protocol::ProtocolInterface::Exception(
+            la::avdecc::protocol::ProtocolInterface::Error::InvalidParameters,
+            "Flight recorder already running");
+      }
+      auto const realtime = std::chrono::duration_cast<std::chrono::nanoseconds>(
+          std::chrono::system_clock::now().time_since_epoch());
+      recorder_ = std::make_unique<FlightRecorder>(path, capacity, steadyNanos(),
+                                                   static_cast<uint64_t>(realtime.count()));
+      recorderLevel_ = level;
+      observer_.setRecorder(recorder_.get(), level);
+      applyLevels();
+      return true;
+    });
+  }
+
+  /// Items seen per (level, layer), as `counts[level * (LogLayerCount + 1)
+  /// + layer]`, whether or not they are forwarded. Copies up to `count`
+  /// entries (LogCountsSize for all).
+  void copyLogCounts(uint64_t* out, size_t count) const noexcept {
+    observer_.copyCounts(out, count);
+  }
+
+  /// Have la_avdecc emit items down to `level` so they are counted, even
+  /// below every forwarding level; they are dropped right after counting.
+  /// LayerLevelInherit counts only what is emitted anyway.
+  void setCountingLevel(uint8_t level) noexcept {
+    std::lock_guard<std::mutex> lg(levelsLock_);
+    countingLevel_ = level;
+    applyLevels();
+  }
+  uint8_t getCountingLevel() const noexcept {
+    std::lock_guard<std::mutex> lg(levelsLock_);
+    return countingLevel_;
+  }
+
+  /// Records appended to the flight recorder; zero without one.
+  uint64_t flightRecorderRecords() const noexcept {
+    std::lock_guard<std::mutex> lg(levelsLock_);
+    return recorder_ ? recorder_->records() : 0u;
+  }
+
+  /// Burst suppression ahead of the Swift crossing (see LogThrottle):
+  /// repeats of one message within `windowMillis` are counted and later
+  /// summarised, and each layer is held to `layerRatePerSecond` items
+  /// with a bucket `layerBurst` deep. 0 disables either stage. Turning a
+  /// stage off emits the summaries still pending.
+  void setBurstSuppression(uint32_t windowMillis, uint32_t layerRatePerSecond,
+                           uint32_t layerBurst) noexcept {
+    std::lock_guard<std::mutex> lg(throttleLock_);
+    if (!throttle_) {
+      if (windowMillis == 0 && layerRatePerSecond == 0) return;
+      throttle_.reset(new (std::nothrow) LogThrottle(LogLayerCount));
+      if (!throttle_) return;
+      observer_.setThrottle(throttle_.get());
+    }
+    throttle_->configure(uint64_t{windowMillis} * 1'000'000u, layerRatePerSecond, layerBurst);
+    if (windowMillis == 0) observer_.flushSummaries(true);
+  }
+
+  /// Emit duplicate summaries whose window has passed. The emitting path
+  /// only finds them gradually, so a quiet logger can call this
+  /// periodically.
+  void flushSuppressionSummaries() noexcept { observer_.flushSummaries(false); }
+
+  /// Burst-suppression counters; zero while it has never been enabled.
+  uint64_t suppressedDuplicates() const noexcept {
+    std::lock_guard<std::mutex> lg(throttleLock_);
+    return throttle_ ? throttle_->duplicates() : 0u;
+  }
+  uint64_t rateLimitedItems() const noexcept {
+    std::lock_guard<std::mutex> lg(throttleLock_);
+    return throttle_ ? throttle_->rateLimited() : 0u;
+  }
+  uint64_t suppressionSummaries() const noexcept {
+    std::lock_guard<std::mutex> lg(throttleLock_);
+    return throttle_ ? throttle_->summariesEmitted() : 0u;
+  }
+
+  /// Ring-mode counters; zero in direct mode.
+  uint64_t ringCaptured() const noexcept { return ring_ ? ring_->captured() : 0u; }
+  uint64_t ringDropped() const noexcept { return ring_ ? ring_->dropped() : 0u; }
+
+  /// Base level, used by every layer without its own override. la_avdecc's
+  /// global emit-level filter is set to the most permissive level in the
+  /// table, so messages below all of them are dropped before our observer
+  /// is even invoked; the table then drops the rest before getMessage()
+  /// formats them. The global level is shared with any other observer.
   void setLevel(uint8_t level) noexcept {
-    la::avdecc::logger::Logger::getInstance().setLevel(
-        static_cast<la::avdecc::logger::Level>(level));
+    std::lock_guard<std::mutex> lg(levelsLock_);
+    baseLevel_ = level;
+    applyLevels();
   }
   uint8_t getLevel() const noexcept {
-    return static_cast<uint8_t>(
-        la::avdecc::logger::Logger::getInstance().getLevel());
+    std::lock_guard<std::mutex> lg(levelsLock_);
+    return baseLevel_;
+  }
+
+  /// Per-layer override of the base level; LayerLevelInherit removes it.
+  /// Layers outside the table (user layers) always use the base level.
+  void setLayerLevel(uint8_t layer, uint8_t level) noexcept {
+    if (layer >= LogLayerCount) return;
+    std::lock_guard<std::mutex> lg(levelsLock_);
+    layerOverrides_[layer] = level;
+    applyLevels();
+  }
+  /// The level in effect for `layer`, override or base.
+  uint8_t getLayerLevel(uint8_t layer) const noexcept {
+    std::lock_guard<std::mutex> lg(levelsLock_);
+    return effectiveLevel(layer);
   }
 
 private:
@@ -460,36 +1564,298 @@ private:
       std::lock_guard<std::mutex> lock(mutex_);
       slot_ = Block<void, uint8_t, uint8_t, char const*, size_t>(cb);
     }
+    void setBatchSlot(void (^cb)(LogRecord const*, size_t)) noexcept {
+      std::lock_guard<std::mutex> lock(mutex_);
+      batchSlot_ = Block<void, LogRecord const*, size_t>(cb);
+    }
     void clearSlot() noexcept {
       std::lock_guard<std::mutex> lock(mutex_);
       slot_.reset();
+      batchSlot_.reset();
+    }
+    void setRing(LogRing* ring) noexcept {
+      ring_.store(ring, std::memory_order_release);
+    }
+    void setThreshold(size_t index, uint8_t level) noexcept {
+      thresholds_[index].store(level, std::memory_order_relaxed);
+    }
+    void setRecorder(FlightRecorder* recorder, uint8_t level) noexcept {
+      recorderLevel_.store(level, std::memory_order_relaxed);
+      recorder_.store(recorder, std::memory_order_release);
+    }
+    void copyCounts(uint64_t* out, size_t count) const noexcept {
+      for (size_t i = 0; i < std::min(count, LogCountsSize); ++i) {
+        out[i] = counts_[i].load(std::memory_order_relaxed);
+      }
+    }
+    void setThrottle(LogThrottle* throttle) noexcept {
+      throttle_.store(throttle, std::memory_order_release);
+    }
+    /// Emit the throttle's pending duplicate summaries: expired ones, or
+    /// with `all` every one.
+    void flushSummaries(bool all) noexcept {
+      auto* const throttle = throttle_.load(std::memory_order_acquire);
+      if (!throttle) return;
+      auto* const ring = ring_.load(std::memory_order_acquire);
+      auto const blk = ring ? Block<void, uint8_t, uint8_t, char const*, size_t>() : copySlot();
+      auto const now = steadyNanos();
+      LogSummary summaries[8];
+      size_t count;
+      do {
+        count = throttle->sweep(now, all, summaries, 8);
+        for (size_t i = 0; i < count; ++i) {
+          auto const& summary = summaries[i];
+          emit(ring, blk, summary.level, summary.layer, summary.text, summary.size, now);
+        }
+      } while (count == 8);
+    }
+    Block<void, LogRecord const*, size_t> copyBatchSlot() const noexcept {
+      std::lock_guard<std::mutex> lock(mutex_);
+      return batchSlot_;
     }
 
   private:
     void onLogItem(la::avdecc::logger::Level const level,
                    la::avdecc::logger::LogItem const* const item) noexcept override {
+      if (!item) return;
+      auto const rawLevel = static_cast<uint8_t>(level);
+      auto const layer = static_cast<size_t>(item->getLayer());
+      // Counted before any filter or slot, so counts cover everything
+      // la_avdecc emits down to the global level.
+      if (rawLevel < LogLevelCount) {
+        counts_[rawLevel * (LogLayerCount + 1) + std::min(layer, size_t{LogLayerCount})]
+            .fetch_add(1, std::memory_order_relaxed);
+      }
+      // Per-layer filter, ahead of any formatting. Slot LogLayerCount
+      // holds the base level for layers outside the table. The flight
+      // recorder has a level of its own.
+      auto const& threshold = thresholds_[std::min(layer, size_t{LogLayerCount})];
+      auto forward = rawLevel >= threshold.load(std::memory_order_relaxed);
+      auto* recorder = recorder_.load(std::memory_order_acquire);
+      if (recorder && rawLevel < recorderLevel_.load(std::memory_order_relaxed)) {
+        recorder = nullptr;
+      }
+      if (!forward && !recorder) return;
+      auto* const ring = ring_.load(std::memory_order_acquire);
       // Copy slot under lock so the local copy survives concurrent
       // setSlot() during dispatch (Block_copy retain on copy ctor).
-      auto blk = [&]() noexcept {
-        std::lock_guard<std::mutex> lock(mutex_);
-        return slot_;
-      }();
-      if (!blk || !item) return;
+      Block<void, uint8_t, uint8_t, char const*, size_t> blk;
+      if (forward && !ring) {
+        blk = copySlot();
+        forward = static_cast<bool>(blk);
+      }
+      if (!forward && !recorder) return;
       auto const msg = item->getMessage();
-      blk(static_cast<uint8_t>(level),
-          static_cast<uint8_t>(item->getLayer()),
-          msg.data(), msg.size());
+      auto const rawLayer = static_cast<uint8_t>(item->getLayer());
+      auto const now = steadyNanos();
+      // The recorder keeps everything at its level, before suppression:
+      // it is the record of what actually happened.
+      if (recorder) recorder->append(rawLevel, rawLayer, now, msg.data(), msg.size());
+      if (!forward) return;
+      auto* const throttle = throttle_.load(std::memory_order_acquire);
+      if (throttle && throttle->enabled()) {
+        LogSummary summaries[LogThrottle::MaxSummariesPerItem];
+        size_t count = 0;
+        auto const admitted = throttle->admit(rawLevel, rawLayer, msg.data(), msg.size(),
+                                              now, summaries, count);
+        for (size_t i = 0; i < count; ++i) {
+          auto const& summary = summaries[i];
+          emit(ring, blk, summary.level, summary.layer, summary.text, summary.size, now);
+        }
+        if (!admitted) return;
+      }
+      emit(ring, blk, rawLevel, rawLayer, msg.data(), msg.size(), now);
+    }
+
+    Block<void, uint8_t, uint8_t, char const*, size_t> copySlot() const noexcept {
+      std::lock_guard<std::mutex> lock(mutex_);
+      return slot_;
+    }
+
+    static void emit(LogRing* ring,
+                     Block<void, uint8_t, uint8_t, char const*, size_t> const& blk,
+                     uint8_t level, uint8_t layer, char const* data, size_t size,
+                     uint64_t now) noexcept {
+      if (ring) {
+        ring->tryPush(level, layer, now, data, size);
+      } else if (blk) {
+        blk(level, layer, data, size);
+      }
     }
 
     mutable std::mutex mutex_;
     Block<void, uint8_t, uint8_t, char const*, size_t> slot_;
+    Block<void, LogRecord const*, size_t> batchSlot_;
+    std::atomic<LogRing*> ring_{nullptr};
+    std::array<std::atomic<uint8_t>, LogLayerCount + 1> thresholds_{};
+    std::atomic<LogThrottle*> throttle_{nullptr};
+    std::atomic<FlightRecorder*> recorder_{nullptr};
+    std::atomic<uint8_t> recorderLevel_{LayerLevelInherit};
+    std::array<std::atomic<uint64_t>, LogCountsSize> counts_{};
   };
 
-  LoggerOwner() noexcept = default;
+  LoggerOwner() noexcept {
+    layerOverrides_.fill(LayerLevelInherit);
+    baseLevel_ = static_cast<uint8_t>(la::avdecc::logger::Logger::getInstance().getLevel());
+    for (size_t i = 0; i <= LogLayerCount; ++i) observer_.setThreshold(i, baseLevel_);
+  }
   ~LoggerOwner() noexcept { close(); }
 
+  /// Drainer thread body. The thread holds its own reference to the
+  /// ring, so a drainer detached by close() from inside the batch block
+  /// can still see `abandoned()` after the owner is gone.
+  void drainLoop(LogRing& ring, std::unique_ptr<LogRecord[]> batch) noexcept {
+    for (;;) {
+      auto const count = ring.drain(batch.get(), LogBatchCapacity);
+      if (count) {
+        auto blk = observer_.copyBatchSlot();
+        if (blk) blk(batch.get(), count);
+        if (ring.abandoned()) return;
+        continue;
+      }
+      if (!ring.waitForRecords()) return;
+    }
+  }
+
+  // levelsLock_ held.
+  uint8_t effectiveLevel(size_t layer) const noexcept {
+    if (layer >= LogLayerCount || layerOverrides_[layer] == LayerLevelInherit) {
+      return baseLevel_;
+    }
+    return layerOverrides_[layer];
+  }
+
+  // levelsLock_ held. Publishes the table to the observer and lowers (or
+  // raises) la_avdecc's global level to the most permissive entry, the
+  // flight recorder's and counting level included.
+  void applyLevels() noexcept {
+    auto global = std::min({baseLevel_, recorderLevel_, countingLevel_});
+    for (size_t i = 0; i <= LogLayerCount; ++i) {
+      auto const level = effectiveLevel(i);
+      observer_.setThreshold(i, level);
+      global = std::min(global, level);
+    }
+    la::avdecc::logger::Logger::getInstance().setLevel(
+        static_cast<la::avdecc::logger::Level>(global));
+  }
+
   Observer observer_;
   bool registered_ = false;
+  bool closed_ = false;
+  mutable std::mutex levelsLock_;
+  uint8_t baseLevel_ = 0;
+  std::array<uint8_t, LogLayerCount> layerOverrides_{};
+  uint8_t recorderLevel_ = LayerLevelInherit;
+  uint8_t countingLevel_ = LayerLevelInherit;
+  std::unique_ptr<FlightRecorder> recorder_;
+  std::shared_ptr<LogRing> ring_;
+  std::thread drainer_;
+  mutable std::mutex throttleLock_;
+  std::unique_ptr<LogThrottle> throttle_;
+};
+
+/* ------------------------------------------------------------------- */
+/* Callback delivery                                                   */
+/* ------------------------------------------------------------------- */
+
+class CallbackShardsOwner;
+
+} // namespace AVDECCSwift
+
+void AVDECCSwift_CallbackShardsOwner_retain(AVDECCSwift::CallbackShardsOwner* p) noexcept;
+void AVDECCSwift_CallbackShardsOwner_release(AVDECCSwift::CallbackShardsOwner* p) noexcept;
+
+namespace AVDECCSwift {
+
+/// Swift handle on a CallbackShards (AVDECCSwiftDelivery.hpp). Attached
+/// to a ProtocolInterfaceOwner and/or LocalEntityOwner through their
+/// `setCallbackShards`; one instance may serve several of them, in which
+/// case an entity's PI notifications and delegate callbacks share a
+/// shard and stay mutually ordered.
+class SWIFT_SHARED_REFERENCE(AVDECCSwift_CallbackShardsOwner_retain,
+                             AVDECCSwift_CallbackShardsOwner_release)
+    CallbackShardsOwner final
+    : public IntrusiveReferenceCounted<CallbackShardsOwner> {
+public:
+  /// Returns nullptr with `outErr` filled if the queues cannot be
+  /// created.
+  SWIFT_RETURNS_RETAINED
+  static CallbackShardsOwner* create(std::string const& label, uint32_t count,
+                                     CapturedException& outErr) noexcept {
+    return invokeCapturingException(outErr, [&]() -> CallbackShardsOwner* {
+      return new CallbackShardsOwner(CallbackShards::create(label, count));
+    });
+  }
+
+  uint32_t count() const noexcept { return shards_->count(); }
+
+  /// Block until every callback submitted so far has been delivered.
+  /// No-op when called from inside a delivered callback.
+  void flush() const noexcept { shards_->flush(); }
+
+  std::shared_ptr<CallbackShards> const& shared() const noexcept { return shards_; }
+
+private:
+  friend class IntrusiveReferenceCounted<CallbackShardsOwner>;
+  explicit CallbackShardsOwner(std::shared_ptr<CallbackShards> shards) noexcept
+      : shards_(std::move(shards)) {}
+
+  std::shared_ptr<CallbackShards> shards_;
+};
+
+class CallbackEventStreamOwner;
+
+} // namespace AVDECCSwift
+
+void AVDECCSwift_CallbackEventStreamOwner_retain(AVDECCSwift::CallbackEventStreamOwner* p) noexcept;
+void AVDECCSwift_CallbackEventStreamOwner_release(AVDECCSwift::CallbackEventStreamOwner* p) noexcept;
+
+namespace AVDECCSwift {
+
+/// Swift handle on one CallbackEventRing (AVDECCSwiftEventStream.hpp):
+/// the consumer end of an event stream. Attached to one
+/// ProtocolInterfaceOwner or LocalEntityOwner through
+/// `attachEventStream`; closed by `detachEventStream` or the owner's
+/// `close()`.
+class SWIFT_SHARED_REFERENCE(AVDECCSwift_CallbackEventStreamOwner_retain,
+                             AVDECCSwift_CallbackEventStreamOwner_release)
+    CallbackEventStreamOwner final
+    : public IntrusiveReferenceCounted<CallbackEventStreamOwner> {
+public:
+  /// `depth` records are allocated up front; `overflow` is a
+  /// CallbackEventOverflow. `ready` is called (on a la_avdecc thread)
+  /// when an event arrives after `arm()`, and on close. Returns nullptr
+  /// with `outErr` filled if the ring cannot be allocated.
+  SWIFT_RETURNS_RETAINED
+  static CallbackEventStreamOwner* create(uint32_t depth, uint8_t overflow, void (^ready)(),
+                                          CapturedException& outErr) noexcept {
+    return invokeCapturingException(outErr, [&]() -> CallbackEventStreamOwner* {
+      return new CallbackEventStreamOwner(CallbackEventRing::create(
+          depth, static_cast<CallbackEventOverflow>(overflow), Block<void>(ready)));
+    });
+  }
+
+  size_t depth() const noexcept { return ring_->depth(); }
+  /// See CallbackEventRing::drain.
+  size_t drain(CallbackEventRecord* out, size_t max) noexcept { return ring_->drain(out, max); }
+  /// See CallbackEventRing::arm.
+  bool arm() noexcept { return ring_->arm(); }
+  void close() noexcept { ring_->close(); }
+  bool closed() const noexcept { return ring_->closed(); }
+
+  uint64_t recorded() const noexcept { return ring_->recorded(); }
+  uint64_t dropped() const noexcept { return ring_->dropped(); }
+  uint64_t coalesced() const noexcept { return ring_->coalesced(); }
+
+  std::shared_ptr<CallbackEventRing> const& shared() const noexcept { return ring_; }
+
+private:
+  friend class IntrusiveReferenceCounted<CallbackEventStreamOwner>;
+  explicit CallbackEventStreamOwner(std::shared_ptr<CallbackEventRing> ring) noexcept
+      : ring_(std::move(ring)) {}
+  ~CallbackEventStreamOwner() noexcept { ring_->close(); }
+
+  std::shared_ptr<CallbackEventRing> const ring_;
 };
 
 /* ------------------------------------------------------------------- */
@@ -538,6 +1904,22 @@ inline size_t entity_getInterfaceInformationCount(
 // Callers must pass a pointer to the matching la_avdecc PDU type — the
 // Swift wrapper structs (Aecpdu / AemAecpdu / Acmpdu) enforce this at
 // construction.
+inline uint64_t adpdu_getEntityID(void const* p) noexcept {
+  return static_cast<Adpdu const*>(p)->getEntityID().getValue();
+}
+inline uint64_t adpdu_getEntityModelID(void const* p) noexcept {
+  return static_cast<Adpdu const*>(p)->getEntityModelID().getValue();
+}
+inline uint8_t adpdu_getMessageType(void const* p) noexcept {
+  return static_cast<Adpdu const*>(p)->getMessageType().getValue();
+}
+inline uint8_t adpdu_getValidTime(void const* p) noexcept {
+  return static_cast<Adpdu const*>(p)->getValidTime();
+}
+inline uint32_t adpdu_getAvailableIndex(void const* p) noexcept {
+  return static_cast<Adpdu const*>(p)->getAvailableIndex();
+}
+
 inline uint64_t aecpdu_getTargetEntityID(void const* p) noexcept {
   return static_cast<Aecpdu const*>(p)->getTargetEntityID().getValue();
 }
@@ -810,6 +2192,23 @@ inline void aem_aecpdu_setCommandSpecificData(
   static_cast<AemAecpdu*>(p)->setCommandSpecificData(data, len);
 }
 
+/// A slot-table snapshot plus the adapter override that took it: batched
+/// and profiled events are keyed by slot offset within the table and
+/// named after the site.
+template <typename Snapshot>
+struct SiteSnapshot {
+  Snapshot table;
+  char const* site;
+  auto operator->() const noexcept { return table.operator->(); }
+};
+
+/// Byte offset of `blk` within the slots `snapshot` points at.
+template <typename Snapshot, typename BlockT>
+uint32_t slotOffsetIn(Snapshot const& snapshot, BlockT const& blk) noexcept {
+  return static_cast<uint32_t>(reinterpret_cast<char const*>(&blk) -
+                               reinterpret_cast<char const*>(&*snapshot.table));
+}
+
 /// Concrete subclass of la::avdecc::protocol::ProtocolInterface::Observer
 /// that dispatches each virtual to a stored clang block. Swift sets the
 /// blocks at runtime; null blocks are no-ops. PDU pointers are passed
@@ -822,11 +2221,19 @@ inline void aem_aecpdu_setCommandSpecificData(
 ///
 /// Thread-safety: la_avdecc fires observer callbacks on its executor
 /// thread. Swift may concurrently rebind / clear slots from any thread.
-/// All slot reads and writes are serialised by `slotsMutex_`. Each
-/// notification override copies the slot under the lock (Block<> copy
-/// ctor calls Block_copy) and invokes the local copy outside the lock,
-/// so observer callbacks run without holding our mutex and may freely
-/// re-enter ProtocolInterfaceOwner.
+/// The slots live in a SlotTable (AVDECCSwiftSlotTable.hpp): each
+/// notification override reads them through a snapshot and invokes the
+/// block in place, without a lock or a Block_copy, while a setter
+/// publishes a changed copy. Callbacks hold no lock of ours and may
+/// freely re-enter ProtocolInterfaceOwner, rebinding slots included.
+/// An override whose slot is unbound returns after checking the table's
+/// installed-slots mask, before taking a snapshot, unless event streams
+/// are attached: those record every event, bound or not, into their own
+/// rings (AVDECCSwiftEventStream.hpp) before the block is called.
+///
+/// With `setShards`, the local block copy and owned copies of the
+/// arguments are handed to a CallbackShards queue instead, keyed by the
+/// event's entity ID; see AVDECCSwiftDelivery.hpp.
 ///
 /// Callback contract: Swift closures bridged through Block<> must not
 /// throw C++ exceptions. The block invocation in `Block<>::operator()`
@@ -836,138 +2243,307 @@ inline void aem_aecpdu_setCommandSpecificData(
 class BlockProtocolInterfaceObserver final
     : public la::avdecc::protocol::ProtocolInterface::Observer {
 public:
-  // Slot accessor used by ProtocolInterfaceOwner setters: takes the
-  // slots-mutex, then assigns under the lock. The Block<> wrapper's
+  struct Slots;
+
+  // Slot accessor used by ProtocolInterfaceOwner setters: publishes a
+  // copy of the slots with `slot` replaced. The Block<> wrapper's
   // copy/move assignment handles Block_copy / Block_release of the
   // outgoing/incoming pointer.
   template <typename SlotT, typename ValueT>
-  void setSlot(SlotT BlockProtocolInterfaceObserver::* slot, ValueT&& value) noexcept {
-    std::lock_guard<std::mutex> lock(slotsMutex_);
-    (this->*slot) = std::forward<ValueT>(value);
+  void setSlot(SlotT Slots::* slot, ValueT&& value) noexcept {
+    slots_.set(slot, std::forward<ValueT>(value));
+  }
+
+  // Route subsequent callbacks through `shards` (nullptr: inline on the
+  // executor, the default). Callbacks already handed to the previous
+  // shards still run there.
+  void setShards(std::shared_ptr<CallbackShards> shards) noexcept {
+    std::atomic_store_explicit(&shards_, std::move(shards), std::memory_order_release);
   }
 
-  // Bulk reset under one lock. Called from ProtocolInterfaceOwner when
+  // Record every received PDU into `capture` (nullptr: stop recording).
+  // Receipts already past the check may still reach the previous one.
+  void setCapture(std::shared_ptr<PduCapture> capture) noexcept {
+    capturing_.store(capture != nullptr, std::memory_order_relaxed);
+    std::atomic_store_explicit(&capture_, std::move(capture), std::memory_order_release);
+  }
+
+  // Queue the follow-up work of each job handling a received ACMP PDU on
+  // the Interactive lane (false: Bulk, like everything else).
+  void setAcmpInteractive(bool enabled) noexcept {
+    acmpInteractive_.store(enabled, std::memory_order_relaxed);
+  }
+
+  // Report every received PDU to `probe` (nullptr: stop), which matches
+  // it to a replayed send; see AVDECCSwiftPduReplay.hpp.
+  void setReplayProbe(std::shared_ptr<PduReplayProbe> probe) noexcept {
+    probing_.store(probe != nullptr, std::memory_order_relaxed);
+    std::atomic_store_explicit(&replayProbe_, std::move(probe), std::memory_order_release);
+  }
+
+  // Bulk reset in one update. Called from ProtocolInterfaceOwner when
   // the observer is being detached.
   void clearAllSlots() noexcept {
-    std::lock_guard<std::mutex> lock(slotsMutex_);
-    onTransportError_.reset();
-    onLocalEntityOnline_.reset();
-    onLocalEntityOffline_.reset();
-    onLocalEntityUpdated_.reset();
-    onRemoteEntityOnline_.reset();
-    onRemoteEntityOffline_.reset();
-    onRemoteEntityUpdated_.reset();
-    onAecpCommand_.reset();
-    onAecpAemUnsolicitedResponse_.reset();
-    onAecpAemIdentifyNotification_.reset();
-    onAcmpCommand_.reset();
-    onAcmpResponse_.reset();
+    slots_.clear();
   }
 
 private:
   friend class ProtocolInterfaceOwner;
 
-  // Copy a slot under the lock and return the local copy. Block<>'s copy
-  // ctor calls Block_copy, so the returned value owns its own retain;
-  // releasing it (when the local goes out of scope) is independent of
-  // any further assignment to the slot from another thread.
+  // Snapshot of the slots; blocks are called through it in place and
+  // stay alive until it goes out of scope, whatever setters do meanwhile.
+  // (Deduced: naming SlotTable<Slots>::Snapshot here would need Slots
+  // complete.) `site` defaults to the calling override's name, which the
+  // executor's stall watchdog reports if the callback then blocks.
+  auto readSlots(char const* site = __builtin_FUNCTION()) const noexcept {
+    markJobSite(site);
+    return SiteSnapshot<decltype(slots_.read())>{slots_.read(), site};
+  }
+
+  // Whether an override has anyone to tell: its block or a stream.
   template <typename SlotT>
-  SlotT copySlotLocked(SlotT const& slot) const noexcept {
-    std::lock_guard<std::mutex> lock(slotsMutex_);
-    return slot;
+  bool wanted(SlotT Slots::* slot) const noexcept {
+    return slots_.installed(slot) || streams_.active();
+  }
+
+  // Record the event into any attached streams, then hand
+  // `proj(blk, args...)` to the attached shards, or run it inline; timed
+  // per slot while profiling.
+  template <typename View, typename BlockT, typename Project, typename... Args>
+  void deliver(View const& slots, uint64_t key, BlockT const& blk, Project proj,
+               Args const&... args) const noexcept {
+    if (streams_.active()) {
+      proj(CallbackEventRecorder<BlockT>{streams_, slots.site, key, slotOffsetIn(slots, blk)},
+           args...);
+    }
+    if (!blk) return;
+    auto const shards = std::atomic_load_explicit(&shards_, std::memory_order_acquire);
+    if (profiler_->enabled()) {
+      deliverCallback(shards, key, blk,
+                      ProfiledProjection<Project>{proj, profiler_, slotOffsetIn(slots, blk),
+                                                  slots.site},
+                      args...);
+      return;
+    }
+    deliverCallback(shards, key, blk, proj, args...);
+  }
+
+  // Hand a received PDU to the pcapng capture and the replay probe, if
+  // attached. Off, each is one relaxed load.
+  template <typename Pdu>
+  void noteReceived(Pdu const& pdu) const noexcept {
+    if (capturing_.load(std::memory_order_relaxed)) {
+      if (auto const capture = std::atomic_load_explicit(&capture_, std::memory_order_acquire)) {
+        capture->record(PduCaptureDirection::Inbound, pdu);
+      }
+    }
+    if (probing_.load(std::memory_order_relaxed)) {
+      if (auto const probe =
+              std::atomic_load_explicit(&replayProbe_, std::memory_order_acquire)) {
+        probe->received();
+      }
+    }
   }
 
   void onTransportError(la::avdecc::protocol::ProtocolInterface* pi) noexcept override {
-    auto blk = copySlotLocked(onTransportError_);
-    if (blk) blk(pi);
+    if (!wanted(&Slots::onTransportError_)) return;
+    auto const slots = readSlots();
+    auto const& blk = slots->onTransportError_;
+    deliver(slots, 0, blk, [](auto const& blk, auto const& pi) { blk(pi); }, pi);
   }
   void onLocalEntityOnline(la::avdecc::protocol::ProtocolInterface* pi,
                            la::avdecc::entity::Entity const& e) noexcept override {
-    auto blk = copySlotLocked(onLocalEntityOnline_);
-    if (blk) blk(pi, &e);
+    if (!wanted(&Slots::onLocalEntityOnline_)) return;
+    auto const slots = readSlots();
+    auto const& blk = slots->onLocalEntityOnline_;
+    deliver(slots, e.getEntityID().getValue(), blk,
+            [](auto const& blk, auto const& pi, auto const& e) { blk(pi, &e); }, pi, e);
   }
   void onLocalEntityOffline(la::avdecc::protocol::ProtocolInterface* pi,
                             la::avdecc::UniqueIdentifier const id) noexcept override {
-    auto blk = copySlotLocked(onLocalEntityOffline_);
-    if (blk) blk(pi, id.getValue());
+    if (!wanted(&Slots::onLocalEntityOffline_)) return;
+    auto const slots = readSlots();
+    auto const& blk = slots->onLocalEntityOffline_;
+    deliver(slots, id.getValue(), blk,
+            [](auto const& blk, auto const& pi, auto const& id) { blk(pi, id.getValue()); }, pi, id);
   }
   void onLocalEntityUpdated(la::avdecc::protocol::ProtocolInterface* pi,
                             la::avdecc::entity::Entity const& e) noexcept override {
-    auto blk = copySlotLocked(onLocalEntityUpdated_);
-    if (blk) blk(pi, &e);
+    if (!wanted(&Slots::onLocalEntityUpdated_)) return;
+    auto const slots = readSlots();
+    auto const& blk = slots->onLocalEntityUpdated_;
+    deliver(slots, e.getEntityID().getValue(), blk,
+            [](auto const& blk, auto const& pi, auto const& e) { blk(pi, &e); }, pi, e);
   }
   void onRemoteEntityOnline(la::avdecc::protocol::ProtocolInterface* pi,
                             la::avdecc::entity::Entity const& e) noexcept override {
-    auto blk = copySlotLocked(onRemoteEntityOnline_);
-    if (blk) blk(pi, &e);
+    updateFilter_.seed(e);
+    if (!wanted(&Slots::onRemoteEntityOnline_)) return;
+    auto const slots = readSlots();
+    auto const& blk = slots->onRemoteEntityOnline_;
+    deliver(slots, e.getEntityID().getValue(), blk,
+            [](auto const& blk, auto const& pi, auto const& e) { blk(pi, &e); }, pi, e);
   }
   void onRemoteEntityOffline(la::avdecc::protocol::ProtocolInterface* pi,
                              la::avdecc::UniqueIdentifier const id) noexcept override {
-    auto blk = copySlotLocked(onRemoteEntityOffline_);
-    if (blk) blk(pi, id.getValue());
+    updateFilter_.forget(id);
+    if (!wanted(&Slots::onRemoteEntityOffline_)) return;
+    auto const slots = readSlots();
+    auto const& blk = slots->onRemoteEntityOffline_;
+    deliver(slots, id.getValue(), blk,
+            [](auto const& blk, auto const& pi, auto const& id) { blk(pi, id.getValue()); }, pi, id);
   }
   void onRemoteEntityUpdated(la::avdecc::protocol::ProtocolInterface* pi,
                              la::avdecc::entity::Entity const& e) noexcept override {
-    auto blk = copySlotLocked(onRemoteEntityUpdated_);
-    if (blk) blk(pi, &e);
+    if (!wanted(&Slots::onRemoteEntityUpdated_)) return;
+    if (!updateFilter_.admit(e)) return;
+    auto const slots = readSlots();
+    auto const& blk = slots->onRemoteEntityUpdated_;
+    deliver(slots, e.getEntityID().getValue(), blk,
+            [](auto const& blk, auto const& pi, auto const& e) { blk(pi, &e); }, pi, e);
   }
   void onAecpCommand(la::avdecc::protocol::ProtocolInterface* pi,
                      la::avdecc::protocol::Aecpdu const& pdu) noexcept override {
-    auto blk = copySlotLocked(onAecpCommand_);
-    if (blk) blk(pi, &pdu);
+    if (!wanted(&Slots::onAecpCommand_)) return;
+    auto const slots = readSlots();
+    auto const& blk = slots->onAecpCommand_;
+    deliver(slots, pdu.getTargetEntityID().getValue(), blk,
+            [](auto const& blk, auto const& pi, auto const& pdu) { blk(pi, &pdu); }, pi, pdu);
   }
   void onAecpAemUnsolicitedResponse(la::avdecc::protocol::ProtocolInterface* pi,
                                     la::avdecc::protocol::AemAecpdu const& pdu) noexcept override {
-    auto blk = copySlotLocked(onAecpAemUnsolicitedResponse_);
-    if (blk) blk(pi, &pdu);
+    if (!wanted(&Slots::onAecpAemUnsolicitedResponse_)) return;
+    auto const slots = readSlots();
+    auto const& blk = slots->onAecpAemUnsolicitedResponse_;
+    deliver(slots, pdu.getTargetEntityID().getValue(), blk,
+            [](auto const& blk, auto const& pi, auto const& pdu) { blk(pi, &pdu); }, pi, pdu);
   }
   void onAecpAemIdentifyNotification(la::avdecc::protocol::ProtocolInterface* pi,
                                      la::avdecc::protocol::AemAecpdu const& pdu) noexcept override {
-    auto blk = copySlotLocked(onAecpAemIdentifyNotification_);
-    if (blk) blk(pi, &pdu);
+    if (!wanted(&Slots::onAecpAemIdentifyNotification_)) return;
+    auto const slots = readSlots();
+    auto const& blk = slots->onAecpAemIdentifyNotification_;
+    deliver(slots, pdu.getTargetEntityID().getValue(), blk,
+            [](auto const& blk, auto const& pi, auto const& pdu) { blk(pi, &pdu); }, pi, pdu);
   }
   void onAcmpCommand(la::avdecc::protocol::ProtocolInterface* pi,
                      la::avdecc::protocol::Acmpdu const& pdu) noexcept override {
-    auto blk = copySlotLocked(onAcmpCommand_);
-    if (blk) blk(pi, &pdu);
+    if (!wanted(&Slots::onAcmpCommand_)) return;
+    auto const slots = readSlots();
+    auto const& blk = slots->onAcmpCommand_;
+    deliver(slots, pdu.getListenerEntityID().getValue(), blk,
+            [](auto const& blk, auto const& pi, auto const& pdu) { blk(pi, &pdu); }, pi, pdu);
   }
   void onAcmpResponse(la::avdecc::protocol::ProtocolInterface* pi,
                       la::avdecc::protocol::Acmpdu const& pdu) noexcept override {
-    auto blk = copySlotLocked(onAcmpResponse_);
-    if (blk) blk(pi, &pdu);
-  }
-  // onAdpduReceived / onAecpduReceived / onAcmpduReceived inherit the
-  // base no-op; we don't expose them to Swift yet. (Add slots + setters
-  // following the pattern above when needed.)
-
-  mutable std::mutex slotsMutex_;
-
-  Block<void, la::avdecc::protocol::ProtocolInterface*> onTransportError_;
-
-  Block<void, la::avdecc::protocol::ProtocolInterface*,
-        la::avdecc::entity::Entity const*> onLocalEntityOnline_;
-  Block<void, la::avdecc::protocol::ProtocolInterface*,
-        uint64_t /*entityID*/> onLocalEntityOffline_;
-  Block<void, la::avdecc::protocol::ProtocolInterface*,
-        la::avdecc::entity::Entity const*> onLocalEntityUpdated_;
-  Block<void, la::avdecc::protocol::ProtocolInterface*,
-        la::avdecc::entity::Entity const*> onRemoteEntityOnline_;
-  Block<void, la::avdecc::protocol::ProtocolInterface*,
-        uint64_t /*entityID*/> onRemoteEntityOffline_;
-  Block<void, la::avdecc::protocol::ProtocolInterface*,
-        la::avdecc::entity::Entity const*> onRemoteEntityUpdated_;
-
-  Block<void, la::avdecc::protocol::ProtocolInterface*,
-        la::avdecc::protocol::Aecpdu const*> onAecpCommand_;
-  Block<void, la::avdecc::protocol::ProtocolInterface*,
-        la::avdecc::protocol::AemAecpdu const*> onAecpAemUnsolicitedResponse_;
-  Block<void, la::avdecc::protocol::ProtocolInterface*,
-        la::avdecc::protocol::AemAecpdu const*> onAecpAemIdentifyNotification_;
-
-  Block<void, la::avdecc::protocol::ProtocolInterface*,
-        la::avdecc::protocol::Acmpdu const*> onAcmpCommand_;
-  Block<void, la::avdecc::protocol::ProtocolInterface*,
-        la::avdecc::protocol::Acmpdu const*> onAcmpResponse_;
+    if (!wanted(&Slots::onAcmpResponse_)) return;
+    auto const slots = readSlots();
+    auto const& blk = slots->onAcmpResponse_;
+    deliver(slots, pdu.getListenerEntityID().getValue(), blk,
+            [](auto const& blk, auto const& pi, auto const& pdu) { blk(pi, &pdu); }, pi, pdu);
+  }
+
+  // Raw PDU taps: every received PDU, before la_avdecc processes it.
+  // Off until a filter is set; only PDUs it matches reach the slot (see
+  // AVDECCSwiftPduFilter.hpp). A running pcapng capture and a replay
+  // probe see every PDU, whatever the filter.
+  void onAdpduReceived(la::avdecc::protocol::ProtocolInterface* pi,
+                       la::avdecc::protocol::Adpdu const& pdu) noexcept override {
+    noteReceived(pdu);
+    auto& tap = taps_[static_cast<size_t>(PduTapKind::Adp)];
+    if (!tap.enabled() || !wanted(&Slots::onAdpduReceived_)) return;
+    if (!tap.admit(pdu)) return;
+    auto const slots = readSlots();
+    auto const& blk = slots->onAdpduReceived_;
+    deliver(slots, pdu.getEntityID().getValue(), blk,
+            [](auto const& blk, auto const& pi, auto const& pdu) { blk(pi, &pdu); }, pi, pdu);
+  }
+  void onAecpduReceived(la::avdecc::protocol::ProtocolInterface* pi,
+                        la::avdecc::protocol::Aecpdu const& pdu) noexcept override {
+    noteReceived(pdu);
+    auto& tap = taps_[static_cast<size_t>(PduTapKind::Aecp)];
+    if (!tap.enabled() || !wanted(&Slots::onAecpduReceived_)) return;
+    if (!tap.admit(pdu)) return;
+    auto const slots = readSlots();
+    auto const& blk = slots->onAecpduReceived_;
+    deliver(slots, pdu.getTargetEntityID().getValue(), blk,
+            [](auto const& blk, auto const& pi, auto const& pdu) { blk(pi, &pdu); }, pi, pdu);
+  }
+  void onAcmpduReceived(la::avdecc::protocol::ProtocolInterface* pi,
+                        la::avdecc::protocol::Acmpdu const& pdu) noexcept override {
+    // Raised ahead of la_avdecc's own ACMP processing in the same job, so
+    // the state-machine work that follows is queued Interactive.
+    if (acmpInteractive_.load(std::memory_order_relaxed)) {
+      promoteRunningJob(ExecutorLane::Interactive);
+    }
+    noteReceived(pdu);
+    auto& tap = taps_[static_cast<size_t>(PduTapKind::Acmp)];
+    if (!tap.enabled() || !wanted(&Slots::onAcmpduReceived_)) return;
+    if (!tap.admit(pdu)) return;
+    auto const slots = readSlots();
+    auto const& blk = slots->onAcmpduReceived_;
+    deliver(slots, pdu.getListenerEntityID().getValue(), blk,
+            [](auto const& blk, auto const& pi, auto const& pdu) { blk(pi, &pdu); }, pi, pdu);
+  }
+
+  // Accessed only through std::atomic_load/store.
+  std::shared_ptr<CallbackShards> shards_;
+
+public:
+  struct Slots {
+    Block<void, la::avdecc::protocol::ProtocolInterface*> onTransportError_;
+
+    Block<void, la::avdecc::protocol::ProtocolInterface*,
+          la::avdecc::entity::Entity const*> onLocalEntityOnline_;
+    Block<void, la::avdecc::protocol::ProtocolInterface*,
+          uint64_t /*entityID*/> onLocalEntityOffline_;
+    Block<void, la::avdecc::protocol::ProtocolInterface*,
+          la::avdecc::entity::Entity const*> onLocalEntityUpdated_;
+    Block<void, la::avdecc::protocol::ProtocolInterface*,
+          la::avdecc::entity::Entity const*> onRemoteEntityOnline_;
+    Block<void, la::avdecc::protocol::ProtocolInterface*,
+          uint64_t /*entityID*/> onRemoteEntityOffline_;
+    Block<void, la::avdecc::protocol::ProtocolInterface*,
+          la::avdecc::entity::Entity const*> onRemoteEntityUpdated_;
+
+    Block<void, la::avdecc::protocol::ProtocolInterface*,
+          la::avdecc::protocol::Aecpdu const*> onAecpCommand_;
+    Block<void, la::avdecc::protocol::ProtocolInterface*,
+          la::avdecc::protocol::AemAecpdu const*> onAecpAemUnsolicitedResponse_;
+    Block<void, la::avdecc::protocol::ProtocolInterface*,
+          la::avdecc::protocol::AemAecpdu const*> onAecpAemIdentifyNotification_;
+
+    Block<void, la::avdecc::protocol::ProtocolInterface*,
+          la::avdecc::protocol::Acmpdu const*> onAcmpCommand_;
+    Block<void, la::avdecc::protocol::ProtocolInterface*,
+          la::avdecc::protocol::Acmpdu const*> onAcmpResponse_;
+
+    Block<void, la::avdecc::protocol::ProtocolInterface*,
+          la::avdecc::protocol::Adpdu const*> onAdpduReceived_;
+    Block<void, la::avdecc::protocol::ProtocolInterface*,
+          la::avdecc::protocol::Aecpdu const*> onAecpduReceived_;
+    Block<void, la::avdecc::protocol::ProtocolInterface*,
+          la::avdecc::protocol::Acmpdu const*> onAcmpduReceived_;
+  };
+
+private:
+  SlotTable<Slots> slots_;
+  // Change-only filtering of onRemoteEntityUpdated; see
+  // AVDECCSwiftEntityFilter.hpp.
+  EntityUpdateFilter updateFilter_;
+  // Per-slot invocation counts and latencies; see AVDECCSwiftSlotProfile.hpp.
+  std::shared_ptr<SlotProfiler> const profiler_ = SlotProfiler::create();
+  // Attached event streams; see AVDECCSwiftEventStream.hpp.
+  CallbackEventStreams streams_;
+  // Raw PDU tap filters, indexed by PduTapKind.
+  PduTap taps_[PduTapCount];
+  // Running pcapng capture; accessed only through std::atomic_load/store.
+  std::shared_ptr<PduCapture> capture_;
+  std::atomic<bool> capturing_{false};
+  // Probe of the replay feeding this interface; same access rule.
+  std::shared_ptr<PduReplayProbe> replayProbe_;
+  std::atomic<bool> probing_{false};
+  std::atomic<bool> acmpInteractive_{true};
 };
 
 /// Owns an la_avdecc ProtocolInterface (move-only `UniquePointer`) plus the
@@ -996,7 +2572,14 @@ public:
       auto pi = la::avdecc::protocol::ProtocolInterface::create(
           static_cast<la::avdecc::protocol::ProtocolInterface::Type>(type),
           networkInterfaceID, executorName);
-      return new ProtocolInterfaceOwner(std::move(pi));
+      auto* owner =
+          new ProtocolInterfaceOwner(std::move(pi), type, networkInterfaceID, executorName);
+      // ACMP lane promotion is on by default and needs the observer.
+      {
+        std::lock_guard<std::mutex> lg(owner->attachLock_);
+        owner->updateObserverAttachment();
+      }
+      return owner;
     });
   }
 
@@ -1004,11 +2587,15 @@ public:
   /// ProtocolInterface (which also unwinds la_avdecc's static
   /// ProtocolInterfaceManager entry). Outlives until refcount hits 0.
   void close() noexcept {
+    if (!pi_) return;
+    stopPduCapture();
+    std::lock_guard<std::mutex> lg(attachLock_);
     if (!pi_) return;
     if (observerAttached_) {
       pi_->Subject::unregisterObserver(&observer_);
       observerAttached_ = false;
     }
+    observer_.streams_.closeAll();
     pi_.reset();
   }
 
@@ -1092,23 +2679,41 @@ public:
   // Transport support: only when isDirectMessageSupported() is true (PCAP
   // transport on Linux + macOS; macOS-native is not). On unsupported
   // transports la_avdecc returns TransportError.
+  //
+  // A running pcapng capture records each PDU these send successfully,
+  // stamped with the time just before the send.
   uint8_t sendAdpMessage(void const* pdu) const noexcept {
     if (!pi_ || !pdu) return static_cast<uint8_t>(
         la::avdecc::protocol::ProtocolInterface::Error::InvalidParameters);
-    return static_cast<uint8_t>(pi_->sendAdpMessage(
-        *static_cast<la::avdecc::protocol::Adpdu const*>(pdu)));
+    auto const& typed = *static_cast<la::avdecc::protocol::Adpdu const*>(pdu);
+    auto const sentAt = captureSendTime();
+    auto const error = pi_->sendAdpMessage(typed);
+    if (error == la::avdecc::protocol::ProtocolInterface::Error::NoError) {
+      captureSent(typed, sentAt);
+    }
+    return static_cast<uint8_t>(error);
   }
   uint8_t sendAecpMessage(void const* pdu) const noexcept {
     if (!pi_ || !pdu) return static_cast<uint8_t>(
         la::avdecc::protocol::ProtocolInterface::Error::InvalidParameters);
-    return static_cast<uint8_t>(pi_->sendAecpMessage(
-        *static_cast<la::avdecc::protocol::Aecpdu const*>(pdu)));
+    auto const& typed = *static_cast<la::avdecc::protocol::Aecpdu const*>(pdu);
+    auto const sentAt = captureSendTime();
+    auto const error = pi_->sendAecpMessage(typed);
+    if (error == la::avdecc::protocol::ProtocolInterface::Error::NoError) {
+      captureSent(typed, sentAt);
+    }
+    return static_cast<uint8_t>(error);
   }
   uint8_t sendAcmpMessage(void const* pdu) const noexcept {
     if (!pi_ || !pdu) return static_cast<uint8_t>(
         la::avdecc::protocol::ProtocolInterface::Error::InvalidParameters);
-    return static_cast<uint8_t>(pi_->sendAcmpMessage(
-        *static_cast<la::avdecc::protocol::Acmpdu const*>(pdu)));
+    auto const& typed = *static_cast<la::avdecc::protocol::Acmpdu const*>(pdu);
+    auto const sentAt = captureSendTime();
+    auto const error = pi_->sendAcmpMessage(typed);
+    if (error == la::avdecc::protocol::ProtocolInterface::Error::NoError) {
+      captureSent(typed, sentAt);
+    }
+    return static_cast<uint8_t>(error);
   }
 
   /// Observer block setters. Each one stores a clang block (in an
@@ -1121,32 +2726,32 @@ public:
   /// C++ type directly.
   ///
   /// Each setter routes through `BlockProtocolInterfaceObserver::setSlot`,
-  /// which takes the observer's slots-mutex before the assignment so it
-  /// is safe to rebind from any thread while la_avdecc is delivering
-  /// notifications on the executor thread.
+  /// which publishes a new slot table so it is safe to rebind from any
+  /// thread while la_avdecc is delivering notifications on the executor
+  /// thread.
   void setOnTransportError(void (^cb)(void* /*pi*/)) noexcept {
     using BT = void (^)(la::avdecc::protocol::ProtocolInterface*);
-    observer_.setSlot(&BlockProtocolInterfaceObserver::onTransportError_,
+    observer_.setSlot(&BlockProtocolInterfaceObserver::Slots::onTransportError_,
                       Block<void, la::avdecc::protocol::ProtocolInterface*>((BT)cb));
   }
   void setOnLocalEntityOnline(
       void (^cb)(void* /*pi*/, la::avdecc::entity::Entity const*)) noexcept {
     using BT = void (^)(la::avdecc::protocol::ProtocolInterface*,
                         la::avdecc::entity::Entity const*);
-    observer_.setSlot(&BlockProtocolInterfaceObserver::onLocalEntityOnline_,
+    observer_.setSlot(&BlockProtocolInterfaceObserver::Slots::onLocalEntityOnline_,
                       Block<void, la::avdecc::protocol::ProtocolInterface*,
                             la::avdecc::entity::Entity const*>((BT)cb));
   }
   void setOnLocalEntityOffline(void (^cb)(void* /*pi*/, uint64_t /*entityID*/)) noexcept {
     using BT = void (^)(la::avdecc::protocol::ProtocolInterface*, uint64_t);
-    observer_.setSlot(&BlockProtocolInterfaceObserver::onLocalEntityOffline_,
+    observer_.setSlot(&BlockProtocolInterfaceObserver::Slots::onLocalEntityOffline_,
                       Block<void, la::avdecc::protocol::ProtocolInterface*, uint64_t>((BT)cb));
   }
   void setOnLocalEntityUpdated(
       void (^cb)(void* /*pi*/, la::avdecc::entity::Entity const*)) noexcept {
     using BT = void (^)(la::avdecc::protocol::ProtocolInterface*,
                         la::avdecc::entity::Entity const*);
-    observer_.setSlot(&BlockProtocolInterfaceObserver::onLocalEntityUpdated_,
+    observer_.setSlot(&BlockProtocolInterfaceObserver::Slots::onLocalEntityUpdated_,
                       Block<void, la::avdecc::protocol::ProtocolInterface*,
                             la::avdecc::entity::Entity const*>((BT)cb));
   }
@@ -1154,20 +2759,20 @@ public:
       void (^cb)(void* /*pi*/, la::avdecc::entity::Entity const*)) noexcept {
     using BT = void (^)(la::avdecc::protocol::ProtocolInterface*,
                         la::avdecc::entity::Entity const*);
-    observer_.setSlot(&BlockProtocolInterfaceObserver::onRemoteEntityOnline_,
+    observer_.setSlot(&BlockProtocolInterfaceObserver::Slots::onRemoteEntityOnline_,
                       Block<void, la::avdecc::protocol::ProtocolInterface*,
                             la::avdecc::entity::Entity const*>((BT)cb));
   }
   void setOnRemoteEntityOffline(void (^cb)(void* /*pi*/, uint64_t /*entityID*/)) noexcept {
     using BT = void (^)(la::avdecc::protocol::ProtocolInterface*, uint64_t);
-    observer_.setSlot(&BlockProtocolInterfaceObserver::onRemoteEntityOffline_,
+    observer_.setSlot(&BlockProtocolInterfaceObserver::Slots::onRemoteEntityOffline_,
                       Block<void, la::avdecc::protocol::ProtocolInterface*, uint64_t>((BT)cb));
   }
   void setOnRemoteEntityUpdated(
       void (^cb)(void* /*pi*/, la::avdecc::entity::Entity const*)) noexcept {
     using BT = void (^)(la::avdecc::protocol::ProtocolInterface*,
                         la::avdecc::entity::Entity const*);
-    observer_.setSlot(&BlockProtocolInterfaceObserver::onRemoteEntityUpdated_,
+    observer_.setSlot(&BlockProtocolInterfaceObserver::Slots::onRemoteEntityUpdated_,
                       Block<void, la::avdecc::protocol::ProtocolInterface*,
                             la::avdecc::entity::Entity const*>((BT)cb));
   }
@@ -1181,7 +2786,7 @@ public:
   void setOnAecpCommand(void (^cb)(void* /*pi*/, void const* /*Aecpdu*/)) noexcept {
     using BT = void (^)(la::avdecc::protocol::ProtocolInterface*,
                         la::avdecc::protocol::Aecpdu const*);
-    observer_.setSlot(&BlockProtocolInterfaceObserver::onAecpCommand_,
+    observer_.setSlot(&BlockProtocolInterfaceObserver::Slots::onAecpCommand_,
                       Block<void, la::avdecc::protocol::ProtocolInterface*,
                             la::avdecc::protocol::Aecpdu const*>((BT)cb));
   }
@@ -1189,7 +2794,7 @@ public:
       void (^cb)(void* /*pi*/, void const* /*AemAecpdu*/)) noexcept {
     using BT = void (^)(la::avdecc::protocol::ProtocolInterface*,
                         la::avdecc::protocol::AemAecpdu const*);
-    observer_.setSlot(&BlockProtocolInterfaceObserver::onAecpAemUnsolicitedResponse_,
+    observer_.setSlot(&BlockProtocolInterfaceObserver::Slots::onAecpAemUnsolicitedResponse_,
                       Block<void, la::avdecc::protocol::ProtocolInterface*,
                             la::avdecc::protocol::AemAecpdu const*>((BT)cb));
   }
@@ -1197,21 +2802,43 @@ public:
       void (^cb)(void* /*pi*/, void const* /*AemAecpdu*/)) noexcept {
     using BT = void (^)(la::avdecc::protocol::ProtocolInterface*,
                         la::avdecc::protocol::AemAecpdu const*);
-    observer_.setSlot(&BlockProtocolInterfaceObserver::onAecpAemIdentifyNotification_,
+    observer_.setSlot(&BlockProtocolInterfaceObserver::Slots::onAecpAemIdentifyNotification_,
                       Block<void, la::avdecc::protocol::ProtocolInterface*,
                             la::avdecc::protocol::AemAecpdu const*>((BT)cb));
   }
   void setOnAcmpCommand(void (^cb)(void* /*pi*/, void const* /*Acmpdu*/)) noexcept {
     using BT = void (^)(la::avdecc::protocol::ProtocolInterface*,
                         la::avdecc::protocol::Acmpdu const*);
-    observer_.setSlot(&BlockProtocolInterfaceObserver::onAcmpCommand_,
+    observer_.setSlot(&BlockProtocolInterfaceObserver::Slots::onAcmpCommand_,
                       Block<void, la::avdecc::protocol::ProtocolInterface*,
                             la::avdecc::protocol::Acmpdu const*>((BT)cb));
   }
   void setOnAcmpResponse(void (^cb)(void* /*pi*/, void const* /*Acmpdu*/)) noexcept {
     using BT = void (^)(la::avdecc::protocol::ProtocolInterface*,
                         la::avdecc::protocol::Acmpdu const*);
-    observer_.setSlot(&BlockProtocolInterfaceObserver::onAcmpResponse_,
+    observer_.setSlot(&BlockProtocolInterfaceObserver::Slots::onAcmpResponse_,
+                      Block<void, la::avdecc::protocol::ProtocolInterface*,
+                            la::avdecc::protocol::Acmpdu const*>((BT)cb));
+  }
+
+  void setOnAdpduReceived(void (^cb)(void* /*pi*/, void const* /*Adpdu*/)) noexcept {
+    using BT = void (^)(la::avdecc::protocol::ProtocolInterface*,
+                        la::avdecc::protocol::Adpdu const*);
+    observer_.setSlot(&BlockProtocolInterfaceObserver::Slots::onAdpduReceived_,
+                      Block<void, la::avdecc::protocol::ProtocolInterface*,
+                            la::avdecc::protocol::Adpdu const*>((BT)cb));
+  }
+  void setOnAecpduReceived(void (^cb)(void* /*pi*/, void const* /*Aecpdu*/)) noexcept {
+    using BT = void (^)(la::avdecc::protocol::ProtocolInterface*,
+                        la::avdecc::protocol::Aecpdu const*);
+    observer_.setSlot(&BlockProtocolInterfaceObserver::Slots::onAecpduReceived_,
+                      Block<void, la::avdecc::protocol::ProtocolInterface*,
+                            la::avdecc::protocol::Aecpdu const*>((BT)cb));
+  }
+  void setOnAcmpduReceived(void (^cb)(void* /*pi*/, void const* /*Acmpdu*/)) noexcept {
+    using BT = void (^)(la::avdecc::protocol::ProtocolInterface*,
+                        la::avdecc::protocol::Acmpdu const*);
+    observer_.setSlot(&BlockProtocolInterfaceObserver::Slots::onAcmpduReceived_,
                       Block<void, la::avdecc::protocol::ProtocolInterface*,
                             la::avdecc::protocol::Acmpdu const*>((BT)cb));
   }
@@ -1219,28 +2846,325 @@ public:
   void clearObserverBlocks() noexcept { observer_.clearAllSlots(); }
 
   void registerObserver() noexcept {
-    if (pi_ && !observerAttached_) {
-      pi_->Subject::registerObserver(&observer_);
-      observerAttached_ = true;
-    }
+    std::lock_guard<std::mutex> lg(attachLock_);
+    observerWanted_ = true;
+    updateObserverAttachment();
   }
   void unregisterObserver() noexcept {
-    if (pi_ && observerAttached_) {
-      pi_->Subject::unregisterObserver(&observer_);
-      observerAttached_ = false;
+    std::lock_guard<std::mutex> lg(attachLock_);
+    observerWanted_ = false;
+    updateObserverAttachment();
+  }
+
+  /// Record every observer event into `stream`'s ring, whether or not an
+  /// observer is registered; the observer stays subscribed while any
+  /// stream is attached. No-op on a closed owner, which closes `stream`.
+  void attachEventStream(CallbackEventStreamOwner* stream) noexcept {
+    if (!stream) return;
+    std::lock_guard<std::mutex> lg(attachLock_);
+    if (!pi_) {
+      stream->close();
+      return;
+    }
+    try {
+      observer_.streams_.add(stream->shared());
+    } catch (...) {
+      stream->close();
+      return;
+    }
+    updateObserverAttachment();
+  }
+  /// Detach and close `stream`.
+  void detachEventStream(CallbackEventStreamOwner* stream) noexcept {
+    if (!stream) return;
+    std::lock_guard<std::mutex> lg(attachLock_);
+    observer_.streams_.remove(stream->shared().get());
+    stream->close();
+    updateObserverAttachment();
+  }
+
+  /// Hand observer callbacks to `shards` (one serial queue per entity-ID
+  /// hash) instead of running them on la_avdecc's executor; nullptr
+  /// restores inline delivery. Safe to call at any time.
+  void setCallbackShards(CallbackShardsOwner* shards) noexcept {
+    observer_.setShards(shards ? shards->shared() : nullptr);
+  }
+
+  /// Turn raw PDU tap `tap` (a PduTapKind) on with a filter compiled from
+  /// these values (see PduFilter), or off with `enabled` false. Returns
+  /// false, leaving the tap as it was, if the filter cannot be allocated.
+  bool setPduTapFilter(uint8_t tap, bool enabled, uint64_t const* entityIDs,
+                       size_t entityIDCount, uint32_t messageTypes, uint32_t statuses,
+                       uint16_t const* commandTypes, size_t commandTypeCount) noexcept {
+    if (tap >= PduTapCount) return false;
+    std::shared_ptr<PduFilter const> filter;
+    if (enabled) {
+      try {
+        filter = std::make_shared<PduFilter const>(entityIDs, entityIDCount, messageTypes,
+                                                   statuses, commandTypes, commandTypeCount);
+      } catch (...) {
+        return false;
+      }
     }
+    observer_.taps_[tap].setFilter(std::move(filter));
+    return true;
+  }
+  /// PDUs tap `tap` passed to the observer and filtered out.
+  uint64_t pduTapMatched(uint8_t tap) const noexcept {
+    return tap < PduTapCount ? observer_.taps_[tap].matched() : 0;
+  }
+  uint64_t pduTapRejected(uint8_t tap) const noexcept {
+    return tap < PduTapCount ? observer_.taps_[tap].rejected() : 0;
+  }
+
+  /// Queue the work la_avdecc's ACMP handling spawns from each received
+  /// ACMP PDU on ExecutorLane::Interactive, ahead of queued Bulk work (the
+  /// default), or leave it on Bulk. The observer stays subscribed while
+  /// this is on.
+  void setAcmpInteractive(bool enabled) noexcept {
+    std::lock_guard<std::mutex> lg(attachLock_);
+    acmpInteractive_ = enabled;
+    observer_.setAcmpInteractive(enabled);
+    updateObserverAttachment();
+  }
+  bool acmpInteractive() const noexcept {
+    std::lock_guard<std::mutex> lg(attachLock_);
+    return acmpInteractive_;
+  }
+
+  /// Forward onRemoteEntityUpdated only when a field group in `mask`
+  /// (EntityUpdateField bits) changed; 0 forwards every update.
+  void setEntityUpdateFilter(uint32_t mask) noexcept { observer_.updateFilter_.setMask(mask); }
+  uint64_t entityUpdatesForwarded() const noexcept {
+    return observer_.updateFilter_.forwarded();
+  }
+  uint64_t entityUpdatesSuppressed() const noexcept {
+    return observer_.updateFilter_.suppressed();
+  }
+
+  /// Count and time every observer block call per slot; see
+  /// AVDECCSwiftSlotProfile.hpp. Returns false if the counters could not
+  /// be allocated.
+  bool setCallbackProfiling(bool enabled) noexcept {
+    return observer_.profiler_->setEnabled(enabled);
+  }
+  bool callbackProfiling() const noexcept { return observer_.profiler_->enabled(); }
+  /// Copy the profiled slots into `out` (up to `capacity`; there are at
+  /// most SlotProfileCapacity); returns how many were written.
+  size_t copyCallbackProfile(SlotProfileStatistics* out, size_t capacity) const noexcept {
+    return observer_.profiler_->copyTo(out, capacity);
+  }
+
+  /// Write every ADP / AECP / ACMP PDU received, and every one sent
+  /// through send*Message, to pcapng files at `path` (see
+  /// AVDECCSwiftPduCapture.hpp), through a ring of `depth` frames that a
+  /// writer thread empties. Files rotate after `maxFileSize` bytes (0:
+  /// never), keeping the last `maxFiles` (0: all). The observer stays
+  /// subscribed while capturing. Returns false with `outErr` filled if
+  /// the first file cannot be created, the interface is closed, or a
+  /// capture is already running.
+  bool startPduCapture(std::string const& path, uint64_t maxFileSize, uint32_t maxFiles,
+                       uint32_t depth, CapturedException& outErr) noexcept {
+    return invokeCapturingException(outErr, [&]() -> bool {
+      std::lock_guard<std::mutex> lg(captureLock_);
+      if (!pi_ || captureActive_.load(std::memory_order_relaxed)) {
+        throw la::avdecc::protocol::ProtocolInterface::Exception(
+            la::avdecc::protocol::ProtocolInterface::Error::InvalidParameters,
+            pi_ ? "PDU capture already running" : "Protocol interface closed");
+      }
+      capture_ = std::make_shared<PduCapture>(path, networkInterfaceID_, maxFileSize,
+                                              maxFiles, depth);
+      observer_.setCapture(capture_);
+      std::lock_guard<std::mutex> attach(attachLock_);
+      captureActive_.store(true, std::memory_order_relaxed);
+      updateObserverAttachment();
+      return true;
+    });
+  }
+
+  /// Write out what is queued and close the file. The counters stay
+  /// readable until the next start. Idempotent.
+  void stopPduCapture() noexcept {
+    std::lock_guard<std::mutex> lg(captureLock_);
+    if (!captureActive_.load(std::memory_order_relaxed)) return;
+    observer_.setCapture(nullptr);
+    capture_->stop();
+    std::lock_guard<std::mutex> attach(attachLock_);
+    captureActive_.store(false, std::memory_order_relaxed);
+    updateObserverAttachment();
+  }
+
+  /// Counters of the running (or last) capture, including frames lost
+  /// to a full ring because the writer fell behind.
+  PduCaptureStatistics pduCaptureStatistics() const noexcept {
+    std::lock_guard<std::mutex> lg(captureLock_);
+    return capture_ ? capture_->statistics() : PduCaptureStatistics{};
+  }
+
+  /// Feed every received PDU to `probe` while a PduReplay injects into
+  /// this interface; nullptr detaches. The observer stays subscribed
+  /// while a probe is attached. Returns false if the interface is closed
+  /// or another probe is attached.
+  bool setReplayProbe(std::shared_ptr<PduReplayProbe> probe) noexcept {
+    std::lock_guard<std::mutex> lg(attachLock_);
+    if (probe && (!pi_ || replayActive_)) return false;
+    replayActive_ = probe != nullptr;
+    observer_.setReplayProbe(std::move(probe));
+    updateObserverAttachment();
+    return true;
   }
 
+  /// The la_avdecc ProtocolInterface::Type this was created with.
+  uint8_t type() const noexcept { return type_; }
+  std::string const& networkInterfaceID() const noexcept { return networkInterfaceID_; }
+  /// The executor la_avdecc runs this interface's state machines on.
+  std::string const& executorName() const noexcept { return executorName_; }
+
 private:
   friend class IntrusiveReferenceCounted<ProtocolInterfaceOwner>;
-  explicit ProtocolInterfaceOwner(
-      la::avdecc::protocol::ProtocolInterface::UniquePointer pi) noexcept
-      : pi_(std::move(pi)) {}
+  ProtocolInterfaceOwner(la::avdecc::protocol::ProtocolInterface::UniquePointer pi,
+                         uint8_t type, std::string networkInterfaceID,
+                         std::string executorName) noexcept
+      : pi_(std::move(pi)),
+        type_(type),
+        networkInterfaceID_(std::move(networkInterfaceID)),
+        executorName_(std::move(executorName)) {}
   ~ProtocolInterfaceOwner() noexcept { close(); }
 
+  // Caller's thread, before the send: the frame's capture timestamp, or
+  // 0 without a capture.
+  uint64_t captureSendTime() const noexcept {
+    return captureActive_.load(std::memory_order_relaxed) ? PduCapture::realtimeNanos() : 0;
+  }
+
+  // Caller's thread, after a successful send stamped `sentAt`. Reads the
+  // observer's copy of the capture, so a send never takes captureLock_.
+  template <typename Pdu>
+  void captureSent(Pdu const& pdu, uint64_t sentAt) const noexcept {
+    if (!sentAt) return;
+    if (auto const capture = std::atomic_load_explicit(&observer_.capture_,
+                                                       std::memory_order_acquire)) {
+      capture->record(PduCaptureDirection::Outbound, pdu, sentAt);
+    }
+  }
+
+  // attachLock_ held. Subscribed while Swift has registered an
+  // observer, a stream is attached, a PDU capture is running, a replay
+  // probe is attached or ACMP lane promotion is on. la_avdecc throws on
+  // a second registration, so only one caller at a time may decide.
+  void updateObserverAttachment() noexcept {
+    auto const wanted = pi_ && (observerWanted_ || observer_.streams_.active() ||
+                                captureActive_.load(std::memory_order_relaxed) ||
+                                replayActive_ || acmpInteractive_);
+    if (wanted && !observerAttached_) {
+      pi_->Subject::registerObserver(&observer_);
+      observerAttached_ = true;
+    } else if (!wanted && observerAttached_ && pi_) {
+      pi_->Subject::unregisterObserver(&observer_);
+      observerAttached_ = false;
+    }
+  }
+
   la::avdecc::protocol::ProtocolInterface::UniquePointer pi_;
+  uint8_t const type_;
+  std::string const networkInterfaceID_;
+  std::string const executorName_;
   BlockProtocolInterfaceObserver observer_;
+  // Guards whether the observer is subscribed and everything that
+  // decides it, and pi_'s reset. Taken after captureLock_.
+  mutable std::mutex attachLock_;
+  bool observerWanted_ = false;
   bool observerAttached_ = false;
+  bool acmpInteractive_ = true;
+  bool replayActive_ = false;
+  // Current or last PDU capture, for start / stop / statistics; the PDU
+  // paths use the observer's copy.
+  mutable std::mutex captureLock_;
+  std::shared_ptr<PduCapture> capture_;
+  // Written under both locks; the send paths read it without either.
+  std::atomic<bool> captureActive_{false};
+};
+
+class PduReplayOwner;
+
+} // namespace AVDECCSwift
+
+void AVDECCSwift_PduReplayOwner_retain(AVDECCSwift::PduReplayOwner* p) noexcept;
+void AVDECCSwift_PduReplayOwner_release(AVDECCSwift::PduReplayOwner* p) noexcept;
+
+namespace AVDECCSwift {
+
+/// Swift handle on a PduReplay (AVDECCSwiftPduReplay.hpp) into a virtual
+/// ProtocolInterfaceOwner, which it keeps alive and probes until stopped.
+class SWIFT_SHARED_REFERENCE(AVDECCSwift_PduReplayOwner_retain,
+                             AVDECCSwift_PduReplayOwner_release)
+    PduReplayOwner final
+    : public IntrusiveReferenceCounted<PduReplayOwner> {
+public:
+  /// Opens `path` and starts replaying it into `target` at `speed`
+  /// times the recorded pacing (0: back to back), through a second
+  /// virtual interface on the target's interface ID and executor. Frames
+  /// captured as outbound are skipped unless `includeOutbound`.
+  /// Returns nullptr with `outErr` filled if `target` is not an open
+  /// virtual interface, already has a replay, or the file cannot be read.
+  SWIFT_RETURNS_RETAINED
+  static PduReplayOwner* create(ProtocolInterfaceOwner* target, std::string const& path,
+                                double speed, bool includeOutbound,
+                                CapturedException& outErr) noexcept {
+    return invokeCapturingException(outErr, [&]() -> PduReplayOwner* {
+      using la::avdecc::protocol::ProtocolInterface;
+      if (!target || !target->get() ||
+          target->type() != static_cast<uint8_t>(ProtocolInterface::Type::Virtual)) {
+        throw ProtocolInterface::Exception(ProtocolInterface::Error::InvalidParameters,
+                                           "Replay target must be an open virtual interface");
+      }
+      auto injector = ProtocolInterface::create(ProtocolInterface::Type::Virtual,
+                                                target->networkInterfaceID(),
+                                                target->executorName());
+      auto probe = std::make_shared<PduReplayProbe>();
+      if (!target->setReplayProbe(probe)) {
+        throw ProtocolInterface::Exception(ProtocolInterface::Error::InvalidParameters,
+                                           "Replay already attached");
+      }
+      try {
+        auto replay = std::make_unique<PduReplay>(path, speed, includeOutbound,
+                                                  std::move(injector), probe);
+        return new PduReplayOwner(target, std::move(replay));
+      } catch (...) {
+        target->setReplayProbe(nullptr);
+        throw;
+      }
+    });
+  }
+
+  /// Abandon the rest of the file and detach from the target, whose
+  /// observer then stops reporting lag. Idempotent.
+  void stop() noexcept {
+    replay_->stop();
+    if (target_) {
+      target_->setReplayProbe(nullptr);
+      AVDECCSwift_ProtocolInterfaceOwner_release(target_);
+      target_ = nullptr;
+    }
+  }
+
+  /// See PduReplay::waitUntilFinished; UINT64_MAX waits indefinitely.
+  bool waitUntilFinished(uint64_t timeoutNanos) noexcept {
+    return replay_->waitUntilFinished(timeoutNanos);
+  }
+
+  PduReplayStatistics statistics() const noexcept { return replay_->statistics(); }
+
+private:
+  friend class IntrusiveReferenceCounted<PduReplayOwner>;
+  PduReplayOwner(ProtocolInterfaceOwner* target, std::unique_ptr<PduReplay> replay) noexcept
+      : target_(target), replay_(std::move(replay)) {
+    AVDECCSwift_ProtocolInterfaceOwner_retain(target_);
+  }
+  ~PduReplayOwner() noexcept { stop(); }
+
+  ProtocolInterfaceOwner* target_;
+  std::unique_ptr<PduReplay> const replay_;
 };
 
 
@@ -1255,9 +3179,9 @@ private:
 ///
 /// Inherits `DefaultedDelegate` so unimplemented overrides fall through to
 /// la_avdecc's empty defaults; we only override the ones we surface. Each
-/// override copies the matching Block<> slot under `slotsMutex_`, releases
-/// the lock, and invokes — same lock-then-copy discipline as
-/// `BlockProtocolInterfaceObserver`. Threading: la_avdecc fires these on
+/// override reads the matching Block<> slot from a SlotTable snapshot and
+/// invokes it in place, as `BlockProtocolInterfaceObserver` does.
+/// Threading: la_avdecc fires these on
 /// arbitrary internal threads (executor, ACMP state machine, statistics).
 ///
 /// Slot grouping: 80 callbacks fall into ~30 distinct argument shapes;
@@ -1269,21 +3193,133 @@ private:
 class BlockControllerDelegate final
     : public la::avdecc::entity::controller::DefaultedDelegate {
 public:
+  struct Slots;
+
   template <typename SlotT, typename ValueT>
-  void setSlot(SlotT BlockControllerDelegate::* slot, ValueT&& value) noexcept {
-    std::lock_guard<std::mutex> lock(slotsMutex_);
-    (this->*slot) = std::forward<ValueT>(value);
+  void setSlot(SlotT Slots::* slot, ValueT&& value) noexcept {
+    slots_.set(slot, std::forward<ValueT>(value));
+    if (auto* const coalescer = coalescer_.load(std::memory_order_acquire)) {
+      coalescer->forget(static_cast<uint32_t>(SlotTable<Slots>::slotOffset(slot)));
+    }
+  }
+
+  void clearAllSlots() noexcept {
+    slots_.clear();
+    if (auto* const coalescer = coalescer_.load(std::memory_order_acquire)) coalescer->forget();
+  }
+
+  /// Deliver only the latest value per (entity, first `keyArgs`
+  /// arguments) of `slot`, each at most once per `intervalNanos`; 0 turns
+  /// it off. The coalescer is created, delivering on `executorName`,
+  /// the first time an interval is set. See
+  /// AVDECCSwiftDelegateCoalesce.hpp.
+  template <typename SlotT>
+  void setCoalescing(SlotT Slots::* slot, uint32_t keyArgs, uint64_t intervalNanos,
+                     std::string const& executorName) noexcept {
+    auto* coalescer = coalescer_.load(std::memory_order_acquire);
+    if (!coalescer) {
+      if (!intervalNanos) return;
+      coalescer = createCoalescer(executorName);
+      if (!coalescer) return;
+    }
+    coalescer->setInterval(static_cast<uint32_t>(SlotTable<Slots>::slotOffset(slot)), keyArgs,
+                           intervalNanos);
+  }
+
+  /// Nullptr until a slot has been coalesced; then lives as long as this.
+  DelegateCoalescer* coalescer() const noexcept {
+    return coalescer_.load(std::memory_order_acquire);
+  }
+
+  // See BlockProtocolInterfaceObserver::setShards.
+  void setShards(std::shared_ptr<CallbackShards> shards) noexcept {
+    std::lock_guard<std::mutex> lg(coalescerLock_);
+    if (coalescerOwner_) coalescerOwner_->setShards(shards);
+    std::atomic_store_explicit(&shards_, std::move(shards), std::memory_order_release);
+  }
+
+  /// Record events into `batcher` instead of delivering them (nullptr
+  /// returns to direct / sharded delivery). Takes precedence over shards.
+  /// Returns the batcher it replaces.
+  std::shared_ptr<DelegateEventBatcher> setBatcher(
+      std::shared_ptr<DelegateEventBatcher> batcher) noexcept {
+    std::lock_guard<std::mutex> lg(coalescerLock_);
+    if (coalescerOwner_) coalescerOwner_->setBatcher(batcher);
+    return std::atomic_exchange_explicit(&batcher_, std::move(batcher),
+                                         std::memory_order_acq_rel);
+  }
+  std::shared_ptr<DelegateEventBatcher> batcher() const noexcept {
+    return std::atomic_load_explicit(&batcher_, std::memory_order_acquire);
   }
 
-  void clearAllSlots() noexcept;
+  /// Call the slot a recorded event came from, as it is bound now.
+  void replay(DelegateEventRecord const& record, DelegateEventBatch const& batch) const noexcept {
+    if (!record.replay) return;
+    auto const slots = slots_.read();
+    profiler_->time(record.slotOffset, record.name,
+                    [&] { record.replay(&*slots, record, batch); });
+  }
 
 private:
   friend class LocalEntityOwner;
 
+  // See BlockProtocolInterfaceObserver::readSlots.
+  auto readSlots(char const* site = __builtin_FUNCTION()) const noexcept {
+    markJobSite(site);
+    return SiteSnapshot<decltype(slots_.read())>{slots_.read(), site};
+  }
+
+  // Under coalescerLock_, so shards and batcher set meanwhile are not
+  // missed.
+  DelegateCoalescer* createCoalescer(std::string const& executorName) noexcept {
+    std::lock_guard<std::mutex> lg(coalescerLock_);
+    if (!coalescerOwner_) {
+      try {
+        coalescerOwner_ = DelegateCoalescer::create(executorName, profiler_);
+      } catch (...) {
+        return nullptr;
+      }
+      coalescerOwner_->setShards(std::atomic_load_explicit(&shards_, std::memory_order_acquire));
+      coalescerOwner_->setBatcher(std::atomic_load_explicit(&batcher_, std::memory_order_acquire));
+      coalescer_.store(coalescerOwner_.get(), std::memory_order_release);
+    }
+    return coalescerOwner_.get();
+  }
+
+  // See BlockProtocolInterfaceObserver::wanted.
   template <typename SlotT>
-  SlotT copySlotLocked(SlotT const& slot) const noexcept {
-    std::lock_guard<std::mutex> lock(slotsMutex_);
-    return slot;
+  bool wanted(SlotT Slots::* slot) const noexcept {
+    return slots_.installed(slot) || streams_.active();
+  }
+
+  // Streams first, as for the observer; then the coalescer, the batcher,
+  // or shards / inline.
+  template <typename View, typename BlockT, typename Project, typename... Args>
+  void deliver(View const& slots, uint64_t key, BlockT const& blk, Project proj,
+               Args const&... args) const noexcept {
+    auto const offset = slotOffsetIn(slots, blk);
+    if (streams_.active()) {
+      proj(CallbackEventRecorder<BlockT>{streams_, slots.site, key, offset}, args...);
+    }
+    if (!blk) return;
+    if constexpr (DelegateCoalescible<BlockT>::value) {
+      auto* const coalescer = coalescer_.load(std::memory_order_acquire);
+      if (coalescer && coalescer->coalesces(offset)) {
+        proj(DelegateCoalesceRecorder<BlockT>{*coalescer, blk, slots.site, offset}, args...);
+        return;
+      }
+    }
+    if (auto const batcher = std::atomic_load_explicit(&batcher_, std::memory_order_acquire)) {
+      proj(DelegateEventRecorder<BlockT>{*batcher, blk, slots.site, key, offset}, args...);
+      return;
+    }
+    auto const shards = std::atomic_load_explicit(&shards_, std::memory_order_acquire);
+    if (profiler_->enabled()) {
+      deliverCallback(shards, key, blk,
+                      ProfiledProjection<Project>{proj, profiler_, offset, slots.site}, args...);
+      return;
+    }
+    deliverCallback(shards, key, blk, proj, args...);
   }
 
   // ---- Shared block shapes ----------------------------------------------
@@ -1334,133 +3370,151 @@ private:
             uint64_t /*listenerEID*/, uint16_t /*listenerStreamIdx*/,
             uint16_t /*count*/, uint16_t /*flags*/, uint16_t /*status*/>;
 
+public:
   // ---- Slots ------------------------------------------------------------
 
-  // Global / lifecycle
-  Block<void> onTransportError_;
-  EntityRefBlock onEntityOnline_;
-  EntityRefBlock onEntityUpdate_;
-  JustEntityBlock onEntityOffline_;
-  JustEntityBlock onEntityIdentifyNotification_;
-  JustEntityBlock onDeregisteredFromUnsolicitedNotifications_;
-
-  // Sniffed ACMP responses — six shapes, all `(talker, listener, count,
-  // flags, status)`. The ACMP status is `LocalEntity::ControlStatus`, a
-  // distinct enum from AEM (see Swift `LocalEntityControlStatus`).
-  AcmpSniffedBlock onControllerConnectResponseSniffed_;
-  AcmpSniffedBlock onControllerDisconnectResponseSniffed_;
-  AcmpSniffedBlock onListenerConnectResponseSniffed_;
-  AcmpSniffedBlock onListenerDisconnectResponseSniffed_;
-  AcmpSniffedBlock onGetTalkerStreamStateResponseSniffed_;
-  AcmpSniffedBlock onGetListenerStreamStateResponseSniffed_;
-
-  // Lock / acquire — shape (entityID, owningOrLockingEntityID, descType,
-  // descIdx). la_avdecc passes a UniqueIdentifier for the second slot;
-  // absent owners come through as 0.
-  AcquireBlock onEntityAcquired_;
-  AcquireBlock onEntityReleased_;
-  AcquireBlock onEntityLocked_;
-  AcquireBlock onEntityUnlocked_;
-
-  // Configuration / clock-source / association
-  Block<void, uint64_t, uint16_t /*configurationIndex*/> onConfigurationChanged_;
-  Block<void, uint64_t, uint64_t /*associationID*/> onAssociationIDChanged_;
-  Block<void, uint64_t, uint16_t /*clockDomainIdx*/,
-        uint16_t /*clockSourceIdx*/> onClockSourceChanged_;
-
-  // Stream format / info / mappings / start-stop
-  StreamFormatBlock onStreamInputFormatChanged_;
-  StreamFormatBlock onStreamOutputFormatChanged_;
-  StreamMappingsChangedBlock onStreamPortInputAudioMappingsChanged_;
-  StreamMappingsChangedBlock onStreamPortOutputAudioMappingsChanged_;
-  StreamMappingsBlock onStreamPortInputAudioMappingsAdded_;
-  StreamMappingsBlock onStreamPortOutputAudioMappingsAdded_;
-  StreamMappingsBlock onStreamPortInputAudioMappingsRemoved_;
-  StreamMappingsBlock onStreamPortOutputAudioMappingsRemoved_;
-  StreamInfoChangedBlock onStreamInputInfoChanged_;
-  StreamInfoChangedBlock onStreamOutputInfoChanged_;
-  StreamIdxBlock onStreamInputStarted_;
-  StreamIdxBlock onStreamOutputStarted_;
-  StreamIdxBlock onStreamInputStopped_;
-  StreamIdxBlock onStreamOutputStopped_;
-  Block<void, uint64_t, uint16_t /*streamIndex*/,
-        uint64_t /*nanoseconds*/> onMaxTransitTimeChanged_;
-
-  // Names — `AvdeccFixedString` const& trailing arg.
-  EntityNameBlock onEntityNameChanged_;
-  EntityNameBlock onEntityGroupNameChanged_;
-  ConfigNameBlock onConfigurationNameChanged_;
-  DescNameBlock onAudioUnitNameChanged_;
-  DescNameBlock onStreamInputNameChanged_;
-  DescNameBlock onStreamOutputNameChanged_;
-  DescNameBlock onJackInputNameChanged_;
-  DescNameBlock onJackOutputNameChanged_;
-  DescNameBlock onAvbInterfaceNameChanged_;
-  DescNameBlock onClockSourceNameChanged_;
-  DescNameBlock onMemoryObjectNameChanged_;
-  DescNameBlock onAudioClusterNameChanged_;
-  DescNameBlock onControlNameChanged_;
-  DescNameBlock onClockDomainNameChanged_;
-  DescNameBlock onTimingNameChanged_;
-  DescNameBlock onPtpInstanceNameChanged_;
-  DescNameBlock onPtpPortNameChanged_;
-
-  // Sampling rates — la_avdecc's SamplingRate is a uint32 wrapper.
-  SamplingRateBlock onAudioUnitSamplingRateChanged_;
-  SamplingRateBlock onVideoClusterSamplingRateChanged_;
-  SamplingRateBlock onSensorClusterSamplingRateChanged_;
-
-  // Counters — entity-level and per-descriptor variants.
-  EntityCountersBlock onEntityCountersChanged_;
-  DescCountersBlock onAvbInterfaceCountersChanged_;
-  DescCountersBlock onClockDomainCountersChanged_;
-  DescCountersBlock onStreamInputCountersChanged_;
-  DescCountersBlock onStreamOutputCountersChanged_;
-
-  // AVB info / AS path / control values
-  Block<void, uint64_t, uint16_t /*avbInterfaceIdx*/,
-        la::avdecc::entity::model::AvbInfo const*> onAvbInfoChanged_;
-  Block<void, uint64_t, uint16_t /*avbInterfaceIdx*/,
-        la::avdecc::entity::model::AsPath const*> onAsPathChanged_;
-  Block<void, uint64_t, uint16_t /*controlIdx*/,
-        uint8_t const* /*packed*/, size_t /*len*/> onControlValuesChanged_;
-
-  // Memory object / operation
-  Block<void, uint64_t, uint16_t /*configurationIndex*/,
-        uint16_t /*memoryObjectIndex*/, uint64_t /*length*/>
-      onMemoryObjectLengthChanged_;
-  Block<void, uint64_t, uint16_t /*descType*/, uint16_t /*descIdx*/,
-        uint16_t /*operationID*/, uint16_t /*percentComplete*/>
-      onOperationStatus_;
-
-  // Milan MVU
-  Block<void, uint64_t, uint64_t /*systemUniqueID*/,
-        la::avdecc::entity::model::AvdeccFixedString const*>
-      onSystemUniqueIDChanged_;
-  Block<void, uint64_t, uint16_t /*clockDomainIdx*/, uint8_t /*defaultPriority*/,
-        bool /*hasUserPrio*/, uint8_t /*userPrio*/, bool /*hasName*/,
-        la::avdecc::entity::model::AvdeccFixedString const* /*domainName*/>
-      onMediaClockReferenceInfoChanged_;
-  Block<void, uint64_t, uint16_t /*streamIndex*/,
-        uint64_t /*talkerEID*/, uint16_t /*talkerStreamIdx*/,
-        uint16_t /*flags*/> onBindStream_;
-  StreamIdxBlock onUnbindStream_;
-  Block<void, uint64_t, uint16_t /*streamIndex*/,
-        la::avdecc::entity::model::StreamInputInfoEx const*>
-      onStreamInputInfoExChanged_;
-
-  // Statistics
-  JustEntityBlock onAecpRetry_;
-  JustEntityBlock onAecpTimeout_;
-  JustEntityBlock onAecpUnexpectedResponse_;
-  Block<void, uint64_t, uint64_t /*responseTimeMs*/> onAecpResponseTime_;
-  Block<void, uint64_t, uint16_t /*sequenceID*/> onAemAecpUnsolicitedReceived_;
-  Block<void, uint64_t, uint16_t /*sequenceID*/> onMvuAecpUnsolicitedReceived_;
+  struct Slots {
+    // Global / lifecycle
+    Block<void> onTransportError_;
+    EntityRefBlock onEntityOnline_;
+    EntityRefBlock onEntityUpdate_;
+    JustEntityBlock onEntityOffline_;
+    JustEntityBlock onEntityIdentifyNotification_;
+    JustEntityBlock onDeregisteredFromUnsolicitedNotifications_;
+
+    // Sniffed ACMP responses — six shapes, all `(talker, listener, count,
+    // flags, status)`. The ACMP status is `LocalEntity::ControlStatus`, a
+    // distinct enum from AEM (see Swift `LocalEntityControlStatus`).
+    AcmpSniffedBlock onControllerConnectResponseSniffed_;
+    AcmpSniffedBlock onControllerDisconnectResponseSniffed_;
+    AcmpSniffedBlock onListenerConnectResponseSniffed_;
+    AcmpSniffedBlock onListenerDisconnectResponseSniffed_;
+    AcmpSniffedBlock onGetTalkerStreamStateResponseSniffed_;
+    AcmpSniffedBlock onGetListenerStreamStateResponseSniffed_;
+
+    // Lock / acquire — shape (entityID, owningOrLockingEntityID, descType,
+    // descIdx). la_avdecc passes a UniqueIdentifier for the second slot;
+    // absent owners come through as 0.
+    AcquireBlock onEntityAcquired_;
+    AcquireBlock onEntityReleased_;
+    AcquireBlock onEntityLocked_;
+    AcquireBlock onEntityUnlocked_;
+
+    // Configuration / clock-source / association
+    Block<void, uint64_t, uint16_t /*configurationIndex*/> onConfigurationChanged_;
+    Block<void, uint64_t, uint64_t /*associationID*/> onAssociationIDChanged_;
+    Block<void, uint64_t, uint16_t /*clockDomainIdx*/,
+          uint16_t /*clockSourceIdx*/> onClockSourceChanged_;
+
+    // Stream format / info / mappings / start-stop
+    StreamFormatBlock onStreamInputFormatChanged_;
+    StreamFormatBlock onStreamOutputFormatChanged_;
+    StreamMappingsChangedBlock onStreamPortInputAudioMappingsChanged_;
+    StreamMappingsChangedBlock onStreamPortOutputAudioMappingsChanged_;
+    StreamMappingsBlock onStreamPortInputAudioMappingsAdded_;
+    StreamMappingsBlock onStreamPortOutputAudioMappingsAdded_;
+    StreamMappingsBlock onStreamPortInputAudioMappingsRemoved_;
+    StreamMappingsBlock onStreamPortOutputAudioMappingsRemoved_;
+    StreamInfoChangedBlock onStreamInputInfoChanged_;
+    StreamInfoChangedBlock onStreamOutputInfoChanged_;
+    StreamIdxBlock onStreamInputStarted_;
+    StreamIdxBlock onStreamOutputStarted_;
+    StreamIdxBlock onStreamInputStopped_;
+    StreamIdxBlock onStreamOutputStopped_;
+    Block<void, uint64_t, uint16_t /*streamIndex*/,
+          uint64_t /*nanoseconds*/> onMaxTransitTimeChanged_;
+
+    // Names — `AvdeccFixedString` const& trailing arg.
+    EntityNameBlock onEntityNameChanged_;
+    EntityNameBlock onEntityGroupNameChanged_;
+    ConfigNameBlock onConfigurationNameChanged_;
+    DescNameBlock onAudioUnitNameChanged_;
+    DescNameBlock onStreamInputNameChanged_;
+    DescNameBlock onStreamOutputNameChanged_;
+    DescNameBlock onJackInputNameChanged_;
+    DescNameBlock onJackOutputNameChanged_;
+    DescNameBlock onAvbInterfaceNameChanged_;
+    DescNameBlock onClockSourceNameChanged_;
+    DescNameBlock onMemoryObjectNameChanged_;
+    DescNameBlock onAudioClusterNameChanged_;
+    DescNameBlock onControlNameChanged_;
+    DescNameBlock onClockDomainNameChanged_;
+    DescNameBlock onTimingNameChanged_;
+    DescNameBlock onPtpInstanceNameChanged_;
+    DescNameBlock onPtpPortNameChanged_;
+
+    // Sampling rates — la_avdecc's SamplingRate is a uint32 wrapper.
+    SamplingRateBlock onAudioUnitSamplingRateChanged_;
+    SamplingRateBlock onVideoClusterSamplingRateChanged_;
+    SamplingRateBlock onSensorClusterSamplingRateChanged_;
+
+    // Counters — entity-level and per-descriptor variants.
+    EntityCountersBlock onEntityCountersChanged_;
+    DescCountersBlock onAvbInterfaceCountersChanged_;
+    DescCountersBlock onClockDomainCountersChanged_;
+    DescCountersBlock onStreamInputCountersChanged_;
+    DescCountersBlock onStreamOutputCountersChanged_;
+
+    // AVB info / AS path / control values
+    Block<void, uint64_t, uint16_t /*avbInterfaceIdx*/,
+          la::avdecc::entity::model::AvbInfo const*> onAvbInfoChanged_;
+    Block<void, uint64_t, uint16_t /*avbInterfaceIdx*/,
+          la::avdecc::entity::model::AsPath const*> onAsPathChanged_;
+    Block<void, uint64_t, uint16_t /*controlIdx*/,
+          uint8_t const* /*packed*/, size_t /*len*/> onControlValuesChanged_;
+
+    // Memory object / operation
+    Block<void, uint64_t, uint16_t /*configurationIndex*/,
+          uint16_t /*memoryObjectIndex*/, uint64_t /*length*/>
+        onMemoryObjectLengthChanged_;
+    Block<void, uint64_t, uint16_t /*descType*/, uint16_t /*descIdx*/,
+          uint16_t /*operationID*/, uint16_t /*percentComplete*/>
+        onOperationStatus_;
+
+    // Milan MVU
+    Block<void, uint64_t, uint64_t /*systemUniqueID*/,
+          la::avdecc::entity::model::AvdeccFixedString const*>
+        onSystemUniqueIDChanged_;
+    Block<void, uint64_t, uint16_t /*clockDomainIdx*/, uint8_t /*defaultPriority*/,
+          bool /*hasUserPrio*/, uint8_t /*userPrio*/, bool /*hasName*/,
+          la::avdecc::entity::model::AvdeccFixedString const* /*domainName*/>
+        onMediaClockReferenceInfoChanged_;
+    Block<void, uint64_t, uint16_t /*streamIndex*/,
+          uint64_t /*talkerEID*/, uint16_t /*talkerStreamIdx*/,
+          uint16_t /*flags*/> onBindStream_;
+    StreamIdxBlock onUnbindStream_;
+    Block<void, uint64_t, uint16_t /*streamIndex*/,
+          la::avdecc::entity::model::StreamInputInfoEx const*>
+        onStreamInputInfoExChanged_;
+
+    // Statistics
+    JustEntityBlock onAecpRetry_;
+    JustEntityBlock onAecpTimeout_;
+    JustEntityBlock onAecpUnexpectedResponse_;
+    Block<void, uint64_t, uint64_t /*responseTimeMs*/> onAecpResponseTime_;
+    Block<void, uint64_t, uint16_t /*sequenceID*/> onAemAecpUnsolicitedReceived_;
+    Block<void, uint64_t, uint16_t /*sequenceID*/> onMvuAecpUnsolicitedReceived_;
+  };
 
-  mutable std::mutex slotsMutex_;
+private:
+  SlotTable<Slots> slots_;
+  std::shared_ptr<CallbackShards> shards_;
+  std::shared_ptr<DelegateEventBatcher> batcher_;
+  // Per-slot invocation counts and latencies; see AVDECCSwiftSlotProfile.hpp.
+  std::shared_ptr<SlotProfiler> const profiler_ = SlotProfiler::create();
+  // Latest-value coalescing, created on first use. The raw pointer is
+  // what notifications read; the owner keeps it alive until we go.
+  std::mutex coalescerLock_;
+  std::shared_ptr<DelegateCoalescer> coalescerOwner_;
+  std::atomic<DelegateCoalescer*> coalescer_{nullptr};
+  // Change-only filtering of onEntityUpdate.
+  EntityUpdateFilter updateFilter_;
+  // Attached event streams.
+  CallbackEventStreams streams_;
 
   // ---- Override declarations ---------------------------------------------
-  // Each follows the same recipe: copy slot under lock, fire if non-null.
+  // Each follows the same recipe: read the slot from a snapshot and
+  // deliver, which records to streams and fires the block if non-null.
   // Order matches la_avdecc's `Delegate` declaration in
   // controllerEntity.hpp.
 
@@ -1468,22 +3522,44 @@ private:
   using UID = la::avdecc::UniqueIdentifier const;
 
   void onTransportError(DT) noexcept override {
-    auto blk = copySlotLocked(onTransportError_);
-    if (blk) blk();
+    if (!wanted(&Slots::onTransportError_)) return;
+    auto const slots = readSlots();
+    auto const& blk = slots->onTransportError_;
+    deliver(slots, 0, blk, [](auto const& blk) {
+      blk();
+    });
   }
 
   // ADP
   void onEntityOnline(DT, UID id, la::avdecc::entity::Entity const& e) noexcept override {
-    auto blk = copySlotLocked(onEntityOnline_);
-    if (blk) blk(id.getValue(), &e);
+    updateFilter_.seed(e);
+    if (!wanted(&Slots::onEntityOnline_)) return;
+    auto const slots = readSlots();
+    auto const& blk = slots->onEntityOnline_;
+    deliver(slots, id.getValue(), blk, [](auto const& blk, auto const& id, auto const& e) {
+      blk(id.getValue(), &e);
+    }, id, e);
   }
   void onEntityUpdate(DT, UID id, la::avdecc::entity::Entity const& e) noexcept override {
-    auto blk = copySlotLocked(onEntityUpdate_);
-    if (blk) blk(id.getValue(), &e);
+    if (!wanted(&Slots::onEntityUpdate_)) return;
+    if (!updateFilter_.admit(e)) return;
+    auto const slots = readSlots();
+    auto const& blk = slots->onEntityUpdate_;
+    deliver(slots, id.getValue(), blk, [](auto const& blk, auto const& id, auto const& e) {
+      blk(id.getValue(), &e);
+    }, id, e);
   }
   void onEntityOffline(DT, UID id) noexcept override {
-    auto blk = copySlotLocked(onEntityOffline_);
-    if (blk) blk(id.getValue());
+    updateFilter_.forget(id);
+    if (auto* const coalescer = coalescer_.load(std::memory_order_acquire)) {
+      coalescer->forgetEntity(id.getValue());
+    }
+    if (!wanted(&Slots::onEntityOffline_)) return;
+    auto const slots = readSlots();
+    auto const& blk = slots->onEntityOffline_;
+    deliver(slots, id.getValue(), blk, [](auto const& blk, auto const& id) {
+      blk(id.getValue());
+    }, id);
   }
 
   // Sniffed ACMP
@@ -1492,157 +3568,225 @@ private:
       la::avdecc::entity::model::StreamIdentification const& l,
       uint16_t const count, la::avdecc::entity::ConnectionFlags const flags,
       la::avdecc::entity::LocalEntity::ControlStatus const status) noexcept override {
-    auto blk = copySlotLocked(onControllerConnectResponseSniffed_);
-    if (blk) blk(t.entityID.getValue(), t.streamIndex,
-                 l.entityID.getValue(), l.streamIndex,
-                 count, flags.value(), static_cast<uint16_t>(status));
+    if (!wanted(&Slots::onControllerConnectResponseSniffed_)) return;
+    auto const slots = readSlots();
+    auto const& blk = slots->onControllerConnectResponseSniffed_;
+    deliver(slots, l.entityID.getValue(), blk, [](auto const& blk, auto const& t, auto const& l, auto const& count, auto const& flags, auto const& status) {
+      blk(t.entityID.getValue(), t.streamIndex, l.entityID.getValue(), l.streamIndex, count, flags.value(), static_cast<uint16_t>(status));
+    }, t, l, count, flags, status);
   }
   void onControllerDisconnectResponseSniffed(
       DT, la::avdecc::entity::model::StreamIdentification const& t,
       la::avdecc::entity::model::StreamIdentification const& l,
       uint16_t const count, la::avdecc::entity::ConnectionFlags const flags,
       la::avdecc::entity::LocalEntity::ControlStatus const status) noexcept override {
-    auto blk = copySlotLocked(onControllerDisconnectResponseSniffed_);
-    if (blk) blk(t.entityID.getValue(), t.streamIndex,
-                 l.entityID.getValue(), l.streamIndex,
-                 count, flags.value(), static_cast<uint16_t>(status));
+    if (!wanted(&Slots::onControllerDisconnectResponseSniffed_)) return;
+    auto const slots = readSlots();
+    auto const& blk = slots->onControllerDisconnectResponseSniffed_;
+    deliver(slots, l.entityID.getValue(), blk, [](auto const& blk, auto const& t, auto const& l, auto const& count, auto const& flags, auto const& status) {
+      blk(t.entityID.getValue(), t.streamIndex, l.entityID.getValue(), l.streamIndex, count, flags.value(), static_cast<uint16_t>(status));
+    }, t, l, count, flags, status);
   }
   void onListenerConnectResponseSniffed(
       DT, la::avdecc::entity::model::StreamIdentification const& t,
       la::avdecc::entity::model::StreamIdentification const& l,
       uint16_t const count, la::avdecc::entity::ConnectionFlags const flags,
       la::avdecc::entity::LocalEntity::ControlStatus const status) noexcept override {
-    auto blk = copySlotLocked(onListenerConnectResponseSniffed_);
-    if (blk) blk(t.entityID.getValue(), t.streamIndex,
-                 l.entityID.getValue(), l.streamIndex,
-                 count, flags.value(), static_cast<uint16_t>(status));
+    if (!wanted(&Slots::onListenerConnectResponseSniffed_)) return;
+    auto const slots = readSlots();
+    auto const& blk = slots->onListenerConnectResponseSniffed_;
+    deliver(slots, l.entityID.getValue(), blk, [](auto const& blk, auto const& t, auto const& l, auto const& count, auto const& flags, auto const& status) {
+      blk(t.entityID.getValue(), t.streamIndex, l.entityID.getValue(), l.streamIndex, count, flags.value(), static_cast<uint16_t>(status));
+    }, t, l, count, flags, status);
   }
   void onListenerDisconnectResponseSniffed(
       DT, la::avdecc::entity::model::StreamIdentification const& t,
       la::avdecc::entity::model::StreamIdentification const& l,
       uint16_t const count, la::avdecc::entity::ConnectionFlags const flags,
       la::avdecc::entity::LocalEntity::ControlStatus const status) noexcept override {
-    auto blk = copySlotLocked(onListenerDisconnectResponseSniffed_);
-    if (blk) blk(t.entityID.getValue(), t.streamIndex,
-                 l.entityID.getValue(), l.streamIndex,
-                 count, flags.value(), static_cast<uint16_t>(status));
+    if (!wanted(&Slots::onListenerDisconnectResponseSniffed_)) return;
+    auto const slots = readSlots();
+    auto const& blk = slots->onListenerDisconnectResponseSniffed_;
+    deliver(slots, l.entityID.getValue(), blk, [](auto const& blk, auto const& t, auto const& l, auto const& count, auto const& flags, auto const& status) {
+      blk(t.entityID.getValue(), t.streamIndex, l.entityID.getValue(), l.streamIndex, count, flags.value(), static_cast<uint16_t>(status));
+    }, t, l, count, flags, status);
   }
   void onGetTalkerStreamStateResponseSniffed(
       DT, la::avdecc::entity::model::StreamIdentification const& t,
       la::avdecc::entity::model::StreamIdentification const& l,
       uint16_t const count, la::avdecc::entity::ConnectionFlags const flags,
       la::avdecc::entity::LocalEntity::ControlStatus const status) noexcept override {
-    auto blk = copySlotLocked(onGetTalkerStreamStateResponseSniffed_);
-    if (blk) blk(t.entityID.getValue(), t.streamIndex,
-                 l.entityID.getValue(), l.streamIndex,
-                 count, flags.value(), static_cast<uint16_t>(status));
+    if (!wanted(&Slots::onGetTalkerStreamStateResponseSniffed_)) return;
+    auto const slots = readSlots();
+    auto const& blk = slots->onGetTalkerStreamStateResponseSniffed_;
+    deliver(slots, l.entityID.getValue(), blk, [](auto const& blk, auto const& t, auto const& l, auto const& count, auto const& flags, auto const& status) {
+      blk(t.entityID.getValue(), t.streamIndex, l.entityID.getValue(), l.streamIndex, count, flags.value(), static_cast<uint16_t>(status));
+    }, t, l, count, flags, status);
   }
   void onGetListenerStreamStateResponseSniffed(
       DT, la::avdecc::entity::model::StreamIdentification const& t,
       la::avdecc::entity::model::StreamIdentification const& l,
       uint16_t const count, la::avdecc::entity::ConnectionFlags const flags,
       la::avdecc::entity::LocalEntity::ControlStatus const status) noexcept override {
-    auto blk = copySlotLocked(onGetListenerStreamStateResponseSniffed_);
-    if (blk) blk(t.entityID.getValue(), t.streamIndex,
-                 l.entityID.getValue(), l.streamIndex,
-                 count, flags.value(), static_cast<uint16_t>(status));
+    if (!wanted(&Slots::onGetListenerStreamStateResponseSniffed_)) return;
+    auto const slots = readSlots();
+    auto const& blk = slots->onGetListenerStreamStateResponseSniffed_;
+    deliver(slots, l.entityID.getValue(), blk, [](auto const& blk, auto const& t, auto const& l, auto const& count, auto const& flags, auto const& status) {
+      blk(t.entityID.getValue(), t.streamIndex, l.entityID.getValue(), l.streamIndex, count, flags.value(), static_cast<uint16_t>(status));
+    }, t, l, count, flags, status);
   }
 
   // Unsolicited
   void onDeregisteredFromUnsolicitedNotifications(DT, UID id) noexcept override {
-    auto blk = copySlotLocked(onDeregisteredFromUnsolicitedNotifications_);
-    if (blk) blk(id.getValue());
+    if (!wanted(&Slots::onDeregisteredFromUnsolicitedNotifications_)) return;
+    auto const slots = readSlots();
+    auto const& blk = slots->onDeregisteredFromUnsolicitedNotifications_;
+    deliver(slots, id.getValue(), blk, [](auto const& blk, auto const& id) {
+      blk(id.getValue());
+    }, id);
   }
   void onEntityAcquired(DT, UID id, UID owning,
                         la::avdecc::entity::model::DescriptorType const dt,
                         la::avdecc::entity::model::DescriptorIndex const di) noexcept override {
-    auto blk = copySlotLocked(onEntityAcquired_);
-    if (blk) blk(id.getValue(), owning.getValue(),
-                 static_cast<uint16_t>(dt), di);
+    if (!wanted(&Slots::onEntityAcquired_)) return;
+    auto const slots = readSlots();
+    auto const& blk = slots->onEntityAcquired_;
+    deliver(slots, id.getValue(), blk, [](auto const& blk, auto const& id, auto const& owning, auto const& dt, auto const& di) {
+      blk(id.getValue(), owning.getValue(), static_cast<uint16_t>(dt), di);
+    }, id, owning, dt, di);
   }
   void onEntityReleased(DT, UID id, UID owning,
                         la::avdecc::entity::model::DescriptorType const dt,
                         la::avdecc::entity::model::DescriptorIndex const di) noexcept override {
-    auto blk = copySlotLocked(onEntityReleased_);
-    if (blk) blk(id.getValue(), owning.getValue(),
-                 static_cast<uint16_t>(dt), di);
+    if (!wanted(&Slots::onEntityReleased_)) return;
+    auto const slots = readSlots();
+    auto const& blk = slots->onEntityReleased_;
+    deliver(slots, id.getValue(), blk, [](auto const& blk, auto const& id, auto const& owning, auto const& dt, auto const& di) {
+      blk(id.getValue(), owning.getValue(), static_cast<uint16_t>(dt), di);
+    }, id, owning, dt, di);
   }
   void onEntityLocked(DT, UID id, UID locking,
                       la::avdecc::entity::model::DescriptorType const dt,
                       la::avdecc::entity::model::DescriptorIndex const di) noexcept override {
-    auto blk = copySlotLocked(onEntityLocked_);
-    if (blk) blk(id.getValue(), locking.getValue(),
-                 static_cast<uint16_t>(dt), di);
+    if (!wanted(&Slots::onEntityLocked_)) return;
+    auto const slots = readSlots();
+    auto const& blk = slots->onEntityLocked_;
+    deliver(slots, id.getValue(), blk, [](auto const& blk, auto const& id, auto const& locking, auto const& dt, auto const& di) {
+      blk(id.getValue(), locking.getValue(), static_cast<uint16_t>(dt), di);
+    }, id, locking, dt, di);
   }
   void onEntityUnlocked(DT, UID id, UID locking,
                         la::avdecc::entity::model::DescriptorType const dt,
                         la::avdecc::entity::model::DescriptorIndex const di) noexcept override {
-    auto blk = copySlotLocked(onEntityUnlocked_);
-    if (blk) blk(id.getValue(), locking.getValue(),
-                 static_cast<uint16_t>(dt), di);
+    if (!wanted(&Slots::onEntityUnlocked_)) return;
+    auto const slots = readSlots();
+    auto const& blk = slots->onEntityUnlocked_;
+    deliver(slots, id.getValue(), blk, [](auto const& blk, auto const& id, auto const& locking, auto const& dt, auto const& di) {
+      blk(id.getValue(), locking.getValue(), static_cast<uint16_t>(dt), di);
+    }, id, locking, dt, di);
   }
   void onConfigurationChanged(DT, UID id,
                               la::avdecc::entity::model::ConfigurationIndex const cfg) noexcept override {
-    auto blk = copySlotLocked(onConfigurationChanged_);
-    if (blk) blk(id.getValue(), cfg);
+    if (!wanted(&Slots::onConfigurationChanged_)) return;
+    auto const slots = readSlots();
+    auto const& blk = slots->onConfigurationChanged_;
+    deliver(slots, id.getValue(), blk, [](auto const& blk, auto const& id, auto const& cfg) {
+      blk(id.getValue(), cfg);
+    }, id, cfg);
   }
   void onStreamInputFormatChanged(DT, UID id,
                                   la::avdecc::entity::model::StreamIndex const si,
                                   la::avdecc::entity::model::StreamFormat const fmt) noexcept override {
-    auto blk = copySlotLocked(onStreamInputFormatChanged_);
-    if (blk) blk(id.getValue(), si, fmt.getValue());
+    if (!wanted(&Slots::onStreamInputFormatChanged_)) return;
+    auto const slots = readSlots();
+    auto const& blk = slots->onStreamInputFormatChanged_;
+    deliver(slots, id.getValue(), blk, [](auto const& blk, auto const& id, auto const& si, auto const& fmt) {
+      blk(id.getValue(), si, fmt.getValue());
+    }, id, si, fmt);
   }
   void onStreamOutputFormatChanged(DT, UID id,
                                    la::avdecc::entity::model::StreamIndex const si,
                                    la::avdecc::entity::model::StreamFormat const fmt) noexcept override {
-    auto blk = copySlotLocked(onStreamOutputFormatChanged_);
-    if (blk) blk(id.getValue(), si, fmt.getValue());
+    if (!wanted(&Slots::onStreamOutputFormatChanged_)) return;
+    auto const slots = readSlots();
+    auto const& blk = slots->onStreamOutputFormatChanged_;
+    deliver(slots, id.getValue(), blk, [](auto const& blk, auto const& id, auto const& si, auto const& fmt) {
+      blk(id.getValue(), si, fmt.getValue());
+    }, id, si, fmt);
   }
   void onStreamPortInputAudioMappingsChanged(DT, UID id,
                                              la::avdecc::entity::model::StreamPortIndex const sp,
                                              la::avdecc::entity::model::MapIndex const numMaps,
                                              la::avdecc::entity::model::MapIndex const mi,
                                              la::avdecc::entity::model::AudioMappings const& m) noexcept override {
-    auto blk = copySlotLocked(onStreamPortInputAudioMappingsChanged_);
-    if (blk) blk(id.getValue(), sp, numMaps, mi, m.data(), m.size());
+    if (!wanted(&Slots::onStreamPortInputAudioMappingsChanged_)) return;
+    auto const slots = readSlots();
+    auto const& blk = slots->onStreamPortInputAudioMappingsChanged_;
+    deliver(slots, id.getValue(), blk, [](auto const& blk, auto const& id, auto const& sp, auto const& numMaps, auto const& mi, auto const& m) {
+      blk(id.getValue(), sp, numMaps, mi, m.data(), m.size());
+    }, id, sp, numMaps, mi, m);
   }
   void onStreamPortOutputAudioMappingsChanged(DT, UID id,
                                               la::avdecc::entity::model::StreamPortIndex const sp,
                                               la::avdecc::entity::model::MapIndex const numMaps,
                                               la::avdecc::entity::model::MapIndex const mi,
                                               la::avdecc::entity::model::AudioMappings const& m) noexcept override {
-    auto blk = copySlotLocked(onStreamPortOutputAudioMappingsChanged_);
-    if (blk) blk(id.getValue(), sp, numMaps, mi, m.data(), m.size());
+    if (!wanted(&Slots::onStreamPortOutputAudioMappingsChanged_)) return;
+    auto const slots = readSlots();
+    auto const& blk = slots->onStreamPortOutputAudioMappingsChanged_;
+    deliver(slots, id.getValue(), blk, [](auto const& blk, auto const& id, auto const& sp, auto const& numMaps, auto const& mi, auto const& m) {
+      blk(id.getValue(), sp, numMaps, mi, m.data(), m.size());
+    }, id, sp, numMaps, mi, m);
   }
   void onStreamInputInfoChanged(DT, UID id,
                                 la::avdecc::entity::model::StreamIndex const si,
                                 la::avdecc::entity::model::StreamInfo const& info,
                                 bool const fromGet) noexcept override {
-    auto blk = copySlotLocked(onStreamInputInfoChanged_);
-    if (blk) blk(id.getValue(), si, &info, fromGet);
+    if (!wanted(&Slots::onStreamInputInfoChanged_)) return;
+    auto const slots = readSlots();
+    auto const& blk = slots->onStreamInputInfoChanged_;
+    deliver(slots, id.getValue(), blk, [](auto const& blk, auto const& id, auto const& si, auto const& info, auto const& fromGet) {
+      blk(id.getValue(), si, &info, fromGet);
+    }, id, si, info, fromGet);
   }
   void onStreamOutputInfoChanged(DT, UID id,
                                  la::avdecc::entity::model::StreamIndex const si,
                                  la::avdecc::entity::model::StreamInfo const& info,
                                  bool const fromGet) noexcept override {
-    auto blk = copySlotLocked(onStreamOutputInfoChanged_);
-    if (blk) blk(id.getValue(), si, &info, fromGet);
+    if (!wanted(&Slots::onStreamOutputInfoChanged_)) return;
+    auto const slots = readSlots();
+    auto const& blk = slots->onStreamOutputInfoChanged_;
+    deliver(slots, id.getValue(), blk, [](auto const& blk, auto const& id, auto const& si, auto const& info, auto const& fromGet) {
+      blk(id.getValue(), si, &info, fromGet);
+    }, id, si, info, fromGet);
   }
   void onEntityNameChanged(DT, UID id,
                            la::avdecc::entity::model::AvdeccFixedString const& n) noexcept override {
-    auto blk = copySlotLocked(onEntityNameChanged_);
-    if (blk) blk(id.getValue(), &n);
+    if (!wanted(&Slots::onEntityNameChanged_)) return;
+    auto const slots = readSlots();
+    auto const& blk = slots->onEntityNameChanged_;
+    deliver(slots, id.getValue(), blk, [](auto const& blk, auto const& id, auto const& n) {
+      blk(id.getValue(), &n);
+    }, id, n);
   }
   void onEntityGroupNameChanged(DT, UID id,
                                 la::avdecc::entity::model::AvdeccFixedString const& n) noexcept override {
-    auto blk = copySlotLocked(onEntityGroupNameChanged_);
-    if (blk) blk(id.getValue(), &n);
+    if (!wanted(&Slots::onEntityGroupNameChanged_)) return;
+    auto const slots = readSlots();
+    auto const& blk = slots->onEntityGroupNameChanged_;
+    deliver(slots, id.getValue(), blk, [](auto const& blk, auto const& id, auto const& n) {
+      blk(id.getValue(), &n);
+    }, id, n);
   }
   void onConfigurationNameChanged(DT, UID id,
                                   la::avdecc::entity::model::ConfigurationIndex const cfg,
                                   la::avdecc::entity::model::AvdeccFixedString const& n) noexcept override {
-    auto blk = copySlotLocked(onConfigurationNameChanged_);
-    if (blk) blk(id.getValue(), cfg, &n);
+    if (!wanted(&Slots::onConfigurationNameChanged_)) return;
+    auto const slots = readSlots();
+    auto const& blk = slots->onConfigurationNameChanged_;
+    deliver(slots, id.getValue(), blk, [](auto const& blk, auto const& id, auto const& cfg, auto const& n) {
+      blk(id.getValue(), cfg, &n);
+    }, id, cfg, n);
   }
 
   // Descriptor-level name changes — all share `(id, configIdx, descIdx, &name)`.
@@ -1650,401 +3794,522 @@ private:
                               la::avdecc::entity::model::ConfigurationIndex const cfg,
                               la::avdecc::entity::model::AudioUnitIndex const au,
                               la::avdecc::entity::model::AvdeccFixedString const& n) noexcept override {
-    auto blk = copySlotLocked(onAudioUnitNameChanged_);
-    if (blk) blk(id.getValue(), cfg, au, &n);
+    if (!wanted(&Slots::onAudioUnitNameChanged_)) return;
+    auto const slots = readSlots();
+    auto const& blk = slots->onAudioUnitNameChanged_;
+    deliver(slots, id.getValue(), blk, [](auto const& blk, auto const& id, auto const& cfg, auto const& au, auto const& n) {
+      blk(id.getValue(), cfg, au, &n);
+    }, id, cfg, au, n);
   }
   void onStreamInputNameChanged(DT, UID id,
                                 la::avdecc::entity::model::ConfigurationIndex const cfg,
                                 la::avdecc::entity::model::StreamIndex const si,
                                 la::avdecc::entity::model::AvdeccFixedString const& n) noexcept override {
-    auto blk = copySlotLocked(onStreamInputNameChanged_);
-    if (blk) blk(id.getValue(), cfg, si, &n);
+    if (!wanted(&Slots::onStreamInputNameChanged_)) return;
+    auto const slots = readSlots();
+    auto const& blk = slots->onStreamInputNameChanged_;
+    deliver(slots, id.getValue(), blk, [](auto const& blk, auto const& id, auto const& cfg, auto const& si, auto const& n) {
+      blk(id.getValue(), cfg, si, &n);
+    }, id, cfg, si, n);
   }
   void onStreamOutputNameChanged(DT, UID id,
                                  la::avdecc::entity::model::ConfigurationIndex const cfg,
                                  la::avdecc::entity::model::StreamIndex const si,
                                  la::avdecc::entity::model::AvdeccFixedString const& n) noexcept override {
-    auto blk = copySlotLocked(onStreamOutputNameChanged_);
-    if (blk) blk(id.getValue(), cfg, si, &n);
+    if (!wanted(&Slots::onStreamOutputNameChanged_)) return;
+    auto const slots = readSlots();
+    auto const& blk = slots->onStreamOutputNameChanged_;
+    deliver(slots, id.getValue(), blk, [](auto const& blk, auto const& id, auto const& cfg, auto const& si, auto const& n) {
+      blk(id.getValue(), cfg, si, &n);
+    }, id, cfg, si, n);
   }
   void onJackInputNameChanged(DT, UID id,
                               la::avdecc::entity::model::ConfigurationIndex const cfg,
                               la::avdecc::entity::model::JackIndex const j,
                               la::avdecc::entity::model::AvdeccFixedString const& n) noexcept override {
-    auto blk = copySlotLocked(onJackInputNameChanged_);
-    if (blk) blk(id.getValue(), cfg, j, &n);
+    if (!wanted(&Slots::onJackInputNameChanged_)) return;
+    auto const slots = readSlots();
+    auto const& blk = slots->onJackInputNameChanged_;
+    deliver(slots, id.getValue(), blk, [](auto const& blk, auto const& id, auto const& cfg, auto const& j, auto const& n) {
+      blk(id.getValue(), cfg, j, &n);
+    }, id, cfg, j, n);
   }
   void onJackOutputNameChanged(DT, UID id,
                                la::avdecc::entity::model::ConfigurationIndex const cfg,
                                la::avdecc::entity::model::JackIndex const j,
                                la::avdecc::entity::model::AvdeccFixedString const& n) noexcept override {
-    auto blk = copySlotLocked(onJackOutputNameChanged_);
-    if (blk) blk(id.getValue(), cfg, j, &n);
+    if (!wanted(&Slots::onJackOutputNameChanged_)) return;
+    auto const slots = readSlots();
+    auto const& blk = slots->onJackOutputNameChanged_;
+    deliver(slots, id.getValue(), blk, [](auto const& blk, auto const& id, auto const& cfg, auto const& j, auto const& n) {
+      blk(id.getValue(), cfg, j, &n);
+    }, id, cfg, j, n);
   }
   void onAvbInterfaceNameChanged(DT, UID id,
                                  la::avdecc::entity::model::ConfigurationIndex const cfg,
                                  la::avdecc::entity::model::AvbInterfaceIndex const a,
                                  la::avdecc::entity::model::AvdeccFixedString const& n) noexcept override {
-    auto blk = copySlotLocked(onAvbInterfaceNameChanged_);
-    if (blk) blk(id.getValue(), cfg, a, &n);
+    if (!wanted(&Slots::onAvbInterfaceNameChanged_)) return;
+    auto const slots = readSlots();
+    auto const& blk = slots->onAvbInterfaceNameChanged_;
+    deliver(slots, id.getValue(), blk, [](auto const& blk, auto const& id, auto const& cfg, auto const& a, auto const& n) {
+      blk(id.getValue(), cfg, a, &n);
+    }, id, cfg, a, n);
   }
   void onClockSourceNameChanged(DT, UID id,
                                 la::avdecc::entity::model::ConfigurationIndex const cfg,
                                 la::avdecc::entity::model::ClockSourceIndex const cs,
                                 la::avdecc::entity::model::AvdeccFixedString const& n) noexcept override {
-    auto blk = copySlotLocked(onClockSourceNameChanged_);
-    if (blk) blk(id.getValue(), cfg, cs, &n);
+    if (!wanted(&Slots::onClockSourceNameChanged_)) return;
+    auto const slots = readSlots();
+    auto const& blk = slots->onClockSourceNameChanged_;
+    deliver(slots, id.getValue(), blk, [](auto const& blk, auto const& id, auto const& cfg, auto const& cs, auto const& n) {
+      blk(id.getValue(), cfg, cs, &n);
+    }, id, cfg, cs, n);
   }
   void onMemoryObjectNameChanged(DT, UID id,
                                  la::avdecc::entity::model::ConfigurationIndex const cfg,
                                  la::avdecc::entity::model::MemoryObjectIndex const mo,
                                  la::avdecc::entity::model::AvdeccFixedString const& n) noexcept override {
-    auto blk = copySlotLocked(onMemoryObjectNameChanged_);
-    if (blk) blk(id.getValue(), cfg, mo, &n);
+    if (!wanted(&Slots::onMemoryObjectNameChanged_)) return;
+    auto const slots = readSlots();
+    auto const& blk = slots->onMemoryObjectNameChanged_;
+    deliver(slots, id.getValue(), blk, [](auto const& blk, auto const& id, auto const& cfg, auto const& mo, auto const& n) {
+      blk(id.getValue(), cfg, mo, &n);
+    }, id, cfg, mo, n);
   }
   void onAudioClusterNameChanged(DT, UID id,
                                  la::avdecc::entity::model::ConfigurationIndex const cfg,
                                  la::avdecc::entity::model::ClusterIndex const cl,
                                  la::avdecc::entity::model::AvdeccFixedString const& n) noexcept override {
-    auto blk = copySlotLocked(onAudioClusterNameChanged_);
-    if (blk) blk(id.getValue(), cfg, cl, &n);
+    if (!wanted(&Slots::onAudioClusterNameChanged_)) return;
+    auto const slots = readSlots();
+    auto const& blk = slots->onAudioClusterNameChanged_;
+    deliver(slots, id.getValue(), blk, [](auto const& blk, auto const& id, auto const& cfg, auto const& cl, auto const& n) {
+      blk(id.getValue(), cfg, cl, &n);
+    }, id, cfg, cl, n);
   }
   void onControlNameChanged(DT, UID id,
                             la::avdecc::entity::model::ConfigurationIndex const cfg,
                             la::avdecc::entity::model::ControlIndex const ci,
                             la::avdecc::entity::model::AvdeccFixedString const& n) noexcept override {
-    auto blk = copySlotLocked(onControlNameChanged_);
-    if (blk) blk(id.getValue(), cfg, ci, &n);
+    if (!wanted(&Slots::onControlNameChanged_)) return;
+    auto const slots = readSlots();
+    auto const& blk = slots->onControlNameChanged_;
+    deliver(slots, id.getValue(), blk, [](auto const& blk, auto const& id, auto const& cfg, auto const& ci, auto const& n) {
+      blk(id.getValue(), cfg, ci, &n);
+    }, id, cfg, ci, n);
   }
   void onClockDomainNameChanged(DT, UID id,
                                 la::avdecc::entity::model::ConfigurationIndex const cfg,
                                 la::avdecc::entity::model::ClockDomainIndex const cd,
                                 la::avdecc::entity::model::AvdeccFixedString const& n) noexcept override {
-    auto blk = copySlotLocked(onClockDomainNameChanged_);
-    if (blk) blk(id.getValue(), cfg, cd, &n);
+    if (!wanted(&Slots::onClockDomainNameChanged_)) return;
+    auto const slots = readSlots();
+    auto const& blk = slots->onClockDomainNameChanged_;
+    deliver(slots, id.getValue(), blk, [](auto const& blk, auto const& id, auto const& cfg, auto const& cd, auto const& n) {
+      blk(id.getValue(), cfg, cd, &n);
+    }, id, cfg, cd, n);
   }
   void onTimingNameChanged(DT, UID id,
                            la::avdecc::entity::model::ConfigurationIndex const cfg,
                            la::avdecc::entity::model::TimingIndex const ti,
                            la::avdecc::entity::model::AvdeccFixedString const& n) noexcept override {
-    auto blk = copySlotLocked(onTimingNameChanged_);
-    if (blk) blk(id.getValue(), cfg, ti, &n);
+    if (!wanted(&Slots::onTimingNameChanged_)) return;
+    auto const slots = readSlots();
+    auto const& blk = slots->onTimingNameChanged_;
+    deliver(slots, id.getValue(), blk, [](auto const& blk, auto const& id, auto const& cfg, auto const& ti, auto const& n) {
+      blk(id.getValue(), cfg, ti, &n);
+    }, id, cfg, ti, n);
   }
   void onPtpInstanceNameChanged(DT, UID id,
                                 la::avdecc::entity::model::ConfigurationIndex const cfg,
                                 la::avdecc::entity::model::PtpInstanceIndex const pi,
                                 la::avdecc::entity::model::AvdeccFixedString const& n) noexcept override {
-    auto blk = copySlotLocked(onPtpInstanceNameChanged_);
-    if (blk) blk(id.getValue(), cfg, pi, &n);
+    if (!wanted(&Slots::onPtpInstanceNameChanged_)) return;
+    auto const slots = readSlots();
+    auto const& blk = slots->onPtpInstanceNameChanged_;
+    deliver(slots, id.getValue(), blk, [](auto const& blk, auto const& id, auto const& cfg, auto const& pi, auto const& n) {
+      blk(id.getValue(), cfg, pi, &n);
+    }, id, cfg, pi, n);
   }
   void onPtpPortNameChanged(DT, UID id,
                             la::avdecc::entity::model::ConfigurationIndex const cfg,
                             la::avdecc::entity::model::PtpPortIndex const pp,
                             la::avdecc::entity::model::AvdeccFixedString const& n) noexcept override {
-    auto blk = copySlotLocked(onPtpPortNameChanged_);
-    if (blk) blk(id.getValue(), cfg, pp, &n);
+    if (!wanted(&Slots::onPtpPortNameChanged_)) return;
+    auto const slots = readSlots();
+    auto const& blk = slots->onPtpPortNameChanged_;
+    deliver(slots, id.getValue(), blk, [](auto const& blk, auto const& id, auto const& cfg, auto const& pp, auto const& n) {
+      blk(id.getValue(), cfg, pp, &n);
+    }, id, cfg, pp, n);
   }
   void onAssociationIDChanged(DT, UID id, UID assoc) noexcept override {
-    auto blk = copySlotLocked(onAssociationIDChanged_);
-    if (blk) blk(id.getValue(), assoc.getValue());
+    if (!wanted(&Slots::onAssociationIDChanged_)) return;
+    auto const slots = readSlots();
+    auto const& blk = slots->onAssociationIDChanged_;
+    deliver(slots, id.getValue(), blk, [](auto const& blk, auto const& id, auto const& assoc) {
+      blk(id.getValue(), assoc.getValue());
+    }, id, assoc);
   }
   void onAudioUnitSamplingRateChanged(DT, UID id,
                                       la::avdecc::entity::model::AudioUnitIndex const au,
                                       la::avdecc::entity::model::SamplingRate const sr) noexcept override {
-    auto blk = copySlotLocked(onAudioUnitSamplingRateChanged_);
-    if (blk) blk(id.getValue(), au, sr.getValue());
+    if (!wanted(&Slots::onAudioUnitSamplingRateChanged_)) return;
+    auto const slots = readSlots();
+    auto const& blk = slots->onAudioUnitSamplingRateChanged_;
+    deliver(slots, id.getValue(), blk, [](auto const& blk, auto const& id, auto const& au, auto const& sr) {
+      blk(id.getValue(), au, sr.getValue());
+    }, id, au, sr);
   }
   void onVideoClusterSamplingRateChanged(DT, UID id,
                                          la::avdecc::entity::model::ClusterIndex const c,
                                          la::avdecc::entity::model::SamplingRate const sr) noexcept override {
-    auto blk = copySlotLocked(onVideoClusterSamplingRateChanged_);
-    if (blk) blk(id.getValue(), c, sr.getValue());
+    if (!wanted(&Slots::onVideoClusterSamplingRateChanged_)) return;
+    auto const slots = readSlots();
+    auto const& blk = slots->onVideoClusterSamplingRateChanged_;
+    deliver(slots, id.getValue(), blk, [](auto const& blk, auto const& id, auto const& c, auto const& sr) {
+      blk(id.getValue(), c, sr.getValue());
+    }, id, c, sr);
   }
   void onSensorClusterSamplingRateChanged(DT, UID id,
                                           la::avdecc::entity::model::ClusterIndex const c,
                                           la::avdecc::entity::model::SamplingRate const sr) noexcept override {
-    auto blk = copySlotLocked(onSensorClusterSamplingRateChanged_);
-    if (blk) blk(id.getValue(), c, sr.getValue());
+    if (!wanted(&Slots::onSensorClusterSamplingRateChanged_)) return;
+    auto const slots = readSlots();
+    auto const& blk = slots->onSensorClusterSamplingRateChanged_;
+    deliver(slots, id.getValue(), blk, [](auto const& blk, auto const& id, auto const& c, auto const& sr) {
+      blk(id.getValue(), c, sr.getValue());
+    }, id, c, sr);
   }
   void onClockSourceChanged(DT, UID id,
                             la::avdecc::entity::model::ClockDomainIndex const cd,
                             la::avdecc::entity::model::ClockSourceIndex const cs) noexcept override {
-    auto blk = copySlotLocked(onClockSourceChanged_);
-    if (blk) blk(id.getValue(), cd, cs);
+    if (!wanted(&Slots::onClockSourceChanged_)) return;
+    auto const slots = readSlots();
+    auto const& blk = slots->onClockSourceChanged_;
+    deliver(slots, id.getValue(), blk, [](auto const& blk, auto const& id, auto const& cd, auto const& cs) {
+      blk(id.getValue(), cd, cs);
+    }, id, cd, cs);
   }
   void onControlValuesChanged(DT, UID id,
                               la::avdecc::entity::model::ControlIndex const ci,
                               la::avdecc::MemoryBuffer const& packed) noexcept override {
-    auto blk = copySlotLocked(onControlValuesChanged_);
-    if (blk) blk(id.getValue(), ci, packed.data(), packed.size());
+    if (!wanted(&Slots::onControlValuesChanged_)) return;
+    auto const slots = readSlots();
+    auto const& blk = slots->onControlValuesChanged_;
+    deliver(slots, id.getValue(), blk, [](auto const& blk, auto const& id, auto const& ci, auto const& packed) {
+      blk(id.getValue(), ci, packed.data(), packed.size());
+    }, id, ci, packed);
   }
   void onStreamInputStarted(DT, UID id,
                             la::avdecc::entity::model::StreamIndex const si) noexcept override {
-    auto blk = copySlotLocked(onStreamInputStarted_);
-    if (blk) blk(id.getValue(), si);
+    if (!wanted(&Slots::onStreamInputStarted_)) return;
+    auto const slots = readSlots();
+    auto const& blk = slots->onStreamInputStarted_;
+    deliver(slots, id.getValue(), blk, [](auto const& blk, auto const& id, auto const& si) {
+      blk(id.getValue(), si);
+    }, id, si);
   }
   void onStreamOutputStarted(DT, UID id,
                              la::avdecc::entity::model::StreamIndex const si) noexcept override {
-    auto blk = copySlotLocked(onStreamOutputStarted_);
-    if (blk) blk(id.getValue(), si);
+    if (!wanted(&Slots::onStreamOutputStarted_)) return;
+    auto const slots = readSlots();
+    auto const& blk = slots->onStreamOutputStarted_;
+    deliver(slots, id.getValue(), blk, [](auto const& blk, auto const& id, auto const& si) {
+      blk(id.getValue(), si);
+    }, id, si);
   }
   void onStreamInputStopped(DT, UID id,
                             la::avdecc::entity::model::StreamIndex const si) noexcept override {
-    auto blk = copySlotLocked(onStreamInputStopped_);
-    if (blk) blk(id.getValue(), si);
+    if (!wanted(&Slots::onStreamInputStopped_)) return;
+    auto const slots = readSlots();
+    auto const& blk = slots->onStreamInputStopped_;
+    deliver(slots, id.getValue(), blk, [](auto const& blk, auto const& id, auto const& si) {
+      blk(id.getValue(), si);
+    }, id, si);
   }
   void onStreamOutputStopped(DT, UID id,
                              la::avdecc::entity::model::StreamIndex const si) noexcept override {
-    auto blk = copySlotLocked(onStreamOutputStopped_);
-    if (blk) blk(id.getValue(), si);
+    if (!wanted(&Slots::onStreamOutputStopped_)) return;
+    auto const slots = readSlots();
+    auto const& blk = slots->onStreamOutputStopped_;
+    deliver(slots, id.getValue(), blk, [](auto const& blk, auto const& id, auto const& si) {
+      blk(id.getValue(), si);
+    }, id, si);
   }
   void onAvbInfoChanged(DT, UID id,
                         la::avdecc::entity::model::AvbInterfaceIndex const a,
                         la::avdecc::entity::model::AvbInfo const& info) noexcept override {
-    auto blk = copySlotLocked(onAvbInfoChanged_);
-    if (blk) blk(id.getValue(), a, &info);
+    if (!wanted(&Slots::onAvbInfoChanged_)) return;
+    auto const slots = readSlots();
+    auto const& blk = slots->onAvbInfoChanged_;
+    deliver(slots, id.getValue(), blk, [](auto const& blk, auto const& id, auto const& a, auto const& info) {
+      blk(id.getValue(), a, &info);
+    }, id, a, info);
   }
   void onAsPathChanged(DT, UID id,
                        la::avdecc::entity::model::AvbInterfaceIndex const a,
                        la::avdecc::entity::model::AsPath const& path) noexcept override {
-    auto blk = copySlotLocked(onAsPathChanged_);
-    if (blk) blk(id.getValue(), a, &path);
+    if (!wanted(&Slots::onAsPathChanged_)) return;
+    auto const slots = readSlots();
+    auto const& blk = slots->onAsPathChanged_;
+    deliver(slots, id.getValue(), blk, [](auto const& blk, auto const& id, auto const& a, auto const& path) {
+      blk(id.getValue(), a, &path);
+    }, id, a, path);
   }
   void onEntityCountersChanged(DT, UID id,
                                la::avdecc::entity::EntityCounterValidFlags const valid,
                                la::avdecc::entity::model::DescriptorCounters const& c) noexcept override {
-    auto blk = copySlotLocked(onEntityCountersChanged_);
-    if (blk) blk(id.getValue(), valid.value(), c.data());
+    if (!wanted(&Slots::onEntityCountersChanged_)) return;
+    auto const slots = readSlots();
+    auto const& blk = slots->onEntityCountersChanged_;
+    deliver(slots, id.getValue(), blk, [](auto const& blk, auto const& id, auto const& valid, auto const& c) {
+      blk(id.getValue(), valid.value(), c.data());
+    }, id, valid, c);
   }
   void onAvbInterfaceCountersChanged(DT, UID id,
                                      la::avdecc::entity::model::AvbInterfaceIndex const a,
                                      la::avdecc::entity::AvbInterfaceCounterValidFlags const valid,
                                      la::avdecc::entity::model::DescriptorCounters const& c) noexcept override {
-    auto blk = copySlotLocked(onAvbInterfaceCountersChanged_);
-    if (blk) blk(id.getValue(), a, valid.value(), c.data());
+    if (!wanted(&Slots::onAvbInterfaceCountersChanged_)) return;
+    auto const slots = readSlots();
+    auto const& blk = slots->onAvbInterfaceCountersChanged_;
+    deliver(slots, id.getValue(), blk, [](auto const& blk, auto const& id, auto const& a, auto const& valid, auto const& c) {
+      blk(id.getValue(), a, valid.value(), c.data());
+    }, id, a, valid, c);
   }
   void onClockDomainCountersChanged(DT, UID id,
                                     la::avdecc::entity::model::ClockDomainIndex const cd,
                                     la::avdecc::entity::ClockDomainCounterValidFlags const valid,
                                     la::avdecc::entity::model::DescriptorCounters const& c) noexcept override {
-    auto blk = copySlotLocked(onClockDomainCountersChanged_);
-    if (blk) blk(id.getValue(), cd, valid.value(), c.data());
+    if (!wanted(&Slots::onClockDomainCountersChanged_)) return;
+    auto const slots = readSlots();
+    auto const& blk = slots->onClockDomainCountersChanged_;
+    deliver(slots, id.getValue(), blk, [](auto const& blk, auto const& id, auto const& cd, auto const& valid, auto const& c) {
+      blk(id.getValue(), cd, valid.value(), c.data());
+    }, id, cd, valid, c);
   }
   void onStreamInputCountersChanged(DT, UID id,
                                     la::avdecc::entity::model::StreamIndex const si,
                                     la::avdecc::entity::StreamInputCounterValidFlags const valid,
                                     la::avdecc::entity::model::DescriptorCounters const& c) noexcept override {
-    auto blk = copySlotLocked(onStreamInputCountersChanged_);
-    if (blk) blk(id.getValue(), si, valid.value(), c.data());
+    if (!wanted(&Slots::onStreamInputCountersChanged_)) return;
+    auto const slots = readSlots();
+    auto const& blk = slots->onStreamInputCountersChanged_;
+    deliver(slots, id.getValue(), blk, [](auto const& blk, auto const& id, auto const& si, auto const& valid, auto const& c) {
+      blk(id.getValue(), si, valid.value(), c.data());
+    }, id, si, valid, c);
   }
   void onStreamOutputCountersChanged(DT, UID id,
                                      la::avdecc::entity::model::StreamIndex const si,
                                      la::avdecc::entity::StreamOutputCounterValidFlags const valid,
                                      la::avdecc::entity::model::DescriptorCounters const& c) noexcept override {
-    auto blk = copySlotLocked(onStreamOutputCountersChanged_);
-    if (blk) blk(id.getValue(), si, valid.value(), c.data());
+    if (!wanted(&Slots::onStreamOutputCountersChanged_)) return;
+    auto const slots = readSlots();
+    auto const& blk = slots->onStreamOutputCountersChanged_;
+    deliver(slots, id.getValue(), blk, [](auto const& blk, auto const& id, auto const& si, auto const& valid, auto const& c) {
+      blk(id.getValue(), si, valid.value(), c.data());
+    }, id, si, valid, c);
   }
   void onStreamPortInputAudioMappingsAdded(DT, UID id,
                                            la::avdecc::entity::model::StreamPortIndex const sp,
                                            la::avdecc::entity::model::AudioMappings const& m) noexcept override {
-    auto blk = copySlotLocked(onStreamPortInputAudioMappingsAdded_);
-    if (blk) blk(id.getValue(), sp, m.data(), m.size());
+    if (!wanted(&Slots::onStreamPortInputAudioMappingsAdded_)) return;
+    auto const slots = readSlots();
+    auto const& blk = slots->onStreamPortInputAudioMappingsAdded_;
+    deliver(slots, id.getValue(), blk, [](auto const& blk, auto const& id, auto const& sp, auto const& m) {
+      blk(id.getValue(), sp, m.data(), m.size());
+    }, id, sp, m);
   }
   void onStreamPortOutputAudioMappingsAdded(DT, UID id,
                                             la::avdecc::entity::model::StreamPortIndex const sp,
                                             la::avdecc::entity::model::AudioMappings const& m) noexcept override {
-    auto blk = copySlotLocked(onStreamPortOutputAudioMappingsAdded_);
-    if (blk) blk(id.getValue(), sp, m.data(), m.size());
+    if (!wanted(&Slots::onStreamPortOutputAudioMappingsAdded_)) return;
+    auto const slots = readSlots();
+    auto const& blk = slots->onStreamPortOutputAudioMappingsAdded_;
+    deliver(slots, id.getValue(), blk, [](auto const& blk, auto const& id, auto const& sp, auto const& m) {
+      blk(id.getValue(), sp, m.data(), m.size());
+    }, id, sp, m);
   }
   void onStreamPortInputAudioMappingsRemoved(DT, UID id,
                                              la::avdecc::entity::model::StreamPortIndex const sp,
                                              la::avdecc::entity::model::AudioMappings const& m) noexcept override {
-    auto blk = copySlotLocked(onStreamPortInputAudioMappingsRemoved_);
-    if (blk) blk(id.getValue(), sp, m.data(), m.size());
+    if (!wanted(&Slots::onStreamPortInputAudioMappingsRemoved_)) return;
+    auto const slots = readSlots();
+    auto const& blk = slots->onStreamPortInputAudioMappingsRemoved_;
+    deliver(slots, id.getValue(), blk, [](auto const& blk, auto const& id, auto const& sp, auto const& m) {
+      blk(id.getValue(), sp, m.data(), m.size());
+    }, id, sp, m);
   }
   void onStreamPortOutputAudioMappingsRemoved(DT, UID id,
                                               la::avdecc::entity::model::StreamPortIndex const sp,
                                               la::avdecc::entity::model::AudioMappings const& m) noexcept override {
-    auto blk = copySlotLocked(onStreamPortOutputAudioMappingsRemoved_);
-    if (blk) blk(id.getValue(), sp, m.data(), m.size());
+    if (!wanted(&Slots::onStreamPortOutputAudioMappingsRemoved_)) return;
+    auto const slots = readSlots();
+    auto const& blk = slots->onStreamPortOutputAudioMappingsRemoved_;
+    deliver(slots, id.getValue(), blk, [](auto const& blk, auto const& id, auto const& sp, auto const& m) {
+      blk(id.getValue(), sp, m.data(), m.size());
+    }, id, sp, m);
   }
   void onMemoryObjectLengthChanged(DT, UID id,
                                    la::avdecc::entity::model::ConfigurationIndex const cfg,
                                    la::avdecc::entity::model::MemoryObjectIndex const mo,
                                    std::uint64_t const length) noexcept override {
-    auto blk = copySlotLocked(onMemoryObjectLengthChanged_);
-    if (blk) blk(id.getValue(), cfg, mo, length);
+    if (!wanted(&Slots::onMemoryObjectLengthChanged_)) return;
+    auto const slots = readSlots();
+    auto const& blk = slots->onMemoryObjectLengthChanged_;
+    deliver(slots, id.getValue(), blk, [](auto const& blk, auto const& id, auto const& cfg, auto const& mo, auto const& length) {
+      blk(id.getValue(), cfg, mo, length);
+    }, id, cfg, mo, length);
   }
   void onOperationStatus(DT, UID id,
                          la::avdecc::entity::model::DescriptorType const dt,
                          la::avdecc::entity::model::DescriptorIndex const di,
                          la::avdecc::entity::model::OperationID const op,
                          std::uint16_t const pct) noexcept override {
-    auto blk = copySlotLocked(onOperationStatus_);
-    if (blk) blk(id.getValue(), static_cast<uint16_t>(dt), di, op, pct);
+    if (!wanted(&Slots::onOperationStatus_)) return;
+    auto const slots = readSlots();
+    auto const& blk = slots->onOperationStatus_;
+    deliver(slots, id.getValue(), blk, [](auto const& blk, auto const& id, auto const& dt, auto const& di, auto const& op, auto const& pct) {
+      blk(id.getValue(), static_cast<uint16_t>(dt), di, op, pct);
+    }, id, dt, di, op, pct);
   }
   void onMaxTransitTimeChanged(DT, UID id,
                                la::avdecc::entity::model::StreamIndex const si,
                                std::chrono::nanoseconds const& ns) noexcept override {
-    auto blk = copySlotLocked(onMaxTransitTimeChanged_);
-    if (blk) blk(id.getValue(), si, static_cast<uint64_t>(ns.count()));
+    if (!wanted(&Slots::onMaxTransitTimeChanged_)) return;
+    auto const slots = readSlots();
+    auto const& blk = slots->onMaxTransitTimeChanged_;
+    deliver(slots, id.getValue(), blk, [](auto const& blk, auto const& id, auto const& si, auto const& ns) {
+      blk(id.getValue(), si, static_cast<uint64_t>(ns.count()));
+    }, id, si, ns);
   }
   void onSystemUniqueIDChanged(DT, UID id, UID sys,
                                la::avdecc::entity::model::AvdeccFixedString const& name) noexcept override {
-    auto blk = copySlotLocked(onSystemUniqueIDChanged_);
-    if (blk) blk(id.getValue(), sys.getValue(), &name);
+    if (!wanted(&Slots::onSystemUniqueIDChanged_)) return;
+    auto const slots = readSlots();
+    auto const& blk = slots->onSystemUniqueIDChanged_;
+    deliver(slots, id.getValue(), blk, [](auto const& blk, auto const& id, auto const& sys, auto const& name) {
+      blk(id.getValue(), sys.getValue(), &name);
+    }, id, sys, name);
   }
   void onMediaClockReferenceInfoChanged(
       DT, UID id, la::avdecc::entity::model::ClockDomainIndex const cd,
       la::avdecc::entity::model::DefaultMediaClockReferencePriority const def,
       la::avdecc::entity::model::MediaClockReferenceInfo const& info) noexcept override {
-    auto blk = copySlotLocked(onMediaClockReferenceInfoChanged_);
+    if (!wanted(&Slots::onMediaClockReferenceInfoChanged_)) return;
+    auto const slots = readSlots();
+    auto const& blk = slots->onMediaClockReferenceInfoChanged_;
     if (!blk) return;
-    auto const hasPrio = info.userMediaClockPriority.has_value();
-    auto const prio = hasPrio
-        ? *info.userMediaClockPriority
-        : la::avdecc::entity::model::MediaClockReferencePriority{0u};
-    auto const hasName = info.mediaClockDomainName.has_value();
-    blk(id.getValue(), cd, static_cast<uint8_t>(def),
-        hasPrio, prio,
-        hasName, hasName ? &(*info.mediaClockDomainName) : nullptr);
+    deliver(slots, id.getValue(), blk, [](auto const& blk, auto const& id, auto const& cd,
+                                   auto const& def, auto const& info) {
+      auto const hasPrio = info.userMediaClockPriority.has_value();
+      auto const prio = hasPrio
+          ? *info.userMediaClockPriority
+          : la::avdecc::entity::model::MediaClockReferencePriority{0u};
+      auto const hasName = info.mediaClockDomainName.has_value();
+      blk(id.getValue(), cd, static_cast<uint8_t>(def),
+          hasPrio, prio,
+          hasName, hasName ? &(*info.mediaClockDomainName) : nullptr);
+    }, id, cd, def, info);
   }
   void onBindStream(DT, UID id,
                     la::avdecc::entity::model::StreamIndex const si,
                     la::avdecc::entity::model::StreamIdentification const& t,
                     la::avdecc::entity::BindStreamFlags const f) noexcept override {
-    auto blk = copySlotLocked(onBindStream_);
-    if (blk) blk(id.getValue(), si,
-                 t.entityID.getValue(), t.streamIndex, f.value());
+    if (!wanted(&Slots::onBindStream_)) return;
+    auto const slots = readSlots();
+    auto const& blk = slots->onBindStream_;
+    deliver(slots, id.getValue(), blk, [](auto const& blk, auto const& id, auto const& si, auto const& t, auto const& f) {
+      blk(id.getValue(), si, t.entityID.getValue(), t.streamIndex, f.value());
+    }, id, si, t, f);
   }
   void onUnbindStream(DT, UID id,
                       la::avdecc::entity::model::StreamIndex const si) noexcept override {
-    auto blk = copySlotLocked(onUnbindStream_);
-    if (blk) blk(id.getValue(), si);
+    if (!wanted(&Slots::onUnbindStream_)) return;
+    auto const slots = readSlots();
+    auto const& blk = slots->onUnbindStream_;
+    deliver(slots, id.getValue(), blk, [](auto const& blk, auto const& id, auto const& si) {
+      blk(id.getValue(), si);
+    }, id, si);
   }
   void onStreamInputInfoExChanged(DT, UID id,
                                   la::avdecc::entity::model::StreamIndex const si,
                                   la::avdecc::entity::model::StreamInputInfoEx const& info) noexcept override {
-    auto blk = copySlotLocked(onStreamInputInfoExChanged_);
-    if (blk) blk(id.getValue(), si, &info);
+    if (!wanted(&Slots::onStreamInputInfoExChanged_)) return;
+    auto const slots = readSlots();
+    auto const& blk = slots->onStreamInputInfoExChanged_;
+    deliver(slots, id.getValue(), blk, [](auto const& blk, auto const& id, auto const& si, auto const& info) {
+      blk(id.getValue(), si, &info);
+    }, id, si, info);
   }
 
   // Identification
   void onEntityIdentifyNotification(DT, UID id) noexcept override {
-    auto blk = copySlotLocked(onEntityIdentifyNotification_);
-    if (blk) blk(id.getValue());
+    if (!wanted(&Slots::onEntityIdentifyNotification_)) return;
+    auto const slots = readSlots();
+    auto const& blk = slots->onEntityIdentifyNotification_;
+    deliver(slots, id.getValue(), blk, [](auto const& blk, auto const& id) {
+      blk(id.getValue());
+    }, id);
   }
 
   // Statistics. la_avdecc passes UniqueIdentifier by const ref here (not
   // value); Delegate.hpp signatures use `UniqueIdentifier const&`.
   void onAecpRetry(DT, la::avdecc::UniqueIdentifier const& id) noexcept override {
-    auto blk = copySlotLocked(onAecpRetry_);
-    if (blk) blk(id.getValue());
+    if (!wanted(&Slots::onAecpRetry_)) return;
+    auto const slots = readSlots();
+    auto const& blk = slots->onAecpRetry_;
+    deliver(slots, id.getValue(), blk, [](auto const& blk, auto const& id) {
+      blk(id.getValue());
+    }, id);
   }
   void onAecpTimeout(DT, la::avdecc::UniqueIdentifier const& id) noexcept override {
-    auto blk = copySlotLocked(onAecpTimeout_);
-    if (blk) blk(id.getValue());
+    if (!wanted(&Slots::onAecpTimeout_)) return;
+    auto const slots = readSlots();
+    auto const& blk = slots->onAecpTimeout_;
+    deliver(slots, id.getValue(), blk, [](auto const& blk, auto const& id) {
+      blk(id.getValue());
+    }, id);
   }
   void onAecpUnexpectedResponse(DT, la::avdecc::UniqueIdentifier const& id) noexcept override {
-    auto blk = copySlotLocked(onAecpUnexpectedResponse_);
-    if (blk) blk(id.getValue());
+    if (!wanted(&Slots::onAecpUnexpectedResponse_)) return;
+    auto const slots = readSlots();
+    auto const& blk = slots->onAecpUnexpectedResponse_;
+    deliver(slots, id.getValue(), blk, [](auto const& blk, auto const& id) {
+      blk(id.getValue());
+    }, id);
   }
   void onAecpResponseTime(DT, la::avdecc::UniqueIdentifier const& id,
                           std::chrono::milliseconds const& ms) noexcept override {
-    auto blk = copySlotLocked(onAecpResponseTime_);
-    if (blk) blk(id.getValue(), static_cast<uint64_t>(ms.count()));
+    if (!wanted(&Slots::onAecpResponseTime_)) return;
+    auto const slots = readSlots();
+    auto const& blk = slots->onAecpResponseTime_;
+    deliver(slots, id.getValue(), blk, [](auto const& blk, auto const& id, auto const& ms) {
+      blk(id.getValue(), static_cast<uint64_t>(ms.count()));
+    }, id, ms);
   }
   void onAemAecpUnsolicitedReceived(DT, la::avdecc::UniqueIdentifier const& id,
                                     la::avdecc::protocol::AecpSequenceID const seq) noexcept override {
-    auto blk = copySlotLocked(onAemAecpUnsolicitedReceived_);
-    if (blk) blk(id.getValue(), seq);
+    if (!wanted(&Slots::onAemAecpUnsolicitedReceived_)) return;
+    auto const slots = readSlots();
+    auto const& blk = slots->onAemAecpUnsolicitedReceived_;
+    deliver(slots, id.getValue(), blk, [](auto const& blk, auto const& id, auto const& seq) {
+      blk(id.getValue(), seq);
+    }, id, seq);
   }
   void onMvuAecpUnsolicitedReceived(DT, la::avdecc::UniqueIdentifier const& id,
                                     la::avdecc::protocol::AecpSequenceID const seq) noexcept override {
-    auto blk = copySlotLocked(onMvuAecpUnsolicitedReceived_);
-    if (blk) blk(id.getValue(), seq);
+    if (!wanted(&Slots::onMvuAecpUnsolicitedReceived_)) return;
+    auto const slots = readSlots();
+    auto const& blk = slots->onMvuAecpUnsolicitedReceived_;
+    deliver(slots, id.getValue(), blk, [](auto const& blk, auto const& id, auto const& seq) {
+      blk(id.getValue(), seq);
+    }, id, seq);
   }
 };
 
-inline void BlockControllerDelegate::clearAllSlots() noexcept {
-  std::lock_guard<std::mutex> lock(slotsMutex_);
-  onTransportError_.reset();
-  onEntityOnline_.reset();
-  onEntityUpdate_.reset();
-  onEntityOffline_.reset();
-  onEntityIdentifyNotification_.reset();
-  onDeregisteredFromUnsolicitedNotifications_.reset();
-  onControllerConnectResponseSniffed_.reset();
-  onControllerDisconnectResponseSniffed_.reset();
-  onListenerConnectResponseSniffed_.reset();
-  onListenerDisconnectResponseSniffed_.reset();
-  onGetTalkerStreamStateResponseSniffed_.reset();
-  onGetListenerStreamStateResponseSniffed_.reset();
-  onEntityAcquired_.reset();
-  onEntityReleased_.reset();
-  onEntityLocked_.reset();
-  onEntityUnlocked_.reset();
-  onConfigurationChanged_.reset();
-  onAssociationIDChanged_.reset();
-  onClockSourceChanged_.reset();
-  onStreamInputFormatChanged_.reset();
-  onStreamOutputFormatChanged_.reset();
-  onStreamPortInputAudioMappingsChanged_.reset();
-  onStreamPortOutputAudioMappingsChanged_.reset();
-  onStreamPortInputAudioMappingsAdded_.reset();
-  onStreamPortOutputAudioMappingsAdded_.reset();
-  onStreamPortInputAudioMappingsRemoved_.reset();
-  onStreamPortOutputAudioMappingsRemoved_.reset();
-  onStreamInputInfoChanged_.reset();
-  onStreamOutputInfoChanged_.reset();
-  onStreamInputStarted_.reset();
-  onStreamOutputStarted_.reset();
-  onStreamInputStopped_.reset();
-  onStreamOutputStopped_.reset();
-  onMaxTransitTimeChanged_.reset();
-  onEntityNameChanged_.reset();
-  onEntityGroupNameChanged_.reset();
-  onConfigurationNameChanged_.reset();
-  onAudioUnitNameChanged_.reset();
-  onStreamInputNameChanged_.reset();
-  onStreamOutputNameChanged_.reset();
-  onJackInputNameChanged_.reset();
-  onJackOutputNameChanged_.reset();
-  onAvbInterfaceNameChanged_.reset();
-  onClockSourceNameChanged_.reset();
-  onMemoryObjectNameChanged_.reset();
-  onAudioClusterNameChanged_.reset();
-  onControlNameChanged_.reset();
-  onClockDomainNameChanged_.reset();
-  onTimingNameChanged_.reset();
-  onPtpInstanceNameChanged_.reset();
-  onPtpPortNameChanged_.reset();
-  onAudioUnitSamplingRateChanged_.reset();
-  onVideoClusterSamplingRateChanged_.reset();
-  onSensorClusterSamplingRateChanged_.reset();
-  onEntityCountersChanged_.reset();
-  onAvbInterfaceCountersChanged_.reset();
-  onClockDomainCountersChanged_.reset();
-  onStreamInputCountersChanged_.reset();
-  onStreamOutputCountersChanged_.reset();
-  onAvbInfoChanged_.reset();
-  onAsPathChanged_.reset();
-  onControlValuesChanged_.reset();
-  onMemoryObjectLengthChanged_.reset();
-  onOperationStatus_.reset();
-  onSystemUniqueIDChanged_.reset();
-  onMediaClockReferenceInfoChanged_.reset();
-  onBindStream_.reset();
-  onUnbindStream_.reset();
-  onStreamInputInfoExChanged_.reset();
-  onAecpRetry_.reset();
-  onAecpTimeout_.reset();
-  onAecpUnexpectedResponse_.reset();
-  onAecpResponseTime_.reset();
-  onAemAecpUnsolicitedReceived_.reset();
-  onMvuAecpUnsolicitedReceived_.reset();
-}
-
 class LocalEntityOwner;
 
 } // namespace AVDECCSwift
@@ -2097,13 +4362,19 @@ static_assert(static_cast<uint16_t>(la::avdecc::entity::LocalEntity::MvuCommandS
 /// `Status` is one of `LocalEntity::{AemCommand,Control,MvuCommand}Status`.
 /// The `Block<>` is moved into the lambda capture (so Block_copy stays
 /// balanced); the projection receives it by const reference.
+///
+/// `site` (defaulting to the calling wrapper's name — for the shared
+/// `*Impl` / `*Handler` helpers, the helper's) is what the executor's
+/// stall watchdog reports while the response callback runs.
 template <typename Status, typename BlockT, typename Project>
-auto avdeccHandler(BlockT blk, Project proj) noexcept {
-  return [blk = std::move(blk), proj = std::move(proj)](
+auto avdeccHandler(BlockT blk, Project proj,
+                   char const* site = __builtin_FUNCTION()) noexcept {
+  return [blk = std::move(blk), proj = std::move(proj), site](
       la::avdecc::entity::controller::Interface const* const,
       la::avdecc::UniqueIdentifier const,
       Status const status,
       auto&&... rest) noexcept {
+    markJobSite(site);
     if (blk) proj(blk, static_cast<uint16_t>(status),
                   std::forward<decltype(rest)>(rest)...);
   };
@@ -2167,11 +4438,15 @@ public:
   /// Detaches the controller delegate first so la_avdecc cannot deliver a
   /// notification while we are tearing down.
   void close() noexcept {
+    std::lock_guard<std::mutex> lg(attachLock_);
     if (agg_ && delegateAttached_) {
       agg_->setControllerDelegate(nullptr);
       delegateAttached_ = false;
     }
+    if (auto const batcher = delegate_.setBatcher(nullptr)) batcher->stop();
+    if (auto* const coalescer = delegate_.coalescer()) coalescer->stop();
     delegate_.clearAllSlots();
+    delegate_.streams_.closeAll();
     agg_.reset();
   }
 
@@ -2183,19 +4458,144 @@ public:
   // `detachDelegate()` unsubscribes; `clearDelegateBlocks()` resets every
   // slot. All three are safe to call on a closed owner.
   void attachDelegate() noexcept {
-    if (agg_ && !delegateAttached_) {
-      agg_->setControllerDelegate(&delegate_);
-      delegateAttached_ = true;
-    }
+    std::lock_guard<std::mutex> lg(attachLock_);
+    delegateWanted_ = true;
+    updateDelegateAttachment();
   }
   void detachDelegate() noexcept {
-    if (agg_ && delegateAttached_) {
-      agg_->setControllerDelegate(nullptr);
-      delegateAttached_ = false;
-    }
+    std::lock_guard<std::mutex> lg(attachLock_);
+    delegateWanted_ = false;
+    updateDelegateAttachment();
   }
   void clearDelegateBlocks() noexcept { delegate_.clearAllSlots(); }
 
+  /// Record every delegate event into `stream`'s ring; see
+  /// ProtocolInterfaceOwner::attachEventStream. Streams see events before
+  /// batching and coalescing, which apply to the delegate blocks only.
+  void attachEventStream(CallbackEventStreamOwner* stream) noexcept {
+    if (!stream) return;
+    std::lock_guard<std::mutex> lg(attachLock_);
+    if (!agg_) {
+      stream->close();
+      return;
+    }
+    try {
+      delegate_.streams_.add(stream->shared());
+    } catch (...) {
+      stream->close();
+      return;
+    }
+    updateDelegateAttachment();
+  }
+  void detachEventStream(CallbackEventStreamOwner* stream) noexcept {
+    if (!stream) return;
+    std::lock_guard<std::mutex> lg(attachLock_);
+    delegate_.streams_.remove(stream->shared().get());
+    stream->close();
+    updateDelegateAttachment();
+  }
+
+  /// Per-entity sharded delegate delivery; see
+  /// ProtocolInterfaceOwner::setCallbackShards. AECP/ACMP command result
+  /// handlers are unaffected and still run on the executor, so they are
+  /// not ordered against the entity's sharded notifications.
+  void setCallbackShards(CallbackShardsOwner* shards) noexcept {
+    delegate_.setShards(shards ? shards->shared() : nullptr);
+  }
+
+  /// Batched delegate delivery; see AVDECCSwiftDelegateBatch.hpp. `cb`
+  /// receives a `DelegateEventBatch const*` valid for the call; events in
+  /// it reach their slot blocks only through `replayDelegateEvent`.
+  /// `intervalNanos` 0 flushes behind the executor's pending jobs. Events
+  /// already recorded by a batcher this replaces are flushed first, on
+  /// the calling thread. Takes precedence over callback shards.
+  void setDelegateBatching(uint64_t intervalNanos, uint32_t maxEvents,
+                           void (^cb)(void const*)) noexcept {
+    std::shared_ptr<DelegateEventBatcher> batcher;
+    if (piOwner_) {
+      try {
+        batcher = DelegateEventBatcher::create(piOwner_->executorName(), intervalNanos,
+                                               maxEvents, DelegateEventBatcher::BatchBlock(cb));
+      } catch (...) {
+      }
+    }
+    retireBatcher(delegate_.setBatcher(std::move(batcher)));
+  }
+  /// Back to direct (or sharded) delivery, flushing what was recorded.
+  void disableDelegateBatching() noexcept { retireBatcher(delegate_.setBatcher(nullptr)); }
+
+  /// Call event `index` of `batch` (as passed to the batching block) on
+  /// the slot it was recorded from. A slot unbound since is skipped.
+  void replayDelegateEvent(void const* batch, size_t index) const noexcept {
+    auto const& events = *static_cast<DelegateEventBatch const*>(batch);
+    if (index < events.size()) delegate_.replay(events[index], events);
+  }
+
+  /// Forward onEntityUpdate only when a field group in `mask`
+  /// (EntityUpdateField bits) changed; 0 forwards every update.
+  void setEntityUpdateFilter(uint32_t mask) noexcept { delegate_.updateFilter_.setMask(mask); }
+  uint64_t entityUpdatesForwarded() const noexcept {
+    return delegate_.updateFilter_.forwarded();
+  }
+  uint64_t entityUpdatesSuppressed() const noexcept {
+    return delegate_.updateFilter_.suppressed();
+  }
+
+  /// Count and time every delegate block call per slot, including
+  /// replayed and coalesced ones. See
+  /// ProtocolInterfaceOwner::setCallbackProfiling.
+  bool setCallbackProfiling(bool enabled) noexcept {
+    return delegate_.profiler_->setEnabled(enabled);
+  }
+  bool callbackProfiling() const noexcept { return delegate_.profiler_->enabled(); }
+  size_t copyCallbackProfile(SlotProfileStatistics* out, size_t capacity) const noexcept {
+    return delegate_.profiler_->copyTo(out, capacity);
+  }
+
+  /// Latest-value coalescing for one high-rate delegate event, numbered
+  /// as Swift's `CoalescedDelegateEvent`: 0 entity counters, 1 AVB
+  /// interface counters, 2 clock domain counters, 3 stream input
+  /// counters, 4 stream output counters, 5 AECP response time, 6
+  /// operation status. Keys are the entity plus the descriptor (and, for
+  /// operation status, the operation ID). `intervalNanos` 0 turns it off.
+  /// Values are delivered where the entity's other callbacks are: its
+  /// shard, or the executor.
+  void setDelegateCoalescing(uint8_t event, uint64_t intervalNanos) noexcept {
+    using S = BlockControllerDelegate::Slots;
+    if (!piOwner_) return;
+    auto const& executor = piOwner_->executorName();
+    switch (event) {
+      case 0: delegate_.setCoalescing(&S::onEntityCountersChanged_, 0, intervalNanos, executor); break;
+      case 1: delegate_.setCoalescing(&S::onAvbInterfaceCountersChanged_, 1, intervalNanos, executor); break;
+      case 2: delegate_.setCoalescing(&S::onClockDomainCountersChanged_, 1, intervalNanos, executor); break;
+      case 3: delegate_.setCoalescing(&S::onStreamInputCountersChanged_, 1, intervalNanos, executor); break;
+      case 4: delegate_.setCoalescing(&S::onStreamOutputCountersChanged_, 1, intervalNanos, executor); break;
+      case 5: delegate_.setCoalescing(&S::onAecpResponseTime_, 0, intervalNanos, executor); break;
+      case 6: delegate_.setCoalescing(&S::onOperationStatus_, 3, intervalNanos, executor); break;
+      default: break;
+    }
+  }
+
+  /// Coalesced events taken, and values delivered for them.
+  uint64_t delegateCoalescedEvents() const noexcept {
+    auto const* coalescer = delegate_.coalescer();
+    return coalescer ? coalescer->offered() : 0;
+  }
+  uint64_t delegateCoalescedDeliveries() const noexcept {
+    auto const* coalescer = delegate_.coalescer();
+    return coalescer ? coalescer->delivered() : 0;
+  }
+
+  /// Events recorded and batches delivered by the current batcher.
+  uint64_t delegateBatchEvents() const noexcept {
+    auto const batcher = delegate_.batcher();
+    return batcher ? batcher->events() : 0;
+  }
+  uint64_t delegateBatches() const noexcept {
+    auto const batcher = delegate_.batcher();
+    return batcher ? batcher->batches() : 0;
+  }
+
   // Per-slot setters. Each takes a Swift-side `void (^)(...)` block and
   // routes it to the matching slot via BlockControllerDelegate::setSlot.
   // Block argument shapes mirror the C++ slot shapes; fields that la_avdecc
@@ -2205,34 +4605,34 @@ public:
 
   void setOnTransportError(void (^cb)()) noexcept {
     using BT = void (^)();
-    delegate_.setSlot(&BlockControllerDelegate::onTransportError_,
+    delegate_.setSlot(&BlockControllerDelegate::Slots::onTransportError_,
                       Block<void>((BT)cb));
   }
   void setOnEntityOnline(
       void (^cb)(uint64_t, la::avdecc::entity::Entity const*)) noexcept {
     using BT = void (^)(uint64_t, la::avdecc::entity::Entity const*);
-    delegate_.setSlot(&BlockControllerDelegate::onEntityOnline_,
+    delegate_.setSlot(&BlockControllerDelegate::Slots::onEntityOnline_,
                       Block<void, uint64_t,
                             la::avdecc::entity::Entity const*>((BT)cb));
   }
   void setOnEntityUpdate(
       void (^cb)(uint64_t, la::avdecc::entity::Entity const*)) noexcept {
     using BT = void (^)(uint64_t, la::avdecc::entity::Entity const*);
-    delegate_.setSlot(&BlockControllerDelegate::onEntityUpdate_,
+    delegate_.setSlot(&BlockControllerDelegate::Slots::onEntityUpdate_,
                       Block<void, uint64_t,
                             la::avdecc::entity::Entity const*>((BT)cb));
   }
   void setOnEntityOffline(void (^cb)(uint64_t)) noexcept {
-    delegate_.setSlot(&BlockControllerDelegate::onEntityOffline_,
+    delegate_.setSlot(&BlockControllerDelegate::Slots::onEntityOffline_,
                       Block<void, uint64_t>(cb));
   }
   void setOnEntityIdentifyNotification(void (^cb)(uint64_t)) noexcept {
-    delegate_.setSlot(&BlockControllerDelegate::onEntityIdentifyNotification_,
+    delegate_.setSlot(&BlockControllerDelegate::Slots::onEntityIdentifyNotification_,
                       Block<void, uint64_t>(cb));
   }
   void setOnDeregisteredFromUnsolicitedNotifications(void (^cb)(uint64_t)) noexcept {
     delegate_.setSlot(
-        &BlockControllerDelegate::onDeregisteredFromUnsolicitedNotifications_,
+        &BlockControllerDelegate::Slots::onDeregisteredFromUnsolicitedNotifications_,
         Block<void, uint64_t>(cb));
   }
 
@@ -2240,85 +4640,85 @@ public:
   void setOnControllerConnectResponseSniffed(
       void (^cb)(uint64_t, uint16_t, uint64_t, uint16_t,
                  uint16_t, uint16_t, uint16_t)) noexcept {
-    delegate_.setSlot(&BlockControllerDelegate::onControllerConnectResponseSniffed_,
+    delegate_.setSlot(&BlockControllerDelegate::Slots::onControllerConnectResponseSniffed_,
                       BlockControllerDelegate::AcmpSniffedBlock(cb));
   }
   void setOnControllerDisconnectResponseSniffed(
       void (^cb)(uint64_t, uint16_t, uint64_t, uint16_t,
                  uint16_t, uint16_t, uint16_t)) noexcept {
-    delegate_.setSlot(&BlockControllerDelegate::onControllerDisconnectResponseSniffed_,
+    delegate_.setSlot(&BlockControllerDelegate::Slots::onControllerDisconnectResponseSniffed_,
                       BlockControllerDelegate::AcmpSniffedBlock(cb));
   }
   void setOnListenerConnectResponseSniffed(
       void (^cb)(uint64_t, uint16_t, uint64_t, uint16_t,
                  uint16_t, uint16_t, uint16_t)) noexcept {
-    delegate_.setSlot(&BlockControllerDelegate::onListenerConnectResponseSniffed_,
+    delegate_.setSlot(&BlockControllerDelegate::Slots::onListenerConnectResponseSniffed_,
                       BlockControllerDelegate::AcmpSniffedBlock(cb));
   }
   void setOnListenerDisconnectResponseSniffed(
       void (^cb)(uint64_t, uint16_t, uint64_t, uint16_t,
                  uint16_t, uint16_t, uint16_t)) noexcept {
-    delegate_.setSlot(&BlockControllerDelegate::onListenerDisconnectResponseSniffed_,
+    delegate_.setSlot(&BlockControllerDelegate::Slots::onListenerDisconnectResponseSniffed_,
                       BlockControllerDelegate::AcmpSniffedBlock(cb));
   }
   void setOnGetTalkerStreamStateResponseSniffed(
       void (^cb)(uint64_t, uint16_t, uint64_t, uint16_t,
                  uint16_t, uint16_t, uint16_t)) noexcept {
-    delegate_.setSlot(&BlockControllerDelegate::onGetTalkerStreamStateResponseSniffed_,
+    delegate_.setSlot(&BlockControllerDelegate::Slots::onGetTalkerStreamStateResponseSniffed_,
                       BlockControllerDelegate::AcmpSniffedBlock(cb));
   }
   void setOnGetListenerStreamStateResponseSniffed(
       void (^cb)(uint64_t, uint16_t, uint64_t, uint16_t,
                  uint16_t, uint16_t, uint16_t)) noexcept {
-    delegate_.setSlot(&BlockControllerDelegate::onGetListenerStreamStateResponseSniffed_,
+    delegate_.setSlot(&BlockControllerDelegate::Slots::onGetListenerStreamStateResponseSniffed_,
                       BlockControllerDelegate::AcmpSniffedBlock(cb));
   }
 
   // Acquire / release / lock / unlock — single shape.
   void setOnEntityAcquired(
       void (^cb)(uint64_t, uint64_t, uint16_t, uint16_t)) noexcept {
-    delegate_.setSlot(&BlockControllerDelegate::onEntityAcquired_,
+    delegate_.setSlot(&BlockControllerDelegate::Slots::onEntityAcquired_,
                       BlockControllerDelegate::AcquireBlock(cb));
   }
   void setOnEntityReleased(
       void (^cb)(uint64_t, uint64_t, uint16_t, uint16_t)) noexcept {
-    delegate_.setSlot(&BlockControllerDelegate::onEntityReleased_,
+    delegate_.setSlot(&BlockControllerDelegate::Slots::onEntityReleased_,
                       BlockControllerDelegate::AcquireBlock(cb));
   }
   void setOnEntityLocked(
       void (^cb)(uint64_t, uint64_t, uint16_t, uint16_t)) noexcept {
-    delegate_.setSlot(&BlockControllerDelegate::onEntityLocked_,
+    delegate_.setSlot(&BlockControllerDelegate::Slots::onEntityLocked_,
                       BlockControllerDelegate::AcquireBlock(cb));
   }
   void setOnEntityUnlocked(
       void (^cb)(uint64_t, uint64_t, uint16_t, uint16_t)) noexcept {
-    delegate_.setSlot(&BlockControllerDelegate::onEntityUnlocked_,
+    delegate_.setSlot(&BlockControllerDelegate::Slots::onEntityUnlocked_,
                       BlockControllerDelegate::AcquireBlock(cb));
   }
 
   void setOnConfigurationChanged(void (^cb)(uint64_t, uint16_t)) noexcept {
-    delegate_.setSlot(&BlockControllerDelegate::onConfigurationChanged_,
+    delegate_.setSlot(&BlockControllerDelegate::Slots::onConfigurationChanged_,
                       Block<void, uint64_t, uint16_t>(cb));
   }
   void setOnAssociationIDChanged(void (^cb)(uint64_t, uint64_t)) noexcept {
-    delegate_.setSlot(&BlockControllerDelegate::onAssociationIDChanged_,
+    delegate_.setSlot(&BlockControllerDelegate::Slots::onAssociationIDChanged_,
                       Block<void, uint64_t, uint64_t>(cb));
   }
   void setOnClockSourceChanged(
       void (^cb)(uint64_t, uint16_t, uint16_t)) noexcept {
-    delegate_.setSlot(&BlockControllerDelegate::onClockSourceChanged_,
+    delegate_.setSlot(&BlockControllerDelegate::Slots::onClockSourceChanged_,
                       Block<void, uint64_t, uint16_t, uint16_t>(cb));
   }
 
   // Stream format / mappings / info / start-stop.
   void setOnStreamInputFormatChanged(
       void (^cb)(uint64_t, uint16_t, uint64_t)) noexcept {
-    delegate_.setSlot(&BlockControllerDelegate::onStreamInputFormatChanged_,
+    delegate_.setSlot(&BlockControllerDelegate::Slots::onStreamInputFormatChanged_,
                       BlockControllerDelegate::StreamFormatBlock(cb));
   }
   void setOnStreamOutputFormatChanged(
       void (^cb)(uint64_t, uint16_t, uint64_t)) noexcept {
-    delegate_.setSlot(&BlockControllerDelegate::onStreamOutputFormatChanged_,
+    delegate_.setSlot(&BlockControllerDelegate::Slots::onStreamOutputFormatChanged_,
                       BlockControllerDelegate::StreamFormatBlock(cb));
   }
   void setOnStreamPortInputAudioMappingsChanged(
@@ -2326,7 +4726,7 @@ public:
                  la::avdecc::entity::model::AudioMapping const*, size_t)) noexcept {
     using BT = void (^)(uint64_t, uint16_t, uint16_t, uint16_t,
                         la::avdecc::entity::model::AudioMapping const*, size_t);
-    delegate_.setSlot(&BlockControllerDelegate::onStreamPortInputAudioMappingsChanged_,
+    delegate_.setSlot(&BlockControllerDelegate::Slots::onStreamPortInputAudioMappingsChanged_,
                       BlockControllerDelegate::StreamMappingsChangedBlock((BT)cb));
   }
   void setOnStreamPortOutputAudioMappingsChanged(
@@ -2334,7 +4734,7 @@ public:
                  la::avdecc::entity::model::AudioMapping const*, size_t)) noexcept {
     using BT = void (^)(uint64_t, uint16_t, uint16_t, uint16_t,
                         la::avdecc::entity::model::AudioMapping const*, size_t);
-    delegate_.setSlot(&BlockControllerDelegate::onStreamPortOutputAudioMappingsChanged_,
+    delegate_.setSlot(&BlockControllerDelegate::Slots::onStreamPortOutputAudioMappingsChanged_,
                       BlockControllerDelegate::StreamMappingsChangedBlock((BT)cb));
   }
   void setOnStreamPortInputAudioMappingsAdded(
@@ -2342,7 +4742,7 @@ public:
                  la::avdecc::entity::model::AudioMapping const*, size_t)) noexcept {
     using BT = void (^)(uint64_t, uint16_t,
                         la::avdecc::entity::model::AudioMapping const*, size_t);
-    delegate_.setSlot(&BlockControllerDelegate::onStreamPortInputAudioMappingsAdded_,
+    delegate_.setSlot(&BlockControllerDelegate::Slots::onStreamPortInputAudioMappingsAdded_,
                       BlockControllerDelegate::StreamMappingsBlock((BT)cb));
   }
   void setOnStreamPortOutputAudioMappingsAdded(
@@ -2350,7 +4750,7 @@ public:
                  la::avdecc::entity::model::AudioMapping const*, size_t)) noexcept {
     using BT = void (^)(uint64_t, uint16_t,
                         la::avdecc::entity::model::AudioMapping const*, size_t);
-    delegate_.setSlot(&BlockControllerDelegate::onStreamPortOutputAudioMappingsAdded_,
+    delegate_.setSlot(&BlockControllerDelegate::Slots::onStreamPortOutputAudioMappingsAdded_,
                       BlockControllerDelegate::StreamMappingsBlock((BT)cb));
   }
   void setOnStreamPortInputAudioMappingsRemoved(
@@ -2358,7 +4758,7 @@ public:
                  la::avdecc::entity::model::AudioMapping const*, size_t)) noexcept {
     using BT = void (^)(uint64_t, uint16_t,
                         la::avdecc::entity::model::AudioMapping const*, size_t);
-    delegate_.setSlot(&BlockControllerDelegate::onStreamPortInputAudioMappingsRemoved_,
+    delegate_.setSlot(&BlockControllerDelegate::Slots::onStreamPortInputAudioMappingsRemoved_,
                       BlockControllerDelegate::StreamMappingsBlock((BT)cb));
   }
   void setOnStreamPortOutputAudioMappingsRemoved(
@@ -2366,7 +4766,7 @@ public:
                  la::avdecc::entity::model::AudioMapping const*, size_t)) noexcept {
     using BT = void (^)(uint64_t, uint16_t,
                         la::avdecc::entity::model::AudioMapping const*, size_t);
-    delegate_.setSlot(&BlockControllerDelegate::onStreamPortOutputAudioMappingsRemoved_,
+    delegate_.setSlot(&BlockControllerDelegate::Slots::onStreamPortOutputAudioMappingsRemoved_,
                       BlockControllerDelegate::StreamMappingsBlock((BT)cb));
   }
   void setOnStreamInputInfoChanged(
@@ -2374,7 +4774,7 @@ public:
                  la::avdecc::entity::model::StreamInfo const*, bool)) noexcept {
     using BT = void (^)(uint64_t, uint16_t,
                         la::avdecc::entity::model::StreamInfo const*, bool);
-    delegate_.setSlot(&BlockControllerDelegate::onStreamInputInfoChanged_,
+    delegate_.setSlot(&BlockControllerDelegate::Slots::onStreamInputInfoChanged_,
                       BlockControllerDelegate::StreamInfoChangedBlock((BT)cb));
   }
   void setOnStreamOutputInfoChanged(
@@ -2382,28 +4782,28 @@ public:
                  la::avdecc::entity::model::StreamInfo const*, bool)) noexcept {
     using BT = void (^)(uint64_t, uint16_t,
                         la::avdecc::entity::model::StreamInfo const*, bool);
-    delegate_.setSlot(&BlockControllerDelegate::onStreamOutputInfoChanged_,
+    delegate_.setSlot(&BlockControllerDelegate::Slots::onStreamOutputInfoChanged_,
                       BlockControllerDelegate::StreamInfoChangedBlock((BT)cb));
   }
   void setOnStreamInputStarted(void (^cb)(uint64_t, uint16_t)) noexcept {
-    delegate_.setSlot(&BlockControllerDelegate::onStreamInputStarted_,
+    delegate_.setSlot(&BlockControllerDelegate::Slots::onStreamInputStarted_,
                       BlockControllerDelegate::StreamIdxBlock(cb));
   }
   void setOnStreamOutputStarted(void (^cb)(uint64_t, uint16_t)) noexcept {
-    delegate_.setSlot(&BlockControllerDelegate::onStreamOutputStarted_,
+    delegate_.setSlot(&BlockControllerDelegate::Slots::onStreamOutputStarted_,
                       BlockControllerDelegate::StreamIdxBlock(cb));
   }
   void setOnStreamInputStopped(void (^cb)(uint64_t, uint16_t)) noexcept {
-    delegate_.setSlot(&BlockControllerDelegate::onStreamInputStopped_,
+    delegate_.setSlot(&BlockControllerDelegate::Slots::onStreamInputStopped_,
                       BlockControllerDelegate::StreamIdxBlock(cb));
   }
   void setOnStreamOutputStopped(void (^cb)(uint64_t, uint16_t)) noexcept {
-    delegate_.setSlot(&BlockControllerDelegate::onStreamOutputStopped_,
+    delegate_.setSlot(&BlockControllerDelegate::Slots::onStreamOutputStopped_,
                       BlockControllerDelegate::StreamIdxBlock(cb));
   }
   void setOnMaxTransitTimeChanged(
       void (^cb)(uint64_t, uint16_t, uint64_t)) noexcept {
-    delegate_.setSlot(&BlockControllerDelegate::onMaxTransitTimeChanged_,
+    delegate_.setSlot(&BlockControllerDelegate::Slots::onMaxTransitTimeChanged_,
                       Block<void, uint64_t, uint16_t, uint64_t>(cb));
   }
 
@@ -2413,7 +4813,7 @@ public:
                  la::avdecc::entity::model::AvdeccFixedString const*)) noexcept {
     using BT = void (^)(uint64_t,
                         la::avdecc::entity::model::AvdeccFixedString const*);
-    delegate_.setSlot(&BlockControllerDelegate::onEntityNameChanged_,
+    delegate_.setSlot(&BlockControllerDelegate::Slots::onEntityNameChanged_,
                       BlockControllerDelegate::EntityNameBlock((BT)cb));
   }
   void setOnEntityGroupNameChanged(
@@ -2421,7 +4821,7 @@ public:
                  la::avdecc::entity::model::AvdeccFixedString const*)) noexcept {
     using BT = void (^)(uint64_t,
                         la::avdecc::entity::model::AvdeccFixedString const*);
-    delegate_.setSlot(&BlockControllerDelegate::onEntityGroupNameChanged_,
+    delegate_.setSlot(&BlockControllerDelegate::Slots::onEntityGroupNameChanged_,
                       BlockControllerDelegate::EntityNameBlock((BT)cb));
   }
   void setOnConfigurationNameChanged(
@@ -2429,7 +4829,7 @@ public:
                  la::avdecc::entity::model::AvdeccFixedString const*)) noexcept {
     using BT = void (^)(uint64_t, uint16_t,
                         la::avdecc::entity::model::AvdeccFixedString const*);
-    delegate_.setSlot(&BlockControllerDelegate::onConfigurationNameChanged_,
+    delegate_.setSlot(&BlockControllerDelegate::Slots::onConfigurationNameChanged_,
                       BlockControllerDelegate::ConfigNameBlock((BT)cb));
   }
   // Descriptor-name shape: 14 setters, all DescNameBlock.
@@ -2438,7 +4838,7 @@ public:
                  la::avdecc::entity::model::AvdeccFixedString const*)) noexcept {
     using BT = void (^)(uint64_t, uint16_t, uint16_t,
                         la::avdecc::entity::model::AvdeccFixedString const*);
-    delegate_.setSlot(&BlockControllerDelegate::onAudioUnitNameChanged_,
+    delegate_.setSlot(&BlockControllerDelegate::Slots::onAudioUnitNameChanged_,
                       BlockControllerDelegate::DescNameBlock((BT)cb));
   }
   void setOnStreamInputNameChanged(
@@ -2446,7 +4846,7 @@ public:
                  la::avdecc::entity::model::AvdeccFixedString const*)) noexcept {
     using BT = void (^)(uint64_t, uint16_t, uint16_t,
                         la::avdecc::entity::model::AvdeccFixedString const*);
-    delegate_.setSlot(&BlockControllerDelegate::onStreamInputNameChanged_,
+    delegate_.setSlot(&BlockControllerDelegate::Slots::onStreamInputNameChanged_,
                       BlockControllerDelegate::DescNameBlock((BT)cb));
   }
   void setOnStreamOutputNameChanged(
@@ -2454,7 +4854,7 @@ public:
                  la::avdecc::entity::model::AvdeccFixedString const*)) noexcept {
     using BT = void (^)(uint64_t, uint16_t, uint16_t,
                         la::avdecc::entity::model::AvdeccFixedString const*);
-    delegate_.setSlot(&BlockControllerDelegate::onStreamOutputNameChanged_,
+    delegate_.setSlot(&BlockControllerDelegate::Slots::onStreamOutputNameChanged_,
                       BlockControllerDelegate::DescNameBlock((BT)cb));
   }
   void setOnJackInputNameChanged(
@@ -2462,7 +4862,7 @@ public:
                  la::avdecc::entity::model::AvdeccFixedString const*)) noexcept {
     using BT = void (^)(uint64_t, uint16_t, uint16_t,
                         la::avdecc::entity::model::AvdeccFixedString const*);
-    delegate_.setSlot(&BlockControllerDelegate::onJackInputNameChanged_,
+    delegate_.setSlot(&BlockControllerDelegate::Slots::onJackInputNameChanged_,
                       BlockControllerDelegate::DescNameBlock((BT)cb));
   }
   void setOnJackOutputNameChanged(
@@ -2470,7 +4870,7 @@ public:
                  la::avdecc::entity::model::AvdeccFixedString const*)) noexcept {
     using BT = void (^)(uint64_t, uint16_t, uint16_t,
                         la::avdecc::entity::model::AvdeccFixedString const*);
-    delegate_.setSlot(&BlockControllerDelegate::onJackOutputNameChanged_,
+    delegate_.setSlot(&BlockControllerDelegate::Slots::onJackOutputNameChanged_,
                       BlockControllerDelegate::DescNameBlock((BT)cb));
   }
   void setOnAvbInterfaceNameChanged(
@@ -2478,7 +4878,7 @@ public:
                  la::avdecc::entity::model::AvdeccFixedString const*)) noexcept {
     using BT = void (^)(uint64_t, uint16_t, uint16_t,
                         la::avdecc::entity::model::AvdeccFixedString const*);
-    delegate_.setSlot(&BlockControllerDelegate::onAvbInterfaceNameChanged_,
+    delegate_.setSlot(&BlockControllerDelegate::Slots::onAvbInterfaceNameChanged_,
                       BlockControllerDelegate::DescNameBlock((BT)cb));
   }
   void setOnClockSourceNameChanged(
@@ -2486,7 +4886,7 @@ public:
                  la::avdecc::entity::model::AvdeccFixedString const*)) noexcept {
     using BT = void (^)(uint64_t, uint16_t, uint16_t,
                         la::avdecc::entity::model::AvdeccFixedString const*);
-    delegate_.setSlot(&BlockControllerDelegate::onClockSourceNameChanged_,
+    delegate_.setSlot(&BlockControllerDelegate::Slots::onClockSourceNameChanged_,
                       BlockControllerDelegate::DescNameBlock((BT)cb));
   }
   void setOnMemoryObjectNameChanged(
@@ -2494,7 +4894,7 @@ public:
                  la::avdecc::entity::model::AvdeccFixedString const*)) noexcept {
     using BT = void (^)(uint64_t, uint16_t, uint16_t,
                         la::avdecc::entity::model::AvdeccFixedString const*);
-    delegate_.setSlot(&BlockControllerDelegate::onMemoryObjectNameChanged_,
+    delegate_.setSlot(&BlockControllerDelegate::Slots::onMemoryObjectNameChanged_,
                       BlockControllerDelegate::DescNameBlock((BT)cb));
   }
   void setOnAudioClusterNameChanged(
@@ -2502,7 +4902,7 @@ public:
                  la::avdecc::entity::model::AvdeccFixedString const*)) noexcept {
     using BT = void (^)(uint64_t, uint16_t, uint16_t,
                         la::avdecc::entity::model::AvdeccFixedString const*);
-    delegate_.setSlot(&BlockControllerDelegate::onAudioClusterNameChanged_,
+    delegate_.setSlot(&BlockControllerDelegate::Slots::onAudioClusterNameChanged_,
                       BlockControllerDelegate::DescNameBlock((BT)cb));
   }
   void setOnControlNameChanged(
@@ -2510,7 +4910,7 @@ public:
                  la::avdecc::entity::model::AvdeccFixedString const*)) noexcept {
     using BT = void (^)(uint64_t, uint16_t, uint16_t,
                         la::avdecc::entity::model::AvdeccFixedString const*);
-    delegate_.setSlot(&BlockControllerDelegate::onControlNameChanged_,
+    delegate_.setSlot(&BlockControllerDelegate::Slots::onControlNameChanged_,
                       BlockControllerDelegate::DescNameBlock((BT)cb));
   }
   void setOnClockDomainNameChanged(
@@ -2518,7 +4918,7 @@ public:
                  la::avdecc::entity::model::AvdeccFixedString const*)) noexcept {
     using BT = void (^)(uint64_t, uint16_t, uint16_t,
                         la::avdecc::entity::model::AvdeccFixedString const*);
-    delegate_.setSlot(&BlockControllerDelegate::onClockDomainNameChanged_,
+    delegate_.setSlot(&BlockControllerDelegate::Slots::onClockDomainNameChanged_,
                       BlockControllerDelegate::DescNameBlock((BT)cb));
   }
   void setOnTimingNameChanged(
@@ -2526,7 +4926,7 @@ public:
                  la::avdecc::entity::model::AvdeccFixedString const*)) noexcept {
     using BT = void (^)(uint64_t, uint16_t, uint16_t,
                         la::avdecc::entity::model::AvdeccFixedString const*);
-    delegate_.setSlot(&BlockControllerDelegate::onTimingNameChanged_,
+    delegate_.setSlot(&BlockControllerDelegate::Slots::onTimingNameChanged_,
                       BlockControllerDelegate::DescNameBlock((BT)cb));
   }
   void setOnPtpInstanceNameChanged(
@@ -2534,7 +4934,7 @@ public:
                  la::avdecc::entity::model::AvdeccFixedString const*)) noexcept {
     using BT = void (^)(uint64_t, uint16_t, uint16_t,
                         la::avdecc::entity::model::AvdeccFixedString const*);
-    delegate_.setSlot(&BlockControllerDelegate::onPtpInstanceNameChanged_,
+    delegate_.setSlot(&BlockControllerDelegate::Slots::onPtpInstanceNameChanged_,
                       BlockControllerDelegate::DescNameBlock((BT)cb));
   }
   void setOnPtpPortNameChanged(
@@ -2542,49 +4942,49 @@ public:
                  la::avdecc::entity::model::AvdeccFixedString const*)) noexcept {
     using BT = void (^)(uint64_t, uint16_t, uint16_t,
                         la::avdecc::entity::model::AvdeccFixedString const*);
-    delegate_.setSlot(&BlockControllerDelegate::onPtpPortNameChanged_,
+    delegate_.setSlot(&BlockControllerDelegate::Slots::onPtpPortNameChanged_,
                       BlockControllerDelegate::DescNameBlock((BT)cb));
   }
 
   void setOnAudioUnitSamplingRateChanged(
       void (^cb)(uint64_t, uint16_t, uint32_t)) noexcept {
-    delegate_.setSlot(&BlockControllerDelegate::onAudioUnitSamplingRateChanged_,
+    delegate_.setSlot(&BlockControllerDelegate::Slots::onAudioUnitSamplingRateChanged_,
                       BlockControllerDelegate::SamplingRateBlock(cb));
   }
   void setOnVideoClusterSamplingRateChanged(
       void (^cb)(uint64_t, uint16_t, uint32_t)) noexcept {
-    delegate_.setSlot(&BlockControllerDelegate::onVideoClusterSamplingRateChanged_,
+    delegate_.setSlot(&BlockControllerDelegate::Slots::onVideoClusterSamplingRateChanged_,
                       BlockControllerDelegate::SamplingRateBlock(cb));
   }
   void setOnSensorClusterSamplingRateChanged(
       void (^cb)(uint64_t, uint16_t, uint32_t)) noexcept {
-    delegate_.setSlot(&BlockControllerDelegate::onSensorClusterSamplingRateChanged_,
+    delegate_.setSlot(&BlockControllerDelegate::Slots::onSensorClusterSamplingRateChanged_,
                       BlockControllerDelegate::SamplingRateBlock(cb));
   }
 
   void setOnEntityCountersChanged(
       void (^cb)(uint64_t, uint32_t, uint32_t const*)) noexcept {
-    delegate_.setSlot(&BlockControllerDelegate::onEntityCountersChanged_,
+    delegate_.setSlot(&BlockControllerDelegate::Slots::onEntityCountersChanged_,
                       BlockControllerDelegate::EntityCountersBlock(cb));
   }
   void setOnAvbInterfaceCountersChanged(
       void (^cb)(uint64_t, uint16_t, uint32_t, uint32_t const*)) noexcept {
-    delegate_.setSlot(&BlockControllerDelegate::onAvbInterfaceCountersChanged_,
+    delegate_.setSlot(&BlockControllerDelegate::Slots::onAvbInterfaceCountersChanged_,
                       BlockControllerDelegate::DescCountersBlock(cb));
   }
   void setOnClockDomainCountersChanged(
       void (^cb)(uint64_t, uint16_t, uint32_t, uint32_t const*)) noexcept {
-    delegate_.setSlot(&BlockControllerDelegate::onClockDomainCountersChanged_,
+    delegate_.setSlot(&BlockControllerDelegate::Slots::onClockDomainCountersChanged_,
                       BlockControllerDelegate::DescCountersBlock(cb));
   }
   void setOnStreamInputCountersChanged(
       void (^cb)(uint64_t, uint16_t, uint32_t, uint32_t const*)) noexcept {
-    delegate_.setSlot(&BlockControllerDelegate::onStreamInputCountersChanged_,
+    delegate_.setSlot(&BlockControllerDelegate::Slots::onStreamInputCountersChanged_,
                       BlockControllerDelegate::DescCountersBlock(cb));
   }
   void setOnStreamOutputCountersChanged(
       void (^cb)(uint64_t, uint16_t, uint32_t, uint32_t const*)) noexcept {
-    delegate_.setSlot(&BlockControllerDelegate::onStreamOutputCountersChanged_,
+    delegate_.setSlot(&BlockControllerDelegate::Slots::onStreamOutputCountersChanged_,
                       BlockControllerDelegate::DescCountersBlock(cb));
   }
 
@@ -2593,7 +4993,7 @@ public:
                  la::avdecc::entity::model::AvbInfo const*)) noexcept {
     using BT = void (^)(uint64_t, uint16_t,
                         la::avdecc::entity::model::AvbInfo const*);
-    delegate_.setSlot(&BlockControllerDelegate::onAvbInfoChanged_,
+    delegate_.setSlot(&BlockControllerDelegate::Slots::onAvbInfoChanged_,
                       Block<void, uint64_t, uint16_t,
                             la::avdecc::entity::model::AvbInfo const*>((BT)cb));
   }
@@ -2602,26 +5002,26 @@ public:
                  la::avdecc::entity::model::AsPath const*)) noexcept {
     using BT = void (^)(uint64_t, uint16_t,
                         la::avdecc::entity::model::AsPath const*);
-    delegate_.setSlot(&BlockControllerDelegate::onAsPathChanged_,
+    delegate_.setSlot(&BlockControllerDelegate::Slots::onAsPathChanged_,
                       Block<void, uint64_t, uint16_t,
                             la::avdecc::entity::model::AsPath const*>((BT)cb));
   }
   void setOnControlValuesChanged(
       void (^cb)(uint64_t, uint16_t, uint8_t const*, size_t)) noexcept {
-    delegate_.setSlot(&BlockControllerDelegate::onControlValuesChanged_,
+    delegate_.setSlot(&BlockControllerDelegate::Slots::onControlValuesChanged_,
                       Block<void, uint64_t, uint16_t,
                             uint8_t const*, size_t>(cb));
   }
 
   void setOnMemoryObjectLengthChanged(
       void (^cb)(uint64_t, uint16_t, uint16_t, uint64_t)) noexcept {
-    delegate_.setSlot(&BlockControllerDelegate::onMemoryObjectLengthChanged_,
+    delegate_.setSlot(&BlockControllerDelegate::Slots::onMemoryObjectLengthChanged_,
                       Block<void, uint64_t, uint16_t, uint16_t, uint64_t>(cb));
   }
   void setOnOperationStatus(
       void (^cb)(uint64_t, uint16_t, uint16_t, uint16_t, uint16_t)) noexcept {
     delegate_.setSlot(
-        &BlockControllerDelegate::onOperationStatus_,
+        &BlockControllerDelegate::Slots::onOperationStatus_,
         Block<void, uint64_t, uint16_t, uint16_t, uint16_t, uint16_t>(cb));
   }
 
@@ -2631,7 +5031,7 @@ public:
                  la::avdecc::entity::model::AvdeccFixedString const*)) noexcept {
     using BT = void (^)(uint64_t, uint64_t,
                         la::avdecc::entity::model::AvdeccFixedString const*);
-    delegate_.setSlot(&BlockControllerDelegate::onSystemUniqueIDChanged_,
+    delegate_.setSlot(&BlockControllerDelegate::Slots::onSystemUniqueIDChanged_,
                       Block<void, uint64_t, uint64_t,
                             la::avdecc::entity::model::AvdeccFixedString const*>((BT)cb));
   }
@@ -2641,18 +5041,18 @@ public:
     using BT = void (^)(uint64_t, uint16_t, uint8_t, bool, uint8_t, bool,
                         la::avdecc::entity::model::AvdeccFixedString const*);
     delegate_.setSlot(
-        &BlockControllerDelegate::onMediaClockReferenceInfoChanged_,
+        &BlockControllerDelegate::Slots::onMediaClockReferenceInfoChanged_,
         Block<void, uint64_t, uint16_t, uint8_t, bool, uint8_t, bool,
               la::avdecc::entity::model::AvdeccFixedString const*>((BT)cb));
   }
   void setOnBindStream(
       void (^cb)(uint64_t, uint16_t, uint64_t, uint16_t, uint16_t)) noexcept {
     delegate_.setSlot(
-        &BlockControllerDelegate::onBindStream_,
+        &BlockControllerDelegate::Slots::onBindStream_,
         Block<void, uint64_t, uint16_t, uint64_t, uint16_t, uint16_t>(cb));
   }
   void setOnUnbindStream(void (^cb)(uint64_t, uint16_t)) noexcept {
-    delegate_.setSlot(&BlockControllerDelegate::onUnbindStream_,
+    delegate_.setSlot(&BlockControllerDelegate::Slots::onUnbindStream_,
                       BlockControllerDelegate::StreamIdxBlock(cb));
   }
   void setOnStreamInputInfoExChanged(
@@ -2661,34 +5061,34 @@ public:
     using BT = void (^)(uint64_t, uint16_t,
                         la::avdecc::entity::model::StreamInputInfoEx const*);
     delegate_.setSlot(
-        &BlockControllerDelegate::onStreamInputInfoExChanged_,
+        &BlockControllerDelegate::Slots::onStreamInputInfoExChanged_,
         Block<void, uint64_t, uint16_t,
               la::avdecc::entity::model::StreamInputInfoEx const*>((BT)cb));
   }
 
   // Statistics
   void setOnAecpRetry(void (^cb)(uint64_t)) noexcept {
-    delegate_.setSlot(&BlockControllerDelegate::onAecpRetry_,
+    delegate_.setSlot(&BlockControllerDelegate::Slots::onAecpRetry_,
                       Block<void, uint64_t>(cb));
   }
   void setOnAecpTimeout(void (^cb)(uint64_t)) noexcept {
-    delegate_.setSlot(&BlockControllerDelegate::onAecpTimeout_,
+    delegate_.setSlot(&BlockControllerDelegate::Slots::onAecpTimeout_,
                       Block<void, uint64_t>(cb));
   }
   void setOnAecpUnexpectedResponse(void (^cb)(uint64_t)) noexcept {
-    delegate_.setSlot(&BlockControllerDelegate::onAecpUnexpectedResponse_,
+    delegate_.setSlot(&BlockControllerDelegate::Slots::onAecpUnexpectedResponse_,
                       Block<void, uint64_t>(cb));
   }
   void setOnAecpResponseTime(void (^cb)(uint64_t, uint64_t)) noexcept {
-    delegate_.setSlot(&BlockControllerDelegate::onAecpResponseTime_,
+    delegate_.setSlot(&BlockControllerDelegate::Slots::onAecpResponseTime_,
                       Block<void, uint64_t, uint64_t>(cb));
   }
   void setOnAemAecpUnsolicitedReceived(void (^cb)(uint64_t, uint16_t)) noexcept {
-    delegate_.setSlot(&BlockControllerDelegate::onAemAecpUnsolicitedReceived_,
+    delegate_.setSlot(&BlockControllerDelegate::Slots::onAemAecpUnsolicitedReceived_,
                       Block<void, uint64_t, uint16_t>(cb));
   }
   void setOnMvuAecpUnsolicitedReceived(void (^cb)(uint64_t, uint16_t)) noexcept {
-    delegate_.setSlot(&BlockControllerDelegate::onMvuAecpUnsolicitedReceived_,
+    delegate_.setSlot(&BlockControllerDelegate::Slots::onMvuAecpUnsolicitedReceived_,
                       Block<void, uint64_t, uint16_t>(cb));
   }
 
@@ -4489,6 +6889,24 @@ private:
     if (piOwner_) AVDECCSwift_ProtocolInterfaceOwner_release(piOwner_);
   }
 
+  static void retireBatcher(std::shared_ptr<DelegateEventBatcher> const& batcher) noexcept {
+    if (!batcher) return;
+    batcher->drain();
+    batcher->stop();
+  }
+
+  // attachLock_ held. See ProtocolInterfaceOwner::updateObserverAttachment.
+  void updateDelegateAttachment() noexcept {
+    auto const wanted = agg_ && (delegateWanted_ || delegate_.streams_.active());
+    if (wanted && !delegateAttached_) {
+      agg_->setControllerDelegate(&delegate_);
+      delegateAttached_ = true;
+    } else if (!wanted && delegateAttached_ && agg_) {
+      agg_->setControllerDelegate(nullptr);
+      delegateAttached_ = false;
+    }
+  }
+
   // Strong reference to the PI owner — its underlying ProtocolInterface
   // must outlive the LocalEntity. Manual retain/release because the C++
   // side doesn't have Swift's ARC; we use the same retain/release
@@ -4497,9 +6915,12 @@ private:
   la::avdecc::entity::AggregateEntity::UniquePointer agg_;
   // Controller-delegate adapter. Always present; only attached to the
   // AggregateEntity when the Swift side has registered at least one
-  // callback. `attachDelegate()` flips it on, `close()` and
-  // `detachDelegate()` flip it off.
+  // callback or an event stream. `attachDelegate()` flips it on, `close()`
+  // and `detachDelegate()` flip it off unless streams remain.
   BlockControllerDelegate delegate_;
+  // Guards the attachment, what decides it, and agg_'s reset.
+  std::mutex attachLock_;
+  bool delegateWanted_ = false;
   bool delegateAttached_ = false;
 };
 
@@ -4523,6 +6944,22 @@ inline void AVDECCSwift_LoggerOwner_release(AVDECCSwift::LoggerOwner* p) noexcep
   if (p) p->release();
 }
 
+inline void AVDECCSwift_CallbackShardsOwner_retain(AVDECCSwift::CallbackShardsOwner* p) noexcept {
+  if (p) p->retain();
+}
+inline void AVDECCSwift_CallbackShardsOwner_release(AVDECCSwift::CallbackShardsOwner* p) noexcept {
+  if (p) p->release();
+}
+
+inline void AVDECCSwift_CallbackEventStreamOwner_retain(
+    AVDECCSwift::CallbackEventStreamOwner* p) noexcept {
+  if (p) p->retain();
+}
+inline void AVDECCSwift_CallbackEventStreamOwner_release(
+    AVDECCSwift::CallbackEventStreamOwner* p) noexcept {
+  if (p) p->release();
+}
+
 inline void AVDECCSwift_ProtocolInterfaceOwner_retain(AVDECCSwift::ProtocolInterfaceOwner* p) noexcept {
   if (p) p->retain();
 }
@@ -4530,6 +6967,13 @@ inline void AVDECCSwift_ProtocolInterfaceOwner_release(AVDECCSwift::ProtocolInte
   if (p) p->release();
 }
 
+inline void AVDECCSwift_PduReplayOwner_retain(AVDECCSwift::PduReplayOwner* p) noexcept {
+  if (p) p->retain();
+}
+inline void AVDECCSwift_PduReplayOwner_release(AVDECCSwift::PduReplayOwner* p) noexcept {
+  if (p) p->release();
+}
+
 inline void AVDECCSwift_LocalEntityOwner_retain(AVDECCSwift::LocalEntityOwner* p) noexcept {
   if (p) p->retain();
 }
@@ -0,0 +1,298 @@
+/*
+ * Copyright (C) 2026, PADL Software Pty Ltd
+ *
+ * This file is part of AVDECCSwift.
+ *
+ * AVDECCSwift is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * AVDECCSwift is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with AVDECCSwift.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+// Lock-free job plumbing for the batched ExecutorOwner modes. Kept free of
+// libdispatch, clang blocks and la_avdecc so the primitives can be reasoned
+// about (and exercised) in isolation; ExecutorOwner wires them to a
+// dispatch queue in AVDECCSwiftHelpers.hpp.
+//
+//   * MpscJobQueue — Dmitry Vyukov's intrusive multi-producer/single-
+//     consumer queue. Producers pay one atomic exchange plus one release
+//     store; the consumer never takes a lock. Unbounded: la_avdecc's
+//     `Executor::pushJob` has no failure path, so a bounded ring would
+//     have to either block a producer (which may be the executor itself)
+//     or drop a job, and neither is acceptable here.
+//   * ProducerGate — admission control so terminate() can stop new pushes
+//     and wait for in-flight producers without a mutex on the push path.
+//   * JobNodePool — per-executor slab-backed freelist of JobNodes, so a
+//     steady-state push never reaches the global allocator.
+#pragma once
+
+#include <atomic>
+#include <cstdint>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <utility>
+
+namespace AVDECCSwift {
+
+/// One queued executor job. `next` is the intrusive MpscJobQueue link;
+/// `job` is la_avdecc's `Executor::Job` (a `std::function<void()>`),
+/// moved in so the callable itself is never copied — a std::function move
+/// steals the target (or copies its small buffer) without allocating.
+/// `enqueuedAt` is the push-time `monotonicNanos()` stamp used for
+/// wait-time statistics; `lane` the ExecutorLane it was queued on.
+///
+/// Nodes normally come from a JobNodePool and go back to it once run;
+/// `poolIndex` / `nextFree` are the pool's bookkeeping. `keepAlive` lets a
+/// node handed to `dispatch_async_f` pin its executor's state without the
+/// block allocation a capturing `dispatch_async` would cost.
+struct JobNode {
+  static constexpr uint32_t NotPooled = UINT32_MAX;
+
+  JobNode() noexcept = default;
+  explicit JobNode(std::function<void()>&& j, uint64_t at = 0,
+                   uint8_t l = 0) noexcept
+      : job(std::move(j)), enqueuedAt(at), lane(l) {}
+
+  std::atomic<JobNode*> next{nullptr};
+  std::function<void()> job;
+  uint64_t enqueuedAt = 0;
+  uint8_t lane = 0;
+  uint32_t poolIndex = NotPooled;
+  std::atomic<uint32_t> nextFree{NotPooled};
+  std::shared_ptr<void> keepAlive;
+};
+
+/// Intrusive MPSC FIFO. `push` is wait-free for producers; `pop`/`empty`
+/// must only be called by the single consumer (the executor's drain).
+///
+/// `pop` returns nullptr both when the queue is empty and in the short
+/// window where a producer has swung `head_` but not yet published its
+/// `next` link. Callers that need to tell the two apart check `empty()`:
+/// it only reports true when no producer is mid-push.
+///
+/// All head operations are seq_cst so the drain-scheduling handshake in
+/// ExecutorOwner (producer: push, then test-and-set `drainScheduled`;
+/// consumer: clear `drainScheduled`, then `empty()`) cannot lose a wakeup.
+///
+/// The queue does not own its nodes: whoever owns the node allocator must
+/// `clear()` it before either goes away.
+class MpscJobQueue final {
+public:
+  MpscJobQueue() noexcept : head_(&stub_), tail_(&stub_) {}
+  MpscJobQueue(MpscJobQueue const&) = delete;
+  MpscJobQueue& operator=(MpscJobQueue const&) = delete;
+
+  void push(JobNode* node) noexcept {
+    node->next.store(nullptr, std::memory_order_relaxed);
+    auto* const prev = head_.exchange(node, std::memory_order_seq_cst);
+    prev->next.store(node, std::memory_order_release);
+  }
+
+  JobNode* pop() noexcept {
+    auto* tail = tail_;
+    auto* next = tail->next.load(std::memory_order_acquire);
+    if (tail == &stub_) {
+      if (!next) return nullptr;
+      tail_ = next;
+      tail = next;
+      next = next->next.load(std::memory_order_acquire);
+    }
+    if (next) {
+      tail_ = next;
+      return tail;
+    }
+    if (tail != head_.load(std::memory_order_seq_cst)) return nullptr;
+    // `tail` is the last node; re-insert the stub behind it so it can be
+    // handed out without leaving the queue headless.
+    push(&stub_);
+    next = tail->next.load(std::memory_order_acquire);
+    if (next) {
+      tail_ = next;
+      return tail;
+    }
+    return nullptr;
+  }
+
+  bool empty() const noexcept {
+    return tail_ == &stub_ && head_.load(std::memory_order_seq_cst) == &stub_;
+  }
+
+  /// Consumer-side: hand every queued node to `release` without running
+  /// it. Only valid once producers are quiesced (see ProducerGate::close).
+  template <typename Release>
+  void clear(Release&& release) noexcept {
+    while (auto* node = pop()) release(node);
+  }
+
+private:
+  std::atomic<JobNode*> head_;
+  JobNode* tail_;
+  JobNode stub_;
+};
+
+/// Lock-free freelist of JobNodes for one executor. Nodes are carved from
+/// slabs of `SlabSize` that live as long as the pool, so a node index is
+/// always dereferenceable; the freelist head packs a 32-bit node index
+/// with a 32-bit generation tag, which rules out ABA on the multi-producer
+/// `acquire` side without double-width CAS.
+///
+/// `acquire` is called by producers, `release` by whoever ran the node;
+/// both are lock-free. Only growing takes a mutex — once the pool has
+/// reached the executor's peak depth, submission stops allocating. Past
+/// `MaxSlabs` the pool degrades to plain new/delete (counted).
+class JobNodePool final {
+public:
+  static constexpr uint32_t SlabSize = 256;
+  static constexpr uint32_t MaxSlabs = 1024;
+
+  JobNodePool() noexcept = default;
+  JobNodePool(JobNodePool const&) = delete;
+  JobNodePool& operator=(JobNodePool const&) = delete;
+
+  /// All nodes must have been released (queues cleared) by now.
+  ~JobNodePool() noexcept {
+    auto const count = slabCount_.load(std::memory_order_acquire);
+    for (uint32_t i = 0; i < count; ++i) {
+      delete[] slabs_[i].load(std::memory_order_relaxed);
+    }
+  }
+
+  /// A node with an empty `job`, ready to fill in.
+  JobNode* acquire() noexcept {
+    acquisitions_.fetch_add(1, std::memory_order_relaxed);
+    auto head = freeHead_.load(std::memory_order_acquire);
+    for (;;) {
+      auto const index = static_cast<uint32_t>(head);
+      if (index == JobNode::NotPooled) return grow();
+      auto* const node = nodeAt(index);
+      // May read a stale link if another thread pops `node` first; the
+      // tag bump in its CAS makes ours fail in that case.
+      uint64_t const next = node->nextFree.load(std::memory_order_relaxed);
+      uint64_t const replacement = nextTag(head) | next;
+      if (freeHead_.compare_exchange_weak(head, replacement,
+                                          std::memory_order_acq_rel,
+                                          std::memory_order_acquire)) {
+        return node;
+      }
+    }
+  }
+
+  /// Return a run (or discarded) node. Destroys the job's captures and
+  /// drops `keepAlive` first, so nothing outlives the job.
+  void release(JobNode* node) noexcept {
+    node->job = nullptr;
+    node->keepAlive.reset();
+    if (node->poolIndex == JobNode::NotPooled) {
+      delete node;
+      return;
+    }
+    auto head = freeHead_.load(std::memory_order_relaxed);
+    for (;;) {
+      node->nextFree.store(static_cast<uint32_t>(head), std::memory_order_relaxed);
+      if (freeHead_.compare_exchange_weak(head, nextTag(head) | node->poolIndex,
+                                          std::memory_order_release,
+                                          std::memory_order_relaxed)) {
+        return;
+      }
+    }
+  }
+
+  /// Total `acquire` calls.
+  uint64_t acquisitions() const noexcept {
+    return acquisitions_.load(std::memory_order_relaxed);
+  }
+  /// `acquire` calls that reached the global allocator (slab growth or
+  /// overflow). Flat in steady state.
+  uint64_t heapAllocations() const noexcept {
+    return heapAllocations_.load(std::memory_order_relaxed);
+  }
+  /// Pooled nodes carved so far.
+  uint64_t capacity() const noexcept {
+    return uint64_t{slabCount_.load(std::memory_order_relaxed)} * SlabSize;
+  }
+
+private:
+  static constexpr uint64_t EmptyHead = JobNode::NotPooled;
+
+  static uint64_t nextTag(uint64_t head) noexcept {
+    return ((head >> 32) + 1) << 32;
+  }
+
+  JobNode* nodeAt(uint32_t index) const noexcept {
+    return slabs_[index / SlabSize].load(std::memory_order_acquire) + index % SlabSize;
+  }
+
+  JobNode* grow() noexcept {
+    std::lock_guard<std::mutex> lg(growLock_);
+    heapAllocations_.fetch_add(1, std::memory_order_relaxed);
+    // Another producer may have grown the pool while we waited; its
+    // nodes are on the freelist and we could retry, but one extra slab
+    // under a burst is cheaper than a second round of contention.
+    auto const slab = slabCount_.load(std::memory_order_relaxed);
+    if (slab == MaxSlabs) return new JobNode();
+    auto* const nodes = new JobNode[SlabSize];
+    for (uint32_t i = 0; i < SlabSize; ++i) nodes[i].poolIndex = slab * SlabSize + i;
+    slabs_[slab].store(nodes, std::memory_order_release);
+    slabCount_.store(slab + 1, std::memory_order_release);
+    // Keep node 0 for the caller; publish the rest.
+    for (uint32_t i = 1; i < SlabSize; ++i) release(&nodes[i]);
+    return &nodes[0];
+  }
+
+  std::atomic<uint64_t> freeHead_{EmptyHead};
+  std::atomic<uint64_t> acquisitions_{0};
+  std::atomic<uint64_t> heapAllocations_{0};
+  std::mutex growLock_;
+  std::atomic<uint32_t> slabCount_{0};
+  std::atomic<JobNode*> slabs_[MaxSlabs] = {};
+};
+
+/// Lock-free admission gate for queue producers. `enter()` registers an
+/// in-flight push and fails once `close()` has been called; `close()`
+/// flips the gate and then waits for every producer already past
+/// `enter()` to `leave()`. Together they give terminate() the guarantee
+/// the old enqueueLock provided — nothing lands on the queue after the
+/// final drain — without serialising producers against each other.
+///
+/// The wait in `close()` spins with yield: producers hold the gate only
+/// for the few instructions of a push, never across job execution.
+class ProducerGate final {
+public:
+  bool enter() noexcept {
+    producers_.fetch_add(1, std::memory_order_seq_cst);
+    if (closed_.load(std::memory_order_seq_cst)) {
+      leave();
+      return false;
+    }
+    return true;
+  }
+
+  void leave() noexcept { producers_.fetch_sub(1, std::memory_order_release); }
+
+  void close() noexcept {
+    closed_.store(true, std::memory_order_seq_cst);
+    while (producers_.load(std::memory_order_seq_cst) != 0) {
+      std::this_thread::yield();
+    }
+  }
+
+  bool isClosed() const noexcept {
+    return closed_.load(std::memory_order_acquire);
+  }
+
+private:
+  std::atomic<bool> closed_{false};
+  std::atomic<uint32_t> producers_{0};
+};
+
+} // namespace AVDECCSwift
@@ -0,0 +1,218 @@
+/*
+ * Copyright (C) 2026, PADL Software Pty Ltd
+ *
+ * This file is part of AVDECCSwift.
+ *
+ * AVDECCSwift is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * AVDECCSwift is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with AVDECCSwift.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+// Preallocated log capture ring for LoggerOwner's ring mode. la_avdecc
+// emits log items from whichever thread hit the log site — the executor
+// included — so the emitting side must cost no more than formatting the
+// message: no lock, no allocation, no Swift. Producers claim a slot with
+// one CAS (Vyukov's bounded queue, used MPSC), copy the bytes in and
+// publish the slot's sequence number; a full ring counts the item as
+// dropped instead of waiting. A single drainer thread copies records out
+// in batches and parks on a condvar when the ring is empty.
+#pragma once
+
+#include <algorithm>
+#include <atomic>
+#include <condition_variable>
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <memory>
+#include <mutex>
+
+namespace AVDECCSwift {
+
+/// Message bytes kept per record; longer messages are cut here and
+/// flagged `truncated`. Sized so a record is 256 bytes.
+constexpr size_t LogRecordTextCapacity = 240;
+
+/// One captured log item, as handed to Swift in batches. Plain data so
+/// a batch is a flat array.
+struct LogRecord {
+  /// `steadyNanos()` when the item was captured.
+  uint64_t timestampNanos = 0;
+  uint32_t size = 0;
+  uint8_t level = 0;
+  uint8_t layer = 0;
+  bool truncated = false;
+  char text[LogRecordTextCapacity];
+};
+
+/// `record->text` as a pointer; fixed-size C arrays import into Swift as
+/// tuples, which are awkward to turn into a String.
+inline char const* logRecordText(LogRecord const* record) noexcept {
+  return record->text;
+}
+
+class LogRing final {
+public:
+  /// `capacity` is rounded up to a power of two (at least 2).
+  explicit LogRing(uint32_t capacity) {
+    size_t size = 2;
+    while (size < capacity) size <<= 1;
+    mask_ = size - 1;
+    slots_.reset(new Slot[size]);
+    for (size_t i = 0; i < size; ++i) {
+      slots_[i].sequence.store(i, std::memory_order_relaxed);
+    }
+  }
+
+  LogRing(LogRing const&) = delete;
+  LogRing& operator=(LogRing const&) = delete;
+
+  size_t capacity() const noexcept { return mask_ + 1; }
+
+  /// Any thread. Never blocks; returns false (and counts a drop) if the
+  /// ring is full.
+  bool tryPush(uint8_t level, uint8_t layer, uint64_t timestampNanos,
+               char const* data, size_t size) noexcept {
+    auto position = head_.load(std::memory_order_relaxed);
+    Slot* slot;
+    for (;;) {
+      slot = &slots_[position & mask_];
+      auto const sequence = slot->sequence.load(std::memory_order_acquire);
+      auto const lag = static_cast<int64_t>(sequence - position);
+      if (lag == 0) {
+        if (head_.compare_exchange_weak(position, position + 1,
+                                        std::memory_order_relaxed)) {
+          break;
+        }
+      } else if (lag < 0) {
+        dropped_.fetch_add(1, std::memory_order_relaxed);
+        return false;
+      } else {
+        position = head_.load(std::memory_order_relaxed);
+      }
+    }
+
+    auto& record = slot->record;
+    auto const kept = std::min(size, LogRecordTextCapacity);
+    record.timestampNanos = timestampNanos;
+    record.size = static_cast<uint32_t>(kept);
+    record.level = level;
+    record.layer = layer;
+    record.truncated = kept < size;
+    if (kept) std::memcpy(record.text, data, kept);
+    slot->sequence.store(position + 1, std::memory_order_release);
+    captured_.fetch_add(1, std::memory_order_relaxed);
+    wakeDrainer();
+    return true;
+  }
+
+  /// Drainer only. Copies up to `max` published records into `out`, in
+  /// ring order, and returns how many.
+  size_t drain(LogRecord* out, size_t max) noexcept {
+    size_t count = 0;
+    while (count < max) {
+      auto& slot = slots_[tail_ & mask_];
+      if (slot.sequence.load(std::memory_order_acquire) != tail_ + 1) break;
+      auto const& record = slot.record;
+      auto& copy = out[count++];
+      copy.timestampNanos = record.timestampNanos;
+      copy.size = record.size;
+      copy.level = record.level;
+      copy.layer = record.layer;
+      copy.truncated = record.truncated;
+      std::memcpy(copy.text, record.text, record.size);
+      slot.sequence.store(tail_ + mask_ + 1, std::memory_order_release);
+      ++tail_;
+    }
+    return count;
+  }
+
+  /// Drainer only. Parks until a record is published or `stop()` is
+  /// called; returns false once stopped with the ring empty.
+  bool waitForRecords() noexcept {
+    std::unique_lock<std::mutex> lk(wakeLock_);
+    drainerSleeping_.store(true, std::memory_order_seq_cst);
+    // Orders the store above before the (acquire) slot check; pairs with
+    // the fence in wakeDrainer().
+    std::atomic_thread_fence(std::memory_order_seq_cst);
+    if (hasRecords()) {
+      drainerSleeping_.store(false, std::memory_order_relaxed);
+      return true;
+    }
+    if (stopRequested_.load(std::memory_order_seq_cst)) return false;
+    wakeCondition_.wait(lk, [this] {
+      return !drainerSleeping_.load(std::memory_order_seq_cst) ||
+             stopRequested_.load(std::memory_order_seq_cst);
+    });
+    drainerSleeping_.store(false, std::memory_order_relaxed);
+    return true;
+  }
+
+  void stop() noexcept {
+    {
+      std::lock_guard<std::mutex> lg(wakeLock_);
+      stopRequested_.store(true, std::memory_order_seq_cst);
+    }
+    wakeCondition_.notify_one();
+  }
+
+  /// Stop, and tell a drainer currently inside its batch callback to
+  /// return without touching its owner again (the owner is closing from
+  /// that callback and may be gone by the time it returns).
+  void abandon() noexcept {
+    abandoned_.store(true, std::memory_order_release);
+    stop();
+  }
+  bool abandoned() const noexcept { return abandoned_.load(std::memory_order_acquire); }
+
+  uint64_t captured() const noexcept { return captured_.load(std::memory_order_relaxed); }
+  uint64_t dropped() const noexcept { return dropped_.load(std::memory_order_relaxed); }
+
+private:
+  struct Slot {
+    std::atomic<uint64_t> sequence{0};
+    LogRecord record;
+  };
+
+  bool hasRecords() const noexcept {
+    return slots_[tail_ & mask_].sequence.load(std::memory_order_acquire) == tail_ + 1;
+  }
+
+  void wakeDrainer() noexcept {
+    // Same handshake as the executor thread, and the lock is only taken
+    // when the drainer has really parked. The slot was published with a
+    // release store, which a later load may be reordered ahead of; the
+    // fence pins it so either the drainer sees the slot or we see it
+    // sleeping.
+    std::atomic_thread_fence(std::memory_order_seq_cst);
+    if (drainerSleeping_.load(std::memory_order_seq_cst) &&
+        drainerSleeping_.exchange(false, std::memory_order_seq_cst)) {
+      std::lock_guard<std::mutex> lg(wakeLock_);
+      wakeCondition_.notify_one();
+    }
+  }
+
+  std::unique_ptr<Slot[]> slots_;
+  size_t mask_ = 0;
+  alignas(64) std::atomic<uint64_t> head_{0};
+  alignas(64) uint64_t tail_ = 0;
+  std::atomic<uint64_t> captured_{0};
+  std::atomic<uint64_t> dropped_{0};
+
+  std::mutex wakeLock_;
+  std::condition_variable wakeCondition_;
+  std::atomic<bool> drainerSleeping_{false};
+  std::atomic<bool> stopRequested_{false};
+  std::atomic<bool> abandoned_{false};
+};
+
+} // namespace AVDECCSwift
@@ -0,0 +1,294 @@
+/*
+ * Copyright (C) 2026, PADL Software Pty Ltd
+ *
+ * This file is part of AVDECCSwift.
+ *
+ * AVDECCSwift is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * AVDECCSwift is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with AVDECCSwift.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+// Burst suppression for LoggerOwner. A misbehaving peer can make
+// la_avdecc log the same compat / warn line hundreds of times a second;
+// LogThrottle sits between the observer and Swift and cuts that down in
+// two stages:
+//
+//   * duplicates: (level, layer, message) is hashed into a small table.
+//     The first occurrence in a window is emitted, repeats inside the
+//     window are only counted, and a "repeated N times" summary is
+//     emitted once the window has passed;
+//   * rate: what is left goes through a token bucket per layer. Items
+//     without a token are counted, and the next item admitted on that
+//     layer is preceded by a summary of how many were dropped.
+//
+// Emitting threads never wait here. Table slots and buckets are guarded
+// by a try-lock; an item that finds one contended is simply let through.
+// Expired summaries are found by a sweep that visits one table slot per
+// admitted item, so a burst's summary may lag until more items arrive;
+// `sweep(..., all)` flushes them on demand (LoggerOwner does so on
+// close).
+//
+// `now` is read before the slot or bucket is taken, so another thread
+// may already have stored a later time there; such a `now` counts as
+// no time elapsed rather than wrapping to an expired window.
+#pragma once
+
+#include <algorithm>
+#include <array>
+#include <atomic>
+#include <cinttypes>
+#include <cstddef>
+#include <cstdint>
+#include <cstdio>
+#include <cstring>
+
+#include "AVDECCSwiftLogRing.hpp"
+
+namespace AVDECCSwift {
+
+/// A summary line produced by LogThrottle, emitted like any log item.
+struct LogSummary {
+  uint8_t level = 0;
+  uint8_t layer = 0;
+  uint32_t size = 0;
+  char text[LogRecordTextCapacity];
+};
+
+class LogThrottle final {
+public:
+  /// Duplicate-table slots; a power of two.
+  static constexpr size_t DedupSlotCount = 256;
+  /// Summaries one `admit` call can produce: an evicted or expired
+  /// duplicate, the swept slot, and a rate-limit summary.
+  static constexpr size_t MaxSummariesPerItem = 3;
+  static constexpr uint32_t MaxRatePerSecond = 1'000'000;
+
+  /// `layerCount` buckets are kept, plus one shared by higher layers.
+  explicit LogThrottle(size_t layerCount) noexcept
+      : layerCount_(std::min(layerCount, MaxLayers - 1)) {}
+
+  LogThrottle(LogThrottle const&) = delete;
+  LogThrottle& operator=(LogThrottle const&) = delete;
+
+  /// `windowNanos` 0 disables duplicate suppression; `ratePerSecond` 0
+  /// disables rate limiting (clamped to MaxRatePerSecond). `burst` is the
+  /// bucket depth (at least 1).
+  void configure(uint64_t windowNanos, uint32_t ratePerSecond, uint32_t burst) noexcept {
+    windowNanos_.store(windowNanos, std::memory_order_relaxed);
+    burst_.store(std::max(burst, 1u), std::memory_order_relaxed);
+    ratePerSecond_.store(std::min(ratePerSecond, MaxRatePerSecond), std::memory_order_relaxed);
+  }
+
+  bool enabled() const noexcept {
+    return windowNanos_.load(std::memory_order_relaxed) != 0 ||
+           ratePerSecond_.load(std::memory_order_relaxed) != 0;
+  }
+
+  /// Any thread. Returns whether the item should be emitted; summaries
+  /// to emit first are written to `out` (room for MaxSummariesPerItem)
+  /// and counted in `summaries`.
+  bool admit(uint8_t level, uint8_t layer, char const* data, size_t size,
+             uint64_t now, LogSummary* out, size_t& summaries) noexcept {
+    summaries = 0;
+    auto const window = windowNanos_.load(std::memory_order_relaxed);
+    if (window) {
+      auto const key = hash(level, layer, data, size);
+      auto& slot = dedup_[key & (DedupSlotCount - 1)];
+      if (!slot.busy.test_and_set(std::memory_order_acquire)) {
+        bool repeat = false;
+        if (slot.key == key && elapsedSince(slot.windowStart, now) < window) {
+          ++slot.repeats;
+          repeat = true;
+        } else {
+          if (slot.key && slot.repeats) summarise(slot, now, out[summaries++]);
+          slot.key = key;
+          slot.windowStart = now;
+          slot.repeats = 0;
+          slot.level = level;
+          slot.layer = layer;
+          slot.size = static_cast<uint32_t>(std::min(size, SummaryTextCapacity));
+          if (slot.size) std::memcpy(slot.text, data, slot.size);
+        }
+        slot.busy.clear(std::memory_order_release);
+        if (repeat) {
+          duplicates_.fetch_add(1, std::memory_order_relaxed);
+          return false;
+        }
+      }
+      auto const next = sweepCursor_.fetch_add(1, std::memory_order_relaxed);
+      if (sweepSlot(dedup_[next & (DedupSlotCount - 1)], now, window, out[summaries])) {
+        ++summaries;
+      }
+    }
+
+    auto const rate = ratePerSecond_.load(std::memory_order_relaxed);
+    if (rate) {
+      auto& bucket = buckets_[std::min(size_t{layer}, layerCount_)];
+      if (!bucket.busy.test_and_set(std::memory_order_acquire)) {
+        auto const capacity = uint64_t{burst_.load(std::memory_order_relaxed)} * TokenScale;
+        if (!bucket.primed) {
+          bucket.tokens = capacity;
+          bucket.primed = true;
+        } else {
+          // Capped so the multiply cannot overflow at MaxRatePerSecond.
+          auto const elapsed =
+              std::min<uint64_t>(elapsedSince(bucket.lastRefill, now), 10'000'000'000u);
+          uint64_t const refill = elapsed * rate / (1'000'000'000u / TokenScale);
+          bucket.tokens = std::min(capacity, bucket.tokens + refill);
+        }
+        bucket.lastRefill = std::max(bucket.lastRefill, now);
+        bool const admitted = bucket.tokens >= TokenScale;
+        uint64_t dropped = 0;
+        if (admitted) {
+          bucket.tokens -= TokenScale;
+          dropped = bucket.dropped;
+          bucket.dropped = 0;
+        } else {
+          ++bucket.dropped;
+        }
+        bucket.busy.clear(std::memory_order_release);
+        if (!admitted) {
+          rateLimited_.fetch_add(1, std::memory_order_relaxed);
+          return false;
+        }
+        if (dropped) {
+          auto& summary = out[summaries++];
+          summary.level = level;
+          summary.layer = layer;
+          auto const n = std::snprintf(summary.text, sizeof(summary.text),
+                                       "rate limit: %" PRIu64 " messages suppressed",
+                                       dropped);
+          finish(summary, n, nullptr, 0);
+        }
+      }
+    }
+    return true;
+  }
+
+  /// Emit pending duplicate summaries: those whose window has expired,
+  /// or with `all` every one. Writes at most `max` and returns how many;
+  /// call again until it returns less than `max`.
+  size_t sweep(uint64_t now, bool all, LogSummary* out, size_t max) noexcept {
+    auto const window = all ? 0 : windowNanos_.load(std::memory_order_relaxed);
+    size_t count = 0;
+    for (auto& slot : dedup_) {
+      if (count == max) break;
+      if (sweepSlot(slot, now, window, out[count])) ++count;
+    }
+    return count;
+  }
+
+  /// Items not emitted because they repeated inside a window, or found
+  /// their layer's bucket empty.
+  uint64_t duplicates() const noexcept { return duplicates_.load(std::memory_order_relaxed); }
+  uint64_t rateLimited() const noexcept { return rateLimited_.load(std::memory_order_relaxed); }
+  uint64_t summariesEmitted() const noexcept {
+    return summaries_.load(std::memory_order_relaxed);
+  }
+
+private:
+  static constexpr size_t MaxLayers = 16;
+  /// Message bytes kept for the summary, leaving room for its prefix.
+  static constexpr size_t SummaryTextCapacity = LogRecordTextCapacity - 48;
+  /// Tokens are counted in thousandths so low rates still refill.
+  static constexpr uint64_t TokenScale = 1000;
+
+  struct DedupSlot {
+    std::atomic_flag busy = ATOMIC_FLAG_INIT;
+    uint64_t key = 0;
+    uint64_t windowStart = 0;
+    uint32_t repeats = 0;
+    uint8_t level = 0;
+    uint8_t layer = 0;
+    uint32_t size = 0;
+    char text[SummaryTextCapacity];
+  };
+
+  struct Bucket {
+    std::atomic_flag busy = ATOMIC_FLAG_INIT;
+    bool primed = false;
+    uint64_t tokens = 0;
+    uint64_t lastRefill = 0;
+    uint64_t dropped = 0;
+  };
+
+  static uint64_t elapsedSince(uint64_t then, uint64_t now) noexcept {
+    return now > then ? now - then : 0;
+  }
+
+  /// FNV-1a over level, layer and the message bytes; never 0, which
+  /// marks an empty slot.
+  static uint64_t hash(uint8_t level, uint8_t layer, char const* data, size_t size) noexcept {
+    uint64_t h = 0xcbf29ce484222325ull;
+    auto mix = [&h](uint8_t byte) {
+      h ^= byte;
+      h *= 0x100000001b3ull;
+    };
+    mix(level);
+    mix(layer);
+    for (size_t i = 0; i < size; ++i) mix(static_cast<uint8_t>(data[i]));
+    return h ? h : 1;
+  }
+
+  /// `window` 0 takes any slot with repeats. Clears expired slots either
+  /// way so the next occurrence is emitted fresh.
+  bool sweepSlot(DedupSlot& slot, uint64_t now, uint64_t window, LogSummary& out) noexcept {
+    if (slot.busy.test_and_set(std::memory_order_acquire)) return false;
+    bool produced = false;
+    if (slot.key && (window == 0 || elapsedSince(slot.windowStart, now) >= window)) {
+      if (slot.repeats) {
+        summarise(slot, now, out);
+        produced = true;
+      }
+      slot.key = 0;
+      slot.repeats = 0;
+    }
+    slot.busy.clear(std::memory_order_release);
+    return produced;
+  }
+
+  // Slot's busy flag held.
+  void summarise(DedupSlot const& slot, uint64_t now, LogSummary& out) noexcept {
+    out.level = slot.level;
+    out.layer = slot.layer;
+    auto const n = std::snprintf(out.text, sizeof(out.text),
+                                 "repeated %" PRIu32 " times in %" PRIu64 " ms: ",
+                                 slot.repeats, elapsedSince(slot.windowStart, now) / 1'000'000);
+    finish(out, n, slot.text, slot.size);
+  }
+
+  /// Append `text` after the `prefixLength` bytes snprintf wrote.
+  void finish(LogSummary& out, int prefixLength, char const* text, size_t size) noexcept {
+    auto const used = prefixLength < 0
+                          ? size_t{0}
+                          : std::min(size_t(prefixLength), sizeof(out.text) - 1);
+    auto const kept = std::min(size, sizeof(out.text) - used);
+    if (kept) std::memcpy(out.text + used, text, kept);
+    out.size = static_cast<uint32_t>(used + kept);
+    summaries_.fetch_add(1, std::memory_order_relaxed);
+  }
+
+  size_t const layerCount_;
+  std::atomic<uint64_t> windowNanos_{0};
+  std::atomic<uint32_t> ratePerSecond_{0};
+  std::atomic<uint32_t> burst_{1};
+
+  std::array<DedupSlot, DedupSlotCount> dedup_{};
+  std::array<Bucket, MaxLayers> buckets_{};
+  std::atomic<uint64_t> sweepCursor_{0};
+
+  std::atomic<uint64_t> duplicates_{0};
+  std::atomic<uint64_t> rateLimited_{0};
+  std::atomic<uint64_t> summaries_{0};
+};
+
+} // namespace AVDECCSwift
@@ -0,0 +1,561 @@
+/*
+ * Copyright (C) 2026, PADL Software Pty Ltd
+ *
+ * This file is part of AVDECCSwift.
+ *
+ * AVDECCSwift is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * AVDECCSwift is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with AVDECCSwift.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+// pcapng capture of the ADP / AECP / ACMP PDUs a ProtocolInterfaceOwner
+// sends and receives, readable by Wireshark and tcpdump alongside their
+// own captures.
+//
+// The capturing thread (la_avdecc's executor for received PDUs, the
+// caller for sent ones) serializes the PDU to its Ethernet frame, stamps
+// it with CLOCK_REALTIME in nanoseconds — the clock the kernel stamps
+// packets with, so timestamps line up with a tcpdump of the same wire —
+// and pushes it into a preallocated ring with one CAS (the same bounded
+// MPSC queue as LogRing). A full ring counts the frame as dropped; the
+// capturing thread never waits and never touches the file. One writer
+// thread drains the ring, formats Enhanced Packet Blocks into a staging
+// buffer and writes it out when the ring runs dry or the buffer fills.
+//
+// Files rotate by size: `path` first, then `path` with ".1", ".2", …
+// inserted before the extension. Each file is a complete pcapng section
+// (Section Header Block plus one Ethernet Interface Description Block
+// with nanosecond resolution). Direction is recorded in epb_flags.
+#pragma once
+
+#include <algorithm>
+#include <atomic>
+#include <cerrno>
+#include <chrono>
+#include <condition_variable>
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <system_error>
+#include <thread>
+#include <vector>
+
+#include <fcntl.h>
+#include <unistd.h>
+
+#include <la/avdecc/internals/protocolAcmpdu.hpp>
+#include <la/avdecc/internals/protocolAdpdu.hpp>
+#include <la/avdecc/internals/protocolAecpdu.hpp>
+
+namespace AVDECCSwift {
+
+/// Frame bytes kept per record: an untagged Ethernet frame without FCS.
+/// la_avdecc's largest PDU fits, so nothing is cut in practice.
+constexpr size_t PduCaptureFrameCapacity = 1514;
+
+/// epb_flags inbound / outbound values (pcapng §4.3.1).
+enum class PduCaptureDirection : uint8_t {
+  Inbound = 1,
+  Outbound = 2,
+};
+
+struct PduCaptureRecord {
+  /// CLOCK_REALTIME, nanoseconds since the epoch.
+  uint64_t timestampNanos = 0;
+  uint16_t size = 0;
+  PduCaptureDirection direction = PduCaptureDirection::Inbound;
+  uint8_t frame[PduCaptureFrameCapacity];
+};
+
+/// Snapshot of a capture's counters; every field is zero without one.
+struct PduCaptureStatistics {
+  bool running = false;
+  /// Frames accepted into the ring.
+  uint64_t captured = 0;
+  /// Frames lost because the ring was full.
+  uint64_t dropped = 0;
+  /// Frames written to a file.
+  uint64_t written = 0;
+  /// Bytes written across all files, block headers included.
+  uint64_t bytesWritten = 0;
+  /// Files opened so far, the current one included.
+  uint32_t files = 0;
+  /// errno of the write or open that stopped the writer; 0 while healthy.
+  int32_t writeError = 0;
+};
+
+/// The Ethernet frame la_avdecc's pcap transport puts on the wire for
+/// `pdu`: Ethernet header, AVTP control header, then the PDU's own
+/// fields. Returns the size copied into `out`, or 0 if la_avdecc could
+/// not serialize it.
+template <typename Pdu>
+size_t serializePduFrame(Pdu const& pdu, uint8_t* out, size_t capacity) noexcept {
+  try {
+    la::avdecc::protocol::SerializationBuffer buffer;
+    pdu.la::avdecc::protocol::EtherLayer2::serialize(buffer);
+    pdu.la::avdecc::protocol::AvtpduControl::serialize(buffer);
+    pdu.serialize(buffer);
+    auto const size = std::min(buffer.size(), capacity);
+    std::memcpy(out, buffer.data(), size);
+    return size;
+  } catch (...) {
+    return 0;
+  }
+}
+
+class PduCaptureRing final {
+public:
+  /// `capacity` is rounded up to a power of two (at least 2).
+  explicit PduCaptureRing(uint32_t capacity) {
+    size_t size = 2;
+    while (size < capacity) size <<= 1;
+    mask_ = size - 1;
+    slots_.reset(new Slot[size]);
+    for (size_t i = 0; i < size; ++i) {
+      slots_[i].sequence.store(i, std::memory_order_relaxed);
+    }
+  }
+
+  PduCaptureRing(PduCaptureRing const&) = delete;
+  PduCaptureRing& operator=(PduCaptureRing const&) = delete;
+
+  size_t capacity() const noexcept { return mask_ + 1; }
+
+  /// Any thread. Never blocks; returns false (and counts a drop) if the
+  /// ring is full.
+  bool tryPush(PduCaptureDirection direction, uint64_t timestampNanos, uint8_t const* frame,
+               size_t size) noexcept {
+    auto position = head_.load(std::memory_order_relaxed);
+    Slot* slot;
+    for (;;) {
+      slot = &slots_[position & mask_];
+      auto const sequence = slot->sequence.load(std::memory_order_acquire);
+      auto const lag = static_cast<int64_t>(sequence - position);
+      if (lag == 0) {
+        if (head_.compare_exchange_weak(position, position + 1,
+                                        std::memory_order_relaxed)) {
+          break;
+        }
+      } else if (lag < 0) {
+        dropped_.fetch_add(1, std::memory_order_relaxed);
+        return false;
+      } else {
+        position = head_.load(std::memory_order_relaxed);
+      }
+    }
+
+    auto& record = slot->record;
+    auto const kept = std::min(size, PduCaptureFrameCapacity);
+    record.timestampNanos = timestampNanos;
+    record.size = static_cast<uint16_t>(kept);
+    record.direction = direction;
+    if (kept) std::memcpy(record.frame, frame, kept);
+    slot->sequence.store(position + 1, std::memory_order_release);
+    captured_.fetch_add(1, std::memory_order_relaxed);
+    wakeWriter();
+    return true;
+  }
+
+  /// Writer only. Hands each published record to `consume`, in ring
+  /// order, up to `max`; returns how many.
+  template <typename Consume>
+  size_t drain(size_t max, Consume&& consume) noexcept {
+    size_t count = 0;
+    while (count < max) {
+      auto& slot = slots_[tail_ & mask_];
+      if (slot.sequence.load(std::memory_order_acquire) != tail_ + 1) break;
+      consume(slot.record);
+      slot.sequence.store(tail_ + mask_ + 1, std::memory_order_release);
+      ++tail_;
+      ++count;
+    }
+    return count;
+  }
+
+  /// Writer only. Parks until a record is published or `stop()` is
+  /// called; returns false once stopped with the ring empty.
+  bool waitForRecords() noexcept {
+    std::unique_lock<std::mutex> lk(wakeLock_);
+    writerSleeping_.store(true, std::memory_order_seq_cst);
+    // Orders the store above before the (acquire) slot check; pairs with
+    // the fence in wakeWriter().
+    std::atomic_thread_fence(std::memory_order_seq_cst);
+    if (hasRecords()) {
+      writerSleeping_.store(false, std::memory_order_relaxed);
+      return true;
+    }
+    if (stopRequested_.load(std::memory_order_seq_cst)) return false;
+    wakeCondition_.wait(lk, [this] {
+      return !writerSleeping_.load(std::memory_order_seq_cst) ||
+             stopRequested_.load(std::memory_order_seq_cst);
+    });
+    writerSleeping_.store(false, std::memory_order_relaxed);
+    return true;
+  }
+
+  void stop() noexcept {
+    {
+      std::lock_guard<std::mutex> lg(wakeLock_);
+      stopRequested_.store(true, std::memory_order_seq_cst);
+    }
+    wakeCondition_.notify_one();
+  }
+
+  uint64_t captured() const noexcept { return captured_.load(std::memory_order_relaxed); }
+  uint64_t dropped() const noexcept { return dropped_.load(std::memory_order_relaxed); }
+
+private:
+  struct Slot {
+    std::atomic<uint64_t> sequence{0};
+    PduCaptureRecord record;
+  };
+
+  bool hasRecords() const noexcept {
+    return slots_[tail_ & mask_].sequence.load(std::memory_order_acquire) == tail_ + 1;
+  }
+
+  // LogRing's handshake: the lock is only taken when the writer has
+  // really parked, and the fence keeps the slot's release store ahead of
+  // the sleeping check.
+  void wakeWriter() noexcept {
+    std::atomic_thread_fence(std::memory_order_seq_cst);
+    if (writerSleeping_.load(std::memory_order_seq_cst) &&
+        writerSleeping_.exchange(false, std::memory_order_seq_cst)) {
+      std::lock_guard<std::mutex> lg(wakeLock_);
+      wakeCondition_.notify_one();
+    }
+  }
+
+  std::unique_ptr<Slot[]> slots_;
+  size_t mask_ = 0;
+  alignas(64) std::atomic<uint64_t> head_{0};
+  alignas(64) uint64_t tail_ = 0;
+  std::atomic<uint64_t> captured_{0};
+  std::atomic<uint64_t> dropped_{0};
+
+  std::mutex wakeLock_;
+  std::condition_variable wakeCondition_;
+  std::atomic<bool> writerSleeping_{false};
+  std::atomic<bool> stopRequested_{false};
+};
+
+/// pcapng files for one capture, rotated by size. Writer thread only,
+/// apart from construction.
+class PcapngFileWriter final {
+public:
+  static constexpr uint32_t SectionHeaderBlock = 0x0A0D0D0A;
+  static constexpr uint32_t InterfaceDescriptionBlock = 1;
+  static constexpr uint32_t EnhancedPacketBlock = 6;
+  static constexpr uint32_t ByteOrderMagic = 0x1A2B3C4D;
+  static constexpr uint16_t LinkTypeEthernet = 1;
+
+  /// Opens the first file, so a bad path is reported to the caller.
+  /// `maxFileSize` 0 never rotates; `maxFiles` 0 keeps every file.
+  /// Throws std::system_error.
+  PcapngFileWriter(std::string path, std::string interfaceName, uint64_t maxFileSize,
+                   uint32_t maxFiles)
+      : path_(std::move(path)),
+        interfaceName_(std::move(interfaceName)),
+        maxFileSize_(maxFileSize),
+        maxFiles_(maxFiles) {
+    staging_.reserve(StagingCapacity + blockSize(PduCaptureFrameCapacity));
+    open();
+  }
+
+  ~PcapngFileWriter() noexcept { close(); }
+
+  PcapngFileWriter(PcapngFileWriter const&) = delete;
+  PcapngFileWriter& operator=(PcapngFileWriter const&) = delete;
+
+  /// The file holding file index `index`: "a/b.pcapng" → "a/b.2.pcapng".
+  static std::string rotatedPath(std::string const& path, uint32_t index) {
+    if (index == 0) return path;
+    auto const slash = path.find_last_of('/');
+    auto dot = path.find_last_of('.');
+    if (dot == std::string::npos || (slash != std::string::npos && dot < slash) ||
+        dot == (slash == std::string::npos ? 0 : slash + 1)) {
+      dot = path.size();
+    }
+    return path.substr(0, dot) + "." + std::to_string(index) + path.substr(dot);
+  }
+
+  /// Bytes one Enhanced Packet Block takes for a `frameSize`-byte frame.
+  static size_t blockSize(size_t frameSize) noexcept {
+    return 28 + padded(frameSize) + 8 /* epb_flags */ + 4 /* opt_endofopt */ + 4;
+  }
+
+  /// Appends one record, rotating first if it would take the file past
+  /// `maxFileSize`. Returns false once a write or open has failed.
+  bool append(PduCaptureRecord const& record) noexcept {
+    if (error_) return false;
+    auto const size = blockSize(record.size);
+    auto const fileSize = fileBytes_ + staging_.size();
+    if (maxFileSize_ && fileSize > headerBytes_ && fileSize + size > maxFileSize_) {
+      if (!flush()) return false;
+      close();
+      ++index_;
+      try {
+        open();
+      } catch (std::system_error const& e) {
+        error_ = e.code().value();
+        return false;
+      }
+      if (maxFiles_ && index_ >= maxFiles_) {
+        ::unlink(rotatedPath(path_, index_ - maxFiles_).c_str());
+      }
+    }
+
+    auto const at = staging_.size();
+    staging_.resize(at + size);
+    auto* out = staging_.data() + at;
+    out = put32(out, EnhancedPacketBlock);
+    out = put32(out, static_cast<uint32_t>(size));
+    out = put32(out, 0); // interface ID
+    out = put32(out, static_cast<uint32_t>(record.timestampNanos >> 32));
+    out = put32(out, static_cast<uint32_t>(record.timestampNanos));
+    out = put32(out, record.size); // captured length
+    out = put32(out, record.size); // original length
+    std::memcpy(out, record.frame, record.size);
+    std::memset(out + record.size, 0, padded(record.size) - record.size);
+    out += padded(record.size);
+    out = put16(out, 2); // epb_flags
+    out = put16(out, 4);
+    out = put32(out, static_cast<uint32_t>(record.direction));
+    out = put32(out, 0); // opt_endofopt
+    put32(out, static_cast<uint32_t>(size));
+    ++pending_;
+
+    return staging_.size() < StagingCapacity || flush();
+  }
+
+  /// Writes out staged blocks. Returns false once a write has failed.
+  bool flush() noexcept {
+    if (error_) return false;
+    if (!write(staging_.data(), staging_.size())) return false;
+    written_ += pending_;
+    pending_ = 0;
+    staging_.clear();
+    return true;
+  }
+
+  void close() noexcept {
+    if (fd_ < 0) return;
+    flush();
+    ::close(fd_);
+    fd_ = -1;
+  }
+
+  uint64_t written() const noexcept { return written_; }
+  uint64_t bytesWritten() const noexcept { return bytesWritten_; }
+  uint32_t files() const noexcept { return files_; }
+  int error() const noexcept { return error_; }
+
+private:
+  static constexpr size_t StagingCapacity = 64 << 10;
+
+  static size_t padded(size_t size) noexcept { return (size + 3) & ~size_t{3}; }
+  static uint8_t* put16(uint8_t* out, uint16_t value) noexcept {
+    std::memcpy(out, &value, sizeof(value));
+    return out + sizeof(value);
+  }
+  static uint8_t* put32(uint8_t* out, uint32_t value) noexcept {
+    std::memcpy(out, &value, sizeof(value));
+    return out + sizeof(value);
+  }
+  static uint8_t* put64(uint8_t* out, uint64_t value) noexcept {
+    std::memcpy(out, &value, sizeof(value));
+    return out + sizeof(value);
+  }
+  static uint8_t* putOption(uint8_t* out, uint16_t code, void const* value, size_t size) noexcept {
+    out = put16(out, code);
+    out = put16(out, static_cast<uint16_t>(size));
+    std::memcpy(out, value, size);
+    std::memset(out + size, 0, padded(size) - size);
+    return out + padded(size);
+  }
+
+  // Creates file `index_` and writes its Section Header and Interface
+  // Description Blocks. Blocks are in native byte order, which the
+  // byte-order magic tells readers.
+  void open() {
+    auto const path = rotatedPath(path_, index_);
+    fd_ = ::open(path.c_str(), O_WRONLY | O_CREAT | O_TRUNC | O_CLOEXEC, 0644);
+    if (fd_ < 0) throw std::system_error(errno, std::generic_category(), path);
+    fileBytes_ = 0;
+
+    static constexpr char Application[] = "AVDECCSwift";
+    auto const name = interfaceName_.substr(0, 256);
+    uint8_t header[512];
+    auto* out = header;
+    auto const shbSize = 24 + 4 + padded(sizeof(Application) - 1) + 4 + 4;
+    out = put32(out, SectionHeaderBlock);
+    out = put32(out, static_cast<uint32_t>(shbSize));
+    out = put32(out, ByteOrderMagic);
+    out = put16(out, 1); // major version
+    out = put16(out, 0); // minor version
+    out = put64(out, ~uint64_t{0}); // section length unspecified
+    out = putOption(out, 4, Application, sizeof(Application) - 1); // shb_userappl
+    out = put32(out, 0); // opt_endofopt
+    out = put32(out, static_cast<uint32_t>(shbSize));
+
+    uint8_t const resolution = 9; // if_tsresol: nanoseconds
+    auto const idbSize = 16 + (name.empty() ? 0 : 4 + padded(name.size())) + 8 + 4 + 4;
+    out = put32(out, InterfaceDescriptionBlock);
+    out = put32(out, static_cast<uint32_t>(idbSize));
+    out = put16(out, LinkTypeEthernet);
+    out = put16(out, 0); // reserved
+    out = put32(out, 0); // snap length: unlimited
+    if (!name.empty()) out = putOption(out, 2, name.data(), name.size()); // if_name
+    out = putOption(out, 9, &resolution, sizeof(resolution));
+    out = put32(out, 0); // opt_endofopt
+    out = put32(out, static_cast<uint32_t>(idbSize));
+
+    headerBytes_ = static_cast<size_t>(out - header);
+    if (!write(header, headerBytes_)) {
+      auto const error = error_;
+      ::close(fd_);
+      fd_ = -1;
+      throw std::system_error(error, std::generic_category(), path);
+    }
+    ++files_;
+  }
+
+  bool write(uint8_t const* data, size_t size) noexcept {
+    while (size) {
+      auto const n = ::write(fd_, data, size);
+      if (n < 0) {
+        if (errno == EINTR) continue;
+        error_ = errno;
+        return false;
+      }
+      data += n;
+      size -= static_cast<size_t>(n);
+      fileBytes_ += static_cast<uint64_t>(n);
+      bytesWritten_ += static_cast<uint64_t>(n);
+    }
+    return true;
+  }
+
+  std::string const path_;
+  std::string const interfaceName_;
+  uint64_t const maxFileSize_;
+  uint32_t const maxFiles_;
+  int fd_ = -1;
+  uint32_t index_ = 0;
+  uint64_t fileBytes_ = 0;
+  size_t headerBytes_ = 0;
+  std::vector<uint8_t> staging_;
+  uint64_t pending_ = 0;
+  uint64_t written_ = 0;
+  uint64_t bytesWritten_ = 0;
+  uint32_t files_ = 0;
+  int error_ = 0;
+};
+
+/// One running capture: the ring producers push into and the writer
+/// thread that empties it into files.
+class PduCapture final {
+public:
+  /// Opens the first file and starts the writer. Throws
+  /// std::system_error if the file cannot be created or the thread
+  /// cannot be started.
+  PduCapture(std::string path, std::string interfaceName, uint64_t maxFileSize,
+             uint32_t maxFiles, uint32_t depth)
+      : ring_(depth),
+        file_(std::move(path), std::move(interfaceName), maxFileSize, maxFiles) {
+    writer_ = std::thread([this] { writeLoop(); });
+  }
+
+  ~PduCapture() noexcept { stop(); }
+
+  PduCapture(PduCapture const&) = delete;
+  PduCapture& operator=(PduCapture const&) = delete;
+
+  /// Any thread; never waits. A sent PDU passes the time taken before
+  /// the send, so it is not stamped after the replies it caused.
+  template <typename Pdu>
+  void record(PduCaptureDirection direction, Pdu const& pdu,
+              uint64_t timestampNanos = realtimeNanos()) noexcept {
+    uint8_t frame[PduCaptureFrameCapacity];
+    auto const size = serializePduFrame(pdu, frame, sizeof(frame));
+    if (!size) return;
+    ring_.tryPush(direction, timestampNanos, frame, size);
+  }
+
+  /// Writes out what is queued, closes the file and joins the writer.
+  /// Idempotent; frames pushed afterwards stay in the ring.
+  void stop() noexcept {
+    ring_.stop();
+    if (writer_.joinable()) writer_.join();
+  }
+
+  PduCaptureStatistics statistics() const noexcept {
+    PduCaptureStatistics out;
+    out.running = !stopped_.load(std::memory_order_acquire);
+    out.captured = ring_.captured();
+    out.dropped = ring_.dropped();
+    out.written = written_.load(std::memory_order_relaxed);
+    out.bytesWritten = bytesWritten_.load(std::memory_order_relaxed);
+    out.files = files_.load(std::memory_order_relaxed);
+    out.writeError = writeError_.load(std::memory_order_relaxed);
+    return out;
+  }
+
+  static uint64_t realtimeNanos() noexcept {
+    return static_cast<uint64_t>(std::chrono::duration_cast<std::chrono::nanoseconds>(
+                                     std::chrono::system_clock::now().time_since_epoch())
+                                     .count());
+  }
+
+private:
+  static constexpr size_t WriteBatch = 64;
+
+  void writeLoop() noexcept {
+    for (;;) {
+      auto const count = ring_.drain(WriteBatch, [this](PduCaptureRecord const& record) {
+        file_.append(record);
+      });
+      // Per batch, so statistics() keeps up while the ring never runs dry.
+      publish();
+      if (!count) {
+        file_.flush();
+        publish();
+        if (!ring_.waitForRecords()) break;
+      }
+    }
+    file_.close();
+    publish();
+    stopped_.store(true, std::memory_order_release);
+  }
+
+  // Counters for statistics(), which may run on any thread.
+  void publish() noexcept {
+    written_.store(file_.written(), std::memory_order_relaxed);
+    bytesWritten_.store(file_.bytesWritten(), std::memory_order_relaxed);
+    files_.store(file_.files(), std::memory_order_relaxed);
+    writeError_.store(file_.error(), std::memory_order_relaxed);
+  }
+
+  PduCaptureRing ring_;
+  PcapngFileWriter file_;
+  std::thread writer_;
+  std::atomic<bool> stopped_{false};
+  std::atomic<uint64_t> written_{0};
+  std::atomic<uint64_t> bytesWritten_{0};
+  std::atomic<uint32_t> files_{1};
+  std::atomic<int32_t> writeError_{0};
+};
+
+} // namespace AVDECCSwift
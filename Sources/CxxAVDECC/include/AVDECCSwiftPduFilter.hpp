@@ -0,0 +1,156 @@
+/*
+ * Copyright (C) 2026, PADL Software Pty Ltd
+ *
+ * This file is part of AVDECCSwift.
+ *
+ * AVDECCSwift is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * AVDECCSwift is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with AVDECCSwift.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+// Predicates for the observer's raw PDU taps (onAdpduReceived /
+// onAecpduReceived / onAcmpduReceived). la_avdecc raises these for every
+// PDU on the wire, so forwarding them all to Swift would cost a crossing
+// per packet on a busy network. Each tap instead holds a PduFilter,
+// compiled from Swift's sets into sorted arrays and bitmasks, and tests
+// each PDU in C++ first; only matches reach the slot.
+//
+// A tap without a filter is off: the override returns after one relaxed
+// load. Filters are immutable once published and replaced whole, so a
+// PDU is tested against one consistent filter without a lock.
+#pragma once
+
+#include <algorithm>
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <initializer_list>
+#include <memory>
+#include <vector>
+
+#include <la/avdecc/internals/protocolAcmpdu.hpp>
+#include <la/avdecc/internals/protocolAdpdu.hpp>
+#include <la/avdecc/internals/protocolAecpdu.hpp>
+#include <la/avdecc/internals/protocolAemAecpdu.hpp>
+
+namespace AVDECCSwift {
+
+/// Which raw PDU tap, as numbered by Swift's `PduTap`.
+enum class PduTapKind : uint8_t {
+  Adp = 0,
+  Aecp = 1,
+  Acmp = 2,
+};
+constexpr size_t PduTapCount = 3;
+
+/// What a tap passes on. Fields are ANDed; an empty field matches
+/// anything. Within a field any listed value matches.
+class PduFilter final {
+public:
+  /// `entityIDs` match a PDU's entity (ADP), target or controller (AECP),
+  /// or talker, listener or controller (ACMP). Message types and
+  /// statuses are given as bitmasks of the values that match, all bits
+  /// set for an empty field (every value on the wire is below 32); a 0
+  /// mask matches nothing. Statuses do not apply to ADP. `commandTypes`
+  /// apply to AECP only, where a non-AEM PDU then never matches.
+  PduFilter(uint64_t const* entityIDs, size_t entityIDCount, uint32_t messageTypes,
+            uint32_t statuses, uint16_t const* commandTypes, size_t commandTypeCount)
+      : entityIDs_(entityIDs, entityIDs + entityIDCount),
+        commandTypes_(commandTypes, commandTypes + commandTypeCount),
+        messageTypes_(messageTypes),
+        statuses_(statuses) {
+    std::sort(entityIDs_.begin(), entityIDs_.end());
+    std::sort(commandTypes_.begin(), commandTypes_.end());
+  }
+
+  bool matches(la::avdecc::protocol::Adpdu const& pdu) const noexcept {
+    return messageType(pdu.getMessageType().getValue()) &&
+           entity({pdu.getEntityID().getValue()});
+  }
+
+  bool matches(la::avdecc::protocol::Aecpdu const& pdu) const noexcept {
+    auto const type = pdu.getMessageType().getValue();
+    if (!messageType(type) || !status(pdu.getStatus().getValue())) return false;
+    if (!commandTypes_.empty()) {
+      // AEM_COMMAND and AEM_RESPONSE are the AEM message types, which
+      // la_avdecc deserializes as AemAecpdu.
+      if (type > 1) return false;
+      auto const command =
+          static_cast<la::avdecc::protocol::AemAecpdu const&>(pdu).getCommandType().getValue();
+      if (!std::binary_search(commandTypes_.begin(), commandTypes_.end(), command)) return false;
+    }
+    return entity({pdu.getTargetEntityID().getValue(), pdu.getControllerEntityID().getValue()});
+  }
+
+  bool matches(la::avdecc::protocol::Acmpdu const& pdu) const noexcept {
+    return messageType(pdu.getMessageType().getValue()) &&
+           status(pdu.getStatus().getValue()) &&
+           entity({pdu.getListenerEntityID().getValue(), pdu.getTalkerEntityID().getValue(),
+                   pdu.getControllerEntityID().getValue()});
+  }
+
+private:
+  static bool inMask(uint32_t mask, uint8_t value) noexcept {
+    return value < 32 && (mask & (uint32_t{1} << value));
+  }
+  bool messageType(uint8_t value) const noexcept { return inMask(messageTypes_, value); }
+  bool status(uint8_t value) const noexcept { return inMask(statuses_, value); }
+  bool entity(std::initializer_list<uint64_t> ids) const noexcept {
+    if (entityIDs_.empty()) return true;
+    return std::any_of(ids.begin(), ids.end(), [this](uint64_t id) {
+      return std::binary_search(entityIDs_.begin(), entityIDs_.end(), id);
+    });
+  }
+
+  std::vector<uint64_t> entityIDs_;
+  std::vector<uint16_t> commandTypes_;
+  uint32_t const messageTypes_;
+  uint32_t const statuses_;
+};
+
+/// One tap's current filter and counts.
+class PduTap final {
+public:
+  /// Any thread; one relaxed load.
+  bool enabled() const noexcept { return enabled_.load(std::memory_order_relaxed); }
+
+  /// nullptr turns the tap off.
+  void setFilter(std::shared_ptr<PduFilter const> filter) noexcept {
+    enabled_.store(filter != nullptr, std::memory_order_relaxed);
+    std::atomic_store_explicit(&filter_, std::move(filter), std::memory_order_release);
+  }
+
+  /// Test `pdu` against the current filter, counting the outcome.
+  template <typename Pdu>
+  bool admit(Pdu const& pdu) noexcept {
+    auto const filter = std::atomic_load_explicit(&filter_, std::memory_order_acquire);
+    if (!filter) return false;
+    if (!filter->matches(pdu)) {
+      rejected_.fetch_add(1, std::memory_order_relaxed);
+      return false;
+    }
+    matched_.fetch_add(1, std::memory_order_relaxed);
+    return true;
+  }
+
+  uint64_t matched() const noexcept { return matched_.load(std::memory_order_relaxed); }
+  uint64_t rejected() const noexcept { return rejected_.load(std::memory_order_relaxed); }
+
+private:
+  std::atomic<bool> enabled_{false};
+  // Accessed only through std::atomic_load/store.
+  std::shared_ptr<PduFilter const> filter_;
+  std::atomic<uint64_t> matched_{0};
+  std::atomic<uint64_t> rejected_{0};
+};
+
+} // namespace AVDECCSwift
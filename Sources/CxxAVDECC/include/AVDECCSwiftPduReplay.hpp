@@ -0,0 +1,686 @@
+/*
+ * Copyright (C) 2026, PADL Software Pty Ltd
+ *
+ * This file is part of AVDECCSwift.
+ *
+ * AVDECCSwift is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * AVDECCSwift is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with AVDECCSwift.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+// Replay of a pcap or pcapng capture of AVDECC traffic into a virtual
+// ProtocolInterface, for reproducing incidents and load-testing
+// controller logic offline.
+//
+// la_avdecc's virtual transport delivers what one virtual interface sends
+// to every other virtual interface opened on the same interface ID. The
+// replay opens its own (the injector) on the target's ID, and a thread
+// reads the file, rebuilds each ADP, AEM AECP and ACMP frame into its
+// la_avdecc PDU and sends it at the recorded pacing divided by `speed`
+// (0: as fast as possible). Other frames, including non-AEM AECP, are
+// skipped and counted, as are frames whose pcapng epb_flags mark them
+// outbound unless asked for: a capture taken on a controller (see
+// AVDECCSwiftPduCapture.hpp) holds what it sent as well as what it
+// received, and replaying both would have the target see its own side
+// of the conversation.
+//
+// Processing lag is measured by a PduReplayProbe hooked into the
+// target's observer: the injector stamps each PDU it sends, and the
+// target's executor, on seeing the matching receipt (PDUs arrive in send
+// order), takes the difference. The observer raises the receipt before
+// la_avdecc processes the PDU, so lag is how far the target's executor
+// is behind the replay. Receipts are matched by count, which assumes the
+// replay is the only traffic on that interface ID.
+#pragma once
+
+#include <algorithm>
+#include <atomic>
+#include <cerrno>
+#include <chrono>
+#include <condition_variable>
+#include <cstddef>
+#include <cstdint>
+#include <cstdio>
+#include <cstring>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <system_error>
+#include <thread>
+#include <vector>
+
+#include <la/avdecc/internals/protocolAcmpdu.hpp>
+#include <la/avdecc/internals/protocolAdpdu.hpp>
+#include <la/avdecc/internals/protocolAecpdu.hpp>
+#include <la/avdecc/internals/protocolAemAecpdu.hpp>
+#include <la/avdecc/internals/protocolInterface.hpp>
+#include <la/avdecc/internals/serialization.hpp>
+
+#include "AVDECCSwiftStatistics.hpp"
+
+namespace AVDECCSwift {
+
+/// One frame read from a capture file.
+struct PcapFrame {
+  /// Capture timestamp, nanoseconds since the epoch.
+  uint64_t timestampNanos = 0;
+  /// False for link types other than Ethernet, whose frames are skipped.
+  bool ethernet = false;
+  /// pcapng epb_flags direction is outbound (2); classic pcap has none.
+  bool outbound = false;
+  std::vector<uint8_t> data;
+};
+
+/// Sequential reader for classic pcap (microsecond or nanosecond, either
+/// byte order) and pcapng (every section, interface and if_tsresol; EPB
+/// and obsolete Packet Blocks; Simple Packet Blocks carry no timestamp
+/// and are skipped).
+class PcapFileReader final {
+public:
+  static constexpr uint32_t PcapMicros = 0xA1B2C3D4;
+  static constexpr uint32_t PcapNanos = 0xA1B23C4D;
+  static constexpr uint32_t SectionHeaderBlock = 0x0A0D0D0A;
+  static constexpr uint32_t ByteOrderMagic = 0x1A2B3C4D;
+  static constexpr uint16_t LinkTypeEthernet = 1;
+
+  /// Opens `path` and reads its file header. Throws std::system_error,
+  /// with EINVAL if the file is neither pcap nor pcapng.
+  explicit PcapFileReader(std::string const& path) : path_(path) {
+    file_ = std::fopen(path.c_str(), "rb");
+    if (!file_) throw std::system_error(errno, std::generic_category(), path);
+    uint8_t magic[4];
+    if (!read(magic, sizeof(magic))) fail(path);
+    uint32_t value;
+    std::memcpy(&value, magic, sizeof(value));
+    if (value == SectionHeaderBlock) {
+      pcapng_ = true;
+      std::fseek(file_, 0, SEEK_SET);
+      return;
+    }
+    if (value == PcapMicros || value == PcapNanos) {
+      swap_ = false;
+    } else if (swap32(value) == PcapMicros || swap32(value) == PcapNanos) {
+      swap_ = true;
+      value = swap32(value);
+    } else {
+      fail(path);
+    }
+    nanos_ = value == PcapNanos;
+    uint8_t header[20];
+    if (!read(header, sizeof(header))) fail(path);
+    // The top bits of the link type field may hold FCS information.
+    linkType_ = static_cast<uint16_t>(get32(header + 16));
+  }
+
+  ~PcapFileReader() noexcept {
+    if (file_) std::fclose(file_);
+  }
+
+  PcapFileReader(PcapFileReader const&) = delete;
+  PcapFileReader& operator=(PcapFileReader const&) = delete;
+
+  /// The next frame, or false at the end of the file or on an error
+  /// (then `error()` is nonzero: errno, or EINVAL for a corrupt file).
+  bool next(PcapFrame& frame) noexcept {
+    if (error_) return false;
+    try {
+      return pcapng_ ? nextBlock(frame) : nextRecord(frame);
+    } catch (std::bad_alloc const&) {
+      error_ = ENOMEM;
+      return false;
+    }
+  }
+
+  int error() const noexcept { return error_; }
+
+private:
+  struct Interface {
+    uint16_t linkType = 0;
+    // if_tsresol: units per second as 10^n (decimal) or 2^n.
+    bool binary = false;
+    uint8_t exponent = 6;
+    int64_t offsetSeconds = 0;
+  };
+
+  // Sanity bound on one record or block.
+  static constexpr uint32_t MaxBlock = 16 << 20;
+
+  [[noreturn]] static void fail(std::string const& path) {
+    throw std::system_error(EINVAL, std::generic_category(), path);
+  }
+
+  static uint32_t swap32(uint32_t value) noexcept {
+    return ((value & 0xFF) << 24) | ((value & 0xFF00) << 8) | ((value >> 8) & 0xFF00) |
+           (value >> 24);
+  }
+  static uint16_t swap16(uint16_t value) noexcept {
+    return static_cast<uint16_t>((value << 8) | (value >> 8));
+  }
+  uint32_t get32(uint8_t const* p) const noexcept {
+    uint32_t value;
+    std::memcpy(&value, p, sizeof(value));
+    return swap_ ? swap32(value) : value;
+  }
+  uint16_t get16(uint8_t const* p) const noexcept {
+    uint16_t value;
+    std::memcpy(&value, p, sizeof(value));
+    return swap_ ? swap16(value) : value;
+  }
+
+  bool read(void* out, size_t size) noexcept { return std::fread(out, 1, size, file_) == size; }
+
+  // A short read at a record boundary is the end of the file; anywhere
+  // else the file is truncated.
+  bool readOrEnd(void* out, size_t size) noexcept {
+    auto const n = std::fread(out, 1, size, file_);
+    if (n == size) return true;
+    if (n != 0 || std::ferror(file_)) error_ = std::ferror(file_) ? EIO : EINVAL;
+    return false;
+  }
+
+  bool nextRecord(PcapFrame& frame) {
+    uint8_t header[16];
+    if (!readOrEnd(header, sizeof(header))) return false;
+    auto const size = get32(header + 8);
+    if (size > MaxBlock) {
+      error_ = EINVAL;
+      return false;
+    }
+    frame.data.resize(size);
+    if (size && !read(frame.data.data(), size)) {
+      error_ = EINVAL;
+      return false;
+    }
+    auto const fraction = uint64_t{get32(header + 4)};
+    frame.timestampNanos =
+        uint64_t{get32(header)} * 1000000000u + (nanos_ ? fraction : fraction * 1000u);
+    frame.ethernet = linkType_ == LinkTypeEthernet;
+    frame.outbound = false;
+    return true;
+  }
+
+  // Blocks until a packet block, handling section and interface blocks
+  // on the way.
+  bool nextBlock(PcapFrame& frame) {
+    for (;;) {
+      uint8_t header[8];
+      if (!readOrEnd(header, sizeof(header))) return false;
+      uint32_t type;
+      std::memcpy(&type, header, sizeof(type));
+      if (type == SectionHeaderBlock) {
+        // The byte-order magic follows the length; read it first.
+        uint8_t magic[4];
+        if (!read(magic, sizeof(magic))) {
+          error_ = EINVAL;
+          return false;
+        }
+        uint32_t value;
+        std::memcpy(&value, magic, sizeof(value));
+        if (value == ByteOrderMagic) {
+          swap_ = false;
+        } else if (swap32(value) == ByteOrderMagic) {
+          swap_ = true;
+        } else {
+          error_ = EINVAL;
+          return false;
+        }
+        interfaces_.clear();
+        auto const length = get32(header + 4);
+        if (!skipBody(length, 12)) return false;
+        continue;
+      }
+
+      type = get32(header);
+      auto const length = get32(header + 4);
+      if (length < 12 || length % 4 || length > MaxBlock) {
+        error_ = EINVAL;
+        return false;
+      }
+      block_.resize(length - 8);
+      if (!read(block_.data(), block_.size())) {
+        error_ = EINVAL;
+        return false;
+      }
+      auto const* body = block_.data();
+      auto const bodySize = block_.size() - 4;
+
+      switch (type) {
+        case 1: // Interface Description Block
+          if (bodySize < 8) break;
+          interfaces_.push_back(describeInterface(body, bodySize));
+          break;
+        case 6: // Enhanced Packet Block
+        case 2: { // Packet Block (obsolete)
+          if (bodySize < 20) break;
+          auto const interface = type == 6 ? get32(body) : uint32_t{get16(body)};
+          auto const size = get32(body + 12);
+          if (size > bodySize - 20 || interface >= interfaces_.size()) {
+            error_ = EINVAL;
+            return false;
+          }
+          auto const& info = interfaces_[interface];
+          auto const timestamp = (uint64_t{get32(body + 4)} << 32) | get32(body + 8);
+          frame.timestampNanos = toNanos(info, timestamp);
+          frame.ethernet = info.linkType == LinkTypeEthernet;
+          frame.outbound = type == 6 && outbound(body + 20 + ((size + 3u) & ~3u),
+                                                 body + bodySize);
+          frame.data.assign(body + 20, body + 20 + size);
+          return true;
+        }
+        default: // Simple Packet, Name Resolution, statistics, custom, …
+          break;
+      }
+    }
+  }
+
+  bool skipBody(uint32_t length, uint32_t consumed) noexcept {
+    if (length < consumed + 4 || length % 4 || length > MaxBlock ||
+        std::fseek(file_, static_cast<long>(length - consumed), SEEK_CUR) != 0) {
+      error_ = EINVAL;
+      return false;
+    }
+    return true;
+  }
+
+  // Whether an EPB's options, from `at` to `end`, hold an epb_flags
+  // whose direction bits say outbound.
+  bool outbound(uint8_t const* at, uint8_t const* end) const noexcept {
+    while (at + 4 <= end) {
+      auto const code = get16(at);
+      auto const length = get16(at + 2);
+      if (code == 0 || at + 4 + length > end) break;
+      if (code == 2 && length >= 4) return (get32(at + 4) & 0x3) == 2; // epb_flags
+      at += 4 + ((length + 3u) & ~3u);
+    }
+    return false;
+  }
+
+  Interface describeInterface(uint8_t const* body, size_t size) const noexcept {
+    Interface info;
+    info.linkType = get16(body);
+    for (size_t at = 8; at + 4 <= size;) {
+      auto const code = get16(body + at);
+      auto const length = get16(body + at + 2);
+      auto const* value = body + at + 4;
+      if (code == 0 || at + 4 + length > size) break;
+      if (code == 9 && length >= 1) { // if_tsresol
+        info.binary = (value[0] & 0x80) != 0;
+        info.exponent = value[0] & 0x7F;
+      } else if (code == 14 && length >= 8) { // if_tsoffset
+        uint64_t offset;
+        std::memcpy(&offset, value, sizeof(offset));
+        if (swap_) {
+          offset = (uint64_t{swap32(static_cast<uint32_t>(offset))} << 32) |
+                   swap32(static_cast<uint32_t>(offset >> 32));
+        }
+        info.offsetSeconds = static_cast<int64_t>(offset);
+      }
+      at += 4 + ((length + 3u) & ~3u);
+    }
+    return info;
+  }
+
+  static uint64_t toNanos(Interface const& info, uint64_t timestamp) noexcept {
+    unsigned __int128 nanos;
+    if (info.binary) {
+      auto const shift = std::min<uint8_t>(info.exponent, 63);
+      nanos = (static_cast<unsigned __int128>(timestamp) * 1000000000u) >> shift;
+    } else if (info.exponent <= 9) {
+      uint64_t scale = 1;
+      for (auto i = info.exponent; i < 9; ++i) scale *= 10;
+      nanos = static_cast<unsigned __int128>(timestamp) * scale;
+    } else {
+      uint64_t scale = 1;
+      for (auto i = uint8_t{9}; i < info.exponent && i < 28; ++i) scale *= 10;
+      nanos = timestamp / scale;
+    }
+    return static_cast<uint64_t>(nanos) +
+           static_cast<uint64_t>(info.offsetSeconds) * 1000000000u;
+  }
+
+  std::string const path_;
+  std::FILE* file_ = nullptr;
+  bool pcapng_ = false;
+  bool swap_ = false;
+  bool nanos_ = false;
+  uint16_t linkType_ = 0;
+  std::vector<Interface> interfaces_;
+  std::vector<uint8_t> block_;
+  int error_ = 0;
+};
+
+/// What became of one frame handed to `injectPduFrame`.
+enum class PduReplayOutcome : uint8_t {
+  Injected,
+  /// Not AVDECC, or an AECP message type other than AEM.
+  Skipped,
+  Malformed,
+  SendFailed,
+};
+
+/// Rebuild `frame` (an Ethernet frame, optionally 802.1Q tagged) into
+/// its la_avdecc PDU and send it through `pi`, calling `beforeSend()`
+/// once the PDU is built.
+template <typename BeforeSend>
+PduReplayOutcome injectPduFrame(la::avdecc::protocol::ProtocolInterface& pi,
+                                uint8_t const* frame, size_t size,
+                                BeforeSend&& beforeSend) noexcept {
+  using la::avdecc::protocol::ProtocolInterface;
+  constexpr size_t MacHeader = 14;
+  constexpr uint16_t EtherTypeAvtp = 0x22F0;
+  constexpr uint16_t EtherTypeVlan = 0x8100;
+  constexpr uint8_t SubtypeAdp = 0x7A;
+  constexpr uint8_t SubtypeAecp = 0x7B;
+  constexpr uint8_t SubtypeAcmp = 0x7C;
+
+  if (size < MacHeader + 2) return PduReplayOutcome::Skipped;
+  auto etherType = static_cast<uint16_t>((frame[12] << 8) | frame[13]);
+  // la_avdecc deserializes untagged frames; drop the tag into a copy.
+  uint8_t untagged[1514];
+  if (etherType == EtherTypeVlan) {
+    if (size < MacHeader + 6 || size - 4 > sizeof(untagged)) return PduReplayOutcome::Skipped;
+    std::memcpy(untagged, frame, 12);
+    std::memcpy(untagged + 12, frame + 16, size - 16);
+    frame = untagged;
+    size -= 4;
+    etherType = static_cast<uint16_t>((frame[12] << 8) | frame[13]);
+  }
+  if (etherType != EtherTypeAvtp) return PduReplayOutcome::Skipped;
+
+  auto const sent = [](ProtocolInterface::Error error) noexcept {
+    return error == ProtocolInterface::Error::NoError ? PduReplayOutcome::Injected
+                                                      : PduReplayOutcome::SendFailed;
+  };
+  try {
+    la::avdecc::protocol::DeserializationBuffer buffer(frame, size);
+    switch (frame[MacHeader] & 0x7F) {
+      case SubtypeAdp: {
+        auto pdu = la::avdecc::protocol::Adpdu::create();
+        pdu->la::avdecc::protocol::EtherLayer2::deserialize(buffer);
+        pdu->la::avdecc::protocol::AvtpduControl::deserialize(buffer);
+        pdu->deserialize(buffer);
+        beforeSend();
+        return sent(pi.sendAdpMessage(*pdu));
+      }
+      case SubtypeAecp: {
+        // message_type is the AVTP control_data field.
+        auto const messageType = frame[MacHeader + 1] & 0x0F;
+        if (messageType > 1) return PduReplayOutcome::Skipped; // not AEM
+        auto pdu = la::avdecc::protocol::AemAecpdu::create(messageType == 1);
+        pdu->la::avdecc::protocol::EtherLayer2::deserialize(buffer);
+        pdu->la::avdecc::protocol::AvtpduControl::deserialize(buffer);
+        pdu->deserialize(buffer);
+        beforeSend();
+        return sent(pi.sendAecpMessage(*pdu));
+      }
+      case SubtypeAcmp: {
+        auto pdu = la::avdecc::protocol::Acmpdu::create();
+        pdu->la::avdecc::protocol::EtherLayer2::deserialize(buffer);
+        pdu->la::avdecc::protocol::AvtpduControl::deserialize(buffer);
+        pdu->deserialize(buffer);
+        beforeSend();
+        return sent(pi.sendAcmpMessage(*pdu));
+      }
+      default:
+        return PduReplayOutcome::Skipped;
+    }
+  } catch (...) {
+    return PduReplayOutcome::Malformed;
+  }
+}
+
+/// Send-to-receipt lag of replayed PDUs. `injected` runs on the replay
+/// thread, `received` on the target's executor.
+class PduReplayProbe final {
+public:
+  /// PDUs in flight whose send time is kept; older ones go unmeasured.
+  static constexpr size_t Window = 1 << 14;
+
+  void injected() noexcept {
+    auto const n = injected_.load(std::memory_order_relaxed);
+    stamps_[n & (Window - 1)].store(steadyNanos(), std::memory_order_relaxed);
+    injected_.store(n + 1, std::memory_order_release);
+  }
+
+  /// Undo the last `injected()`, whose PDU was not sent.
+  void withdraw() noexcept {
+    injected_.fetch_sub(1, std::memory_order_release);
+  }
+
+  void received() noexcept {
+    auto const n = received_.load(std::memory_order_relaxed);
+    if (n >= injected_.load(std::memory_order_acquire)) {
+      unmatched_.fetch_add(1, std::memory_order_relaxed);
+      return;
+    }
+    auto const stamp = stamps_[n & (Window - 1)].load(std::memory_order_relaxed);
+    // Re-check: the replay thread may have lapped the slot meanwhile.
+    if (injected_.load(std::memory_order_acquire) - n > Window) {
+      unmeasured_.fetch_add(1, std::memory_order_relaxed);
+    } else {
+      auto const now = steadyNanos();
+      auto const lag = now > stamp ? now - stamp : 0;
+      totalLag_.fetch_add(lag, std::memory_order_relaxed);
+      lastLag_.store(lag, std::memory_order_relaxed);
+      if (lag > maxLag_.load(std::memory_order_relaxed)) {
+        maxLag_.store(lag, std::memory_order_relaxed);
+      }
+    }
+    received_.store(n + 1, std::memory_order_release);
+  }
+
+  uint64_t processed() const noexcept { return received_.load(std::memory_order_acquire); }
+  uint64_t unmeasured() const noexcept { return unmeasured_.load(std::memory_order_relaxed); }
+  uint64_t unmatched() const noexcept { return unmatched_.load(std::memory_order_relaxed); }
+  uint64_t totalLag() const noexcept { return totalLag_.load(std::memory_order_relaxed); }
+  uint64_t maxLag() const noexcept { return maxLag_.load(std::memory_order_relaxed); }
+  uint64_t lastLag() const noexcept { return lastLag_.load(std::memory_order_relaxed); }
+
+private:
+  std::unique_ptr<std::atomic<uint64_t>[]> stamps_{new std::atomic<uint64_t>[Window]()};
+  alignas(64) std::atomic<uint64_t> injected_{0};
+  alignas(64) std::atomic<uint64_t> received_{0};
+  std::atomic<uint64_t> unmeasured_{0};
+  std::atomic<uint64_t> unmatched_{0};
+  std::atomic<uint64_t> totalLag_{0};
+  std::atomic<uint64_t> maxLag_{0};
+  std::atomic<uint64_t> lastLag_{0};
+};
+
+/// Snapshot of a replay's counters.
+struct PduReplayStatistics {
+  bool running = false;
+  /// Frames read from the file.
+  uint64_t frames = 0;
+  uint64_t injected = 0;
+  uint64_t skipped = 0;
+  uint64_t malformed = 0;
+  uint64_t sendFailures = 0;
+  /// Wall time since the replay started, up to when it finished.
+  uint64_t elapsedNanos = 0;
+  /// Recorded time from the first frame to the last one read.
+  uint64_t recordedNanos = 0;
+  /// Latest any PDU was sent after its paced time.
+  uint64_t maxScheduleSlipNanos = 0;
+  /// Injected PDUs the target's observer has seen, and the send-to-
+  /// receipt lag over them (see PduReplayProbe).
+  uint64_t processed = 0;
+  uint64_t totalLagNanos = 0;
+  uint64_t maxLagNanos = 0;
+  uint64_t lastLagNanos = 0;
+  /// Receipts too far behind to match a send time, and receipts of
+  /// traffic the replay did not send.
+  uint64_t unmeasured = 0;
+  uint64_t unmatched = 0;
+  /// errno of the read that ended the replay early (EINVAL: corrupt
+  /// file); 0 otherwise.
+  int32_t readError = 0;
+};
+
+/// One replay: the file, the injector interface and the thread pacing
+/// frames from one into the other.
+class PduReplay final {
+public:
+  /// Opens `path` and starts the replay thread. `speed` divides the
+  /// recorded gaps; 0 sends back to back. Frames marked outbound are
+  /// skipped unless `includeOutbound`. Throws std::system_error.
+  PduReplay(std::string const& path, double speed, bool includeOutbound,
+            la::avdecc::protocol::ProtocolInterface::UniquePointer injector,
+            std::shared_ptr<PduReplayProbe> probe)
+      : reader_(path),
+        speed_(speed > 0 ? speed : 0),
+        includeOutbound_(includeOutbound),
+        injector_(std::move(injector)),
+        probe_(std::move(probe)) {
+    startNanos_ = steadyNanos();
+    thread_ = std::thread([this] { run(); });
+  }
+
+  ~PduReplay() noexcept { stop(); }
+
+  PduReplay(PduReplay const&) = delete;
+  PduReplay& operator=(PduReplay const&) = delete;
+
+  /// Abandon the rest of the file and join the thread. Idempotent.
+  void stop() noexcept {
+    {
+      std::lock_guard<std::mutex> lg(lock_);
+      stopRequested_ = true;
+    }
+    condition_.notify_all();
+    if (thread_.joinable()) thread_.join();
+  }
+
+  /// Block until the file is exhausted or `stop()` is called, or for at
+  /// most `timeoutNanos`; returns whether the replay has finished.
+  bool waitUntilFinished(uint64_t timeoutNanos) noexcept {
+    std::unique_lock<std::mutex> lk(lock_);
+    auto const done = [this] { return finished_; };
+    if (timeoutNanos == UINT64_MAX) {
+      condition_.wait(lk, done);
+      return true;
+    }
+    return condition_.wait_for(lk, std::chrono::nanoseconds(timeoutNanos), done);
+  }
+
+  PduReplayStatistics statistics() const noexcept {
+    PduReplayStatistics out;
+    auto const finishNanos = finishNanos_.load(std::memory_order_acquire);
+    out.running = finishNanos == 0;
+    out.frames = frames_.load(std::memory_order_relaxed);
+    out.injected = injected_.load(std::memory_order_relaxed);
+    out.skipped = skipped_.load(std::memory_order_relaxed);
+    out.malformed = malformed_.load(std::memory_order_relaxed);
+    out.sendFailures = sendFailures_.load(std::memory_order_relaxed);
+    out.elapsedNanos = (out.running ? steadyNanos() : finishNanos) - startNanos_;
+    out.recordedNanos = recordedNanos_.load(std::memory_order_relaxed);
+    out.maxScheduleSlipNanos = maxSlip_.load(std::memory_order_relaxed);
+    out.processed = probe_->processed();
+    out.totalLagNanos = probe_->totalLag();
+    out.maxLagNanos = probe_->maxLag();
+    out.lastLagNanos = probe_->lastLag();
+    out.unmeasured = probe_->unmeasured();
+    out.unmatched = probe_->unmatched();
+    out.readError = readError_.load(std::memory_order_relaxed);
+    return out;
+  }
+
+private:
+  void run() noexcept {
+    PcapFrame frame;
+    uint64_t firstTimestamp = 0;
+    bool first = true;
+    while (reader_.next(frame)) {
+      frames_.fetch_add(1, std::memory_order_relaxed);
+      if (first) {
+        firstTimestamp = frame.timestampNanos;
+        first = false;
+      }
+      auto const offset =
+          frame.timestampNanos > firstTimestamp ? frame.timestampNanos - firstTimestamp : 0;
+      recordedNanos_.store(offset, std::memory_order_relaxed);
+      if (!frame.ethernet || (frame.outbound && !includeOutbound_)) {
+        skipped_.fetch_add(1, std::memory_order_relaxed);
+        continue;
+      }
+      if (!pace(offset)) break;
+
+      auto const outcome = injectPduFrame(*injector_, frame.data.data(), frame.data.size(),
+                                          [this] { probe_->injected(); });
+      switch (outcome) {
+        case PduReplayOutcome::Injected:
+          injected_.fetch_add(1, std::memory_order_relaxed);
+          break;
+        case PduReplayOutcome::Skipped:
+          skipped_.fetch_add(1, std::memory_order_relaxed);
+          break;
+        case PduReplayOutcome::Malformed:
+          malformed_.fetch_add(1, std::memory_order_relaxed);
+          break;
+        case PduReplayOutcome::SendFailed:
+          // Nothing will reach the target: take the stamp back.
+          probe_->withdraw();
+          sendFailures_.fetch_add(1, std::memory_order_relaxed);
+          break;
+      }
+    }
+    readError_.store(reader_.error(), std::memory_order_relaxed);
+    finishNanos_.store(std::max<uint64_t>(steadyNanos(), startNanos_ + 1),
+                       std::memory_order_release);
+    {
+      std::lock_guard<std::mutex> lg(lock_);
+      finished_ = true;
+    }
+    condition_.notify_all();
+  }
+
+  // Wait until `offset` of recorded time, scaled by speed, has passed
+  // since the start. Returns false if stopped meanwhile.
+  bool pace(uint64_t offset) noexcept {
+    std::unique_lock<std::mutex> lk(lock_);
+    if (speed_ > 0) {
+      auto const due = startNanos_ + static_cast<uint64_t>(static_cast<double>(offset) / speed_);
+      auto const deadline = std::chrono::steady_clock::time_point(std::chrono::nanoseconds(due));
+      condition_.wait_until(lk, deadline, [this] { return stopRequested_; });
+      auto const now = steadyNanos();
+      if (now > due && now - due > maxSlip_.load(std::memory_order_relaxed)) {
+        maxSlip_.store(now - due, std::memory_order_relaxed);
+      }
+    }
+    return !stopRequested_;
+  }
+
+  PcapFileReader reader_;
+  double const speed_;
+  bool const includeOutbound_;
+  la::avdecc::protocol::ProtocolInterface::UniquePointer injector_;
+  std::shared_ptr<PduReplayProbe> const probe_;
+  uint64_t startNanos_ = 0;
+  std::thread thread_;
+
+  mutable std::mutex lock_;
+  std::condition_variable condition_;
+  bool stopRequested_ = false;
+  bool finished_ = false;
+
+  std::atomic<uint64_t> frames_{0};
+  std::atomic<uint64_t> injected_{0};
+  std::atomic<uint64_t> skipped_{0};
+  std::atomic<uint64_t> malformed_{0};
+  std::atomic<uint64_t> sendFailures_{0};
+  std::atomic<uint64_t> recordedNanos_{0};
+  std::atomic<uint64_t> maxSlip_{0};
+  std::atomic<uint64_t> finishNanos_{0};
+  std::atomic<int32_t> readError_{0};
+};
+
+} // namespace AVDECCSwift
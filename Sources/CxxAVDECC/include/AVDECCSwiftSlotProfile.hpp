@@ -0,0 +1,159 @@
+/*
+ * Copyright (C) 2026, PADL Software Pty Ltd
+ *
+ * This file is part of AVDECCSwift.
+ *
+ * AVDECCSwift is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * AVDECCSwift is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with AVDECCSwift.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+// Per-slot callback profiling for the observer / delegate adapters. The
+// executor statistics say how long jobs run, not which Swift handler
+// they spent it in. With a SlotProfiler enabled, each call into a slot's
+// block is counted and timed into that slot's Log2Histogram, whichever
+// path delivers it: inline, on a callback shard, replayed from a batch,
+// or flushed by the coalescer.
+//
+// Disabled (the default), the cost is one relaxed load per delivered
+// callback. The counters are allocated on first enable and kept until
+// the profiler is destroyed, so the record path never sees them go away.
+#pragma once
+
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <mutex>
+#include <new>
+
+#include "AVDECCSwiftStatistics.hpp"
+
+namespace AVDECCSwift {
+
+/// Slot indices (slot offset / pointer size) a SlotProfiler tracks, and so
+/// the most entries `copyTo` can write.
+constexpr size_t SlotProfileCapacity = 128;
+
+/// One slot's counters, as `SlotProfiler::copyTo` reports them. Crosses
+/// to Swift by value (the histogram imports as a tuple).
+struct SlotProfileStatistics {
+  /// The override the slot belongs to, e.g. "onEntityOnline"; static
+  /// storage.
+  char const* name = nullptr;
+  uint64_t invocations = 0;
+  /// Time spent inside the block.
+  uint64_t totalNanos = 0;
+  uint64_t maxNanos = 0;
+  uint64_t histogram[StatisticsHistogramBuckets] = {};
+};
+
+class SlotProfiler final {
+public:
+  static constexpr size_t MaxSlots = SlotProfileCapacity;
+
+  static std::shared_ptr<SlotProfiler> create() { return std::make_shared<SlotProfiler>(); }
+
+  ~SlotProfiler() noexcept { delete[] slots_.load(std::memory_order_relaxed); }
+
+  /// Start or stop recording. Counters survive a stop, so re-enabling
+  /// continues from where it left off. Returns false if they could not
+  /// be allocated.
+  bool setEnabled(bool enabled) noexcept {
+    if (enabled && !slots_.load(std::memory_order_acquire)) {
+      std::lock_guard<std::mutex> lg(lock_);
+      if (!slots_.load(std::memory_order_relaxed)) {
+        auto* const slots = new (std::nothrow) Slot[MaxSlots];
+        if (!slots) return false;
+        slots_.store(slots, std::memory_order_release);
+      }
+    }
+    enabled_.store(enabled, std::memory_order_relaxed);
+    return true;
+  }
+
+  /// Any thread; one relaxed load.
+  bool enabled() const noexcept { return enabled_.load(std::memory_order_relaxed); }
+
+  /// Run `fn()`, timing it as one invocation of the slot at `slotOffset`
+  /// if recording.
+  template <typename Fn>
+  void time(uint32_t slotOffset, char const* name, Fn&& fn) noexcept {
+    if (!enabled()) {
+      fn();
+      return;
+    }
+    auto const start = steadyNanos();
+    fn();
+    record(slotOffset, name, steadyNanos() - start);
+  }
+
+  void record(uint32_t slotOffset, char const* name, uint64_t nanos) noexcept {
+    auto* const slots = slots_.load(std::memory_order_acquire);
+    auto const index = slotOffset / sizeof(void*);
+    if (!slots || index >= MaxSlots) return;
+    auto& slot = slots[index];
+    if (!slot.name.load(std::memory_order_relaxed)) {
+      slot.name.store(name, std::memory_order_relaxed);
+    }
+    slot.invocations.fetch_add(1, std::memory_order_relaxed);
+    slot.latency.record(nanos);
+  }
+
+  /// Copy up to `capacity` slots that have been invoked into `out`, in
+  /// slot order; returns how many were written.
+  size_t copyTo(SlotProfileStatistics* out, size_t capacity) const noexcept {
+    auto const* const slots = slots_.load(std::memory_order_acquire);
+    if (!slots) return 0;
+    size_t count = 0;
+    for (size_t i = 0; i < MaxSlots && count < capacity; ++i) {
+      auto const& slot = slots[i];
+      auto const invocations = slot.invocations.load(std::memory_order_relaxed);
+      if (!invocations) continue;
+      auto& stats = out[count++];
+      stats.name = slot.name.load(std::memory_order_relaxed);
+      stats.invocations = invocations;
+      slot.latency.copyTo(stats.histogram, stats.totalNanos, stats.maxNanos);
+    }
+    return count;
+  }
+
+private:
+  // A line each: different slots fire on different shards concurrently.
+  struct alignas(64) Slot {
+    std::atomic<char const*> name{nullptr};
+    std::atomic<uint64_t> invocations{0};
+    Log2Histogram latency;
+  };
+
+  std::atomic<bool> enabled_{false};
+  std::atomic<Slot*> slots_{nullptr};
+  std::mutex lock_;
+};
+
+/// Stands in for an override's projection while profiling, timing the
+/// block call it makes. Holds the profiler by shared_ptr: a sharded
+/// delivery may run after the adapter that queued it is gone.
+template <typename Project>
+struct ProfiledProjection {
+  Project proj;
+  std::shared_ptr<SlotProfiler> profiler;
+  uint32_t slotOffset;
+  char const* name;
+
+  template <typename BlockT, typename... Args>
+  void operator()(BlockT const& blk, Args const&... args) const noexcept {
+    profiler->time(slotOffset, name, [&] { proj(blk, args...); });
+  }
+};
+
+} // namespace AVDECCSwift
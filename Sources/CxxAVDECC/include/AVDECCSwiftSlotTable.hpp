@@ -0,0 +1,344 @@
+/*
+ * Copyright (C) 2026, PADL Software Pty Ltd
+ *
+ * This file is part of AVDECCSwift.
+ *
+ * AVDECCSwift is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * AVDECCSwift is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with AVDECCSwift.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+// Read-mostly slot storage for the observer / delegate adapters. Their
+// block slots are read on every notification, from whichever la_avdecc
+// thread fires it, and written only when Swift rebinds a handler. Taking
+// a mutex and Block_copy'ing the slot on each read made one lock and one
+// block refcount the shared cachelines of every notification.
+//
+// SlotTable instead publishes an immutable copy of all slots through an
+// atomic pointer (RCU style). A reader announces itself in the
+// process-wide EpochDomain, loads the pointer and calls the block in
+// place: two stores to its own cacheline and one load, no lock, no
+// refcount. A writer copies the table, changes it, swaps the pointer and
+// retires the old copy, which is deleted once every reader that could
+// still see it has left: by a later retire, or by the last of those
+// readers on its way out. Writers never wait for readers, so a callback
+// may rebind slots (its own included), or release the adapter, without
+// deadlocking.
+//
+// Most deployments bind a handful of the ~80 slots, so SlotTable also
+// keeps a bitmask of the slots that hold a block. `installed(slot)` is
+// one relaxed load, and an adapter checks it before anything else so an
+// unbound notification never reaches the epoch fence.
+#pragma once
+
+#include <algorithm>
+#include <array>
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <mutex>
+#include <new>
+#include <utility>
+#include <vector>
+
+namespace AVDECCSwift {
+
+/// Epoch-based reclamation shared by every SlotTable. Each thread that
+/// reads gets a record (on first use, reused after the thread exits)
+/// holding the epoch it entered at, or 0 while outside.
+class EpochDomain final {
+public:
+  static EpochDomain& shared() noexcept {
+    // Leaked: readers on threads outliving static destruction must still
+    // find it.
+    static auto* domain = new EpochDomain();
+    return *domain;
+  }
+
+  /// Read-side critical section. Nests: only the outermost guard on a
+  /// thread publishes an epoch.
+  class ReadGuard final {
+  public:
+    explicit ReadGuard(EpochDomain& domain) noexcept;
+    ~ReadGuard() noexcept;
+    ReadGuard(ReadGuard const&) = delete;
+    ReadGuard& operator=(ReadGuard const&) = delete;
+
+  private:
+    struct ThreadState;
+    EpochDomain& domain_;
+    ThreadState& state_;
+    friend class EpochDomain;
+  };
+
+  /// Hand over an object that has just been unpublished; `deleter(object)`
+  /// runs once no reader can still hold it (possibly right away). Pending
+  /// objects are reclaimed on later calls, or when the outermost ReadGuard
+  /// on a thread exits, outside the domain's lock, so a deleter may itself
+  /// retire. If memory runs out the object is leaked rather than freed
+  /// under a reader.
+  void retire(void* object, void (*deleter)(void*)) noexcept {
+    std::atomic_thread_fence(std::memory_order_seq_cst);
+    auto const epoch = epoch_.fetch_add(1, std::memory_order_seq_cst);
+    std::vector<Retired> reclaimable;
+    {
+      std::lock_guard<std::mutex> lg(retiredLock_);
+      try {
+        retired_.push_back(Retired{object, deleter, epoch});
+      } catch (...) {
+      }
+      takeReclaimable(reclaimable);
+    }
+    for (auto const& r : reclaimable) r.deleter(r.object);
+  }
+
+private:
+  struct alignas(64) Record {
+    std::atomic<uint64_t> epoch{0};
+    std::atomic<bool> inUse{true};
+    Record* next = nullptr;
+  };
+
+  EpochDomain() noexcept = default;
+
+  // Lock-free: reuse a record freed by an exited thread, else push a new
+  // one. Records are never freed. Returns nullptr only if allocation
+  // fails; such a thread is counted in `unrecorded_` while it reads,
+  // which holds back all reclamation until it leaves.
+  Record* acquireRecord() noexcept {
+    for (auto* record = records_.load(std::memory_order_acquire); record;
+         record = record->next) {
+      bool expected = false;
+      if (!record->inUse.load(std::memory_order_relaxed) &&
+          record->inUse.compare_exchange_strong(expected, true, std::memory_order_acquire)) {
+        return record;
+      }
+    }
+    auto* record = new (std::nothrow) Record();
+    if (!record) return nullptr;
+    record->next = records_.load(std::memory_order_relaxed);
+    while (!records_.compare_exchange_weak(record->next, record, std::memory_order_release,
+                                           std::memory_order_relaxed)) {
+    }
+    return record;
+  }
+
+  struct Retired {
+    void* object;
+    void (*deleter)(void*);
+    uint64_t epoch;
+  };
+
+  /// Whether no reader can still hold an object retired at `epoch`.
+  bool safeToFree(uint64_t epoch) const noexcept {
+    std::atomic_thread_fence(std::memory_order_seq_cst);
+    if (unrecorded_.load(std::memory_order_acquire) != 0) return false;
+    for (auto* record = records_.load(std::memory_order_acquire); record;
+         record = record->next) {
+      auto const entered = record->epoch.load(std::memory_order_acquire);
+      if (entered != 0 && entered <= epoch) return false;
+    }
+    return true;
+  }
+
+  // retiredLock_ held. Moves what no reader can still hold to `out`.
+  void takeReclaimable(std::vector<Retired>& out) noexcept {
+    auto const safe = std::partition(retired_.begin(), retired_.end(),
+                                     [this](Retired const& r) { return !safeToFree(r.epoch); });
+    try {
+      out.assign(safe, retired_.end());
+      retired_.erase(safe, retired_.end());
+    } catch (...) {
+    }
+    pending_.store(retired_.size(), std::memory_order_relaxed);
+  }
+
+  /// A reader leaving its outermost guard. Without this, the copies
+  /// retired while it read would wait for the next retire, which may
+  /// never come once the handlers are bound. Skipped if the lock is
+  /// busy: whoever holds it is reclaiming already.
+  void reclaim() noexcept {
+    std::vector<Retired> reclaimable;
+    {
+      std::unique_lock<std::mutex> lk(retiredLock_, std::try_to_lock);
+      if (!lk.owns_lock()) return;
+      takeReclaimable(reclaimable);
+    }
+    for (auto const& r : reclaimable) r.deleter(r.object);
+  }
+
+  static ReadGuard::ThreadState& threadState(EpochDomain& domain) noexcept;
+
+  std::atomic<uint64_t> epoch_{1};
+  std::atomic<Record*> records_{nullptr};
+  std::atomic<uint32_t> unrecorded_{0};
+  std::mutex retiredLock_;
+  std::vector<Retired> retired_;
+  /// `retired_.size()`, readable without the lock.
+  std::atomic<size_t> pending_{0};
+};
+
+struct EpochDomain::ReadGuard::ThreadState {
+  Record* record = nullptr;
+  uint32_t depth = 0;
+  ~ThreadState() {
+    if (record) record->inUse.store(false, std::memory_order_release);
+  }
+};
+
+inline EpochDomain::ReadGuard::ThreadState& EpochDomain::threadState(EpochDomain& domain) noexcept {
+  thread_local ReadGuard::ThreadState state;
+  if (!state.record) state.record = domain.acquireRecord();
+  return state;
+}
+
+inline EpochDomain::ReadGuard::ReadGuard(EpochDomain& domain) noexcept
+    : domain_(domain), state_(threadState(domain)) {
+  if (state_.depth++ != 0) return;
+  if (state_.record) {
+    state_.record->epoch.store(domain.epoch_.load(std::memory_order_relaxed),
+                               std::memory_order_relaxed);
+  } else {
+    domain.unrecorded_.fetch_add(1, std::memory_order_relaxed);
+  }
+  // Pairs with the fences in retire(): either the writer
+  // sees this reader, or this reader sees the new pointer.
+  std::atomic_thread_fence(std::memory_order_seq_cst);
+}
+
+inline EpochDomain::ReadGuard::~ReadGuard() noexcept {
+  if (--state_.depth != 0) return;
+  if (state_.record) {
+    state_.record->epoch.store(0, std::memory_order_release);
+  } else {
+    domain_.unrecorded_.fetch_sub(1, std::memory_order_release);
+  }
+  if (domain_.pending_.load(std::memory_order_relaxed) != 0) domain_.reclaim();
+}
+
+/// An immutable `Slots` value published for lock-free reads.
+template <typename Slots>
+class SlotTable final {
+public:
+  /// Keeps the table it was created from alive; use it like a pointer.
+  class Snapshot final {
+  public:
+    Slots const* operator->() const noexcept { return slots_; }
+    Slots const& operator*() const noexcept { return *slots_; }
+
+  private:
+    friend class SlotTable;
+    explicit Snapshot(SlotTable const& table) noexcept
+        : guard_(EpochDomain::shared()),
+          slots_(table.current_.load(std::memory_order_acquire)) {}
+
+    EpochDomain::ReadGuard guard_;
+    Slots const* slots_;
+  };
+
+  SlotTable() : current_(new Slots()) {}
+
+  /// Retired rather than deleted: a callback may drop the last reference
+  /// to the adapter while it is still running inside a snapshot.
+  ~SlotTable() noexcept { retire(current_.load(std::memory_order_relaxed)); }
+
+  SlotTable(SlotTable const&) = delete;
+  SlotTable& operator=(SlotTable const&) = delete;
+
+  /// Any thread, wait-free once the thread has its epoch record.
+  Snapshot read() const noexcept { return Snapshot(*this); }
+
+  /// Whether `slot` held a block when last set. Any thread; a relaxed
+  /// load, so a notification racing a setter may go either way, as it
+  /// could before.
+  template <typename SlotT>
+  bool installed(SlotT Slots::* slot) const noexcept {
+    auto const index = slotIndex(slot);
+    return (installed_[index / 64].load(std::memory_order_relaxed) >> (index % 64)) & 1u;
+  }
+
+  /// Replace one slot, keeping `installed` in step.
+  template <typename SlotT, typename ValueT>
+  void set(SlotT Slots::* slot, ValueT&& value) noexcept {
+    update([&](Slots& slots) {
+      slots.*slot = std::forward<ValueT>(value);
+      auto const index = slotIndex(slot);
+      auto const bit = uint64_t{1} << (index % 64);
+      if (slots.*slot) {
+        installed_[index / 64].fetch_or(bit, std::memory_order_relaxed);
+      } else {
+        installed_[index / 64].fetch_and(~bit, std::memory_order_relaxed);
+      }
+    });
+  }
+
+  /// Reset every slot.
+  void clear() noexcept {
+    update([this](Slots& slots) {
+      slots = Slots{};
+      for (auto& word : installed_) word.store(0, std::memory_order_relaxed);
+    });
+  }
+
+  /// Publish a copy of the current slots changed by `fn(Slots&)`. Writers
+  /// are serialised; readers are never waited for. If the copy cannot be
+  /// allocated the update is dropped.
+  template <typename Fn>
+  void update(Fn&& fn) noexcept {
+    Slots* previous;
+    {
+      std::lock_guard<std::mutex> lg(writeLock_);
+      auto* const next = new (std::nothrow) Slots(*current_.load(std::memory_order_relaxed));
+      if (!next) return;
+      fn(*next);
+      previous = current_.exchange(next, std::memory_order_acq_rel);
+    }
+    // Outside the lock: reclaiming may release blocks whose captures
+    // rebind slots.
+    retire(previous);
+  }
+
+  /// Byte offset of `slot` within Slots. A data member pointer is an
+  /// offset; it is applied to a zeroed, aligned buffer rather than a live
+  /// table, and folds to a constant for a constant `slot`.
+  template <typename SlotT>
+  static size_t slotOffset(SlotT Slots::* slot) noexcept {
+    alignas(Slots) static unsigned char const probe[sizeof(Slots)] = {};
+    auto const* const base = reinterpret_cast<Slots const*>(probe);
+    return static_cast<size_t>(reinterpret_cast<unsigned char const*>(&(base->*slot)) - probe);
+  }
+
+private:
+  /// Slots are pointer-sized (Block<> is one pointer), so a member's
+  /// offset in pointers identifies it.
+  static constexpr size_t MaxSlots = sizeof(Slots) / sizeof(void*);
+  static_assert(sizeof(Slots) % sizeof(void*) == 0 && alignof(Slots) == alignof(void*),
+                "Slots must hold only pointer-sized members");
+
+  template <typename SlotT>
+  static size_t slotIndex(SlotT Slots::* slot) noexcept {
+    static_assert(sizeof(SlotT) == sizeof(void*) && alignof(SlotT) == alignof(void*),
+                  "slotIndex numbers slots by pointer-sized offset");
+    return slotOffset(slot) / sizeof(void*);
+  }
+
+  static void retire(Slots* slots) noexcept {
+    EpochDomain::shared().retire(slots,
+                                 [](void* object) { delete static_cast<Slots*>(object); });
+  }
+
+  std::atomic<Slots*> current_;
+  std::array<std::atomic<uint64_t>, (MaxSlots + 63) / 64> installed_{};
+  std::mutex writeLock_;
+};
+
+} // namespace AVDECCSwift
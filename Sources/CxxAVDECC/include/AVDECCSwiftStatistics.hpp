@@ -0,0 +1,221 @@
+/*
+ * Copyright (C) 2026, PADL Software Pty Ltd
+ *
+ * This file is part of AVDECCSwift.
+ *
+ * AVDECCSwift is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * AVDECCSwift is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with AVDECCSwift.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+// Lock-free instrumentation primitives shared by the executor (and, later,
+// other owners). Everything on the record path is a relaxed atomic RMW on
+// a counter the recording thread almost always owns the cache line of, so
+// the per-job cost is a clock read plus a handful of uncontended adds.
+//
+// Define AVDECCSWIFT_EXECUTOR_STATISTICS=0 (e.g. via `-Xcc -D...`) to
+// compile the recording out entirely: `monotonicNanos()` folds to 0 and
+// every record call to an empty inline body, and snapshots report
+// `enabled == false`.
+#pragma once
+
+#include <atomic>
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+
+#ifndef AVDECCSWIFT_EXECUTOR_STATISTICS
+#  define AVDECCSWIFT_EXECUTOR_STATISTICS 1
+#endif
+
+namespace AVDECCSwift {
+
+/// Number of log2 buckets per histogram. Bucket `i` (i > 0) counts samples
+/// in [2^(i-1), 2^i) nanoseconds; bucket 0 counts zero-length samples and
+/// the last bucket absorbs everything from ~1 s upward.
+constexpr size_t StatisticsHistogramBuckets = 32;
+
+/// Monotonic nanoseconds since an arbitrary epoch. steady_clock is a vDSO
+/// clock_gettime / mach_absolute_time on the platforms we ship, so no
+/// syscall on the hot path.
+inline uint64_t steadyNanos() noexcept {
+  return static_cast<uint64_t>(
+      std::chrono::duration_cast<std::chrono::nanoseconds>(
+          std::chrono::steady_clock::now().time_since_epoch())
+          .count());
+}
+
+/// `steadyNanos()` for statistics stamps; folds to 0 when statistics are
+/// compiled out. Code that needs a real time regardless (the stall
+/// watchdog) calls steadyNanos() directly.
+inline uint64_t monotonicNanos() noexcept {
+#if AVDECCSWIFT_EXECUTOR_STATISTICS
+  return steadyNanos();
+#else
+  return 0;
+#endif
+}
+
+/// Raise `target` to `value` if larger. The load-then-CAS shape means the
+/// common case (not a new maximum) is a single relaxed load.
+inline void atomicStoreMax(std::atomic<uint64_t>& target, uint64_t value) noexcept {
+  auto current = target.load(std::memory_order_relaxed);
+  while (value > current &&
+         !target.compare_exchange_weak(current, value, std::memory_order_relaxed)) {
+  }
+}
+
+/// Log2-bucketed latency histogram. Buckets are independent relaxed
+/// counters, so a concurrent `copyTo` may see a sample in `count` but not
+/// yet in its bucket (or vice versa); fine for monitoring.
+class Log2Histogram final {
+public:
+  static size_t bucketFor(uint64_t nanos) noexcept {
+    if (nanos == 0) return 0;
+    size_t const bit = 64 - static_cast<size_t>(__builtin_clzll(nanos));
+    return bit < StatisticsHistogramBuckets ? bit : StatisticsHistogramBuckets - 1;
+  }
+
+  void record(uint64_t nanos) noexcept {
+    buckets_[bucketFor(nanos)].fetch_add(1, std::memory_order_relaxed);
+    total_.fetch_add(nanos, std::memory_order_relaxed);
+    atomicStoreMax(max_, nanos);
+  }
+
+  void copyTo(uint64_t (&buckets)[StatisticsHistogramBuckets], uint64_t& total,
+              uint64_t& max) const noexcept {
+    for (size_t i = 0; i < StatisticsHistogramBuckets; ++i) {
+      buckets[i] = buckets_[i].load(std::memory_order_relaxed);
+    }
+    total = total_.load(std::memory_order_relaxed);
+    max = max_.load(std::memory_order_relaxed);
+  }
+
+private:
+  std::atomic<uint64_t> buckets_[StatisticsHistogramBuckets] = {};
+  std::atomic<uint64_t> total_{0};
+  std::atomic<uint64_t> max_{0};
+};
+
+/// Plain-data snapshot of an executor's counters. Crosses to Swift by
+/// value (the arrays import as fixed-size tuples); see
+/// `ExecutorOwner::statistics`.
+struct ExecutorStatistics {
+  /// False when built with AVDECCSWIFT_EXECUTOR_STATISTICS=0; every other
+  /// field is then zero.
+  bool enabled = false;
+  uint64_t jobsEnqueued = 0;
+  uint64_t jobsCompleted = 0;
+  /// Jobs discarded unrun by `terminate(flushJobs=false)`.
+  uint64_t jobsDropped = 0;
+  /// Jobs accepted but not yet started (or dropped).
+  uint64_t queueDepth = 0;
+  uint64_t queueDepthHighWater = 0;
+  /// Time since creation at which the snapshot was taken. With
+  /// `jobsCompleted` it gives any reader a rate over its own interval.
+  uint64_t uptimeNanos = 0;
+  /// Enqueue-to-start time.
+  uint64_t totalWaitNanos = 0;
+  uint64_t maxWaitNanos = 0;
+  uint64_t waitHistogram[StatisticsHistogramBuckets] = {};
+  /// Start-to-finish time.
+  uint64_t totalRunNanos = 0;
+  uint64_t maxRunNanos = 0;
+  uint64_t runHistogram[StatisticsHistogramBuckets] = {};
+  /// Jobs the stall watchdog reported (whole-executor snapshot only;
+  /// counted even with statistics compiled out).
+  uint64_t stalls = 0;
+  /// Job-node pool (whole-executor snapshots only; always counted).
+  /// `jobNodeHeapAllocations` is the number of submissions that reached
+  /// the global allocator and should stop moving once the pool has grown
+  /// to the executor's peak queue depth.
+  uint64_t jobNodeAcquisitions = 0;
+  uint64_t jobNodeHeapAllocations = 0;
+  uint64_t jobNodePoolCapacity = 0;
+};
+
+/// Live counters behind `ExecutorStatistics`. `jobEnqueued` is called by
+/// producers, `jobStarted`/`jobFinished` by whichever thread runs the job.
+class ExecutorCounters final {
+public:
+  ExecutorCounters() noexcept : createdAt_(monotonicNanos()) {}
+
+  void jobEnqueued() noexcept {
+#if AVDECCSWIFT_EXECUTOR_STATISTICS
+    enqueued_.fetch_add(1, std::memory_order_relaxed);
+    auto const depth = depth_.fetch_add(1, std::memory_order_relaxed) + 1;
+    atomicStoreMax(depthHighWater_, depth);
+#endif
+  }
+
+  /// `enqueuedAt` is the `monotonicNanos()` stamp taken at push time and
+  /// `now` the start stamp, passed in so one clock read can feed several
+  /// counter sets.
+  void jobStarted(uint64_t enqueuedAt, uint64_t now) noexcept {
+#if AVDECCSWIFT_EXECUTOR_STATISTICS
+    depth_.fetch_sub(1, std::memory_order_relaxed);
+    wait_.record(now > enqueuedAt ? now - enqueuedAt : 0);
+#else
+    (void)enqueuedAt;
+    (void)now;
+#endif
+  }
+
+  /// A queued job discarded without running; leaves the wait histogram
+  /// alone.
+  void jobDropped() noexcept {
+#if AVDECCSWIFT_EXECUTOR_STATISTICS
+    depth_.fetch_sub(1, std::memory_order_relaxed);
+    dropped_.fetch_add(1, std::memory_order_relaxed);
+#endif
+  }
+
+  void jobFinished(uint64_t startedAt, uint64_t now) noexcept {
+#if AVDECCSWIFT_EXECUTOR_STATISTICS
+    run_.record(now > startedAt ? now - startedAt : 0);
+    completed_.fetch_add(1, std::memory_order_relaxed);
+#else
+    (void)startedAt;
+    (void)now;
+#endif
+  }
+
+  void copyTo(ExecutorStatistics& out) const noexcept {
+#if AVDECCSWIFT_EXECUTOR_STATISTICS
+    out.enabled = true;
+    out.jobsEnqueued = enqueued_.load(std::memory_order_relaxed);
+    out.jobsCompleted = completed_.load(std::memory_order_relaxed);
+    out.jobsDropped = dropped_.load(std::memory_order_relaxed);
+    out.queueDepth = depth_.load(std::memory_order_relaxed);
+    out.queueDepthHighWater = depthHighWater_.load(std::memory_order_relaxed);
+    out.uptimeNanos = monotonicNanos() - createdAt_;
+    wait_.copyTo(out.waitHistogram, out.totalWaitNanos, out.maxWaitNanos);
+    run_.copyTo(out.runHistogram, out.totalRunNanos, out.maxRunNanos);
+#else
+    (void)out;
+#endif
+  }
+
+private:
+  uint64_t const createdAt_;
+  // Producer-side and consumer-side counters on separate lines so pushes
+  // from other threads don't bounce the executor's cache line.
+  alignas(64) std::atomic<uint64_t> enqueued_{0};
+  std::atomic<uint64_t> depth_{0};
+  std::atomic<uint64_t> depthHighWater_{0};
+  alignas(64) std::atomic<uint64_t> completed_{0};
+  std::atomic<uint64_t> dropped_{0};
+  Log2Histogram wait_;
+  Log2Histogram run_;
+};
+
+} // namespace AVDECCSwift
@@ -20,9 +20,29 @@
 // will fail to build with "cannot find type" errors that would normally
 // only surface in third-party consumers.
 import AVDECCSwift
+import Logging
 import XCTest
 
 final class AVDECCSwiftTests: XCTestCase {
+  // MARK: - Fixtures
+
+  /// A virtual protocol interface; interfaces with the same
+  /// `interfaceID` see each other's PDUs. Skips the test only if this
+  /// la_avdecc was built without the virtual transport; any other
+  /// failure is rethrown so it fails the test.
+  private func virtualInterface(
+    _ interfaceID: String,
+    executorName: String = DefaultExecutorName
+  ) throws -> ProtocolInterface {
+    do {
+      return try ProtocolInterface(
+        type: .virtual, interfaceID: interfaceID, executorName: executorName
+      )
+    } catch let error as ProtocolInterfaceError where error.code == .interfaceNotSupported {
+      throw XCTSkip("virtual protocol interface not available: \(error)")
+    }
+  }
+
   // MARK: - StreamFormat
 
   func test61883_6FormatString() async throws {
@@ -386,6 +406,1267 @@ final class AVDECCSwiftTests: XCTestCase {
     XCTAssertEqual(msg.payload, [0x00, 0x00, 0x00, 0x01])
   }
 
+  // MARK: - Executor
+
+  func testExecutorOptionsDefaults() {
+    let options = Executor.Options()
+    XCTAssertEqual(options.mode, .dispatch)
+    XCTAssertEqual(options.drainBatchLimit, 64)
+    XCTAssertEqual(Executor.Mode(rawValue: 1), .batched)
+    XCTAssertNil(Executor.Mode(rawValue: 0xFF))
+  }
+
+  func testBatchedExecutorCreateClose() throws {
+    let executor = try Executor(
+      name: "AVDECCSwiftTests.batched",
+      options: .init(mode: .batched, drainBatchLimit: 8)
+    )
+    XCTAssertEqual(executor.options.mode, .batched)
+    executor.close()
+    executor.close()
+  }
+
+  func testThreadExecutorCreateClose() throws {
+    let executor = try Executor(
+      name: "AVDECCSwiftTests.thread",
+      options: .init(mode: .thread)
+    )
+    XCTAssertEqual(executor.options.mode, .thread)
+    XCTAssertNil(executor.options.nice)
+    executor.close()
+  }
+
+  func testExecutorLanesRunSubmittedWork() throws {
+    let executor = try Executor(
+      name: "AVDECCSwiftTests.lanes",
+      options: .init(mode: .batched)
+    )
+    defer { executor.close() }
+    let bulk = expectation(description: "bulk")
+    let interactive = expectation(description: "interactive")
+    executor.async(lane: .bulk) { bulk.fulfill() }
+    executor.async(lane: .interactive) { interactive.fulfill() }
+    wait(for: [bulk, interactive], timeout: 5)
+    XCTAssertEqual(Executor.withLane(.interactive) { 42 }, 42)
+  }
+
+  /// Queues one explicit `.bulk` job, then one on the current lane, from
+  /// inside each received ACMP / ADP PDU's receive job.
+  final class _LaneOrderObserver: ProtocolInterfaceObserver {
+    let executor: Executor
+    let ran: XCTestExpectation
+    private let lock = NSLock()
+    private var order: [String] = []
+
+    init(executor: Executor, ran: XCTestExpectation) {
+      self.executor = executor
+      self.ran = ran
+    }
+
+    var ranOrder: [String] { lock.withLock { order } }
+
+    private func queue(_ kind: String) {
+      executor.async(lane: .bulk) { [self] in record("\(kind) bulk") }
+      executor.async(lane: Executor.currentLane) { [self] in record("\(kind) follow-up") }
+    }
+
+    private func record(_ label: String) {
+      lock.withLock { order.append(label) }
+      ran.fulfill()
+    }
+
+    func onAcmpduReceived(_: ProtocolInterface, pdu _: Acmpdu) { queue("acmp") }
+    func onAdpduReceived(_: ProtocolInterface, pdu _: Adpdu) { queue("adp") }
+  }
+
+  func testAcmpReceiptRunsAheadOfQueuedBulkWork() throws {
+    let executor = try Executor(
+      name: "AVDECCSwiftTests.acmpLane",
+      options: .init(mode: .batched, interactiveBurstLimit: 0)
+    )
+    defer { executor.close() }
+    let interfaceID = "AVDECCSwiftTests.acmpLane"
+    let target = try virtualInterface(interfaceID, executorName: executor.name)
+    let sender = try virtualInterface(interfaceID)
+    defer {
+      sender.close()
+      target.close()
+    }
+    XCTAssertTrue(target.prioritizesAcmp)
+    let ran = expectation(description: "follow-up work ran")
+    ran.expectedFulfillmentCount = 4
+    let observer = _LaneOrderObserver(executor: executor, ran: ran)
+    target.observer = observer
+    target.setPduFilter(.all, for: .acmp)
+    target.setPduFilter(.all, for: .adp)
+    XCTAssertEqual(Executor.currentLane, .bulk)
+
+    try sender.sendAcmpMessage(AcmpMessage(srcMac: [0x02, 0, 0, 0, 0, 1]))
+    try sender.sendAdpMessage(AdpMessage(srcMac: [0x02, 0, 0, 0, 0, 1]))
+    wait(for: [ran], timeout: 5)
+
+    let order = observer.ranOrder
+    func position(_ label: String) -> Int { order.firstIndex(of: label) ?? -1 }
+    // Queued second, from the ACMP receive job, yet run first.
+    XCTAssertLessThan(position("acmp follow-up"), position("acmp bulk"))
+    // Any other receive job's follow-up work keeps FIFO order.
+    XCTAssertLessThan(position("adp bulk"), position("adp follow-up"))
+  }
+
+  func testExecutorStallWatchdogReports() throws {
+    let executor = try Executor(
+      name: "AVDECCSwiftTests.watchdog",
+      options: .init(mode: .batched, stallThreshold: .milliseconds(20))
+    )
+    defer { executor.close() }
+    let reported = expectation(description: "stall reported")
+    reported.assertForOverFulfill = false
+    executor.setStallHandler { running, _ in
+      XCTAssertGreaterThanOrEqual(running, .milliseconds(20))
+      reported.fulfill()
+    }
+    executor.async { Thread.sleep(forTimeInterval: 0.2) }
+    wait(for: [reported], timeout: 5)
+    XCTAssertGreaterThanOrEqual(executor.statistics().stalls, 1)
+  }
+
+  func testExecutorSteadyStateSubmissionDoesNotAllocate() throws {
+    let executor = try Executor(
+      name: "AVDECCSwiftTests.pool",
+      options: .init(mode: .batched)
+    )
+    defer { executor.close() }
+    func roundTrip() {
+      let done = expectation(description: "round trip")
+      executor.async { done.fulfill() }
+      wait(for: [done], timeout: 5)
+    }
+    roundTrip()
+    let warm = executor.statistics().jobNodeHeapAllocations
+    for _ in 0..<100 { roundTrip() }
+    XCTAssertEqual(executor.statistics().jobNodeHeapAllocations, warm)
+  }
+
+  func testPooledExecutorsShareTargetPool() throws {
+    let options = Executor.Options(
+      mode: .batched, targetPool: "AVDECCSwiftTests.pool", targetPoolWidth: 2
+    )
+    let first = try Executor(name: "AVDECCSwiftTests.pooled.0", options: options)
+    defer { first.close() }
+    // The pool already exists, so this width is ignored.
+    var wider = options
+    wider.targetPoolWidth = 8
+    let second = try Executor(name: "AVDECCSwiftTests.pooled.1", options: wider)
+    defer { second.close() }
+    XCTAssertEqual(first.targetPoolWidth, 2)
+    XCTAssertEqual(second.targetPoolWidth, 2)
+
+    let done = expectation(description: "both ran")
+    done.expectedFulfillmentCount = 2
+    first.async { done.fulfill() }
+    second.async { done.fulfill() }
+    wait(for: [done], timeout: 5)
+
+    XCTAssertThrowsError(try Executor(
+      name: "AVDECCSwiftTests.pooled.thread",
+      options: .init(mode: .thread, targetPool: "AVDECCSwiftTests.pool")
+    ))
+  }
+
+  func testPooledExecutorFlushesAndClosesSiblingOnSharedQueue() throws {
+    // Width 1: both executors are rooted on the same serial pool queue.
+    let options = Executor.Options(
+      mode: .batched, targetPool: "AVDECCSwiftTests.pool.shared", targetPoolWidth: 1
+    )
+    let first = try Executor(name: "AVDECCSwiftTests.pool.shared.0", options: options)
+    defer { first.close() }
+    let second = try Executor(name: "AVDECCSwiftTests.pool.shared.1", options: options)
+    defer { second.close() }
+    XCTAssertEqual(first.targetPoolWidth, 1)
+
+    let lock = NSLock()
+    var ran = 0
+    var ranAtFlush = -1
+    var ranAtClose = -1
+    let done = expectation(description: "sibling flushed and closed")
+    first.async {
+      for _ in 0..<10 { second.async { lock.withLock { ran += 1 } } }
+      second.flush()
+      lock.withLock { ranAtFlush = ran }
+      for _ in 0..<10 { second.async { lock.withLock { ran += 1 } } }
+      second.close()
+      lock.withLock { ranAtClose = ran }
+      done.fulfill()
+    }
+    wait(for: [done], timeout: 5)
+    lock.withLock {
+      XCTAssertEqual(ranAtFlush, 10)
+      XCTAssertEqual(ranAtClose, 20)
+    }
+
+    XCTAssertThrowsError(try Executor(
+      name: "AVDECCSwiftTests.pool.shared.dispatch",
+      options: .init(mode: .dispatch, targetPool: "AVDECCSwiftTests.pool.shared")
+    ))
+  }
+
+  func testExecutorBringUpIsSharedUntilClosed() throws {
+    let name = "AVDECCSwiftTests.bringUp"
+    let first = try Executor.bringUp(name: name, options: .init(mode: .batched))
+    // Already up: the requested options are ignored and reported as-is.
+    let second = try Executor.bringUp(name: name)
+    XCTAssertEqual(second.options.mode, .batched)
+    XCTAssertEqual(second.options, first.options)
+
+    second.close()
+    let third = try Executor.bringUp(name: name)
+    defer { third.close() }
+    XCTAssertEqual(third.options.mode, .dispatch)
+  }
+
+  func testExecutorStatisticsSnapshotShape() throws {
+    let executor = try Executor(name: "AVDECCSwiftTests.statistics")
+    defer { executor.close() }
+    let stats = executor.statistics()
+    XCTAssertEqual(stats.waitHistogram.count, 32)
+    XCTAssertEqual(stats.runHistogram.count, 32)
+    XCTAssertLessThanOrEqual(stats.jobsCompleted, stats.jobsEnqueued)
+    XCTAssertGreaterThanOrEqual(stats.queueDepthHighWater, stats.queueDepth)
+  }
+
+  func testExecutorStatisticsCountQueuedAndCompletedJobs() throws {
+    let executor = try Executor(
+      name: "AVDECCSwiftTests.statistics.counts",
+      options: .init(mode: .batched)
+    )
+    defer { executor.close() }
+    guard executor.statistics().isEnabled else {
+      throw XCTSkip("built with AVDECCSWIFT_EXECUTOR_STATISTICS=0")
+    }
+
+    // Hold the executor in one job while ten more queue behind it.
+    let started = DispatchSemaphore(value: 0)
+    let release = DispatchSemaphore(value: 0)
+    executor.async {
+      started.signal()
+      release.wait()
+    }
+    started.wait()
+    for _ in 0..<10 { executor.async(lane: .interactive) {} }
+    let blocked = executor.statistics()
+    XCTAssertEqual(blocked.jobsEnqueued, 11)
+    XCTAssertEqual(blocked.queueDepth, 10)
+    XCTAssertEqual(blocked.queueDepthHighWater, 10)
+    XCTAssertEqual(executor.statistics(lane: .interactive).queueDepth, 10)
+
+    release.signal()
+    let deadline = ContinuousClock.now + .seconds(5)
+    var drained = executor.statistics()
+    while drained.jobsCompleted < 11, ContinuousClock.now < deadline {
+      Thread.sleep(forTimeInterval: 0.01)
+      drained = executor.statistics()
+    }
+    XCTAssertEqual(drained.jobsCompleted, 11)
+    XCTAssertEqual(drained.jobsDropped, 0)
+    XCTAssertEqual(drained.queueDepth, 0)
+    XCTAssertEqual(drained.waitHistogram.reduce(0, +), 11)
+    XCTAssertEqual(drained.runHistogram.reduce(0, +), 11)
+    XCTAssertEqual(executor.statistics(lane: .interactive).jobsCompleted, 10)
+    XCTAssertGreaterThan(drained.jobsPerSecond(since: blocked), 0)
+    XCTAssertEqual(drained.jobsPerSecond(since: drained), 0)
+  }
+
+  // MARK: - CallbackShards
+
+  func testCallbackShardsCreateFlush() throws {
+    let shards = try CallbackShards(count: 3, label: "AVDECCSwiftTests.shards")
+    XCTAssertEqual(shards.count, 3)
+    XCTAssertGreaterThanOrEqual(try CallbackShards().count, 1)
+    // Nothing queued: flush must return rather than wait.
+    shards.flush()
+  }
+
+  /// Records each tapped ADPDU's available index per entity.
+  final class _ShardOrderObserver: ProtocolInterfaceObserver {
+    let received: XCTestExpectation
+    private let lock = NSLock()
+    private var indices: [UniqueIdentifier: [UInt32]] = [:]
+
+    init(received: XCTestExpectation) { self.received = received }
+
+    var indicesByEntity: [UniqueIdentifier: [UInt32]] { lock.withLock { indices } }
+
+    func onAdpduReceived(_: ProtocolInterface, pdu: Adpdu) {
+      lock.withLock { indices[pdu.entityID, default: []].append(pdu.availableIndex) }
+      received.fulfill()
+    }
+  }
+
+  func testCallbackShardsKeepPerEntityOrder() throws {
+    let interfaceID = "AVDECCSwiftTests.shards.order"
+    let target = try virtualInterface(interfaceID)
+    let sender = try virtualInterface(interfaceID)
+    defer {
+      sender.close()
+      target.close()
+    }
+    let entities = (1...4).map { UniqueIdentifier(0x0001_0000_0000_0000 + UInt64($0)) }
+    let perEntity: UInt32 = 50
+    let received = expectation(description: "all ADPDUs delivered")
+    received.expectedFulfillmentCount = entities.count * Int(perEntity)
+    let shards = try CallbackShards(count: 3, label: "AVDECCSwiftTests.shards.order")
+    let observer = _ShardOrderObserver(received: received)
+    target.callbackShards = shards
+    target.observer = observer
+    target.setPduFilter(PduFilter(entityIDs: Set(entities)), for: .adp)
+
+    // Interleave entities so each shard sees several of them.
+    let message = AdpMessage(srcMac: [0x02, 0, 0, 0, 0, 1])
+    for index in 0..<perEntity {
+      for entity in entities {
+        message.entityID = entity
+        message.availableIndex = index
+        try sender.sendAdpMessage(message)
+      }
+    }
+    wait(for: [received], timeout: 10)
+    shards.flush()
+
+    let delivered = observer.indicesByEntity
+    XCTAssertEqual(Set(delivered.keys), Set(entities))
+    for entity in entities {
+      XCTAssertEqual(delivered[entity], Array(0..<perEntity), "\(entity)")
+    }
+  }
+
+  /// Records the entity model ID of each online and forwarded update.
+  final class _EntityUpdateObserver: ProtocolInterfaceObserver {
+    let received: XCTestExpectation
+    private let lock = NSLock()
+    private var onlineModels: [UniqueIdentifier] = []
+    private var updatedModels: [UniqueIdentifier] = []
+
+    init(received: XCTestExpectation) { self.received = received }
+
+    var online: [UniqueIdentifier] { lock.withLock { onlineModels } }
+    var updated: [UniqueIdentifier] { lock.withLock { updatedModels } }
+
+    func onRemoteEntityOnline(_: ProtocolInterface, entity: Entity) {
+      lock.withLock { onlineModels.append(entity.entityModelID) }
+      received.fulfill()
+    }
+
+    func onRemoteEntityUpdated(_: ProtocolInterface, entity: Entity) {
+      lock.withLock { updatedModels.append(entity.entityModelID) }
+      received.fulfill()
+    }
+  }
+
+  func testEntityUpdateFilterSuppressesUnchangedAdvertisements() throws {
+    let interfaceID = "AVDECCSwiftTests.entityUpdate.filter"
+    let target = try virtualInterface(interfaceID)
+    let sender = try virtualInterface(interfaceID)
+    defer {
+      sender.close()
+      target.close()
+    }
+    // Online, then the changed update that ends the run.
+    let received = expectation(description: "online and changed update")
+    received.expectedFulfillmentCount = 2
+    let observer = _EntityUpdateObserver(received: received)
+    target.observer = observer
+    target.entityUpdateFilter = .significant
+
+    // Only the available index moves in the first three re-advertisements,
+    // which la_avdecc still raises as updates; the last changes the model.
+    let firstModel = UniqueIdentifier(0x0001_0000_0000_0A00)
+    let secondModel = UniqueIdentifier(0x0001_0000_0000_0A01)
+    let message = AdpMessage(srcMac: [0x02, 0, 0, 0, 0, 4])
+    message.entityID = UniqueIdentifier(0x0001_0000_0000_0300)
+    message.entityModelID = firstModel
+    for index in 0..<4 {
+      message.availableIndex = UInt32(index)
+      try sender.sendAdpMessage(message)
+    }
+    message.entityModelID = secondModel
+    message.availableIndex = 4
+    try sender.sendAdpMessage(message)
+    wait(for: [received], timeout: 5)
+
+    // Updates are handled in order, so the unchanged ones were counted
+    // before the changed one was forwarded.
+    XCTAssertEqual(observer.online, [firstModel])
+    XCTAssertEqual(observer.updated, [secondModel])
+    let statistics = target.entityUpdateStatistics
+    XCTAssertEqual(statistics.forwarded, 1)
+    XCTAssertEqual(statistics.suppressed, 3)
+  }
+
+  func testEmptyCallbackProfile() {
+    let empty = CallbackProfile()
+    XCTAssertTrue(empty.entries.isEmpty)
+    XCTAssertNil(empty["onEntityOnline"])
+    XCTAssertEqual(empty.since(empty), empty)
+    XCTAssertTrue(empty.byTotalTime.isEmpty)
+  }
+
+  /// Fulfills `received` once per ADPDU.
+  final class _CountingAdpObserver: ProtocolInterfaceObserver {
+    let received: XCTestExpectation
+
+    init(received: XCTestExpectation) { self.received = received }
+
+    func onAdpduReceived(_: ProtocolInterface, pdu _: Adpdu) { received.fulfill() }
+  }
+
+  func testCallbackProfileCountsOneSlot() throws {
+    let interfaceID = "AVDECCSwiftTests.profile"
+    let target = try virtualInterface(interfaceID)
+    let sender = try virtualInterface(interfaceID)
+    defer {
+      sender.close()
+      target.close()
+    }
+    let count = 20
+    let received = expectation(description: "all ADPDUs delivered")
+    received.expectedFulfillmentCount = count
+    // Flushing the shard waits for the timed calls, not just the handlers.
+    let shards = try CallbackShards(count: 1, label: "AVDECCSwiftTests.profile")
+    target.callbackShards = shards
+    target.observer = _CountingAdpObserver(received: received)
+    target.setPduFilter(.all, for: .adp)
+    XCTAssertTrue(target.callbackProfile().entries.isEmpty)
+    target.isCallbackProfilingEnabled = true
+    XCTAssertTrue(target.isCallbackProfilingEnabled)
+
+    // ENTITY_DISCOVER with no local entity to answer: only the tap fires.
+    let message = AdpMessage(srcMac: [0x02, 0, 0, 0, 0, 7])
+    message.messageType = .entityDiscover
+    for _ in 0..<count {
+      try sender.sendAdpMessage(message)
+    }
+    wait(for: [received], timeout: 5)
+    shards.flush()
+
+    let profile = target.callbackProfile()
+    // Slots never invoked are left out, so this is also every other
+    // slot staying at zero.
+    XCTAssertEqual(Array(profile.entries.keys), ["onAdpduReceived"])
+    let entry = try XCTUnwrap(profile["onAdpduReceived"])
+    XCTAssertEqual(entry.invocations, UInt64(count))
+    XCTAssertEqual(entry.histogram.reduce(0, +), UInt64(count))
+    XCTAssertLessThanOrEqual(entry.maxTime, entry.totalTime)
+    XCTAssertEqual(profile.since(profile), CallbackProfile())
+  }
+
+  // MARK: - CallbackEvents
+
+  func testCallbackEventOverflowNumbering() {
+    // Raw values are AVDECCSwift::CallbackEventOverflow's.
+    XCTAssertEqual(CallbackEventOverflow.dropOldest.rawValue, 0)
+    XCTAssertEqual(CallbackEventOverflow.dropNewest.rawValue, 1)
+    XCTAssertEqual(CallbackEventOverflow.coalesce.rawValue, 2)
+    XCTAssertEqual(CallbackEvent.Argument.integer(42).integer, 42)
+    XCTAssertNil(CallbackEvent.Argument.bool(true).integer)
+    XCTAssertNotEqual(CallbackEvent.Argument.mappings([]), .counters([]))
+  }
+
+  func testCallbackEventRingOverflowPolicies() async throws {
+    let interfaceID = "AVDECCSwiftTests.events.overflow"
+    let target = try virtualInterface(interfaceID)
+    let sender = try virtualInterface(interfaceID)
+    defer { sender.close() }
+    let oldest = try target.events(bufferDepth: 2, overflow: .dropOldest)
+    let newest = try target.events(bufferDepth: 2, overflow: .dropNewest)
+    let coalescing = try target.events(bufferDepth: 2, overflow: .coalesce)
+    // Parked on an empty ring before anything is sent, so the first event
+    // has to come through the ready block.
+    let live = try target.events(bufferDepth: 2, overflow: .dropNewest)
+    let liveNames = Task {
+      var names = [String]()
+      for await event in live { names.append(event.name) }
+      return names
+    }
+    try await Task.sleep(for: .milliseconds(100))
+
+    // The observer runs after the streams record, so once it has seen all
+    // five events every ring has too.
+    let received = expectation(description: "all events raised")
+    received.expectedFulfillmentCount = 5
+    target.observer = _EntityUpdateObserver(received: received)
+    let (a, b, c) = (
+      UniqueIdentifier(0x0001_0000_0000_0400), UniqueIdentifier(0x0001_0000_0000_0401),
+      UniqueIdentifier(0x0001_0000_0000_0402)
+    )
+    // Online a, b and c, then two updates of a.
+    let message = AdpMessage(srcMac: [0x02, 0, 0, 0, 0, 5])
+    for (entity, index) in [(a, 0), (b, 0), (c, 0), (a, 1), (a, 2)] as [(UniqueIdentifier, UInt32)] {
+      message.entityID = entity
+      message.availableIndex = index
+      try sender.sendAdpMessage(message)
+    }
+    await fulfillment(of: [received], timeout: 5)
+    // Closing finishes every stream once its buffered events are read.
+    target.close()
+
+    func drain(_ events: CallbackEvents) async -> [String] {
+      var drained = [String]()
+      for await event in events {
+        drained.append("\(event.name) \(event.entityID)")
+      }
+      return drained
+    }
+    let online = "onRemoteEntityOnline", updated = "onRemoteEntityUpdated"
+
+    let keptNewest = await drain(oldest)
+    XCTAssertEqual(keptNewest, ["\(updated) \(a)", "\(updated) \(a)"])
+    XCTAssertEqual(oldest.recorded, 5)
+    XCTAssertEqual(oldest.dropped, 3)
+    XCTAssertEqual(oldest.coalesced, 0)
+
+    let keptOldest = await drain(newest)
+    XCTAssertEqual(keptOldest, ["\(online) \(a)", "\(online) \(b)"])
+    XCTAssertEqual(newest.recorded, 2)
+    XCTAssertEqual(newest.dropped, 3)
+
+    // c's online pushes out a's, a's first update pushes out b's, and the
+    // second update replaces the first.
+    let kept = await drain(coalescing)
+    XCTAssertEqual(kept, ["\(online) \(c)", "\(updated) \(a)"])
+    XCTAssertEqual(coalescing.recorded, 4)
+    XCTAssertEqual(coalescing.dropped, 2)
+    XCTAssertEqual(coalescing.coalesced, 1)
+
+    let names = await liveNames.value
+    XCTAssertEqual(names.first, online)
+    XCTAssertEqual(UInt64(names.count) + live.dropped, 5)
+  }
+
+  // MARK: - PduFilter
+
+  func testPduFilterDefaultsAndTapNumbering() {
+    // Raw values are AVDECCSwift::PduTapKind's.
+    XCTAssertEqual(PduTap.allCases.map(\.rawValue), [0, 1, 2])
+    XCTAssertEqual(PduFilter(), .all)
+    XCTAssertTrue(PduFilter.all.entityIDs.isEmpty)
+    XCTAssertNotEqual(PduFilter(commandTypes: [0x24]), .all)
+    XCTAssertEqual(
+      PduFilter(entityIDs: [UniqueIdentifier(1)]).entityIDs, [UniqueIdentifier(1)]
+    )
+  }
+
+  /// Records the entity of each tapped ADPDU; a tapped ACMPDU marks the
+  /// end of a run.
+  final class _TapObserver: ProtocolInterfaceObserver {
+    let adpReceived: XCTestExpectation
+    let acmpReceived: XCTestExpectation
+    private let lock = NSLock()
+    private var entities: [UniqueIdentifier] = []
+
+    init(adpReceived: XCTestExpectation, acmpReceived: XCTestExpectation) {
+      self.adpReceived = adpReceived
+      self.acmpReceived = acmpReceived
+    }
+
+    var adpEntities: [UniqueIdentifier] { lock.withLock { entities } }
+
+    func onAdpduReceived(_: ProtocolInterface, pdu: Adpdu) {
+      lock.withLock { entities.append(pdu.entityID) }
+      adpReceived.fulfill()
+    }
+
+    func onAcmpduReceived(_: ProtocolInterface, pdu _: Acmpdu) {
+      acmpReceived.fulfill()
+    }
+  }
+
+  func testPduTapCountsMatchedAndRejected() throws {
+    let interfaceID = "AVDECCSwiftTests.pduTap.filter"
+    let target = try virtualInterface(interfaceID)
+    let sender = try virtualInterface(interfaceID)
+    defer {
+      sender.close()
+      target.close()
+    }
+    let adpReceived = expectation(description: "matching ADPDUs")
+    adpReceived.expectedFulfillmentCount = 2
+    let acmpReceived = expectation(description: "end of the unmatchable run")
+    let observer = _TapObserver(adpReceived: adpReceived, acmpReceived: acmpReceived)
+    target.observer = observer
+    let (a, b) = (UniqueIdentifier(0x0001_0000_0000_0500), UniqueIdentifier(0x0001_0000_0000_0501))
+    let message = AdpMessage(srcMac: [0x02, 0, 0, 0, 0, 6])
+    func advertise(_ entity: UniqueIdentifier, index: UInt32) throws {
+      message.entityID = entity
+      message.availableIndex = index
+      try sender.sendAdpMessage(message)
+    }
+
+    // ENTITY_AVAILABLE from a only: b's advertisement, between a's two,
+    // is rejected in C++.
+    target.setPduFilter(PduFilter(entityIDs: [a], messageTypes: [0]), for: .adp)
+    try advertise(a, index: 0)
+    try advertise(b, index: 0)
+    try advertise(a, index: 1)
+    wait(for: [adpReceived], timeout: 5)
+    XCTAssertEqual(observer.adpEntities, [a, a])
+    XCTAssertTrue(target.pduTapStatistics(.adp) == (matched: 2, rejected: 1))
+
+    // No message type is 32 or more, so this filter passes nothing. The
+    // ACMPDU sent after the ADPDUs marks when they have been tested.
+    target.setPduFilter(PduFilter(messageTypes: [32, 200]), for: .adp)
+    target.setPduFilter(.all, for: .acmp)
+    try advertise(a, index: 2)
+    try advertise(b, index: 1)
+    try sender.sendAcmpMessage(AcmpMessage(srcMac: [0x02, 0, 0, 0, 0, 6]))
+    wait(for: [acmpReceived], timeout: 5)
+    XCTAssertEqual(observer.adpEntities, [a, a])
+    XCTAssertTrue(target.pduTapStatistics(.adp) == (matched: 2, rejected: 3))
+    XCTAssertTrue(target.pduTapStatistics(.acmp) == (matched: 1, rejected: 0))
+  }
+
+  // MARK: - PduCapture
+
+  func testPduCaptureWritesSectionHeaderAndRejectsSecondStart() throws {
+    // The virtual transport needs no network interface.
+    let pi = try virtualInterface("AVDECCSwiftTests.capture")
+    defer { pi.close() }
+    XCTAssertEqual(pi.pduCaptureStatistics.files, 0)
+    XCTAssertThrowsError(
+      try pi.startPduCapture(path: "/nonexistent-directory/avdecc.pcapng")
+    ) { error in
+      XCTAssertEqual((error as? ProtocolInterfaceError)?.code, .internalError)
+    }
+
+    let path = "/tmp/AVDECCSwiftTests-\(getpid()).pcapng"
+    defer { unlink(path) }
+    try pi.startPduCapture(path: path, bufferDepth: 16)
+    XCTAssertTrue(pi.pduCaptureStatistics.isRunning)
+    XCTAssertThrowsError(try pi.startPduCapture(path: path)) { error in
+      XCTAssertEqual((error as? ProtocolInterfaceError)?.code, .invalidParameters)
+    }
+    pi.stopPduCapture()
+
+    let stats = pi.pduCaptureStatistics
+    XCTAssertFalse(stats.isRunning)
+    XCTAssertEqual(stats.files, 1)
+    XCTAssertEqual(stats.dropped, 0)
+    let data = try Data(contentsOf: URL(fileURLWithPath: path))
+    XCTAssertEqual(UInt64(data.count), stats.bytesWritten)
+    XCTAssertEqual(Array(data.prefix(4)), [0x0A, 0x0D, 0x0D, 0x0A])
+  }
+
+  /// The Enhanced Packet Blocks of a pcapng file written in this host's
+  /// byte order, as PduCapture writes them.
+  struct _PcapngPacket {
+    let timestampNanos: UInt64
+    let frame: [UInt8]
+    /// epb_flags, if present.
+    let flags: UInt32?
+
+    static func read(_ data: Data) -> [_PcapngPacket] {
+      let bytes = [UInt8](data)
+      func u16(_ at: Int) -> Int {
+        Int(bytes.withUnsafeBytes { $0.loadUnaligned(fromByteOffset: at, as: UInt16.self) })
+      }
+      func u32(_ at: Int) -> UInt32 {
+        bytes.withUnsafeBytes { $0.loadUnaligned(fromByteOffset: at, as: UInt32.self) }
+      }
+      var packets = [_PcapngPacket]()
+      var at = 0
+      while at + 12 <= bytes.count {
+        let length = Int(u32(at + 4))
+        guard length >= 12, at + length <= bytes.count else { break }
+        if u32(at) == 6 {
+          let captured = Int(u32(at + 20))
+          var flags: UInt32?
+          var option = at + 28 + (captured + 3) & ~3
+          while option + 4 <= at + length - 4, u16(option) != 0 {
+            if u16(option) == 2 { flags = u32(option + 4) }
+            option += 4 + (u16(option + 2) + 3) & ~3
+          }
+          packets.append(_PcapngPacket(
+            timestampNanos: UInt64(u32(at + 12)) << 32 | UInt64(u32(at + 16)),
+            frame: Array(bytes[(at + 28)..<(at + 28 + captured)]),
+            flags: flags
+          ))
+        }
+        at += length
+      }
+      return packets
+    }
+  }
+
+  func testPduCaptureRecordsSentPduAsOutbound() throws {
+    let pi = try virtualInterface("AVDECCSwiftTests.capture.sent")
+    defer { pi.close() }
+    let path = "/tmp/AVDECCSwiftTests-sent-\(getpid()).pcapng"
+    defer { unlink(path) }
+    try pi.startPduCapture(path: path, bufferDepth: 16)
+
+    let message = AdpMessage(srcMac: [0x02, 0, 0, 0, 0, 7])
+    message.entityID = UniqueIdentifier(0x0001_0000_0000_0600)
+    let before = UInt64(Date().timeIntervalSince1970 * 1e9)
+    try pi.sendAdpMessage(message)
+    let after = UInt64(Date().timeIntervalSince1970 * 1e9)
+    pi.stopPduCapture()
+
+    let stats = pi.pduCaptureStatistics
+    let packets = _PcapngPacket.read(try Data(contentsOf: URL(fileURLWithPath: path)))
+    XCTAssertEqual(UInt64(packets.count), stats.written)
+    XCTAssertEqual(stats.captured, stats.written)
+    // epb_flags direction 2: outbound.
+    let sent = packets.filter { $0.flags == 2 }
+    XCTAssertEqual(sent.count, 1)
+    guard let packet = sent.first else { return }
+    // Stamped on the way out; the clock's resolution may put it a tick
+    // either side of Date's.
+    XCTAssertGreaterThanOrEqual(packet.timestampNanos + 1_000_000, before)
+    XCTAssertLessThanOrEqual(packet.timestampNanos, after + 1_000_000)
+    // Source MAC, then the AVTP ethertype.
+    XCTAssertEqual(Array(packet.frame[6..<14]), [0x02, 0, 0, 0, 0, 7, 0x22, 0xF0])
+  }
+
+  func testPduReplayOfEmptyCaptureFinishes() throws {
+    let pi = try virtualInterface("AVDECCSwiftTests.replay")
+    defer { pi.close() }
+    XCTAssertThrowsError(
+      try PduReplay(path: "/nonexistent-directory/avdecc.pcapng", into: pi)
+    ) { error in
+      XCTAssertEqual((error as? ProtocolInterfaceError)?.code, .internalError)
+    }
+
+    let path = "/tmp/AVDECCSwiftTests-replay-\(getpid()).pcapng"
+    defer { unlink(path) }
+    try pi.startPduCapture(path: path)
+    pi.stopPduCapture()
+
+    let replay = try PduReplay(path: path, into: pi, speed: 0)
+    XCTAssertThrowsError(try PduReplay(path: path, into: pi)) { error in
+      XCTAssertEqual((error as? ProtocolInterfaceError)?.code, .invalidParameters)
+    }
+    XCTAssertTrue(replay.wait(timeout: .seconds(5)))
+    let stats = replay.statistics
+    XCTAssertFalse(stats.isRunning)
+    XCTAssertEqual(stats.frames, 0)
+    XCTAssertEqual(stats.injected, 0)
+    XCTAssertEqual(stats.readError, 0)
+    replay.stop()
+    // Detached: a new replay may attach.
+    try PduReplay(path: path, into: pi, speed: 0).stop()
+  }
+
+  func testPduReplaySkipsOutboundUnlessIncluded() throws {
+    let source = try virtualInterface("AVDECCSwiftTests.replay.source")
+    let target = try virtualInterface("AVDECCSwiftTests.replay.target")
+    defer {
+      target.close()
+      source.close()
+    }
+    let path = "/tmp/AVDECCSwiftTests-replay-sent-\(getpid()).pcapng"
+    defer { unlink(path) }
+    let entity = UniqueIdentifier(0x0001_0000_0000_0700)
+    try source.startPduCapture(path: path)
+    let message = AdpMessage(srcMac: [0x02, 0, 0, 0, 0, 8])
+    message.entityID = entity
+    message.availableIndex = 7
+    try source.sendAdpMessage(message)
+    source.stopPduCapture()
+    XCTAssertEqual(source.pduCaptureStatistics.written, 1)
+
+    let received = expectation(description: "replayed ADPDU")
+    let observer = _ShardOrderObserver(received: received)
+    target.observer = observer
+    target.setPduFilter(.all, for: .adp)
+
+    // What the source sent is its own side of the conversation: skipped.
+    let skipping = try PduReplay(path: path, into: target, speed: 0)
+    XCTAssertTrue(skipping.wait(timeout: .seconds(5)))
+    let skipped = skipping.statistics
+    XCTAssertEqual(skipped.frames, 1)
+    XCTAssertEqual(skipped.skipped, 1)
+    XCTAssertEqual(skipped.injected, 0)
+    skipping.stop()
+
+    let replay = try PduReplay(path: path, into: target, speed: 0, includeOutbound: true)
+    XCTAssertTrue(replay.wait(timeout: .seconds(5)))
+    wait(for: [received], timeout: 5)
+    let stats = replay.statistics
+    XCTAssertEqual(stats.frames, 1)
+    XCTAssertEqual(stats.injected, 1)
+    XCTAssertEqual(stats.skipped, 0)
+    // Counted as the observer's tap saw it, before the observer ran.
+    XCTAssertEqual(stats.processed, 1)
+    XCTAssertEqual(stats.unmatched, 0)
+    XCTAssertEqual(observer.indicesByEntity, [entity: [7]])
+    replay.stop()
+  }
+
+  // MARK: - DelegateDelivery
+
+  func testDelegateDeliveryDefaults() {
+    // Delivery needs a live entity; check the settings surface only.
+    XCTAssertEqual(DelegateDelivery.batched(), .batched(interval: nil, maxEvents: 4096))
+    XCTAssertNotEqual(DelegateDelivery.batched(), .immediate)
+    XCTAssertNotEqual(
+      DelegateDelivery.batched(interval: .milliseconds(5)), .batched(interval: nil)
+    )
+  }
+
+  /// Records each batch, and whether `onEntityOnline` ran from a batch's
+  /// replay or directly.
+  final class _BatchDelegate: LocalEntityDelegate {
+    struct Recorded: Equatable {
+      let name: String
+      let entityID: UniqueIdentifier
+    }
+
+    let online: XCTestExpectation
+    private let lock = NSLock()
+    private var recordedBatches: [[Recorded]] = []
+    private var replayedIDs: [UniqueIdentifier] = []
+    private var directIDs: [UniqueIdentifier] = []
+    private var replaying = false
+
+    init(online: XCTestExpectation) { self.online = online }
+
+    var batches: [[Recorded]] { lock.withLock { recordedBatches } }
+    var replayed: [UniqueIdentifier] { lock.withLock { replayedIDs } }
+    var direct: [UniqueIdentifier] { lock.withLock { directIDs } }
+
+    func onDelegateEvents(_: LocalEntity, events: DelegateEvents) {
+      let recorded = events.map { Recorded(name: $0.name, entityID: $0.entityID) }
+      lock.withLock {
+        recordedBatches.append(recorded)
+        replaying = true
+      }
+      for event in events { event.deliver() }
+      lock.withLock { replaying = false }
+    }
+
+    func onEntityOnline(_: LocalEntity, id: UniqueIdentifier, entity _: Entity) {
+      lock.withLock {
+        if replaying {
+          replayedIDs.append(id)
+        } else {
+          directIDs.append(id)
+        }
+      }
+      online.fulfill()
+    }
+  }
+
+  func testBatchedDelegateDeliveryReplaysOneBatch() throws {
+    let interfaceID = "AVDECCSwiftTests.delegate.batched"
+    let pi = try virtualInterface(interfaceID)
+    let sender = try virtualInterface(interfaceID)
+    defer {
+      sender.close()
+      pi.close()
+    }
+    let entity = try LocalEntity(
+      protocolInterface: pi, entityID: UniqueIdentifier(0x0001_0000_0000_00F0)
+    )
+    defer { entity.close() }
+    let remotes = (1...3).map { UniqueIdentifier(0x0001_0000_0000_0100 + UInt64($0)) }
+    let online = expectation(description: "remote entities online")
+    online.expectedFulfillmentCount = remotes.count
+    let delegate = _BatchDelegate(online: online)
+    entity.delegate = delegate
+    // Long enough that every event below lands in the first batch.
+    entity.delegateDelivery = .batched(interval: .milliseconds(500))
+
+    let message = AdpMessage(srcMac: [0x02, 0, 0, 0, 0, 2])
+    for remote in remotes {
+      message.entityID = remote
+      try sender.sendAdpMessage(message)
+    }
+    wait(for: [online], timeout: 5)
+
+    XCTAssertEqual(delegate.batches, [remotes.map { .init(name: "onEntityOnline", entityID: $0) }])
+    XCTAssertEqual(delegate.replayed, remotes)
+    XCTAssertEqual(delegate.direct, [])
+    let statistics = entity.delegateBatchStatistics
+    XCTAssertEqual(statistics.events, UInt64(remotes.count))
+    XCTAssertEqual(statistics.batches, 1)
+    entity.delegateDelivery = .immediate
+    XCTAssertEqual(entity.delegateBatchStatistics.batches, 0)
+  }
+
+  func testCoalescedDelegateEventNumbering() {
+    // Raw values are the event numbers LocalEntityOwner switches on.
+    XCTAssertEqual(CoalescedDelegateEvent.allCases.map(\.rawValue), Array(0...6))
+    XCTAssertEqual(CoalescedDelegateEvent(rawValue: 6), .operationStatus)
+    XCTAssertNil(CoalescedDelegateEvent(rawValue: 7))
+  }
+
+  /// Records the first entity counter of each `onEntityCountersChanged`.
+  final class _CountersDelegate: LocalEntityDelegate {
+    let delivered: XCTestExpectation
+    private let lock = NSLock()
+    private var recorded: [UInt32] = []
+
+    init(delivered: XCTestExpectation) { self.delivered = delivered }
+
+    var values: [UInt32] { lock.withLock { recorded } }
+
+    func onEntityCountersChanged(
+      _: LocalEntity, id _: UniqueIdentifier,
+      valid _: EntityCounterValidFlags, counters: DescriptorCounters
+    ) {
+      lock.withLock { recorded.append(counters[0]) }
+      delivered.fulfill()
+    }
+  }
+
+  func testCoalescingDeliversFirstAndLatestCounters() throws {
+    let interfaceID = "AVDECCSwiftTests.delegate.coalesced"
+    let pi = try virtualInterface(interfaceID)
+    let sender = try virtualInterface(interfaceID)
+    defer {
+      sender.close()
+      pi.close()
+    }
+    let controllerID = UniqueIdentifier(0x0001_0000_0000_00F1)
+    let entity = try LocalEntity(protocolInterface: pi, entityID: controllerID)
+    defer { entity.close() }
+    // Nothing is allocated, or counted, until coalescing is first enabled.
+    XCTAssertEqual(entity.coalescingStatistics.events, 0)
+    XCTAssertEqual(entity.coalescingStatistics.deliveries, 0)
+
+    // The first value goes through at once; the rest of the burst is
+    // folded into the latest one, delivered when the interval ends.
+    let delivered = expectation(description: "first and latest counters")
+    delivered.expectedFulfillmentCount = 2
+    let delegate = _CountersDelegate(delivered: delivered)
+    entity.delegate = delegate
+    entity.setCoalescing(.entityCounters, interval: .milliseconds(500))
+
+    let burst: [UInt32] = [1, 2, 3, 4, 5]
+    for (sequence, value) in burst.enumerated() {
+      // GET_COUNTERS: descriptor type and index (ENTITY 0), valid flags,
+      // then 32 big-endian counters.
+      var payload: [UInt8] = [0, 0, 0, 0, 0x80, 0, 0, 0]
+      payload += withUnsafeBytes(of: value.bigEndian, Array.init)
+      payload += [UInt8](repeating: 0, count: 31 * 4)
+      try sender.sendAecpMessage(AemAecpMessage(
+        isResponse: true, srcMac: [0x02, 0, 0, 0, 0, 3], destMac: pi.macAddressBytes,
+        targetEntityID: UniqueIdentifier(0x0001_0000_0000_0200), controllerEntityID: controllerID,
+        sequenceID: UInt16(sequence), unsolicited: true, commandType: .getCounters,
+        payload: payload
+      ))
+    }
+    wait(for: [delivered], timeout: 5)
+
+    XCTAssertEqual(delegate.values, [1, 5])
+    let statistics = entity.coalescingStatistics
+    XCTAssertEqual(statistics.events, UInt64(burst.count))
+    XCTAssertEqual(statistics.deliveries, 2)
+    entity.setCoalescing(.entityCounters, interval: nil)
+  }
+
+  func testEntityUpdateFieldsSignificantExcludesPerAdvertisementFields() {
+    XCTAssertFalse(EntityUpdateFields.significant.contains(.availableIndex))
+    XCTAssertFalse(EntityUpdateFields.significant.contains(.validTime))
+    XCTAssertTrue(EntityUpdateFields.significant.contains([.gptp, .associationID]))
+    XCTAssertEqual(EntityUpdateFields.significant.rawValue, (1 << 9) - 1)
+  }
+
+  // MARK: - Logger
+
+  /// What a Logger forwarded to swift-log. With `holdingFirst`, the first
+  /// item parks its forwarding thread until `release()`, so a test can
+  /// fill a ring behind it.
+  final class _LogSink: @unchecked Sendable {
+    struct Item: Equatable {
+      let level: Logging.Logger.Level
+      let layer: String
+      let message: String
+    }
+
+    private let lock = NSLock()
+    private var recorded: [Item] = []
+    private let holdingFirst: Bool
+    private let held = DispatchSemaphore(value: 0)
+    private let released = DispatchSemaphore(value: 0)
+
+    init(holdingFirst: Bool = false) { self.holdingFirst = holdingFirst }
+
+    var items: [Item] { lock.withLock { recorded } }
+    var messages: [String] { items.map(\.message) }
+
+    var logger: Logging.Logger {
+      Logging.Logger(label: "AVDECCSwiftTests.sink") { _ in _SinkLogHandler(sink: self) }
+    }
+
+    func waitUntilHeld() -> Bool { held.wait(timeout: .now() + 5) == .success }
+    func release() { released.signal() }
+
+    fileprivate func record(_ item: Item) {
+      let first = lock.withLock {
+        recorded.append(item)
+        return recorded.count == 1
+      }
+      if holdingFirst, first {
+        held.signal()
+        released.wait()
+      }
+    }
+  }
+
+  struct _SinkLogHandler: LogHandler {
+    let sink: _LogSink
+    var metadata: Logging.Logger.Metadata = [:]
+    var logLevel: Logging.Logger.Level = .trace
+
+    subscript(metadataKey key: String) -> Logging.Logger.Metadata.Value? {
+      get { metadata[key] }
+      set { metadata[key] = newValue }
+    }
+
+    func log(
+      level: Logging.Logger.Level,
+      message: Logging.Logger.Message,
+      metadata: Logging.Logger.Metadata?,
+      source: String,
+      file: String,
+      function: String,
+      line: UInt
+    ) {
+      sink.record(.init(
+        level: level,
+        layer: self.metadata["avdecc.layer"]?.description ?? "",
+        message: message.description
+      ))
+    }
+  }
+
+  func testRingCaptureLoggerCloses() {
+    let logger = AVDECCSwift.Logger(
+      forwardingTo: Logging.Logger(label: "AVDECCSwiftTests.ring"),
+      capture: .ring(capacity: 100)
+    )
+    XCTAssertEqual(logger.capture, .ring(capacity: 100))
+    XCTAssertEqual(logger.droppedItems, 0)
+    logger.close()
+    logger.close()
+    XCTAssertEqual(logger.droppedItems, 0)
+  }
+
+  func testRingCaptureCountsDropsWhenFull() {
+    let sink = _LogSink(holdingFirst: true)
+    let logger = AVDECCSwift.Logger(forwardingTo: sink.logger, capture: .ring(capacity: 4))
+    XCTAssertEqual(logger.capture, .ring(capacity: 4))
+
+    // The drainer takes the first item and parks in the sink; the next
+    // four fill the ring and the rest are dropped.
+    AVDECCSwift.Logger.emit("ring 0", level: .info)
+    XCTAssertTrue(sink.waitUntilHeld())
+    for i in 1...10 {
+      AVDECCSwift.Logger.emit("ring \(i)", level: .info)
+    }
+    XCTAssertEqual(logger.capturedItems, 5)
+    XCTAssertEqual(logger.droppedItems, 6)
+
+    sink.release()
+    logger.close()
+    XCTAssertEqual(sink.messages, (0...4).map { "ring \($0)" })
+    XCTAssertEqual(logger.droppedItems, 6)
+  }
+
+  func testPerLayerLevels() {
+    let logger = AVDECCSwift.Logger(
+      forwardingTo: Logging.Logger(label: "AVDECCSwiftTests.layers"),
+      level: .warn
+    )
+    defer { logger.close() }
+    XCTAssertEqual(logger.level(for: .protocolInterface), .warn)
+    logger.setLevel(.trace, for: .controllerStateMachine)
+    XCTAssertEqual(logger.level(for: .controllerStateMachine), .trace)
+    XCTAssertEqual(logger.level(for: .protocolInterface), .warn)
+    XCTAssertEqual(logger.level, .warn)
+    logger.level = .error
+    XCTAssertEqual(logger.level(for: .controllerStateMachine), .trace)
+    XCTAssertEqual(logger.level(for: .aemPayload), .error)
+    logger.setLevel(nil, for: .controllerStateMachine)
+    XCTAssertEqual(logger.level(for: .controllerStateMachine), .error)
+  }
+
+  func testBurstSuppressionToggles() {
+    let logger = AVDECCSwift.Logger(
+      forwardingTo: Logging.Logger(label: "AVDECCSwiftTests.burst")
+    )
+    defer { logger.close() }
+    XCTAssertEqual(logger.suppressedDuplicates, 0)
+    logger.setBurstSuppression(.init(maxItemsPerSecond: 100))
+    logger.flushSuppressionSummaries()
+    logger.setBurstSuppression(nil)
+    XCTAssertEqual(logger.suppressedDuplicates, 0)
+    XCTAssertEqual(logger.rateLimitedItems, 0)
+  }
+
+  func testBurstSuppressionFlood() {
+    let sink = _LogSink()
+    let logger = AVDECCSwift.Logger(forwardingTo: sink.logger)
+    defer { logger.close() }
+    func seen(_ layer: LogLayer) -> [String] {
+      sink.items.filter { $0.layer == layer.name }.map(\.message)
+    }
+
+    logger.setBurstSuppression(.init(duplicateWindow: .seconds(60)))
+    for _ in 0..<100 {
+      AVDECCSwift.Logger.emit("flood", level: .warn, layer: .protocolInterface)
+    }
+    XCTAssertEqual(logger.suppressedDuplicates, 99)
+    XCTAssertEqual(seen(.protocolInterface), ["flood"])
+    logger.setBurstSuppression(nil)
+    XCTAssertEqual(logger.suppressionSummaries, 1)
+    let flood = seen(.protocolInterface)
+    XCTAssertEqual(flood.count, 2)
+    XCTAssertTrue(flood.last?.hasPrefix("repeated 99 times in ") ?? false)
+    XCTAssertTrue(flood.last?.hasSuffix(" ms: flood") ?? false)
+
+    logger.setBurstSuppression(.init(duplicateWindow: nil, maxItemsPerSecond: 10, burst: 5))
+    for i in 0..<20 {
+      AVDECCSwift.Logger.emit("rate \(i)", level: .warn, layer: .controller)
+    }
+    XCTAssertEqual(logger.rateLimitedItems, 15)
+    XCTAssertEqual(seen(.controller), (0..<5).map { "rate \($0)" })
+    Thread.sleep(forTimeInterval: 0.2)
+    AVDECCSwift.Logger.emit("after", level: .warn, layer: .controller)
+    XCTAssertEqual(
+      seen(.controller).suffix(2),
+      ["rate limit: 15 messages suppressed", "after"]
+    )
+    XCTAssertEqual(logger.suppressionSummaries, 2)
+    XCTAssertEqual(logger.suppressedDuplicates, 99)
+  }
+
+  func testFlightRecorderRejectsBadPathAndSecondStart() throws {
+    let logger = AVDECCSwift.Logger(
+      forwardingTo: Logging.Logger(label: "AVDECCSwiftTests.recorder")
+    )
+    defer { logger.close() }
+    XCTAssertThrowsError(
+      try logger.startFlightRecorder(path: "/nonexistent-directory/avdecc.flight")
+    ) { error in
+      XCTAssertEqual((error as? LoggerError)?.code, .internalError)
+    }
+    let path = "/tmp/AVDECCSwiftTests-\(getpid()).flight"
+    defer { unlink(path) }
+    try logger.startFlightRecorder(path: path, capacity: 64 * 1024)
+    XCTAssertThrowsError(try logger.startFlightRecorder(path: path)) { error in
+      XCTAssertEqual((error as? LoggerError)?.code, .invalidParameters)
+    }
+    XCTAssertEqual(logger.level, .info)
+  }
+
+  func testFlightRecorderRoundTripAcrossWrap() throws {
+    let sink = _LogSink()
+    // Counts whatever la_avdecc's global level lets through.
+    let watcher = AVDECCSwift.Logger(forwardingTo: sink.logger, level: .error)
+    defer { watcher.close() }
+    let logger = AVDECCSwift.Logger(forwardingTo: sink.logger, level: .error)
+    let path = "/tmp/AVDECCSwiftTests-wrap-\(getpid()).flight"
+    defer { unlink(path) }
+    // One page of data; each record takes 40 bytes, so 500 of them lap
+    // the file several times.
+    try logger.startFlightRecorder(path: path, capacity: 4096, level: .debug)
+    logger.countingLevel = .trace
+    for i in 0..<500 {
+      AVDECCSwift.Logger.emit(String(format: "record %04d", i), level: .debug, layer: .entity)
+    }
+    XCTAssertEqual(logger.flightRecorderRecords, 500)
+    XCTAssertEqual(watcher.counts()[.debug, .entity], 500)
+    logger.close()
+    XCTAssertEqual(logger.flightRecorderRecords, 0)
+    XCTAssertNil(logger.countingLevel)
+    XCTAssertTrue(sink.items.filter { $0.layer == LogLayer.entity.name }.isEmpty)
+
+    // Closing gave la_avdecc back the base level, so the recorder's and
+    // counting levels no longer pull debug items out of it.
+    let before = watcher.counts()
+    AVDECCSwift.Logger.emit("after close", level: .debug, layer: .entity)
+    XCTAssertEqual(watcher.counts().since(before)[.debug], 0)
+
+    let image = try Data(contentsOf: URL(fileURLWithPath: path))
+    let recording = try image.withUnsafeBytes { try FlightRecording(image: $0) }
+    let messages = recording.records.map(\.message)
+    XCTAssertEqual(messages.last, "record 0499")
+    XCTAssertGreaterThan(messages.count, 90)
+    XCTAssertLessThan(messages.count, 500)
+    let first = 500 - messages.count
+    XCTAssertEqual(messages, (first..<500).map { String(format: "record %04d", $0) })
+    XCTAssertTrue(recording.records.allSatisfy { $0.level == .debug && $0.layer == .entity })
+    XCTAssertEqual(
+      recording.records.map(\.timestampNanos),
+      recording.records.map(\.timestampNanos).sorted()
+    )
+
+    XCTAssertThrowsError(try Data(count: 16).withUnsafeBytes { try FlightRecording(image: $0) }) {
+      XCTAssertEqual(($0 as? LoggerError)?.code, .invalidParameters)
+    }
+  }
+
+  func testFlightRecordingRejectsBadCapacity() {
+    // A header in front of one page of data; only `capacity` varies.
+    func image(capacity: UInt64) -> Data {
+      var data = Data(count: 8192)
+      data.replaceSubrange(0..<8, with: Array("AVDFLREC".utf8))
+      withUnsafeBytes(of: UInt32(1)) { data.replaceSubrange(8..<12, with: $0) }
+      withUnsafeBytes(of: UInt32(4096)) { data.replaceSubrange(12..<16, with: $0) }
+      withUnsafeBytes(of: capacity) { data.replaceSubrange(16..<24, with: $0) }
+      return data
+    }
+    XCTAssertNoThrow(try image(capacity: 4096).withUnsafeBytes { try FlightRecording(image: $0) })
+    // Zero would divide by zero in every position lookup; the other one
+    // wraps dataOffset + capacity around to zero.
+    for capacity: UInt64 in [0, 4104, 0 &- 4096] {
+      XCTAssertThrowsError(
+        try image(capacity: capacity).withUnsafeBytes { try FlightRecording(image: $0) },
+        "capacity \(capacity)"
+      ) {
+        XCTAssertEqual(($0 as? LoggerError)?.code, .invalidParameters)
+      }
+    }
+  }
+
+  func testLogCountsSnapshot() {
+    let logger = AVDECCSwift.Logger(
+      forwardingTo: Logging.Logger(label: "AVDECCSwiftTests.counts")
+    )
+    defer { logger.close() }
+    XCTAssertNil(logger.countingLevel)
+    logger.countingLevel = .debug
+    XCTAssertEqual(logger.countingLevel, .debug)
+    XCTAssertEqual(logger.level, .info)
+    let before = logger.counts()
+    for _ in 0..<3 {
+      AVDECCSwift.Logger.emit("counted", level: .debug, layer: .controllerStateMachine)
+    }
+    AVDECCSwift.Logger.emit("counted", level: .warn, layer: .controllerStateMachine)
+    AVDECCSwift.Logger.emit("counted", level: .warn, layer: .protocolInterface)
+    AVDECCSwift.Logger.emit("not counted", level: .trace, layer: .protocolInterface)
+    let delta = logger.counts().since(before)
+    XCTAssertEqual(delta[.debug, .controllerStateMachine], 3)
+    XCTAssertEqual(delta[.warn, .controllerStateMachine], 1)
+    XCTAssertEqual(delta[.warn, .protocolInterface], 1)
+    XCTAssertEqual(delta[.trace], 0)
+    XCTAssertEqual(delta[.debug], 3)
+    XCTAssertEqual(delta[.warn], 2)
+    XCTAssertEqual(delta[layer: .controllerStateMachine], 4)
+    XCTAssertEqual(delta[.none], 0)
+    XCTAssertEqual(delta.total, 5)
+
+    // Without a counting level only what is forwarded reaches the count.
+    logger.countingLevel = nil
+    let quiet = logger.counts()
+    AVDECCSwift.Logger.emit("below level", level: .debug, layer: .entity)
+    AVDECCSwift.Logger.emit("at level", level: .info, layer: .entity)
+    let forwarded = logger.counts().since(quiet)
+    XCTAssertEqual(forwarded[.debug], 0)
+    XCTAssertEqual(forwarded[.info, .entity], 1)
+  }
+
   // MARK: - LocalEntityDelegate
 
   // Smoke-test: a class that doesn't override any of the ~80 methods
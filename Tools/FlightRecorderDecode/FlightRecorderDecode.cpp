@@ -0,0 +1,141 @@
+/*
+ * Copyright (C) 2026, PADL Software Pty Ltd
+ *
+ * This file is part of AVDECCSwift.
+ *
+ * AVDECCSwift is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * AVDECCSwift is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with AVDECCSwift.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+// Turns a flight-recorder file (Logger.startFlightRecorder) back into
+// text, oldest record first, one line per record:
+//
+//     2026-10-17T09:41:07.123456Z trace controllerStateMachine <message>
+//
+//     swift run avdecc-flightrecorder-decode [--monotonic] <file>
+//
+// `--monotonic` prints the raw steady-clock nanoseconds instead of
+// wall-clock time. The file may belong to a process that crashed or is
+// still running; records it was overwriting at that moment are skipped,
+// and the number of bytes skipped is reported on stderr.
+#include <AVDECCSwiftFlightRecorder.hpp>
+
+#include <cerrno>
+#include <cinttypes>
+#include <cstdio>
+#include <cstring>
+#include <ctime>
+#include <string>
+
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+namespace {
+
+char const* levelName(uint8_t level) {
+  switch (level) {
+    case 0: return "trace";
+    case 1: return "debug";
+    case 2: return "info";
+    case 3: return "warn";
+    case 4: return "error";
+    case 5: return "compat";
+    default: return "?";
+  }
+}
+
+// Matches LogLayer.name on the Swift side.
+char const* layerName(uint8_t layer) {
+  static char const* const names[] = {
+      "generic",    "serialization",          "protocolInterface",
+      "aemPayload", "entity",                 "controllerEntity",
+      "controllerStateMachine", "controller", "jsonSerializer",
+  };
+  return layer < sizeof(names) / sizeof(names[0]) ? names[layer] : "user";
+}
+
+void usage(char const* argv0) {
+  std::fprintf(stderr, "usage: %s [--monotonic] <flight-recorder-file>\n", argv0);
+}
+
+} // namespace
+
+int main(int argc, char** argv) {
+  bool monotonic = false;
+  char const* path = nullptr;
+  for (int i = 1; i < argc; ++i) {
+    if (std::strcmp(argv[i], "--monotonic") == 0) {
+      monotonic = true;
+    } else if (!path && argv[i][0] != '-') {
+      path = argv[i];
+    } else {
+      usage(argv[0]);
+      return 1;
+    }
+  }
+  if (!path) {
+    usage(argv[0]);
+    return 1;
+  }
+
+  auto const fd = ::open(path, O_RDONLY | O_CLOEXEC);
+  struct stat st {};
+  if (fd < 0 || ::fstat(fd, &st) != 0) {
+    std::fprintf(stderr, "%s: %s\n", path, std::strerror(errno));
+    return 1;
+  }
+  auto const size = static_cast<size_t>(st.st_size);
+  auto* const image = size ? ::mmap(nullptr, size, PROT_READ, MAP_SHARED, fd, 0) : MAP_FAILED;
+  ::close(fd);
+  if (image == MAP_FAILED) {
+    std::fprintf(stderr, "%s: %s\n", path, size ? std::strerror(errno) : "empty file");
+    return 1;
+  }
+
+  AVDECCSwift::FlightRecorderReader reader;
+  std::string error;
+  if (!reader.open(static_cast<uint8_t const*>(image), size, error)) {
+    std::fprintf(stderr, "%s: %s\n", path, error.c_str());
+    ::munmap(image, size);
+    return 1;
+  }
+
+  auto const& header = reader.header();
+  AVDECCSwift::FlightRecorderReader::Record record;
+  uint64_t count = 0;
+  while (reader.next(record)) {
+    ++count;
+    if (monotonic) {
+      std::printf("%" PRIu64, record.timestampNanos);
+    } else {
+      auto const nanos = header.openedRealtimeNanos +
+                         (record.timestampNanos - header.openedSteadyNanos);
+      auto const seconds = static_cast<time_t>(nanos / 1'000'000'000u);
+      struct tm utc {};
+      gmtime_r(&seconds, &utc);
+      char stamp[32];
+      std::strftime(stamp, sizeof(stamp), "%Y-%m-%dT%H:%M:%S", &utc);
+      std::printf("%s.%06" PRIu64 "Z", stamp, nanos % 1'000'000'000u / 1000u);
+    }
+    std::printf(" %s %s %.*s\n", levelName(record.level), layerName(record.layer),
+                static_cast<int>(record.message.size()), record.message.data());
+  }
+
+  std::fprintf(stderr, "%" PRIu64 " records from pid %" PRIu64 ", %" PRIu64
+                       " bytes skipped\n",
+               count, header.pid, reader.skippedBytes());
+  ::munmap(image, size);
+  return 0;
+}